@@ -0,0 +1,618 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include "AssetWatcher.h"
+#include <RmlUi/Core/Context.h>
+#include <RmlUi/Core/ElementDocument.h>
+#include <RmlUi/Core/Factory.h>
+#include <RmlUi/Core/FileInterface.h>
+#include <RmlUi/Core/Log.h>
+#include <RmlUi/Core/Math.h>
+#include <RmlUi/Core/StringUtilities.h>
+#include <algorithm>
+#include <stdint.h>
+
+#if defined RMLUI_PLATFORM_WIN32
+	#include "RmlUi_Include_Windows.h"
+	#include <memory>
+	#define RMLUI_ASSETWATCHER_READDIRECTORYCHANGES
+#else
+	#include <sys/stat.h>
+#endif
+
+#if defined(__linux__)
+	#include <poll.h>
+	#include <sys/inotify.h>
+	#include <unistd.h>
+	#define RMLUI_ASSETWATCHER_INOTIFY
+#endif
+
+// Templates may use other templates, limit the depth in case they refer to each other.
+static constexpr int MaxDependencyDepth = 8;
+
+static double ToMilliseconds(std::chrono::steady_clock::duration duration)
+{
+	return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+// Lexically normalizes the path so that paths reported by the watcher and paths found in documents compare equal.
+static Rml::String NormalizePath(const Rml::String& path)
+{
+	Rml::String slashed = path;
+	std::replace(slashed.begin(), slashed.end(), '\\', '/');
+
+	Rml::StringList parts;
+	Rml::StringUtilities::ExpandString(parts, slashed, '/');
+
+	Rml::StringList result;
+	for (const Rml::String& part : parts)
+	{
+		if (part.empty() || part == ".")
+			continue;
+		if (part == ".." && !result.empty() && result.back() != "..")
+			result.pop_back();
+		else
+			result.push_back(part);
+	}
+
+	Rml::String joined;
+	Rml::StringUtilities::JoinString(joined, result, '/');
+	return (!slashed.empty() && slashed[0] == '/' ? "/" + joined : joined);
+}
+
+static Rml::String GetDirectory(const Rml::String& path)
+{
+	const size_t slash = path.rfind('/');
+	return (slash == Rml::String::npos ? Rml::String() : path.substr(0, slash));
+}
+
+static Rml::String JoinPath(const Rml::String& directory, const Rml::String& path)
+{
+	return NormalizePath(directory.empty() ? path : directory + '/' + path);
+}
+
+// Returns the value of the attribute in the given tag contents, accepting both single and double quotes.
+static Rml::String GetAttribute(const Rml::String& tag, const char* name)
+{
+	const Rml::String key = Rml::String(name) + '=';
+	size_t pos = tag.find(key);
+	while (pos != Rml::String::npos && pos > 0 && !Rml::StringUtilities::IsWhitespace(tag[pos - 1]))
+		pos = tag.find(key, pos + 1);
+	if (pos == Rml::String::npos || pos + key.size() >= tag.size())
+		return {};
+
+	const char quote = tag[pos + key.size()];
+	if (quote != '"' && quote != '\'')
+		return {};
+
+	const size_t begin = pos + key.size() + 1;
+	const size_t end = tag.find(quote, begin);
+	return (end == Rml::String::npos ? Rml::String() : tag.substr(begin, end - begin));
+}
+
+// Last write time and size of a file. The size is compared as well, since two saves may fall within the resolution of the time.
+struct FileStamp {
+	int64_t write_time = 0;
+	int64_t size = -1;
+
+	bool operator!=(const FileStamp& other) const { return write_time != other.write_time || size != other.size; }
+};
+
+static FileStamp GetFileStamp(const Rml::String& path)
+{
+	FileStamp stamp;
+#if defined RMLUI_PLATFORM_WIN32
+	WIN32_FILE_ATTRIBUTE_DATA data;
+	if (GetFileAttributesExA(path.c_str(), GetFileExInfoStandard, &data))
+	{
+		// In 100 ns units.
+		stamp.write_time = int64_t((uint64_t(data.ftLastWriteTime.dwHighDateTime) << 32) | data.ftLastWriteTime.dwLowDateTime);
+		stamp.size = int64_t((uint64_t(data.nFileSizeHigh) << 32) | data.nFileSizeLow);
+	}
+#else
+	struct stat file_stat;
+	if (stat(path.c_str(), &file_stat) == 0)
+	{
+		// In nanoseconds.
+	#if defined(__APPLE__)
+		const timespec& time = file_stat.st_mtimespec;
+	#else
+		const timespec& time = file_stat.st_mtim;
+	#endif
+		stamp.write_time = int64_t(time.tv_sec) * 1000000000 + int64_t(time.tv_nsec);
+		stamp.size = int64_t(file_stat.st_size);
+	}
+#endif
+	return stamp;
+}
+
+#ifdef RMLUI_ASSETWATCHER_READDIRECTORYCHANGES
+// A directory with an overlapped ReadDirectoryChangesW call kept pending on it. The system writes into the buffer until the call
+// completes, so the watch must not move or be destroyed while a read is pending.
+struct DirectoryWatch {
+	Rml::String directory;
+	HANDLE handle = INVALID_HANDLE_VALUE;
+	OVERLAPPED overlapped = {};
+	bool is_read_pending = false;
+	alignas(DWORD) BYTE buffer[16 * 1024];
+};
+
+static bool BeginDirectoryRead(DirectoryWatch& watch)
+{
+	const DWORD filter = FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_SIZE;
+	watch.is_read_pending =
+		(ReadDirectoryChangesW(watch.handle, watch.buffer, sizeof(watch.buffer), FALSE, filter, nullptr, &watch.overlapped, nullptr) != 0);
+	return watch.is_read_pending;
+}
+
+static void CloseDirectoryWatch(DirectoryWatch& watch)
+{
+	if (watch.is_read_pending)
+	{
+		DWORD length = 0;
+		CancelIo(watch.handle);
+		GetOverlappedResult(watch.handle, &watch.overlapped, &length, TRUE);
+		watch.is_read_pending = false;
+	}
+	if (watch.handle != INVALID_HANDLE_VALUE)
+		CloseHandle(watch.handle);
+	if (watch.overlapped.hEvent)
+		CloseHandle(watch.overlapped.hEvent);
+	watch.handle = INVALID_HANDLE_VALUE;
+	watch.overlapped.hEvent = nullptr;
+}
+
+static Rml::String ToUTF8(const WCHAR* str, int length)
+{
+	const int size = WideCharToMultiByte(CP_UTF8, 0, str, length, nullptr, 0, nullptr, nullptr);
+	Rml::String result(size_t(Rml::Math::Max(size, 0)), '\0');
+	if (size > 0)
+		WideCharToMultiByte(CP_UTF8, 0, str, length, &result[0], size, nullptr, nullptr);
+	return result;
+}
+#endif
+
+AssetWatcher::AssetWatcher(Rml::Context* in_context, std::function<void()> in_wake_callback) :
+	context(in_context), wake_callback(std::move(in_wake_callback))
+{
+	RefreshDependencies();
+	thread = std::thread(&AssetWatcher::WatchThread, this);
+}
+
+AssetWatcher::~AssetWatcher()
+{
+	stop = true;
+	if (thread.joinable())
+		thread.join();
+}
+
+void AssetWatcher::SetDebounceTime(double seconds)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	debounce_time = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(Rml::Math::Max(seconds, 0.0)));
+}
+
+bool AssetWatcher::Update()
+{
+	RefreshDependencies();
+
+	Rml::Vector<Rml::String> changes;
+	Clock::time_point change_time;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		changes.swap(changed_files);
+		change_time = first_change_time;
+	}
+
+	if (changes.empty())
+		return false;
+
+	const Clock::time_point reload_begin = Clock::now();
+
+	// Documents are reloaded when they or their templates changed, otherwise only their style sheets are reloaded.
+	Rml::UnorderedSet<Rml::String> reload_documents;
+	Rml::UnorderedSet<Rml::String> reload_styles;
+	bool templates_changed = false;
+
+	for (const Rml::String& path : changes)
+	{
+		auto it = dependencies.find(path);
+		if (it == dependencies.end())
+			continue;
+
+		const Dependency& dependency = it->second;
+		templates_changed |= (dependency.kind == FileKind::Template);
+		for (const Rml::String& document_url : dependency.document_urls)
+		{
+			if (dependency.kind == FileKind::StyleSheet)
+				reload_styles.insert(document_url);
+			else
+				reload_documents.insert(document_url);
+		}
+	}
+
+	if (reload_documents.empty() && reload_styles.empty())
+		return false;
+
+	if (templates_changed)
+		Rml::Factory::ClearTemplateCache();
+
+	for (const Rml::String& document_url : reload_documents)
+		ReloadDocuments(document_url);
+
+	for (const Rml::String& document_url : reload_styles)
+	{
+		if (reload_documents.count(document_url))
+			continue;
+
+		for (int i = 0; i < context->GetNumDocuments(); i++)
+		{
+			Rml::ElementDocument* document = context->GetDocument(i);
+			if (NormalizePath(document->GetSourceURL()) == document_url)
+				document->ReloadStyleSheet();
+		}
+	}
+
+	RefreshDependencies();
+
+	const Clock::time_point reload_end = Clock::now();
+	Rml::Log::Message(Rml::Log::LT_INFO,
+		"Hot reload: %d documents and %d style sheets reloaded after %d changed files in %.1f ms, %.1f ms after the first change.",
+		(int)reload_documents.size(), (int)(reload_styles.size()), (int)changes.size(), ToMilliseconds(reload_end - reload_begin),
+		ToMilliseconds(reload_end - change_time));
+
+	return true;
+}
+
+void AssetWatcher::ReloadDocuments(const Rml::String& document_url)
+{
+	struct ScrollPosition {
+		Rml::String id;
+		float left, top;
+	};
+
+	// Gather the documents first, as closing and loading documents changes their order in the context.
+	Rml::Vector<Rml::ElementDocument*> documents;
+	for (int i = 0; i < context->GetNumDocuments(); i++)
+	{
+		Rml::ElementDocument* document = context->GetDocument(i);
+		if (NormalizePath(document->GetSourceURL()) == document_url)
+			documents.push_back(document);
+	}
+
+	for (Rml::ElementDocument* old_document : documents)
+	{
+		Rml::Vector<ScrollPosition> scroll_positions;
+		Rml::Vector<Rml::Element*> stack = {old_document};
+		while (!stack.empty())
+		{
+			Rml::Element* element = stack.back();
+			stack.pop_back();
+
+			const float left = element->GetScrollLeft();
+			const float top = element->GetScrollTop();
+			if ((left != 0.f || top != 0.f) && !element->GetId().empty())
+				scroll_positions.push_back(ScrollPosition{element->GetId(), left, top});
+
+			for (int i = 0; i < element->GetNumChildren(); i++)
+				stack.push_back(element->GetChild(i));
+		}
+
+		const Rml::String source_url = old_document->GetSourceURL();
+		const bool visible = old_document->IsVisible();
+		old_document->Close();
+
+		Rml::ElementDocument* document = context->LoadDocument(source_url);
+		if (!document)
+		{
+			Rml::Log::Message(Rml::Log::LT_ERROR, "Hot reload: could not reload document '%s'.", source_url.c_str());
+			continue;
+		}
+
+		if (visible)
+			document->Show();
+
+		if (!scroll_positions.empty())
+		{
+			// Scroll offsets are clamped to the scrollable area, so the layout must be known before they are restored.
+			document->UpdateDocument();
+			for (const ScrollPosition& scroll : scroll_positions)
+			{
+				if (Rml::Element* element = document->GetElementById(scroll.id))
+				{
+					element->SetScrollLeft(scroll.left);
+					element->SetScrollTop(scroll.top);
+				}
+			}
+		}
+	}
+}
+
+void AssetWatcher::RefreshDependencies()
+{
+	Rml::Vector<const void*> documents;
+	for (int i = 0; i < context->GetNumDocuments(); i++)
+		documents.push_back(context->GetDocument(i));
+
+	if (documents == known_documents)
+		return;
+
+	known_documents = std::move(documents);
+	dependencies.clear();
+
+	for (int i = 0; i < context->GetNumDocuments(); i++)
+	{
+		const Rml::String document_url = NormalizePath(context->GetDocument(i)->GetSourceURL());
+		AddDependencies(document_url, document_url, FileKind::Document, 0);
+	}
+
+	Rml::Vector<Rml::String> files;
+	files.reserve(dependencies.size());
+	for (const auto& dependency : dependencies)
+		files.push_back(dependency.first);
+	std::sort(files.begin(), files.end());
+
+	std::lock_guard<std::mutex> lock(mutex);
+	if (files != watched_files)
+	{
+		watched_files = std::move(files);
+		watched_files_dirty = true;
+	}
+}
+
+void AssetWatcher::AddDependencies(const Rml::String& document_url, const Rml::String& path, FileKind kind, int depth)
+{
+	// Documents loaded from memory, such as the debugger, have no source file and are skipped here.
+	Rml::String source;
+	if (depth > MaxDependencyDepth || !Rml::GetFileInterface()->LoadFile(path, source))
+		return;
+
+	Dependency& dependency = dependencies[path];
+	dependency.kind = kind;
+	dependency.document_urls.insert(document_url);
+
+	if (kind == FileKind::StyleSheet)
+		return;
+
+	const Rml::String directory = GetDirectory(path);
+	for (size_t pos = source.find("<link"); pos != Rml::String::npos; pos = source.find("<link", pos + 1))
+	{
+		const size_t end = source.find('>', pos);
+		if (end == Rml::String::npos)
+			break;
+
+		const Rml::String tag = source.substr(pos, end - pos);
+		const Rml::String type = GetAttribute(tag, "type");
+		const Rml::String href = GetAttribute(tag, "href");
+		if (href.empty())
+			continue;
+
+		if (type == "text/rcss")
+			AddDependencies(document_url, JoinPath(directory, href), FileKind::StyleSheet, depth + 1);
+		else if (type == "text/template")
+			AddDependencies(document_url, JoinPath(directory, href), FileKind::Template, depth + 1);
+	}
+}
+
+void AssetWatcher::WatchThread()
+{
+	Rml::UnorderedSet<Rml::String> pending;
+	Clock::time_point pending_first_time, pending_last_time;
+
+	auto add_change = [&](const Rml::String& path) {
+		const Clock::time_point now = Clock::now();
+		if (pending.empty())
+			pending_first_time = now;
+		pending_last_time = now;
+		pending.insert(path);
+	};
+
+	Rml::Vector<Rml::String> files;
+
+	// Watch the directories of the files, since editors commonly save by writing a new file and renaming it over the old one.
+#if defined RMLUI_ASSETWATCHER_INOTIFY
+	const int inotify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if (inotify_fd < 0)
+		Rml::Log::Message(Rml::Log::LT_WARNING, "Hot reload: inotify is not available, polling files instead.");
+	Rml::UnorderedMap<int, Rml::String> watch_directories;
+	const bool use_notifications = (inotify_fd >= 0);
+#elif defined RMLUI_ASSETWATCHER_READDIRECTORYCHANGES
+	Rml::Vector<std::unique_ptr<DirectoryWatch>> directory_watches;
+	bool use_notifications = true;
+#else
+	const bool use_notifications = false;
+#endif
+	Rml::UnorderedMap<Rml::String, FileStamp> file_stamps;
+
+	while (!stop)
+	{
+		Clock::duration debounce;
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			debounce = debounce_time;
+			if (watched_files_dirty)
+			{
+				files = watched_files;
+				watched_files_dirty = false;
+			}
+			else
+				files.clear();
+		}
+
+		// Files are only copied when the set changed, refresh the watches and the recorded file stamps accordingly.
+		if (!files.empty())
+		{
+#if defined RMLUI_ASSETWATCHER_INOTIFY
+			if (use_notifications)
+			{
+				for (const Rml::String& file : files)
+				{
+					const Rml::String directory = GetDirectory(file);
+					const char* directory_path = (directory.empty() ? "." : directory.c_str());
+					const int wd = inotify_add_watch(inotify_fd, directory_path, IN_CLOSE_WRITE | IN_MOVED_TO);
+					if (wd >= 0)
+						watch_directories[wd] = directory;
+				}
+			}
+#elif defined RMLUI_ASSETWATCHER_READDIRECTORYCHANGES
+			for (size_t i = 0; use_notifications && i < files.size(); i++)
+			{
+				const Rml::String directory = GetDirectory(files[i]);
+				auto is_watched = [&](const std::unique_ptr<DirectoryWatch>& watch) { return watch->directory == directory; };
+				if (std::any_of(directory_watches.begin(), directory_watches.end(), is_watched))
+					continue;
+
+				std::unique_ptr<DirectoryWatch> watch(new DirectoryWatch);
+				watch->directory = directory;
+				watch->handle = CreateFileA(directory.empty() ? "." : directory.c_str(), FILE_LIST_DIRECTORY,
+					FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED,
+					nullptr);
+				watch->overlapped.hEvent = CreateEventA(nullptr, TRUE, FALSE, nullptr);
+
+				if (watch->handle == INVALID_HANDLE_VALUE || !watch->overlapped.hEvent || !BeginDirectoryRead(*watch))
+				{
+					Rml::Log::Message(Rml::Log::LT_WARNING, "Hot reload: could not watch directory '%s', polling files instead.", directory.c_str());
+					CloseDirectoryWatch(*watch);
+					use_notifications = false;
+					break;
+				}
+				directory_watches.push_back(std::move(watch));
+			}
+#endif
+			Rml::UnorderedMap<Rml::String, FileStamp> new_stamps;
+			for (const Rml::String& file : files)
+				new_stamps[file] = GetFileStamp(file);
+			file_stamps = std::move(new_stamps);
+		}
+
+		if (use_notifications)
+		{
+#if defined RMLUI_ASSETWATCHER_INOTIFY
+			pollfd poll_fd = {inotify_fd, POLLIN, 0};
+			if (poll(&poll_fd, 1, 50) > 0)
+			{
+				alignas(inotify_event) char buffer[4096];
+				ssize_t length;
+				while ((length = read(inotify_fd, buffer, sizeof(buffer))) > 0)
+				{
+					for (char* ptr = buffer; ptr < buffer + length;)
+					{
+						const inotify_event* event = reinterpret_cast<const inotify_event*>(ptr);
+						auto it = watch_directories.find(event->wd);
+						if (event->len > 0 && it != watch_directories.end())
+							add_change(JoinPath(it->second, event->name));
+						ptr += sizeof(inotify_event) + event->len;
+					}
+				}
+			}
+#elif defined RMLUI_ASSETWATCHER_READDIRECTORYCHANGES
+			// Wait for the first directories to report, the remaining ones are checked without waiting afterwards.
+			Rml::Vector<HANDLE> events;
+			for (size_t i = 0; i < directory_watches.size() && i < MAXIMUM_WAIT_OBJECTS; i++)
+				events.push_back(directory_watches[i]->overlapped.hEvent);
+			if (events.empty())
+				std::this_thread::sleep_for(std::chrono::milliseconds(50));
+			else
+				WaitForMultipleObjects(DWORD(events.size()), events.data(), FALSE, 50);
+
+			for (const std::unique_ptr<DirectoryWatch>& watch : directory_watches)
+			{
+				DWORD length = 0;
+				if (!GetOverlappedResult(watch->handle, &watch->overlapped, &length, FALSE) && GetLastError() == ERROR_IO_INCOMPLETE)
+					continue;
+				watch->is_read_pending = false;
+
+				if (length == 0)
+				{
+					// The changes did not fit into the buffer or the read failed, consider all watched files in the directory changed.
+					for (const auto& entry : file_stamps)
+					{
+						if (GetDirectory(entry.first) == watch->directory)
+							add_change(entry.first);
+					}
+				}
+				else
+				{
+					for (const BYTE* ptr = watch->buffer;;)
+					{
+						const FILE_NOTIFY_INFORMATION* info = reinterpret_cast<const FILE_NOTIFY_INFORMATION*>(ptr);
+						if (info->Action == FILE_ACTION_ADDED || info->Action == FILE_ACTION_MODIFIED || info->Action == FILE_ACTION_RENAMED_NEW_NAME)
+							add_change(JoinPath(watch->directory, ToUTF8(info->FileName, int(info->FileNameLength / sizeof(WCHAR)))));
+						if (info->NextEntryOffset == 0)
+							break;
+						ptr += info->NextEntryOffset;
+					}
+				}
+
+				if (!BeginDirectoryRead(*watch))
+				{
+					Rml::Log::Message(Rml::Log::LT_WARNING, "Hot reload: stopped watching directory '%s', polling files instead.",
+						watch->directory.c_str());
+					use_notifications = false;
+				}
+			}
+#endif
+		}
+		else
+		{
+			// Without change notifications, poll the watched files a few times per second.
+			std::this_thread::sleep_for(std::chrono::milliseconds(250));
+			for (auto& entry : file_stamps)
+			{
+				const FileStamp stamp = GetFileStamp(entry.first);
+				if (stamp != entry.second)
+				{
+					entry.second = stamp;
+					add_change(entry.first);
+				}
+			}
+		}
+
+		if (!pending.empty() && Clock::now() - pending_last_time >= debounce)
+		{
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				if (changed_files.empty())
+					first_change_time = pending_first_time;
+				changed_files.insert(changed_files.end(), pending.begin(), pending.end());
+			}
+			pending.clear();
+
+			if (wake_callback)
+				wake_callback();
+		}
+	}
+
+#if defined RMLUI_ASSETWATCHER_INOTIFY
+	if (inotify_fd >= 0)
+		close(inotify_fd);
+#elif defined RMLUI_ASSETWATCHER_READDIRECTORYCHANGES
+	for (const std::unique_ptr<DirectoryWatch>& watch : directory_watches)
+		CloseDirectoryWatch(*watch);
+#endif
+}
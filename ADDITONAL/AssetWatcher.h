@@ -0,0 +1,101 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef RMLUI_BACKENDS_ASSETWATCHER_H
+#define RMLUI_BACKENDS_ASSETWATCHER_H
+
+#include <RmlUi/Core/Types.h>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace Rml {
+class Context;
+}
+
+/**
+    Watches the files used by the documents of a context, and reloads only what depends on changed files.
+
+    The dependencies of each document are found by scanning its source and the templates it uses for linked style sheets and templates.
+    A changed style sheet reloads the styles of the documents using it, without touching their elements. A changed document or template
+    reloads the documents using it, while data models, which are owned by the context, stay intact and the scroll positions of elements
+    with an id are carried over to the new document.
+
+    Changes are detected on a background thread using inotify on Linux and ReadDirectoryChangesW on Windows, and otherwise by polling
+    the last write times and sizes of the files. Bursts of writes, as editors commonly produce when saving, are collected until the files
+    have been quiet for the debounce time. The wake callback is then invoked from the background thread, so that a sleeping main loop can
+    apply the changes through Update().
+ */
+class AssetWatcher {
+public:
+	AssetWatcher(Rml::Context* context, std::function<void()> wake_callback = nullptr);
+	~AssetWatcher();
+
+	// Sets the time in seconds that files must be unchanged before the changes are applied.
+	void SetDebounceTime(double seconds);
+
+	// Applies any pending changes, call from the main thread before updating the context. Returns true if any document changed.
+	bool Update();
+
+private:
+	using Clock = std::chrono::steady_clock;
+
+	enum class FileKind { Document, Template, StyleSheet };
+	struct Dependency {
+		FileKind kind;
+		Rml::UnorderedSet<Rml::String> document_urls;
+	};
+
+	void RefreshDependencies();
+	void AddDependencies(const Rml::String& document_url, const Rml::String& path, FileKind kind, int depth);
+	void ReloadDocuments(const Rml::String& document_url);
+
+	void WatchThread();
+
+	Rml::Context* context;
+	std::function<void()> wake_callback;
+
+	// Main thread state.
+	Rml::UnorderedMap<Rml::String, Dependency> dependencies;
+	Rml::Vector<const void*> known_documents;
+
+	// Shared with the watcher thread.
+	std::mutex mutex;
+	Rml::Vector<Rml::String> watched_files;
+	bool watched_files_dirty = false;
+	Rml::Vector<Rml::String> changed_files;
+	Clock::time_point first_change_time;
+	Clock::duration debounce_time = std::chrono::milliseconds(150);
+
+	std::atomic<bool> stop{false};
+	std::thread thread;
+};
+
+#endif
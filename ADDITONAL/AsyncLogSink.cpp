@@ -0,0 +1,385 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include "AsyncLogSink.h"
+#include <RmlUi/Core/Math.h>
+#include <chrono>
+#include <csignal>
+#include <exception>
+#include <string.h>
+#ifdef _WIN32
+	#include <io.h>
+#else
+	#include <unistd.h>
+#endif
+
+static AsyncLogSink* crash_sink = nullptr;
+static int crash_descriptor = -1;
+static std::terminate_handler previous_terminate_handler = nullptr;
+
+static int64_t GetTimeNanoseconds()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static const char* GetTypePrefix(Rml::Log::Type type)
+{
+	switch (type)
+	{
+	case Rml::Log::LT_ALWAYS: return "";
+	case Rml::Log::LT_ERROR: return "[Error] ";
+	case Rml::Log::LT_ASSERT: return "[Assert] ";
+	case Rml::Log::LT_WARNING: return "[Warning] ";
+	case Rml::Log::LT_INFO: return "[Info] ";
+	case Rml::Log::LT_DEBUG: return "[Debug] ";
+	case Rml::Log::LT_MAX: break;
+	}
+	return "";
+}
+
+// Only async-signal-safe calls are allowed in the crash handler, so it bypasses the stdio buffer and writes straight to the descriptor.
+static void WriteRaw(int descriptor, const char* data, size_t length)
+{
+	while (length > 0)
+	{
+#ifdef _WIN32
+		const int result = _write(descriptor, data, (unsigned int)length);
+#else
+		const ssize_t result = write(descriptor, data, length);
+#endif
+		if (result <= 0)
+			return;
+		data += result;
+		length -= (size_t)result;
+	}
+}
+
+AsyncLogSink::AsyncLogSink(FILE* in_output) : output(in_output), slots(new Slot[Capacity])
+{
+	static_assert((Capacity & (Capacity - 1)) == 0, "The capacity must be a power of two.");
+
+	for (size_t i = 0; i < Capacity; i++)
+		slots[i].sequence.store(i, std::memory_order_relaxed);
+
+	thread = std::thread(&AsyncLogSink::WriterThread, this);
+}
+
+AsyncLogSink::~AsyncLogSink()
+{
+	stop = true;
+	if (thread.joinable())
+		thread.join();
+
+	if (crash_sink == this)
+		crash_sink = nullptr;
+}
+
+void AsyncLogSink::SetMaxLogType(Rml::Log::Type max_type)
+{
+	max_log_type = max_type;
+}
+
+void AsyncLogSink::SetRateLimit(double messages_per_second, int burst)
+{
+	const int64_t interval_ns = (messages_per_second > 0.0 ? int64_t(1e9 / messages_per_second) : 0);
+	emission_interval_ns = interval_ns;
+	burst_tolerance_ns = interval_ns * Rml::Math::Max(burst, 1);
+}
+
+bool AsyncLogSink::TryAcquireRate()
+{
+	const int64_t interval = emission_interval_ns.load(std::memory_order_relaxed);
+	if (interval <= 0)
+		return true;
+
+	const int64_t tolerance = burst_tolerance_ns.load(std::memory_order_relaxed);
+	const int64_t now = GetTimeNanoseconds();
+
+	int64_t arrival = theoretical_arrival_ns.load(std::memory_order_relaxed);
+	for (;;)
+	{
+		if (now < arrival - tolerance)
+			return false;
+
+		const int64_t next_arrival = Rml::Math::Max(arrival, now) + interval;
+		if (theoretical_arrival_ns.compare_exchange_weak(arrival, next_arrival, std::memory_order_relaxed))
+			return true;
+	}
+}
+
+void AsyncLogSink::Write(Rml::Log::Type type, const Rml::String& message)
+{
+	if ((int)type > max_log_type.load(std::memory_order_relaxed))
+	{
+		num_filtered.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+
+	if (type == Rml::Log::LT_ASSERT)
+	{
+		// Make sure the assertion is visible before execution possibly stops, at the cost of blocking this once.
+		while (draining.exchange(true, std::memory_order_acquire))
+			std::this_thread::yield();
+		DrainLocked();
+		WriteRepeatSummary();
+		WriteLine(type, message.data(), message.size());
+		fflush(output);
+		num_written.fetch_add(1, std::memory_order_relaxed);
+		draining.store(false, std::memory_order_release);
+		return;
+	}
+
+	if (type != Rml::Log::LT_ALWAYS && !TryAcquireRate())
+	{
+		num_rate_limited.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+
+	// Claim a slot in the ring, the slot's sequence number tells whether it has been consumed since its last use.
+	Slot* slot = nullptr;
+	size_t position = enqueue_position.load(std::memory_order_relaxed);
+	for (;;)
+	{
+		slot = &slots[position & (Capacity - 1)];
+		const size_t sequence = slot->sequence.load(std::memory_order_acquire);
+		const intptr_t difference = (intptr_t)sequence - (intptr_t)position;
+
+		if (difference == 0)
+		{
+			if (enqueue_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+				break;
+		}
+		else if (difference < 0)
+		{
+			num_dropped_full.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+		else
+		{
+			position = enqueue_position.load(std::memory_order_relaxed);
+		}
+	}
+
+	const size_t length = Rml::Math::Min(message.size(), MaxMessageLength);
+	if (length < message.size())
+		num_truncated.fetch_add(1, std::memory_order_relaxed);
+
+	slot->type = type;
+	slot->length = (uint32_t)length;
+	memcpy(slot->text, message.data(), length);
+	slot->sequence.store(position + 1, std::memory_order_release);
+}
+
+bool AsyncLogSink::Flush(double timeout)
+{
+	const size_t target = enqueue_position.load(std::memory_order_acquire);
+	const auto deadline = std::chrono::steady_clock::now() + std::chrono::duration<double>(timeout);
+
+	while (num_dequeued.load(std::memory_order_acquire) < target)
+	{
+		// Help the writer thread along, this also makes flushing work after the writer has been stopped.
+		if (!Drain())
+			std::this_thread::yield();
+		if (std::chrono::steady_clock::now() >= deadline)
+			return false;
+	}
+	return true;
+}
+
+void AsyncLogSink::WriterThread()
+{
+	while (!stop)
+	{
+		Drain();
+		std::this_thread::sleep_for(std::chrono::milliseconds(5));
+	}
+
+	Drain();
+	if (!draining.exchange(true, std::memory_order_acquire))
+	{
+		WriteRepeatSummary();
+		fflush(output);
+		draining.store(false, std::memory_order_release);
+	}
+}
+
+bool AsyncLogSink::Drain()
+{
+	if (draining.exchange(true, std::memory_order_acquire))
+		return false;
+
+	if (DrainLocked())
+		fflush(output);
+
+	draining.store(false, std::memory_order_release);
+	return true;
+}
+
+bool AsyncLogSink::DrainLocked()
+{
+	bool wrote_any = false;
+	for (;;)
+	{
+		Slot& slot = slots[dequeue_position & (Capacity - 1)];
+		if (slot.sequence.load(std::memory_order_acquire) != dequeue_position + 1)
+			break;
+
+		// Identical consecutive messages are only counted, and summarized when a different message follows.
+		if (slot.type == last_type && slot.length == last_text.size() && memcmp(slot.text, last_text.data(), slot.length) == 0)
+		{
+			last_repeats += 1;
+			num_repeated.fetch_add(1, std::memory_order_relaxed);
+		}
+		else
+		{
+			WriteRepeatSummary();
+			WriteLine(slot.type, slot.text, slot.length);
+			last_type = slot.type;
+			last_text.assign(slot.text, slot.length);
+			num_written.fetch_add(1, std::memory_order_relaxed);
+			wrote_any = true;
+		}
+
+		slot.sequence.store(dequeue_position + Capacity, std::memory_order_release);
+		dequeue_position += 1;
+		num_dequeued.store(dequeue_position, std::memory_order_release);
+	}
+
+	return wrote_any;
+}
+
+void AsyncLogSink::WriteLine(Rml::Log::Type type, const char* text, size_t length)
+{
+	const char* prefix = GetTypePrefix(type);
+	fwrite(prefix, 1, strlen(prefix), output);
+	fwrite(text, 1, length, output);
+	fputc('\n', output);
+}
+
+void AsyncLogSink::WriteRepeatSummary()
+{
+	if (last_repeats == 0)
+		return;
+
+	fprintf(output, "%s(previous message repeated %zu more times)\n", GetTypePrefix(last_type), last_repeats);
+	last_repeats = 0;
+}
+
+AsyncLogSink::Statistics AsyncLogSink::GetStatistics() const
+{
+	Statistics statistics = {};
+	statistics.num_written = num_written.load(std::memory_order_relaxed);
+	statistics.num_filtered = num_filtered.load(std::memory_order_relaxed);
+	statistics.num_rate_limited = num_rate_limited.load(std::memory_order_relaxed);
+	statistics.num_dropped_full = num_dropped_full.load(std::memory_order_relaxed);
+	statistics.num_repeated = num_repeated.load(std::memory_order_relaxed);
+	statistics.num_truncated = num_truncated.load(std::memory_order_relaxed);
+	return statistics;
+}
+
+void AsyncLogSink::InstallCrashHandlers()
+{
+	crash_sink = this;
+#ifdef _WIN32
+	crash_descriptor = _fileno(output);
+#else
+	crash_descriptor = fileno(output);
+#endif
+	previous_terminate_handler = std::set_terminate(&AsyncLogSink::TerminateHandler);
+
+	for (int signal : {SIGABRT, SIGSEGV, SIGFPE, SIGILL})
+		std::signal(signal, &AsyncLogSink::CrashHandler);
+}
+
+void AsyncLogSink::CrashHandler(int signal)
+{
+	// Best effort, the writer thread may hold the queue, in which case it is left to finish on its own. Anything still sitting in the
+	// stdio buffer of the output is lost, though the buffer is flushed after every batch.
+	if (AsyncLogSink* sink = crash_sink)
+	{
+		crash_sink = nullptr;
+		if (!sink->draining.exchange(true, std::memory_order_acquire))
+		{
+			sink->DrainRaw(crash_descriptor);
+			sink->draining.store(false, std::memory_order_release);
+		}
+	}
+
+	std::signal(signal, SIG_DFL);
+	std::raise(signal);
+}
+
+void AsyncLogSink::DrainRaw(int descriptor)
+{
+	// Repeats are not collapsed here, as comparing them needs the heap-allocated last message.
+	if (last_repeats > 0)
+	{
+		char digits[24];
+		size_t num_digits = 0;
+		for (size_t value = last_repeats; value > 0 && num_digits < sizeof(digits); value /= 10)
+			digits[sizeof(digits) - 1 - num_digits++] = char('0' + value % 10);
+
+		const char* prefix = GetTypePrefix(last_type);
+		const char repeated[] = "(previous message repeated ";
+		const char times[] = " more times)\n";
+		WriteRaw(descriptor, prefix, strlen(prefix));
+		WriteRaw(descriptor, repeated, sizeof(repeated) - 1);
+		WriteRaw(descriptor, digits + sizeof(digits) - num_digits, num_digits);
+		WriteRaw(descriptor, times, sizeof(times) - 1);
+		last_repeats = 0;
+	}
+
+	for (;;)
+	{
+		Slot& slot = slots[dequeue_position & (Capacity - 1)];
+		if (slot.sequence.load(std::memory_order_acquire) != dequeue_position + 1)
+			break;
+
+		const char* prefix = GetTypePrefix(slot.type);
+		WriteRaw(descriptor, prefix, strlen(prefix));
+		WriteRaw(descriptor, slot.text, slot.length);
+		WriteRaw(descriptor, "\n", 1);
+
+		slot.sequence.store(dequeue_position + Capacity, std::memory_order_release);
+		dequeue_position += 1;
+		num_dequeued.store(dequeue_position, std::memory_order_release);
+	}
+}
+
+void AsyncLogSink::TerminateHandler()
+{
+	if (AsyncLogSink* sink = crash_sink)
+	{
+		crash_sink = nullptr;
+		sink->Flush(0.5);
+	}
+
+	if (previous_terminate_handler)
+		previous_terminate_handler();
+	std::abort();
+}
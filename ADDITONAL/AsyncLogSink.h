@@ -0,0 +1,136 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef RMLUI_BACKENDS_ASYNCLOGSINK_H
+#define RMLUI_BACKENDS_ASYNCLOGSINK_H
+
+#include <RmlUi/Core/Log.h>
+#include <RmlUi/Core/Types.h>
+#include <atomic>
+#include <stdint.h>
+#include <stdio.h>
+#include <thread>
+
+/**
+    Writes log messages from a background thread, so that logging never blocks the thread producing the messages.
+
+    Messages are copied into a fixed-size lock-free ring buffer which any number of threads may write to, and which is drained by a
+    single writer thread. When the ring is full, or messages arrive faster than the rate limit allows, new messages are dropped and
+    counted instead of waiting for the writer. The writer collapses repeated messages into a single line with a repeat count.
+
+    Assertions are written synchronously after flushing the queue, since execution may stop right after them.
+ */
+class AsyncLogSink {
+public:
+	struct Statistics {
+		size_t num_written;      // Messages written to the output.
+		size_t num_filtered;     // Messages below the severity threshold.
+		size_t num_rate_limited; // Messages dropped because of the rate limit.
+		size_t num_dropped_full; // Messages dropped because the ring buffer was full.
+		size_t num_repeated;     // Messages collapsed into the preceding identical message.
+		size_t num_truncated;    // Messages cut to fit a ring buffer slot.
+	};
+
+	explicit AsyncLogSink(FILE* output = stderr);
+	~AsyncLogSink();
+
+	// Messages of a lower severity than the given type, i.e. of a higher type value, are discarded. Defaults to Log::LT_INFO.
+	void SetMaxLogType(Rml::Log::Type max_type);
+	// Allows a burst of messages, then limits the sustained rate in messages per second. Always and assert messages are never limited.
+	void SetRateLimit(double messages_per_second, int burst);
+
+	// Queues the message for writing, never blocks except for assertions. Safe to call from any thread.
+	void Write(Rml::Log::Type type, const Rml::String& message);
+
+	// Waits until all messages queued so far have been written, or the timeout in seconds has elapsed.
+	bool Flush(double timeout = 1.0);
+
+	// Writes out the queued messages when the program crashes from a fatal signal or std::terminate. Only one sink can be installed.
+	// Best effort: on a fatal signal, nothing is written if the writer thread is in the middle of draining the queue.
+	void InstallCrashHandlers();
+
+	Statistics GetStatistics() const;
+
+private:
+	static constexpr size_t Capacity = 1024; // Must be a power of two.
+	static constexpr size_t MaxMessageLength = 480;
+
+	struct Slot {
+		std::atomic<size_t> sequence;
+		Rml::Log::Type type;
+		uint32_t length;
+		char text[MaxMessageLength];
+	};
+
+	bool TryAcquireRate();
+
+	void WriterThread();
+	// Writes all queued messages, returns false if another thread is already draining the queue.
+	bool Drain();
+	// Same as above while already holding the queue, returns true if anything was written.
+	bool DrainLocked();
+	void WriteLine(Rml::Log::Type type, const char* text, size_t length);
+	void WriteRepeatSummary();
+	// Writes the queued messages straight to the file descriptor while holding the queue, only using async-signal-safe calls.
+	void DrainRaw(int descriptor);
+
+	static void CrashHandler(int signal);
+	static void TerminateHandler();
+
+	FILE* output;
+
+	Rml::UniquePtr<Slot[]> slots;
+	std::atomic<size_t> enqueue_position{0};
+	size_t dequeue_position = 0;
+	std::atomic<size_t> num_dequeued{0};
+	std::atomic<bool> draining{false};
+
+	std::atomic<int> max_log_type{Rml::Log::LT_INFO};
+
+	// Generic cell rate algorithm: a message is accepted unless it arrives before the theoretical arrival time minus the burst tolerance.
+	std::atomic<int64_t> theoretical_arrival_ns{0};
+	std::atomic<int64_t> emission_interval_ns{5'000'000};
+	std::atomic<int64_t> burst_tolerance_ns{500'000'000};
+
+	// Repeat detection state, only accessed while draining.
+	Rml::String last_text;
+	Rml::Log::Type last_type = Rml::Log::LT_MAX;
+	size_t last_repeats = 0;
+
+	std::atomic<size_t> num_written{0};
+	std::atomic<size_t> num_filtered{0};
+	std::atomic<size_t> num_rate_limited{0};
+	std::atomic<size_t> num_dropped_full{0};
+	std::atomic<size_t> num_repeated{0};
+	std::atomic<size_t> num_truncated{0};
+
+	std::atomic<bool> stop{false};
+	std::thread thread;
+};
+
+#endif
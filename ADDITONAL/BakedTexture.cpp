@@ -0,0 +1,325 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include "BakedTexture.h"
+#include <RmlUi/Core/Log.h>
+#include <RmlUi/Core/Math.h>
+#include <RmlUi/Core/StringUtilities.h>
+#include <stdio.h>
+#include <string.h>
+
+#if defined RMLUI_PLATFORM_WIN32
+	#include "RmlUi_Include_Windows.h"
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+#define STB_IMAGE_IMPLEMENTATION
+#define STBI_ONLY_TGA
+#define STBI_ONLY_PNG
+#define STBI_ONLY_JPEG
+#include "../stb_image.h"
+
+static constexpr char FileMagic[4] = {'R', 'M', 'L', 'T'};
+
+static bool ReportError(Rml::String* out_message, const Rml::String& message)
+{
+	if (out_message)
+		*out_message = message;
+	return false;
+}
+
+static uint64_t AlignOffset(uint64_t offset)
+{
+	return (offset + BakedTexture::DataAlignment - 1) & ~uint64_t(BakedTexture::DataAlignment - 1);
+}
+
+bool BakedTexture::IsBakedTextureSource(const Rml::String& source)
+{
+	const size_t dot_position = source.rfind('.');
+	if (dot_position == Rml::String::npos)
+		return false;
+	return Rml::StringUtilities::ToLower(source.substr(dot_position + 1)) == FileExtension;
+}
+
+bool BakedTexture::Parse(Rml::Span<const Rml::byte> file_data, Image& out_image, Rml::String* out_message)
+{
+	FileHeader header;
+	if (file_data.size() < sizeof(FileHeader))
+		return ReportError(out_message, "File is smaller than the baked texture header.");
+
+	memcpy(&header, file_data.data(), sizeof(FileHeader));
+
+	if (memcmp(header.magic, FileMagic, sizeof(FileMagic)) != 0)
+		return ReportError(out_message, "File is not a baked texture.");
+	if (header.version != FileVersion)
+		return ReportError(out_message, Rml::CreateString("Unsupported baked texture version %u, expected %u.", header.version, FileVersion));
+	if (header.width == 0 || header.height == 0 || header.width > MaxDimension || header.height > MaxDimension)
+		return ReportError(out_message, Rml::CreateString("Invalid texture dimensions %ux%u.", header.width, header.height));
+	if (header.num_levels < 1 || header.num_levels > MaxNumLevels)
+		return ReportError(out_message, Rml::CreateString("Invalid number of mip levels (%u).", header.num_levels));
+
+	const uint32_t required_flags = FlagPremultipliedAlpha | FlagUploadRowOrder;
+	if ((header.flags & required_flags) != required_flags)
+		return ReportError(out_message, "Baked texture is not premultiplied or not in upload row order.");
+
+	const size_t level_table_end = sizeof(FileHeader) + header.num_levels * sizeof(LevelHeader);
+	if (file_data.size() < level_table_end)
+		return ReportError(out_message, "File is truncated within the level table.");
+
+	out_image = {};
+	out_image.width = (int)header.width;
+	out_image.height = (int)header.height;
+	out_image.num_levels = (int)header.num_levels;
+
+	for (uint32_t i = 0; i < header.num_levels; i++)
+	{
+		LevelHeader level;
+		memcpy(&level, file_data.data() + sizeof(FileHeader) + i * sizeof(LevelHeader), sizeof(LevelHeader));
+
+		const uint32_t expected_width = Rml::Math::Max(header.width >> i, 1u);
+		const uint32_t expected_height = Rml::Math::Max(header.height >> i, 1u);
+		if (level.width != expected_width || level.height != expected_height)
+			return ReportError(out_message, Rml::CreateString("Mip level %u has unexpected dimensions.", i));
+		if (level.size != uint64_t(level.width) * uint64_t(level.height) * 4u)
+			return ReportError(out_message, Rml::CreateString("Mip level %u has unexpected size.", i));
+		if (level.offset % DataAlignment != 0 || level.offset < level_table_end || level.offset > file_data.size() ||
+			level.size > file_data.size() - level.offset)
+			return ReportError(out_message, Rml::CreateString("Mip level %u is out of bounds.", i));
+
+		out_image.levels[i].width = (int)level.width;
+		out_image.levels[i].height = (int)level.height;
+		out_image.levels[i].data = file_data.data() + level.offset;
+	}
+
+	return true;
+}
+
+// Halves the source image using a box filter. Odd dimensions clamp to the last row or column.
+static void DownsampleLevel(const Rml::byte* src, int src_width, int src_height, Rml::byte* dst, int dst_width, int dst_height)
+{
+	for (int y = 0; y < dst_height; y++)
+	{
+		const int y0 = Rml::Math::Min(2 * y, src_height - 1);
+		const int y1 = Rml::Math::Min(2 * y + 1, src_height - 1);
+		for (int x = 0; x < dst_width; x++)
+		{
+			const int x0 = Rml::Math::Min(2 * x, src_width - 1);
+			const int x1 = Rml::Math::Min(2 * x + 1, src_width - 1);
+			for (int c = 0; c < 4; c++)
+			{
+				const int sum = src[(y0 * src_width + x0) * 4 + c] + src[(y0 * src_width + x1) * 4 + c] + src[(y1 * src_width + x0) * 4 + c] +
+					src[(y1 * src_width + x1) * 4 + c];
+				dst[(y * dst_width + x) * 4 + c] = Rml::byte((sum + 2) / 4);
+			}
+		}
+	}
+}
+
+bool BakedTexture::Bake(const Rml::String& source_path, const Rml::String& destination_path, bool generate_mipmaps, Rml::String* out_message)
+{
+	int width = 0, height = 0, num_components = 0;
+	stbi_uc* pixels = stbi_load(source_path.c_str(), &width, &height, &num_components, 4);
+	if (!pixels)
+		return ReportError(out_message, Rml::CreateString("Could not decode '%s': %s.", source_path.c_str(), stbi_failure_reason()));
+	if (uint32_t(width) > MaxDimension || uint32_t(height) > MaxDimension)
+	{
+		stbi_image_free(pixels);
+		return ReportError(out_message, Rml::CreateString("'%s' is %dx%d, larger than the maximum of %u.", source_path.c_str(), width, height,
+			MaxDimension));
+	}
+
+	// Convert to premultiplied alpha. The decoder returns the top row first, which is the row order RmlUi uploads textures in.
+	const size_t num_pixels = size_t(width) * size_t(height);
+	for (size_t i = 0; i < num_pixels; i++)
+	{
+		Rml::byte* pixel = pixels + i * 4;
+		const Rml::byte alpha = pixel[3];
+		for (int j = 0; j < 3; j++)
+			pixel[j] = Rml::byte((pixel[j] * alpha) / 255);
+	}
+
+	// Build the level table and the remaining mip levels.
+	uint32_t num_levels = 1;
+	if (generate_mipmaps)
+	{
+		while (num_levels < MaxNumLevels && ((width >> num_levels) > 0 || (height >> num_levels) > 0))
+			num_levels += 1;
+	}
+
+	Rml::Vector<Rml::Vector<Rml::byte>> mip_levels(num_levels - 1);
+	LevelHeader level_headers[MaxNumLevels] = {};
+	uint64_t offset = AlignOffset(sizeof(FileHeader) + num_levels * sizeof(LevelHeader));
+
+	for (uint32_t i = 0; i < num_levels; i++)
+	{
+		LevelHeader& level = level_headers[i];
+		level.width = Rml::Math::Max(uint32_t(width) >> i, 1u);
+		level.height = Rml::Math::Max(uint32_t(height) >> i, 1u);
+		level.size = uint64_t(level.width) * uint64_t(level.height) * 4u;
+		level.offset = offset;
+		offset = AlignOffset(offset + level.size);
+
+		if (i > 0)
+		{
+			const LevelHeader& parent = level_headers[i - 1];
+			const Rml::byte* parent_data = (i == 1 ? pixels : mip_levels[i - 2].data());
+			mip_levels[i - 1].resize((size_t)level.size);
+			DownsampleLevel(parent_data, (int)parent.width, (int)parent.height, mip_levels[i - 1].data(), (int)level.width, (int)level.height);
+		}
+	}
+
+	FileHeader header = {};
+	memcpy(header.magic, FileMagic, sizeof(FileMagic));
+	header.version = FileVersion;
+	header.width = (uint32_t)width;
+	header.height = (uint32_t)height;
+	header.num_levels = num_levels;
+	header.flags = FlagPremultipliedAlpha | FlagUploadRowOrder;
+
+	FILE* file = fopen(destination_path.c_str(), "wb");
+	if (!file)
+	{
+		stbi_image_free(pixels);
+		return ReportError(out_message, Rml::CreateString("Could not open '%s' for writing.", destination_path.c_str()));
+	}
+
+	bool success = (fwrite(&header, sizeof(header), 1, file) == 1);
+	success &= (fwrite(level_headers, sizeof(LevelHeader), num_levels, file) == num_levels);
+
+	for (uint32_t i = 0; i < num_levels && success; i++)
+	{
+		const LevelHeader& level = level_headers[i];
+		success &= (fseek(file, (long)level.offset, SEEK_SET) == 0);
+		const Rml::byte* level_data = (i == 0 ? pixels : mip_levels[i - 1].data());
+		success &= (fwrite(level_data, 1, (size_t)level.size, file) == level.size);
+	}
+
+	fclose(file);
+	stbi_image_free(pixels);
+
+	if (!success)
+		return ReportError(out_message, Rml::CreateString("Could not write baked texture to '%s'.", destination_path.c_str()));
+
+	if (out_message)
+		*out_message = Rml::CreateString("Baked '%s' (%dx%d, %u levels) to '%s'.", source_path.c_str(), width, height, num_levels,
+			destination_path.c_str());
+	return true;
+}
+
+BakedTexture::MappedFile::~MappedFile()
+{
+	Close();
+}
+
+bool BakedTexture::MappedFile::Open(const Rml::String& path)
+{
+	Close();
+
+#if defined RMLUI_PLATFORM_WIN32
+	HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+		return false;
+
+	LARGE_INTEGER file_size = {};
+	if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0)
+	{
+		CloseHandle(file);
+		return false;
+	}
+
+	HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (!mapping)
+	{
+		CloseHandle(file);
+		return false;
+	}
+
+	void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if (!view)
+	{
+		CloseHandle(mapping);
+		CloseHandle(file);
+		return false;
+	}
+
+	file_handle = file;
+	mapping_handle = mapping;
+	data = static_cast<const Rml::byte*>(view);
+	size = (size_t)file_size.QuadPart;
+#else
+	const int fd = open(path.c_str(), O_RDONLY);
+	if (fd < 0)
+		return false;
+
+	struct stat sb;
+	if (fstat(fd, &sb) != 0 || sb.st_size <= 0)
+	{
+		close(fd);
+		return false;
+	}
+
+	void* view = mmap(nullptr, (size_t)sb.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	if (view == MAP_FAILED)
+	{
+		close(fd);
+		return false;
+	}
+
+	file_descriptor = fd;
+	data = static_cast<const Rml::byte*>(view);
+	size = (size_t)sb.st_size;
+#endif
+
+	return true;
+}
+
+void BakedTexture::MappedFile::Close()
+{
+#if defined RMLUI_PLATFORM_WIN32
+	if (data)
+		UnmapViewOfFile(data);
+	if (mapping_handle)
+		CloseHandle(mapping_handle);
+	if (file_handle)
+		CloseHandle(file_handle);
+	file_handle = nullptr;
+	mapping_handle = nullptr;
+#else
+	if (data)
+		munmap(const_cast<Rml::byte*>(data), size);
+	if (file_descriptor >= 0)
+		close(file_descriptor);
+	file_descriptor = -1;
+#endif
+	data = nullptr;
+	size = 0;
+}
@@ -0,0 +1,127 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef RMLUI_BACKENDS_BAKEDTEXTURE_H
+#define RMLUI_BACKENDS_BAKEDTEXTURE_H
+
+#include <RmlUi/Core/Platform.h>
+#include <RmlUi/Core/Types.h>
+#include <stdint.h>
+
+/**
+    Pre-baked texture container format.
+
+    Baked textures store premultiplied RGBA8 pixels, optionally with a full mip chain, with the rows already in the order expected by
+    glTexImage2D. The files can be memory-mapped and each level uploaded directly from the mapping, without any decoding or conversion.
+
+    Layout: FileHeader, followed by FileHeader::num_levels LevelHeader entries, followed by the pixel data of each level. Level data is
+    aligned to DataAlignment bytes from the start of the file.
+ */
+namespace BakedTexture {
+
+static constexpr char FileExtension[] = "rmlt";
+static constexpr uint32_t FileVersion = 1;
+static constexpr uint32_t MaxNumLevels = 16;
+// Largest width or height accepted, matching the texture size limit the renderers can rely on.
+static constexpr uint32_t MaxDimension = 16384;
+static constexpr uint32_t DataAlignment = 16;
+
+enum FileFlags : uint32_t {
+	FlagPremultipliedAlpha = 1 << 0,
+	FlagUploadRowOrder = 1 << 1,
+};
+
+struct FileHeader {
+	char magic[4]; // "RMLT"
+	uint32_t version;
+	uint32_t width;
+	uint32_t height;
+	uint32_t num_levels;
+	uint32_t flags;
+};
+static_assert(sizeof(FileHeader) == 24, "Unexpected padding in the baked texture file header.");
+
+struct LevelHeader {
+	uint32_t width;
+	uint32_t height;
+	uint64_t offset;
+	uint64_t size;
+};
+static_assert(sizeof(LevelHeader) == 24, "Unexpected padding in the baked texture level header.");
+
+struct Level {
+	int width = 0;
+	int height = 0;
+	const Rml::byte* data = nullptr;
+};
+
+struct Image {
+	int width = 0;
+	int height = 0;
+	int num_levels = 0;
+	Level levels[MaxNumLevels];
+};
+
+// Returns true if the given texture source refers to a baked texture file.
+bool IsBakedTextureSource(const Rml::String& source);
+
+// Validates the file contents and fills the image with pointers into the provided data, which must outlive the image.
+bool Parse(Rml::Span<const Rml::byte> file_data, Image& out_image, Rml::String* out_message = nullptr);
+
+// Converts a TGA, PNG or JPEG image to the baked texture format. Optionally generates the full mip chain.
+bool Bake(const Rml::String& source_path, const Rml::String& destination_path, bool generate_mipmaps, Rml::String* out_message = nullptr);
+
+/**
+    Read-only memory mapping of a file.
+ */
+class MappedFile {
+public:
+	MappedFile() = default;
+	~MappedFile();
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	bool Open(const Rml::String& path);
+	void Close();
+
+	Rml::Span<const Rml::byte> GetData() const { return {data, size}; }
+
+private:
+#ifdef RMLUI_PLATFORM_WIN32
+	void* file_handle = nullptr;
+	void* mapping_handle = nullptr;
+#else
+	int file_descriptor = -1;
+#endif
+	const Rml::byte* data = nullptr;
+	size_t size = 0;
+};
+
+} // namespace BakedTexture
+
+#endif
@@ -0,0 +1,364 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include "FrameTiming.h"
+#include <RmlUi/Core/Context.h>
+#include <RmlUi/Core/DataModelHandle.h>
+#include <RmlUi/Core/ElementDocument.h>
+#include <RmlUi/Core/Log.h>
+#include <RmlUi/Core/Math.h>
+#include <algorithm>
+#include <chrono>
+#include <stdio.h>
+#include <thread>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr int NumPhases = (int)FrameTiming::Phase::Count;
+constexpr int WindowSize = 600;
+
+// Refresh interval of the overlay, frequent enough to follow changes without making the overlay itself a significant cost.
+constexpr double OverlayRefreshInterval = 0.25;
+
+struct FrameRecord {
+	float interval_ms;
+	float phase_ms[NumPhases];
+};
+
+struct OverlayRow {
+	Rml::String name;
+	float p50 = 0.f;
+	float p95 = 0.f;
+	float p99 = 0.f;
+	float max = 0.f;
+};
+
+struct TimingData {
+	// Rolling window of presented frames, 'next_record' is the slot that is written next.
+	Rml::Vector<FrameRecord> records;
+	int next_record = 0;
+
+	FrameRecord current = {};
+	bool current_presented = false;
+	Clock::time_point phase_begin[NumPhases];
+	Clock::time_point last_present_time;
+	bool has_last_present = false;
+
+	Clock::duration frame_period = Clock::duration::zero();
+	Clock::time_point next_frame_time;
+
+	Rml::Context* overlay_context = nullptr;
+	Rml::ElementDocument* overlay_document = nullptr;
+	Rml::DataModelHandle overlay_model;
+	Rml::Vector<OverlayRow> overlay_rows;
+	float overlay_fps = 0.f;
+	Clock::time_point overlay_refresh_time;
+};
+
+TimingData data;
+
+double ToMilliseconds(Clock::duration duration)
+{
+	return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+template <typename Func>
+FrameTiming::Percentiles ComputePercentiles(Func&& get_sample)
+{
+	Rml::Vector<float> samples;
+	samples.reserve(data.records.size());
+	for (const FrameRecord& record : data.records)
+		samples.push_back(get_sample(record));
+
+	FrameTiming::Percentiles result = {};
+	if (samples.empty())
+		return result;
+
+	std::sort(samples.begin(), samples.end());
+	auto at = [&](int percent) { return double(samples[Rml::Math::Min(samples.size() - 1, samples.size() * percent / 100)]); };
+	result.p50_ms = at(50);
+	result.p95_ms = at(95);
+	result.p99_ms = at(99);
+	result.max_ms = double(samples.back());
+	return result;
+}
+
+const char* overlay_rml = R"(
+<rml>
+<head>
+	<title>Frame timing</title>
+	<style>
+		body { position: absolute; top: 8dp; right: 8dp; width: 360dp; padding: 6dp 8dp; background-color: #000c;
+		       font-family: LatoLatin; font-size: 13dp; color: #eee; pointer-events: none; }
+		div.row { display: flex; }
+		div.row span { flex: 1; text-align: right; }
+		div.row span.name { flex: 2; text-align: left; }
+		div.header { color: #9cf; }
+	</style>
+</head>
+<body data-model="frame_timing">
+	<div>{{ fps | format(1) }} frames per second</div>
+	<div class="row header"><span class="name">ms</span><span>p50</span><span>p95</span><span>p99</span><span>max</span></div>
+	<div class="row" data-for="row : rows">
+		<span class="name">{{ row.name }}</span><span>{{ row.p50 | format(2) }}</span><span>{{ row.p95 | format(2) }}</span>
+		<span>{{ row.p99 | format(2) }}</span><span>{{ row.max | format(2) }}</span>
+	</div>
+</body>
+</rml>
+)";
+
+} // namespace
+
+const char* FrameTiming::GetPhaseName(Phase phase)
+{
+	switch (phase)
+	{
+	case Phase::IdleTasks: return "idle_tasks";
+	case Phase::ProcessEvents: return "events";
+	case Phase::Update: return "update";
+	case Phase::Render: return "render";
+	case Phase::EndFrame: return "end_frame";
+	case Phase::SwapBuffers: return "swap";
+	case Phase::Count: break;
+	}
+	return "";
+}
+
+void FrameTiming::NewFrame()
+{
+	if (data.current_presented)
+	{
+		if ((int)data.records.size() < WindowSize)
+			data.records.push_back(data.current);
+		else
+			data.records[data.next_record] = data.current;
+		data.next_record = (data.next_record + 1) % WindowSize;
+	}
+
+	data.current = {};
+	data.current_presented = false;
+}
+
+void FrameTiming::BeginPhase(Phase phase)
+{
+	data.phase_begin[(int)phase] = Clock::now();
+}
+
+void FrameTiming::EndPhase(Phase phase)
+{
+	const Clock::time_point now = Clock::now();
+	data.current.phase_ms[(int)phase] += (float)ToMilliseconds(now - data.phase_begin[(int)phase]);
+
+	// The frame counts as presented once its buffers are swapped, its interval is measured from the previous presented frame.
+	if (phase == Phase::SwapBuffers)
+	{
+		data.current.interval_ms = (data.has_last_present ? (float)ToMilliseconds(now - data.last_present_time) : 0.f);
+		data.current_presented = true;
+		data.last_present_time = now;
+		data.has_last_present = true;
+	}
+}
+
+void FrameTiming::SetFrameLimit(double frames_per_second)
+{
+	if (frames_per_second > 0.0)
+		data.frame_period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / frames_per_second));
+	else
+		data.frame_period = Clock::duration::zero();
+
+	data.next_frame_time = Clock::now();
+}
+
+void FrameTiming::WaitForNextFrame()
+{
+	if (data.frame_period == Clock::duration::zero())
+		return;
+
+	// Sleep for most of the remaining time, and yield for the last part since sleeping tends to overshoot by up to a millisecond.
+	constexpr auto spin_duration = std::chrono::milliseconds(1);
+	if (Clock::now() + spin_duration < data.next_frame_time)
+		std::this_thread::sleep_until(data.next_frame_time - spin_duration);
+	while (Clock::now() < data.next_frame_time)
+		std::this_thread::yield();
+
+	// When we fall behind, start counting from now rather than trying to catch up with a burst of frames.
+	const Clock::time_point now = Clock::now();
+	data.next_frame_time = std::max(data.next_frame_time + data.frame_period, now);
+}
+
+FrameTiming::Percentiles FrameTiming::GetPhasePercentiles(Phase phase)
+{
+	return ComputePercentiles([phase](const FrameRecord& record) { return record.phase_ms[(int)phase]; });
+}
+
+FrameTiming::Percentiles FrameTiming::GetIntervalPercentiles()
+{
+	return ComputePercentiles([](const FrameRecord& record) { return record.interval_ms; });
+}
+
+int FrameTiming::GetNumRecordedFrames()
+{
+	return (int)data.records.size();
+}
+
+bool FrameTiming::ExportCSV(const Rml::String& path)
+{
+	FILE* file = fopen(path.c_str(), "w");
+	if (!file)
+	{
+		Rml::Log::Message(Rml::Log::LT_ERROR, "Could not open '%s' for writing frame timings.", path.c_str());
+		return false;
+	}
+
+	fprintf(file, "frame,interval_ms");
+	for (int i = 0; i < NumPhases; i++)
+		fprintf(file, ",%s_ms", GetPhaseName(Phase(i)));
+	fprintf(file, "\n");
+
+	// Write the frames oldest first, the window wraps around once it is full.
+	const int num_records = (int)data.records.size();
+	const int first = (num_records < WindowSize ? 0 : data.next_record);
+	for (int i = 0; i < num_records; i++)
+	{
+		const FrameRecord& record = data.records[(first + i) % num_records];
+		fprintf(file, "%d,%.4f", i, record.interval_ms);
+		for (int j = 0; j < NumPhases; j++)
+			fprintf(file, ",%.4f", record.phase_ms[j]);
+		fprintf(file, "\n");
+	}
+
+	fclose(file);
+	return true;
+}
+
+bool FrameTiming::ExportJSON(const Rml::String& path)
+{
+	FILE* file = fopen(path.c_str(), "w");
+	if (!file)
+	{
+		Rml::Log::Message(Rml::Log::LT_ERROR, "Could not open '%s' for writing frame timings.", path.c_str());
+		return false;
+	}
+
+	auto write_percentiles = [file](const char* name, const Percentiles& p, bool last) {
+		fprintf(file, "    \"%s\": {\"p50_ms\": %.4f, \"p95_ms\": %.4f, \"p99_ms\": %.4f, \"max_ms\": %.4f}%s\n", name, p.p50_ms, p.p95_ms, p.p99_ms,
+			p.max_ms, last ? "" : ",");
+	};
+
+	fprintf(file, "{\n  \"frames\": %d,\n  \"timings\": {\n", GetNumRecordedFrames());
+	write_percentiles("interval", GetIntervalPercentiles(), false);
+	for (int i = 0; i < NumPhases; i++)
+		write_percentiles(GetPhaseName(Phase(i)), GetPhasePercentiles(Phase(i)), i == NumPhases - 1);
+	fprintf(file, "  }\n}\n");
+
+	fclose(file);
+	return true;
+}
+
+bool FrameTiming::ShowOverlay(Rml::Context* context)
+{
+	if (data.overlay_document)
+		return true;
+
+	Rml::DataModelConstructor constructor = context->CreateDataModel("frame_timing");
+	if (!constructor)
+		return false;
+
+	if (auto row_handle = constructor.RegisterStruct<OverlayRow>())
+	{
+		row_handle.RegisterMember("name", &OverlayRow::name);
+		row_handle.RegisterMember("p50", &OverlayRow::p50);
+		row_handle.RegisterMember("p95", &OverlayRow::p95);
+		row_handle.RegisterMember("p99", &OverlayRow::p99);
+		row_handle.RegisterMember("max", &OverlayRow::max);
+	}
+	constructor.RegisterArray<Rml::Vector<OverlayRow>>();
+
+	data.overlay_rows.assign(NumPhases + 1, OverlayRow{});
+	data.overlay_rows[0].name = "interval";
+	for (int i = 0; i < NumPhases; i++)
+		data.overlay_rows[i + 1].name = GetPhaseName(Phase(i));
+
+	constructor.Bind("fps", &data.overlay_fps);
+	constructor.Bind("rows", &data.overlay_rows);
+	data.overlay_model = constructor.GetModelHandle();
+
+	data.overlay_document = context->LoadDocumentFromMemory(overlay_rml, "[frame timing overlay]");
+	if (!data.overlay_document)
+	{
+		context->RemoveDataModel("frame_timing");
+		return false;
+	}
+
+	data.overlay_context = context;
+	data.overlay_document->Show(Rml::ModalFlag::None, Rml::FocusFlag::None);
+	data.overlay_refresh_time = Clock::now();
+	return true;
+}
+
+bool FrameTiming::UpdateOverlay()
+{
+	if (!data.overlay_document)
+		return false;
+
+	const Clock::time_point now = Clock::now();
+	if (now < data.overlay_refresh_time)
+		return false;
+	data.overlay_refresh_time = now + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(OverlayRefreshInterval));
+
+	auto assign = [](OverlayRow& row, const Percentiles& p) {
+		row.p50 = (float)p.p50_ms;
+		row.p95 = (float)p.p95_ms;
+		row.p99 = (float)p.p99_ms;
+		row.max = (float)p.max_ms;
+	};
+
+	const Percentiles interval = GetIntervalPercentiles();
+	assign(data.overlay_rows[0], interval);
+	for (int i = 0; i < NumPhases; i++)
+		assign(data.overlay_rows[i + 1], GetPhasePercentiles(Phase(i)));
+	data.overlay_fps = (interval.p50_ms > 0.0 ? float(1000.0 / interval.p50_ms) : 0.f);
+
+	data.overlay_model.DirtyVariable("fps");
+	data.overlay_model.DirtyVariable("rows");
+	return true;
+}
+
+void FrameTiming::HideOverlay()
+{
+	if (!data.overlay_document)
+		return;
+
+	data.overlay_document->Close();
+	data.overlay_context->RemoveDataModel("frame_timing");
+	data.overlay_document = nullptr;
+	data.overlay_context = nullptr;
+	data.overlay_model = {};
+}
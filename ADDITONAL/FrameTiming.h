@@ -0,0 +1,101 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef RMLUI_BACKENDS_FRAMETIMING_H
+#define RMLUI_BACKENDS_FRAMETIMING_H
+
+#include <RmlUi/Core/Types.h>
+
+namespace Rml {
+class Context;
+}
+
+/**
+    Frame timing telemetry for the main loop.
+
+    Each frame is split into phases which are timestamped with a monotonic clock. The durations of the most recent frames are kept in
+    a rolling window, from which percentiles are computed on request. Only presented frames are recorded, loop iterations which skip
+    rendering are discarded so that idle time does not show up as frame time. The interval between presented frames is recorded
+    separately from the phases, and reveals jitter caused by waiting or by the swap interval.
+
+    Optionally, the frame rate can be limited. The limiter sleeps before events are processed, so that input is sampled as late as
+    possible before the context is updated.
+ */
+namespace FrameTiming {
+
+enum class Phase { IdleTasks, ProcessEvents, Update, Render, EndFrame, SwapBuffers, Count };
+
+const char* GetPhaseName(Phase phase);
+
+struct Percentiles {
+	double p50_ms;
+	double p95_ms;
+	double p99_ms;
+	double max_ms;
+};
+
+// Records the previous frame if it was presented, and starts timing a new one.
+void NewFrame();
+
+void BeginPhase(Phase phase);
+void EndPhase(Phase phase);
+
+class ScopedPhase {
+public:
+	explicit ScopedPhase(Phase in_phase) : phase(in_phase) { BeginPhase(phase); }
+	~ScopedPhase() { EndPhase(phase); }
+
+private:
+	Phase phase;
+};
+
+// Limits the frame rate to the given number of frames per second, zero disables the limiter, which is the default.
+void SetFrameLimit(double frames_per_second);
+// Sleeps until the next frame is due according to the frame limit. Call right before processing input events.
+void WaitForNextFrame();
+
+Percentiles GetPhasePercentiles(Phase phase);
+Percentiles GetIntervalPercentiles();
+// Number of frames currently held in the rolling window.
+int GetNumRecordedFrames();
+
+// Writes the recorded frames as one row per frame, with the frame interval and the duration of each phase in milliseconds.
+bool ExportCSV(const Rml::String& path);
+// Writes the percentiles of the frame interval and of each phase.
+bool ExportJSON(const Rml::String& path);
+
+// Shows an overlay document in the context, displaying the percentiles through the 'frame_timing' data model.
+bool ShowOverlay(Rml::Context* context);
+// Refreshes the overlay a few times per second, returns true if its data model changed and the context should be rendered.
+bool UpdateOverlay();
+// Closes the overlay and removes its data model, call before the context is destroyed.
+void HideOverlay();
+
+} // namespace FrameTiming
+
+#endif
@@ -0,0 +1,215 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include "IdleTaskScheduler.h"
+#include <RmlUi/Core/Context.h>
+#include <RmlUi/Core/Core.h>
+#include <RmlUi/Core/ElementDocument.h>
+#include <RmlUi/Core/FontEngineInterface.h>
+#include <RmlUi/Core/Log.h>
+#include <RmlUi/Core/Mesh.h>
+#include <RmlUi/Core/RenderManager.h>
+#include <RmlUi/Core/TextShapingContext.h>
+#include <chrono>
+#include <utility>
+
+// Number of bytes of characters to rasterise between budget checks.
+static constexpr size_t GLYPH_CHUNK_SIZE = 16;
+
+static double GetSecondsSince(std::chrono::steady_clock::time_point time)
+{
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - time).count();
+}
+
+void IdleTaskScheduler::Submit(const Rml::String& name, Task task, Budget budget, double expected_cost)
+{
+	tasks.push_back(Entry{name, std::move(task), budget, expected_cost});
+	statistics.num_submitted += 1;
+}
+
+bool IdleTaskScheduler::IsOversized(const Entry& entry, double remaining) const
+{
+	if (entry.budget == Budget::Honoured)
+		return !(remaining > 0.0);
+
+	const bool unknown_cost = (entry.max_slice_duration < 0.0);
+	return (unknown_cost || !(entry.max_slice_duration < remaining));
+}
+
+bool IdleTaskScheduler::HasOversizedTasks(double budget) const
+{
+	for (const Entry& entry : tasks)
+	{
+		if (entry.budget == Budget::Ignored && IsOversized(entry, budget))
+			return true;
+	}
+	return false;
+}
+
+Rml::StringList IdleTaskScheduler::GetPendingTaskNames() const
+{
+	Rml::StringList names;
+	for (const Entry& entry : tasks)
+		names.push_back(entry.name);
+	return names;
+}
+
+void IdleTaskScheduler::Run(double budget, bool allow_oversized)
+{
+	if (tasks.empty())
+		return;
+
+	const auto begin_time = std::chrono::steady_clock::now();
+	statistics.num_idle_periods += 1;
+	statistics.time_available += Rml::Math::Max(budget, 0.0);
+
+	bool slice_run = false;
+	size_t i = 0;
+	while (i < tasks.size())
+	{
+		const double remaining = budget - GetSecondsSince(begin_time);
+		const bool oversized = IsOversized(tasks[i], remaining);
+		if (oversized && !(allow_oversized && !slice_run))
+		{
+			i += 1;
+			continue;
+		}
+
+		// Tasks may submit new tasks, keep the task outside the queue while it runs.
+		Task task = std::move(tasks[i].task);
+		const auto slice_begin_time = std::chrono::steady_clock::now();
+		const bool finished = task(Rml::Math::Max(remaining, 0.0));
+		const double duration = GetSecondsSince(slice_begin_time);
+		slice_run = true;
+
+		statistics.num_slices += 1;
+		statistics.time_used += duration;
+		if (oversized)
+		{
+			statistics.num_oversized_slices += 1;
+		}
+		else if (duration > remaining)
+		{
+			statistics.num_overruns += 1;
+			statistics.max_overrun = Rml::Math::Max(statistics.max_overrun, duration - remaining);
+			Rml::Log::Message(Rml::Log::LT_DEBUG, "Idle task '%s' exceeded its budget by %.2f ms.", tasks[i].name.c_str(),
+				1000.0 * (duration - remaining));
+		}
+
+		if (finished)
+		{
+			tasks.erase(tasks.begin() + i);
+			statistics.num_completed += 1;
+		}
+		else
+		{
+			tasks[i].task = std::move(task);
+			tasks[i].max_slice_duration = Rml::Math::Max(tasks[i].max_slice_duration, duration);
+		}
+	}
+}
+
+IdleTaskScheduler::Task IdleTasks::PreloadDocument(Rml::Context* context, const Rml::String& source)
+{
+	return [context, source](double /*budget*/) {
+		if (Rml::ElementDocument* document = context->LoadDocument(source))
+			document->Close();
+		else
+			Rml::Log::Message(Rml::Log::LT_WARNING, "Could not preload document '%s'.", source.c_str());
+		return true;
+	};
+}
+
+IdleTaskScheduler::Task IdleTasks::RasteriseGlyphs(Rml::Context* context, const Rml::String& family, int size, const Rml::String& characters,
+	Rml::Style::FontWeight weight)
+{
+	size_t position = 0;
+	return [context, family, size, characters, weight, position](double budget) mutable {
+		Rml::FontEngineInterface* font_engine = Rml::GetFontEngineInterface();
+		const Rml::FontFaceHandle face = font_engine->GetFontFaceHandle(family, Rml::Style::FontStyle::Normal, weight, size);
+		if (!face)
+		{
+			Rml::Log::Message(Rml::Log::LT_WARNING, "Could not rasterise glyphs, no font face found for family '%s'.", family.c_str());
+			return true;
+		}
+
+		const Rml::FontEffectsHandle effects = font_engine->PrepareFontEffects(face, {});
+		const Rml::String language;
+		const Rml::TextShapingContext text_shaping_context{language};
+		Rml::TexturedMeshList mesh_list;
+
+		// Generating strings adds the missing glyphs to the layer textures of the face, a chunk at a time until the budget is used up.
+		if (position < characters.size())
+		{
+			const auto begin_time = std::chrono::steady_clock::now();
+			while (position < characters.size())
+			{
+				size_t end = Rml::Math::Min(position + GLYPH_CHUNK_SIZE, characters.size());
+				// Don't split multi-byte UTF-8 sequences.
+				while (end < characters.size() && (characters[end] & 0xC0) == 0x80)
+					end += 1;
+
+				mesh_list.clear();
+				font_engine->GenerateString(context->GetRenderManager(), face, effects,
+					Rml::StringView(characters.data() + position, characters.data() + end), Rml::Vector2f(0.f), Rml::ColourbPremultiplied(255),
+					1.f, text_shaping_context, mesh_list);
+				position = end;
+
+				if (GetSecondsSince(begin_time) >= budget)
+					break;
+			}
+
+			// The textures are uploaded in a slice of their own.
+			return false;
+		}
+
+		// A chunk only refers to the atlas pages of its own glyphs. With every glyph in place, generating all characters at once adds
+		// nothing new, and refers to every page holding them.
+		mesh_list.clear();
+		font_engine->GenerateString(context->GetRenderManager(), face, effects, characters, Rml::Vector2f(0.f), Rml::ColourbPremultiplied(255),
+			1.f, text_shaping_context, mesh_list);
+
+		// Querying the dimensions generates and uploads the textures.
+		for (const Rml::TexturedMesh& textured_mesh : mesh_list)
+		{
+			if (textured_mesh.texture)
+				textured_mesh.texture.GetDimensions();
+		}
+		return true;
+	};
+}
+
+IdleTaskScheduler::Task IdleTasks::UploadTexture(Rml::Context* context, const Rml::String& source)
+{
+	return [context, source](double /*budget*/) {
+		const Rml::Texture texture = context->GetRenderManager().LoadTexture(source);
+		if (!texture || texture.GetDimensions() == Rml::Vector2i(0))
+			Rml::Log::Message(Rml::Log::LT_WARNING, "Could not upload texture '%s'.", source.c_str());
+		return true;
+	};
+}
@@ -0,0 +1,119 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef RMLUI_BACKENDS_IDLETASKSCHEDULER_H
+#define RMLUI_BACKENDS_IDLETASKSCHEDULER_H
+
+#include <RmlUi/Core/StyleTypes.h>
+#include <RmlUi/Core/Types.h>
+
+namespace Rml {
+class Context;
+}
+
+/**
+    Runs queued work in the idle time of the main loop, within a time budget.
+
+    Tasks are run in submission order, in slices. Each slice is given the remaining budget and should return before it is used up,
+    splitting longer work over several slices. Tasks which honour their budget this way may start in any idle time. Other tasks are only
+    started when the longest of their previous slices fits the remaining budget, otherwise smaller tasks queued behind them are tried
+    first. Before such a task has run, the expected cost given on submission is used instead, and tasks of unknown cost wait for a slice
+    allowed to be oversized. Slices exceeding their budget are counted, so that the compliance with the budget can be verified.
+ */
+class IdleTaskScheduler {
+public:
+	// Performs a slice of work, given the remaining budget in seconds. Returns true when the task is finished.
+	using Task = Rml::Function<bool(double budget)>;
+
+	enum class Budget {
+		Honoured, // The task splits its work to return within the budget it is given.
+		Ignored,  // The task may take any time, e.g. when its work can't be split.
+	};
+
+	// The expected cost is the duration in seconds of the task's first slice, or negative if unknown. Only used for tasks ignoring the
+	// budget.
+	void Submit(const Rml::String& name, Task task, Budget budget = Budget::Ignored, double expected_cost = -1.0);
+
+	// Runs pending tasks until the budget in seconds is used up. With 'allow_oversized', the first slice is run even if it is not expected
+	// to fit, such that tasks longer than any frame budget are eventually run. Allow it in idle periods without a frame deadline, or
+	// occasionally at the start of a frame period when no such period comes.
+	void Run(double budget, bool allow_oversized);
+
+	bool HasPendingTasks() const { return !tasks.empty(); }
+	// Returns true if a pending task can only run in a slice allowed to be oversized.
+	bool HasOversizedTasks(double budget) const;
+	Rml::StringList GetPendingTaskNames() const;
+
+	struct Statistics {
+		size_t num_submitted;
+		size_t num_completed;
+		size_t num_slices;
+		size_t num_idle_periods;     // Calls to Run() with pending tasks.
+		size_t num_overruns;         // Slices which exceeded their budget, each may delay the following frame.
+		size_t num_oversized_slices; // Slices run with 'allow_oversized' despite not being expected to fit, not counted as overruns.
+		double time_available;       // Sum of the budgets, in seconds.
+		double time_used;
+		double max_overrun;
+	};
+
+	const Statistics& GetStatistics() const { return statistics; }
+
+private:
+	struct Entry {
+		Rml::String name;
+		Task task;
+		Budget budget;
+		double max_slice_duration; // Negative until the task has run, unless its cost was given on submission.
+	};
+
+	bool IsOversized(const Entry& entry, double remaining) const;
+
+	Rml::Vector<Entry> tasks;
+	Statistics statistics = {};
+};
+
+/**
+    Tasks for warming up resources before they are first needed.
+ */
+namespace IdleTasks {
+
+// Loads the document without showing it and closes it again, parsing and caching its style sheets and templates. Runs in a single slice
+// ignoring the budget.
+IdleTaskScheduler::Task PreloadDocument(Rml::Context* context, const Rml::String& source);
+
+// Rasterises the glyphs of the characters for the font face and uploads them to the glyph textures of the context's render manager. Honours
+// the budget.
+IdleTaskScheduler::Task RasteriseGlyphs(Rml::Context* context, const Rml::String& family, int size, const Rml::String& characters,
+	Rml::Style::FontWeight weight = Rml::Style::FontWeight::Normal);
+
+// Loads and uploads the texture, so that it is ready when first rendered by the context. Runs in a single slice ignoring the budget.
+IdleTaskScheduler::Task UploadTexture(Rml::Context* context, const Rml::String& source);
+
+} // namespace IdleTasks
+
+#endif
@@ -0,0 +1,277 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include "InputReplay.h"
+#include <RmlUi/Core/Context.h>
+#include <RmlUi/Core/Log.h>
+#include <stdio.h>
+#include <string.h>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+const char* const event_type_names[] = {"key", "char", "cursor_pos", "cursor_enter", "mouse_button", "scroll", "window_size",
+	"framebuffer_size", "content_scale", "frame"};
+static_assert(sizeof(event_type_names) / sizeof(event_type_names[0]) == (size_t)InputReplay::EventType::Count, "Missing event type name.");
+
+const char* const handler_names[] = {"ProcessMouseMove", "ProcessMouseButtonDown", "ProcessMouseButtonUp", "ProcessMouseWheel",
+	"ProcessMouseLeave", "ProcessKeyDown", "ProcessKeyUp", "ProcessTextInput", "SetDimensions", "SetDensityIndependentPixelRatio"};
+static_assert(sizeof(handler_names) / sizeof(handler_names[0]) == (size_t)InputReplay::Handler::Count, "Missing handler name.");
+
+const char* const file_header = "# RmlUi input recording 1";
+
+} // namespace
+
+const char* InputReplay::GetHandlerName(Handler handler)
+{
+	return handler_names[(int)handler];
+}
+
+bool InputReplay::Save(const Rml::String& path, const Rml::Vector<Event>& events)
+{
+	FILE* file = fopen(path.c_str(), "w");
+	if (!file)
+	{
+		Rml::Log::Message(Rml::Log::LT_ERROR, "Could not open '%s' for writing the input recording.", path.c_str());
+		return false;
+	}
+
+	fprintf(file, "%s\n# time type code action mods x y\n", file_header);
+	for (const Event& event : events)
+	{
+		fprintf(file, "%.6f %s %d %d %d %.4f %.4f\n", event.time, event_type_names[(int)event.type], event.code, event.action, event.mods,
+			event.x, event.y);
+	}
+
+	fclose(file);
+	return true;
+}
+
+bool InputReplay::Load(const Rml::String& path, Rml::Vector<Event>& out_events)
+{
+	FILE* file = fopen(path.c_str(), "r");
+	if (!file)
+	{
+		Rml::Log::Message(Rml::Log::LT_ERROR, "Could not open the input recording '%s'.", path.c_str());
+		return false;
+	}
+
+	out_events.clear();
+
+	char line[256];
+	int line_number = 0;
+	bool result = true;
+	while (fgets(line, sizeof(line), file))
+	{
+		line_number += 1;
+		if (line[0] == '#' || line[0] == '\n')
+			continue;
+
+		Event event = {};
+		char type_name[32] = {};
+		if (sscanf(line, "%lf %31s %d %d %d %lf %lf", &event.time, type_name, &event.code, &event.action, &event.mods, &event.x, &event.y) != 7)
+		{
+			Rml::Log::Message(Rml::Log::LT_ERROR, "Malformed event on line %d of the input recording '%s'.", line_number, path.c_str());
+			result = false;
+			break;
+		}
+
+		int type = 0;
+		while (type < (int)EventType::Count && strcmp(type_name, event_type_names[type]) != 0)
+			type += 1;
+		if (type == (int)EventType::Count)
+		{
+			Rml::Log::Message(Rml::Log::LT_WARNING, "Skipping unknown event '%s' in the input recording '%s'.", type_name, path.c_str());
+			continue;
+		}
+
+		event.type = EventType(type);
+		out_events.push_back(event);
+	}
+
+	fclose(file);
+	return result;
+}
+
+void InputReplay::Recorder::Start(Rml::Vector2i window_size, Rml::Vector2i framebuffer_size, float content_scale)
+{
+	recording = true;
+	start_time = Clock::now();
+	events.clear();
+
+	Record(EventType::WindowSize, 0, 0, 0, window_size.x, window_size.y);
+	Record(EventType::FramebufferSize, 0, 0, 0, framebuffer_size.x, framebuffer_size.y);
+	Record(EventType::ContentScale, 0, 0, 0, content_scale);
+}
+
+void InputReplay::Recorder::Stop()
+{
+	recording = false;
+}
+
+void InputReplay::Recorder::Record(EventType type, int code, int action, int mods, double x, double y)
+{
+	if (!recording)
+		return;
+
+	const double time = std::chrono::duration<double>(Clock::now() - start_time).count();
+	events.push_back(Event{time, type, code, action, mods, x, y});
+}
+
+InputReplay::Player::Player(Rml::Context* in_context, Rml::Vector<Event> in_events) : context(in_context), events(std::move(in_events))
+{
+	for (const Event& event : events)
+	{
+		if (event.type == EventType::Frame)
+			num_frames += 1;
+	}
+}
+
+bool InputReplay::Player::Advance()
+{
+	if (num_frames > 0)
+	{
+		// Events after the last frame event, recorded until the recording was stopped, make up a final frame.
+		bool frame_ended = false;
+		while (next_event < events.size() && !frame_ended)
+		{
+			const Event& event = events[next_event];
+			next_event += 1;
+			frame_ended = (event.type == EventType::Frame);
+			if (!frame_ended)
+				Submit(event);
+			frame_time = event.time;
+		}
+	}
+	else
+	{
+		frame_time += FallbackFrameTime;
+		while (next_event < events.size() && events[next_event].time <= frame_time)
+		{
+			Submit(events[next_event]);
+			next_event += 1;
+		}
+	}
+
+	// As in the backend, the final framebuffer size and then the final cursor position are submitted once all events up to the frame have
+	// been processed.
+	ApplyFramebufferSize();
+	FlushMouseMove();
+
+	return next_event < events.size();
+}
+
+double InputReplay::Player::GetDuration() const
+{
+	return events.empty() ? 0.0 : events.back().time;
+}
+
+void InputReplay::Player::Submit(const Event& event)
+{
+	if (event.type == EventType::CursorPos)
+	{
+		mouse_moves.QueueMove(event.x, event.y, event.mods);
+		return;
+	}
+
+	// Submit any pending move first, so that e.g. a click applies at the position the cursor had when the button was pressed.
+	FlushMouseMove();
+
+	const Clock::time_point begin_time = Clock::now();
+
+	switch (event.type)
+	{
+	case EventType::Key:
+		RmlGLFW::ProcessKeyCallback(context, event.code, event.action, event.mods);
+		AddSample(event.action == GLFW_RELEASE ? Handler::KeyUp : Handler::KeyDown, begin_time);
+		break;
+	case EventType::Char:
+		RmlGLFW::ProcessCharCallback(context, (unsigned int)event.code);
+		AddSample(Handler::TextInput, begin_time);
+		break;
+	case EventType::CursorEnter:
+		// Entering the window is not submitted to the context.
+		if (!event.code)
+		{
+			RmlGLFW::ProcessCursorEnterCallback(context, event.code);
+			AddSample(Handler::MouseLeave, begin_time);
+		}
+		break;
+	case EventType::MouseButton:
+		RmlGLFW::ProcessMouseButtonCallback(context, event.code, event.action, event.mods);
+		AddSample(event.action == GLFW_RELEASE ? Handler::MouseButtonUp : Handler::MouseButtonDown, begin_time);
+		break;
+	case EventType::Scroll:
+		RmlGLFW::ProcessScrollCallback(context, event.y, event.mods);
+		AddSample(Handler::MouseWheel, begin_time);
+		break;
+	case EventType::WindowSize:
+		mouse_moves.SetWindowSize((int)event.x, (int)event.y);
+		break;
+	case EventType::FramebufferSize:
+		mouse_moves.SetFramebufferSize((int)event.x, (int)event.y);
+		pending_framebuffer_size = Rml::Vector2i((int)event.x, (int)event.y);
+		framebuffer_size_dirty = true;
+		break;
+	case EventType::ContentScale:
+		RmlGLFW::ProcessContentScaleCallback(context, (float)event.x);
+		AddSample(Handler::SetDensityIndependentPixelRatio, begin_time);
+		break;
+	case EventType::CursorPos:
+	case EventType::Frame:
+	case EventType::Count: break;
+	}
+}
+
+void InputReplay::Player::ApplyFramebufferSize()
+{
+	if (!framebuffer_size_dirty)
+		return;
+
+	framebuffer_size_dirty = false;
+	const Clock::time_point begin_time = Clock::now();
+	RmlGLFW::ProcessFramebufferSizeCallback(context, pending_framebuffer_size.x, pending_framebuffer_size.y);
+	AddSample(Handler::SetDimensions, begin_time);
+}
+
+void InputReplay::Player::FlushMouseMove()
+{
+	const size_t num_dispatched_moves = mouse_moves.GetStatistics().num_dispatched_moves;
+	const Clock::time_point begin_time = Clock::now();
+
+	mouse_moves.Flush(context);
+
+	if (mouse_moves.GetStatistics().num_dispatched_moves != num_dispatched_moves)
+		AddSample(Handler::MouseMove, begin_time);
+}
+
+void InputReplay::Player::AddSample(Handler handler, Clock::time_point begin_time)
+{
+	handler_samples[(int)handler].push_back(std::chrono::duration<double, std::milli>(Clock::now() - begin_time).count());
+}
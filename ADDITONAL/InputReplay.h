@@ -0,0 +1,148 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef RMLUI_BACKENDS_INPUTREPLAY_H
+#define RMLUI_BACKENDS_INPUTREPLAY_H
+
+#include "RmlUi_Platform_GLFW.h"
+#include <RmlUi/Core/Types.h>
+#include <chrono>
+
+namespace Rml {
+class Context;
+}
+
+/**
+    Recording and replay of window input, for reproducible interaction benchmarks.
+
+    Events are recorded as received from the GLFW callbacks, with the time since the recording started. The backend also records a frame
+    event once it has processed the events of a frame, so that a replay submits the same events in each frame as were processed live.
+    A replay submits them through the same RmlGLFW helpers and mouse move coalescing as live input, so that the context sees the same
+    calls it did while recording. As no window is involved, recordings can be replayed headless, with frames back to back or in real
+    time. The time spent in each of the context's input handlers is measured per event.
+
+    Recordings are stored as text, one event per line.
+ */
+namespace InputReplay {
+
+enum class EventType { Key, Char, CursorPos, CursorEnter, MouseButton, Scroll, WindowSize, FramebufferSize, ContentScale, Frame, Count };
+
+struct Event {
+	double time; // Seconds since the recording started.
+	EventType type;
+	int code;    // Key: GLFW key. MouseButton: button. Char: codepoint. CursorEnter: entered.
+	int action;  // Key and MouseButton: GLFW action.
+	int mods;    // Key, CursorPos, MouseButton and Scroll: GLFW modifier bits.
+	double x, y; // CursorPos: screen coordinates. Scroll: offsets. WindowSize and FramebufferSize: width and height. ContentScale: x scale.
+};
+
+// The context functions input events are handled by during replay.
+enum class Handler {
+	MouseMove,
+	MouseButtonDown,
+	MouseButtonUp,
+	MouseWheel,
+	MouseLeave,
+	KeyDown,
+	KeyUp,
+	TextInput,
+	SetDimensions,
+	SetDensityIndependentPixelRatio,
+	Count
+};
+
+const char* GetHandlerName(Handler handler);
+
+bool Save(const Rml::String& path, const Rml::Vector<Event>& events);
+bool Load(const Rml::String& path, Rml::Vector<Event>& out_events);
+
+class Recorder {
+public:
+	// Starts a new recording, beginning with the current window and framebuffer size, and the content scale of the window.
+	void Start(Rml::Vector2i window_size, Rml::Vector2i framebuffer_size, float content_scale);
+	void Stop();
+	bool IsRecording() const { return recording; }
+
+	// Adds an event at the current time, ignored unless recording.
+	void Record(EventType type, int code, int action, int mods, double x = 0.0, double y = 0.0);
+
+	const Rml::Vector<Event>& GetEvents() const { return events; }
+
+private:
+	bool recording = false;
+	std::chrono::steady_clock::time_point start_time;
+	Rml::Vector<Event> events;
+};
+
+class Player {
+public:
+	Player(Rml::Context* context, Rml::Vector<Event> events);
+
+	// Submits the events of the next recorded frame, coalescing cursor movement and framebuffer size changes as during recording.
+	// Recordings made without frame events are split into frames of FallbackFrameTime instead. Returns false once every event has been
+	// submitted.
+	bool Advance();
+
+	// Time since the start of the recording at which the frame last submitted by Advance() ended.
+	double GetFrameTime() const { return frame_time; }
+
+	// Time of the last event.
+	double GetDuration() const;
+	size_t GetNumEvents() const { return events.size(); }
+	// Number of frame events in the recording, zero for recordings made without them.
+	size_t GetNumFrames() const { return num_frames; }
+
+	static constexpr double FallbackFrameTime = 1.0 / 60.0;
+
+	// Durations in milliseconds of each call to the handler.
+	const Rml::Vector<double>& GetHandlerSamples(Handler handler) const { return handler_samples[(int)handler]; }
+
+private:
+	void Submit(const Event& event);
+	void FlushMouseMove();
+	void ApplyFramebufferSize();
+	void AddSample(Handler handler, std::chrono::steady_clock::time_point begin_time);
+
+	Rml::Context* context;
+	Rml::Vector<Event> events;
+	size_t next_event = 0;
+	size_t num_frames = 0;
+	double frame_time = 0.0;
+
+	MouseMoveCoalescer_GLFW mouse_moves;
+
+	// Only the last framebuffer size of a frame is applied, as the backend does.
+	Rml::Vector2i pending_framebuffer_size;
+	bool framebuffer_size_dirty = false;
+
+	Rml::Vector<double> handler_samples[(int)Handler::Count];
+};
+
+} // namespace InputReplay
+
+#endif
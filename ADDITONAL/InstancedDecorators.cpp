@@ -0,0 +1,731 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include "InstancedDecorators.h"
+#include "RmlUi_Renderer_GL3.h"
+#include <RmlUi/Core/ComputedValues.h>
+#include <RmlUi/Core/Core.h>
+#include <RmlUi/Core/Decorator.h>
+#include <RmlUi/Core/Element.h>
+#include <RmlUi/Core/ElementUtilities.h>
+#include <RmlUi/Core/Factory.h>
+#include <RmlUi/Core/Log.h>
+#include <RmlUi/Core/Math.h>
+#include <RmlUi/Core/PropertyDefinition.h>
+#include <RmlUi/Core/PropertyDictionary.h>
+#include <RmlUi/Core/Spritesheet.h>
+#include <RmlUi/Core/StringUtilities.h>
+#include <RmlUi/Core/SystemInterface.h>
+#include <utility>
+
+using QuadInstance = RenderInterface_GL3::QuadInstance;
+
+// One list of instances for each texture used by the decorator.
+using InstanceLists = Rml::Vector<Rml::Vector<QuadInstance>>;
+
+// Matches the order of the orientation keywords, flipping is done by toggling the bits.
+enum TileOrientation { OrientationNone = 0, OrientationFlipHorizontal = 1, OrientationFlipVertical = 2, OrientationRotate180 = 3 };
+
+struct Tile {
+	bool valid = false;
+	int texture_index = -1;
+	Rml::Vector2f position; // In 'px' units of the texture.
+	Rml::Vector2f size;     // In 'px' units of the texture, negative for sprites which are mirrored in the sprite sheet.
+	float display_scale = 1.f;
+	int orientation = OrientationNone;
+};
+
+struct TilePropertyIds {
+	Rml::PropertyId src, orientation;
+};
+
+/**
+    Base class of the instanced decorators, generates and renders the per-element instance lists.
+ */
+class DecoratorInstanced : public Rml::Decorator {
+public:
+	DecoratorInstanced(RenderInterface_GL3* render_interface) : render_interface(render_interface) {}
+
+	void ReleaseElementData(Rml::DecoratorDataHandle element_data) const override { delete reinterpret_cast<InstanceLists*>(element_data); }
+
+	void RenderElement(Rml::Element* element, Rml::DecoratorDataHandle element_data) const override
+	{
+		const InstanceLists& instance_lists = *reinterpret_cast<const InstanceLists*>(element_data);
+		const Rml::Vector2f translation = element->GetAbsoluteOffset(Rml::BoxArea::Border);
+
+		for (int i = 0; i < (int)instance_lists.size(); i++)
+		{
+			if (instance_lists[i].empty())
+				continue;
+
+			if (const Rml::TextureHandle texture_handle = GetTextureHandle(i))
+				render_interface->RenderQuadInstances(instance_lists[i], translation, texture_handle);
+		}
+	}
+
+	// Adds the sprite sheet texture of the given sprite, returns its index.
+	int AddSpriteTexture(const Rml::Sprite& sprite, Rml::RenderManager& render_manager)
+	{
+		// Resolve the path the same way as RmlUi does before loading the texture, so that we can find it in the renderer.
+		const Rml::TextureSource& texture_source = sprite.sprite_sheet->texture_source;
+		Rml::String source;
+		Rml::GetSystemInterface()->JoinPath(source, Rml::StringUtilities::Replace(texture_source.GetDefinitionSource(), '|', ':'),
+			texture_source.GetSource());
+
+		for (int i = 0; i < (int)texture_sources.size(); i++)
+		{
+			if (texture_sources[i] == source)
+				return i;
+		}
+
+		const int index = AddTexture(texture_source.GetTexture(render_manager));
+		if (index >= 0)
+		{
+			RMLUI_ASSERT(index == (int)texture_sources.size());
+			texture_sources.push_back(std::move(source));
+		}
+		return index;
+	}
+
+protected:
+	InstanceLists* CreateInstanceLists() const { return new InstanceLists(texture_sources.size()); }
+
+	static Rml::DecoratorDataHandle ToHandle(InstanceLists* instance_lists)
+	{
+		for (const auto& instances : *instance_lists)
+		{
+			if (!instances.empty())
+				return reinterpret_cast<Rml::DecoratorDataHandle>(instance_lists);
+		}
+
+		delete instance_lists;
+		return INVALID_DECORATORDATAHANDLE;
+	}
+
+	Rml::Vector2f GetTextureDimensions(int texture_index) const
+	{
+		// Querying the dimensions also ensures that the texture is loaded.
+		const Rml::Vector2i dimensions = GetTexture(texture_index).GetDimensions();
+		return Rml::Vector2f(Rml::Math::Max(dimensions, Rml::Vector2i(1)));
+	}
+
+	static Rml::ColourbPremultiplied GetQuadColour(Rml::Element* element)
+	{
+		const Rml::Style::ComputedValues& computed = element->GetComputedValues();
+		return computed.image_color().ToPremultiplied(computed.opacity());
+	}
+
+	// Adds a quad covering the given surface, with the corners snapped to whole pixels.
+	static void AddInstance(Rml::Vector<QuadInstance>& instances, Rml::Vector2f surface_origin, Rml::Vector2f surface_dimensions,
+		Rml::Vector2f tex_coord_min, Rml::Vector2f tex_coord_max, Rml::ColourbPremultiplied colour)
+	{
+		const Rml::Vector2f p0 = surface_origin.Round();
+		const Rml::Vector2f p1 = (surface_origin + surface_dimensions).Round();
+		if (p1.x <= p0.x || p1.y <= p0.y)
+			return;
+
+		instances.push_back(QuadInstance{p0, p1 - p0, tex_coord_min, tex_coord_max, colour});
+	}
+
+private:
+	Rml::TextureHandle GetTextureHandle(int texture_index) const
+	{
+		Rml::TextureHandle texture_handle = render_interface->FindLoadedTexture(texture_sources[texture_index]);
+		if (!texture_handle)
+		{
+			// RmlUi may have released its textures since the element data was generated, load it again through the texture view.
+			GetTexture(texture_index).GetDimensions();
+			texture_handle = render_interface->FindLoadedTexture(texture_sources[texture_index]);
+		}
+		return texture_handle;
+	}
+
+	RenderInterface_GL3* render_interface;
+	Rml::StringList texture_sources;
+};
+
+/**
+    Base class of the tiled decorators, each tile is stretched to fill its area.
+ */
+class DecoratorInstancedTiled : public DecoratorInstanced {
+public:
+	using DecoratorInstanced::DecoratorInstanced;
+
+	void SetTiles(const Tile* in_tiles, int num_tiles) { tiles.assign(in_tiles, in_tiles + num_tiles); }
+
+protected:
+	enum class Axis { Horizontal, Vertical };
+
+	Rml::Vector2f GetNaturalDimensions(int tile_index, Rml::Element* element) const
+	{
+		const Tile& tile = tiles[tile_index];
+		if (!tile.valid)
+			return Rml::Vector2f(0.f);
+
+		const float scale_raw_to_natural_dimensions = Rml::ElementUtilities::GetDensityIndependentPixelRatio(element) / tile.display_scale;
+		return Rml::Math::Absolute(tile.size) * scale_raw_to_natural_dimensions;
+	}
+
+	// Scales the tile dimensions uniformly such that they match the given value along the axis.
+	static void ScaleTileDimensions(Rml::Vector2f& tile_dimensions, float axis_value, Axis axis)
+	{
+		float& along = (axis == Axis::Horizontal ? tile_dimensions.x : tile_dimensions.y);
+		float& across = (axis == Axis::Horizontal ? tile_dimensions.y : tile_dimensions.x);
+		if (along != axis_value && along > 0.f)
+		{
+			across = across * (axis_value / along);
+			along = axis_value;
+		}
+	}
+
+	void AddTileInstance(InstanceLists& instance_lists, int tile_index, Rml::Vector2f surface_origin, Rml::Vector2f surface_dimensions,
+		Rml::ColourbPremultiplied colour) const
+	{
+		const Tile& tile = tiles[tile_index];
+		if (!tile.valid)
+			return;
+
+		const Rml::Vector2f texture_dimensions = GetTextureDimensions(tile.texture_index);
+		Rml::Vector2f tex_coord_min = tile.position / texture_dimensions;
+		Rml::Vector2f tex_coord_max = (tile.position + tile.size) / texture_dimensions;
+
+		if (tile.orientation & OrientationFlipHorizontal)
+			std::swap(tex_coord_min.x, tex_coord_max.x);
+		if (tile.orientation & OrientationFlipVertical)
+			std::swap(tex_coord_min.y, tex_coord_max.y);
+
+		AddInstance(instance_lists[tile.texture_index], surface_origin, surface_dimensions, tex_coord_min, tex_coord_max, colour);
+	}
+
+	Rml::Vector<Tile> tiles;
+};
+
+class DecoratorInstancedTiledHorizontal : public DecoratorInstancedTiled {
+public:
+	enum { LEFT, CENTRE, RIGHT, COUNT };
+
+	using DecoratorInstancedTiled::DecoratorInstancedTiled;
+
+	Rml::DecoratorDataHandle GenerateElementData(Rml::Element* element, Rml::BoxArea paint_area) const override
+	{
+		const Rml::Vector2f offset = element->GetBox().GetPosition(paint_area);
+		const Rml::Vector2f size = element->GetBox().GetSize(paint_area);
+
+		Rml::Vector2f left_dimensions = GetNaturalDimensions(LEFT, element);
+		Rml::Vector2f right_dimensions = GetNaturalDimensions(RIGHT, element);
+		Rml::Vector2f centre_dimensions = GetNaturalDimensions(CENTRE, element);
+
+		// Scale the tile sizes by the height scale.
+		ScaleTileDimensions(left_dimensions, size.y, Axis::Vertical);
+		ScaleTileDimensions(right_dimensions, size.y, Axis::Vertical);
+		ScaleTileDimensions(centre_dimensions, size.y, Axis::Vertical);
+
+		// Round the outer tile widths now so that we don't get gaps when rounding the quads.
+		left_dimensions.x = Rml::Math::Round(left_dimensions.x);
+		right_dimensions.x = Rml::Math::Round(right_dimensions.x);
+
+		// Shrink the x-sizes on the left and right tiles if necessary.
+		if (size.x < left_dimensions.x + right_dimensions.x)
+		{
+			const float minimum_width = left_dimensions.x + right_dimensions.x;
+			left_dimensions.x = size.x * (left_dimensions.x / minimum_width);
+			right_dimensions.x = size.x * (right_dimensions.x / minimum_width);
+		}
+
+		const Rml::ColourbPremultiplied colour = GetQuadColour(element);
+		InstanceLists* instance_lists = CreateInstanceLists();
+
+		AddTileInstance(*instance_lists, LEFT, offset, left_dimensions, colour);
+		AddTileInstance(*instance_lists, CENTRE, offset + Rml::Vector2f(left_dimensions.x, 0),
+			Rml::Vector2f(size.x - (left_dimensions.x + right_dimensions.x), centre_dimensions.y), colour);
+		AddTileInstance(*instance_lists, RIGHT, offset + Rml::Vector2f(size.x - right_dimensions.x, 0), right_dimensions, colour);
+
+		return ToHandle(instance_lists);
+	}
+};
+
+class DecoratorInstancedTiledVertical : public DecoratorInstancedTiled {
+public:
+	enum { TOP, CENTRE, BOTTOM, COUNT };
+
+	using DecoratorInstancedTiled::DecoratorInstancedTiled;
+
+	Rml::DecoratorDataHandle GenerateElementData(Rml::Element* element, Rml::BoxArea paint_area) const override
+	{
+		const Rml::Vector2f offset = element->GetBox().GetPosition(paint_area);
+		const Rml::Vector2f size = element->GetBox().GetSize(paint_area);
+
+		Rml::Vector2f top_dimensions = GetNaturalDimensions(TOP, element);
+		Rml::Vector2f bottom_dimensions = GetNaturalDimensions(BOTTOM, element);
+		Rml::Vector2f centre_dimensions = GetNaturalDimensions(CENTRE, element);
+
+		// Scale the tile sizes by the width scale.
+		ScaleTileDimensions(top_dimensions, size.x, Axis::Horizontal);
+		ScaleTileDimensions(bottom_dimensions, size.x, Axis::Horizontal);
+		ScaleTileDimensions(centre_dimensions, size.x, Axis::Horizontal);
+
+		// Round the outer tile heights now so that we don't get gaps when rounding the quads.
+		top_dimensions.y = Rml::Math::Round(top_dimensions.y);
+		bottom_dimensions.y = Rml::Math::Round(bottom_dimensions.y);
+
+		// Shrink the y-sizes on the top and bottom tiles if necessary.
+		if (size.y < top_dimensions.y + bottom_dimensions.y)
+		{
+			const float minimum_height = top_dimensions.y + bottom_dimensions.y;
+			top_dimensions.y = size.y * (top_dimensions.y / minimum_height);
+			bottom_dimensions.y = size.y * (bottom_dimensions.y / minimum_height);
+		}
+
+		const Rml::ColourbPremultiplied colour = GetQuadColour(element);
+		InstanceLists* instance_lists = CreateInstanceLists();
+
+		AddTileInstance(*instance_lists, TOP, offset, top_dimensions, colour);
+		AddTileInstance(*instance_lists, CENTRE, offset + Rml::Vector2f(0, top_dimensions.y),
+			Rml::Vector2f(centre_dimensions.x, size.y - (top_dimensions.y + bottom_dimensions.y)), colour);
+		AddTileInstance(*instance_lists, BOTTOM, offset + Rml::Vector2f(0, size.y - bottom_dimensions.y), bottom_dimensions, colour);
+
+		return ToHandle(instance_lists);
+	}
+};
+
+class DecoratorInstancedTiledBox : public DecoratorInstancedTiled {
+public:
+	enum { TOP_LEFT, TOP, TOP_RIGHT, LEFT, CENTRE, RIGHT, BOTTOM_LEFT, BOTTOM, BOTTOM_RIGHT, COUNT };
+
+	using DecoratorInstancedTiled::DecoratorInstancedTiled;
+
+	Rml::DecoratorDataHandle GenerateElementData(Rml::Element* element, Rml::BoxArea paint_area) const override
+	{
+		const Rml::Vector2f offset = element->GetBox().GetPosition(paint_area);
+		const Rml::Vector2f size = element->GetBox().GetSize(paint_area);
+
+		Rml::Vector2f natural[COUNT];
+		for (int i = 0; i < COUNT; i++)
+			natural[i] = GetNaturalDimensions(i, element);
+
+		Rml::Vector2f top_left = natural[TOP_LEFT], top = natural[TOP], top_right = natural[TOP_RIGHT];
+		Rml::Vector2f left = natural[LEFT], right = natural[RIGHT];
+		Rml::Vector2f bottom_left = natural[BOTTOM_LEFT], bottom = natural[BOTTOM], bottom_right = natural[BOTTOM_RIGHT];
+
+		// Scale the corners down if they don't fit. Edges sharing their size with the adjacent corner are scaled along with it.
+		auto ShrinkCorners = [](float available, float& first, float& second, float first_natural, float& first_edge, float first_edge_natural,
+								 float second_natural, float& second_edge, float second_edge_natural) {
+			if (available < first + second)
+			{
+				const float minimum = first + second;
+				first = available * (first / minimum);
+				second = available * (second / minimum);
+				if (first_natural == first_edge_natural)
+					first_edge = first;
+				if (second_natural == second_edge_natural)
+					second_edge = second;
+			}
+		};
+
+		ShrinkCorners(size.x, top_left.x, top_right.x, natural[TOP_LEFT].x, left.x, natural[LEFT].x, natural[TOP_RIGHT].x, right.x,
+			natural[RIGHT].x);
+		ShrinkCorners(size.x, bottom_left.x, bottom_right.x, natural[BOTTOM_LEFT].x, left.x, natural[LEFT].x, natural[BOTTOM_RIGHT].x, right.x,
+			natural[RIGHT].x);
+		ShrinkCorners(size.y, top_left.y, bottom_left.y, natural[TOP_LEFT].y, top.y, natural[TOP].y, natural[BOTTOM_LEFT].y, bottom.y,
+			natural[BOTTOM].y);
+		ShrinkCorners(size.y, top_right.y, bottom_right.y, natural[TOP_RIGHT].y, top.y, natural[TOP].y, natural[BOTTOM_RIGHT].y, bottom.y,
+			natural[BOTTOM].y);
+
+		const Rml::ColourbPremultiplied colour = GetQuadColour(element);
+		InstanceLists* instance_lists = CreateInstanceLists();
+
+		using Rml::Vector2f;
+		AddTileInstance(*instance_lists, TOP_LEFT, offset, top_left, colour);
+		AddTileInstance(*instance_lists, TOP, offset + Vector2f(top_left.x, 0), Vector2f(size.x - (top_left.x + top_right.x), top.y), colour);
+		AddTileInstance(*instance_lists, TOP_RIGHT, offset + Vector2f(size.x - top_right.x, 0), top_right, colour);
+		AddTileInstance(*instance_lists, LEFT, offset + Vector2f(0, top_left.y), Vector2f(left.x, size.y - (top_left.y + bottom_left.y)), colour);
+		AddTileInstance(*instance_lists, RIGHT, offset + Vector2f(size.x - right.x, top_right.y),
+			Vector2f(right.x, size.y - (top_right.y + bottom_right.y)), colour);
+		AddTileInstance(*instance_lists, BOTTOM_LEFT, offset + Vector2f(0, size.y - bottom_left.y), bottom_left, colour);
+		AddTileInstance(*instance_lists, BOTTOM, offset + Vector2f(bottom_left.x, size.y - bottom.y),
+			Vector2f(size.x - (bottom_left.x + bottom_right.x), bottom.y), colour);
+		AddTileInstance(*instance_lists, BOTTOM_RIGHT, offset + Vector2f(size.x - bottom_right.x, size.y - bottom_right.y), bottom_right, colour);
+		AddTileInstance(*instance_lists, CENTRE, offset + Vector2f(left.x, top.y), Vector2f(size.x - (left.x + right.x), size.y - (top.y + bottom.y)),
+			colour);
+
+		return ToHandle(instance_lists);
+	}
+};
+
+class DecoratorInstancedNinePatch : public DecoratorInstanced {
+public:
+	struct Edges {
+		Rml::NumericValue top, right, bottom, left;
+	};
+
+	DecoratorInstancedNinePatch(RenderInterface_GL3* render_interface, Rml::Rectanglef rect_outer, Rml::Rectanglef rect_inner,
+		float display_scale, const Edges* in_edges) :
+		DecoratorInstanced(render_interface), rect_outer(rect_outer), rect_inner(rect_inner), display_scale(display_scale)
+	{
+		if (in_edges)
+			edges = Rml::MakeUnique<Edges>(*in_edges);
+	}
+
+	Rml::DecoratorDataHandle GenerateElementData(Rml::Element* element, Rml::BoxArea paint_area) const override
+	{
+		const Rml::Vector2f texture_dimensions = GetTextureDimensions(0);
+		const Rml::Vector2f surface_offset = element->GetBox().GetPosition(paint_area);
+		const Rml::Vector2f surface_dimensions = element->GetBox().GetSize(paint_area).Round();
+
+		// We operate on the four diagonal vertices of the grid, as they define the whole grid.
+		// Absolute texture coordinates 'px'.
+		const Rml::Vector2f tex_pos[4] = {rect_outer.Position(), rect_inner.Position(), rect_inner.BottomRight(), rect_outer.BottomRight()};
+
+		// Normalized texture coordinates [0, 1].
+		Rml::Vector2f tex_coords[4];
+		for (int i = 0; i < 4; i++)
+			tex_coords[i] = tex_pos[i] / texture_dimensions;
+
+		// Natural size of the corners.
+		const float scale_raw_to_natural_dimensions = Rml::ElementUtilities::GetDensityIndependentPixelRatio(element) / display_scale;
+		Rml::Vector2f surface_pos[4];
+		surface_pos[0] = Rml::Vector2f(0);
+		surface_pos[1] = (tex_pos[1] - tex_pos[0]) * scale_raw_to_natural_dimensions;
+		surface_pos[2] = surface_dimensions - (tex_pos[3] - tex_pos[2]) * scale_raw_to_natural_dimensions;
+		surface_pos[3] = surface_dimensions;
+
+		// Change the size of the edges if specified, numbers scale the natural size of the edge.
+		if (edges)
+		{
+			const float top = element->ResolveNumericValue(edges->top, surface_pos[1].y - surface_pos[0].y);
+			const float right = element->ResolveNumericValue(edges->right, surface_pos[3].x - surface_pos[2].x);
+			const float bottom = element->ResolveNumericValue(edges->bottom, surface_pos[3].y - surface_pos[2].y);
+			const float left = element->ResolveNumericValue(edges->left, surface_pos[1].x - surface_pos[0].x);
+
+			surface_pos[1] = Rml::Vector2f(left, top);
+			surface_pos[2] = surface_dimensions - Rml::Vector2f(right, bottom);
+		}
+
+		// In case the surface is smaller than the corners, scale the corners down proportionally.
+		auto FitCorners = [](float& inner_min, float& inner_max, float surface_size) {
+			const float corners_size = inner_min + (surface_size - inner_max);
+			if (corners_size > surface_size && corners_size > 0.f)
+			{
+				const float scale = surface_size / corners_size;
+				inner_min *= scale;
+				inner_max = surface_size - (surface_size - inner_max) * scale;
+			}
+		};
+		FitCorners(surface_pos[1].x, surface_pos[2].x, surface_dimensions.x);
+		FitCorners(surface_pos[1].y, surface_pos[2].y, surface_dimensions.y);
+
+		// Round the inner corners.
+		surface_pos[1] = surface_pos[1].Round();
+		surface_pos[2] = surface_pos[2].Round();
+
+		const Rml::ColourbPremultiplied colour = GetQuadColour(element);
+		InstanceLists* instance_lists = CreateInstanceLists();
+
+		for (int y = 0; y < 3; y++)
+		{
+			for (int x = 0; x < 3; x++)
+			{
+				const Rml::Vector2f p0 = {surface_pos[x].x, surface_pos[y].y};
+				const Rml::Vector2f p1 = {surface_pos[x + 1].x, surface_pos[y + 1].y};
+				const Rml::Vector2f t0 = {tex_coords[x].x, tex_coords[y].y};
+				const Rml::Vector2f t1 = {tex_coords[x + 1].x, tex_coords[y + 1].y};
+				AddInstance((*instance_lists)[0], surface_offset + p0, p1 - p0, t0, t1, colour);
+			}
+		}
+
+		return ToHandle(instance_lists);
+	}
+
+private:
+	Rml::Rectanglef rect_outer, rect_inner;
+	float display_scale;
+	Rml::UniquePtr<Edges> edges;
+};
+
+/**
+    Base class of the instancers. Keeps track of the registered property names, so that decorators which can't be
+    instanced here can be handed over to the built-in instancer of the same name.
+ */
+class DecoratorInstancedInstancer : public Rml::DecoratorInstancer {
+public:
+	DecoratorInstancedInstancer(RenderInterface_GL3* render_interface, Rml::DecoratorInstancer* fallback_instancer) :
+		render_interface(render_interface), fallback_instancer(fallback_instancer)
+	{}
+
+protected:
+	Rml::PropertyId RegisterTrackedProperty(const Rml::String& name, const Rml::String& default_value, const Rml::String& parser,
+		const Rml::String& parser_parameters = Rml::String())
+	{
+		property_names.push_back(name);
+		return RegisterProperty(name, default_value).AddParser(parser, parser_parameters).GetId();
+	}
+
+	TilePropertyIds RegisterTileProperty(const Rml::String& name)
+	{
+		TilePropertyIds ids = {};
+		ids.src = RegisterTrackedProperty(name + "-src", "", "string");
+		ids.orientation = RegisterTrackedProperty(name + "-orientation", "none", "keyword", "none, flip-horizontal, flip-vertical, rotate-180");
+		RegisterShorthand(name, name + "-src, " + name + "-orientation", Rml::ShorthandType::FallThrough);
+		return ids;
+	}
+
+	// Reads the tile from its properties. Returns false if the tile source is not a sprite, which is not supported by the instanced decorators.
+	static bool GetTileProperties(Tile& tile, DecoratorInstanced& decorator, const TilePropertyIds& ids, const Rml::PropertyDictionary& properties,
+		const Rml::DecoratorInstancerInterface& instancer_interface)
+	{
+		const Rml::String src = properties.GetProperty(ids.src)->Get<Rml::String>();
+		if (src.empty() || src == "none" || src == "auto")
+			return true;
+
+		const Rml::Sprite* sprite = instancer_interface.GetSprite(src);
+		if (!sprite)
+			return false;
+
+		tile.texture_index = decorator.AddSpriteTexture(*sprite, instancer_interface.GetRenderManager());
+		tile.valid = (tile.texture_index >= 0);
+		tile.position = sprite->rectangle.Position();
+		tile.size = sprite->rectangle.Size();
+		tile.display_scale = sprite->sprite_sheet->display_scale;
+		tile.orientation = properties.GetProperty(ids.orientation)->Get<int>();
+		return true;
+	}
+
+	// If only one of the two opposite tiles is given, mirror it for the other side.
+	static void MirrorMissingTile(Tile& a, Tile& b, TileOrientation mirror)
+	{
+		if (a.valid && !b.valid)
+		{
+			b = a;
+			b.orientation ^= mirror;
+		}
+		else if (b.valid && !a.valid)
+		{
+			a = b;
+			a.orientation ^= mirror;
+		}
+	}
+
+	Rml::SharedPtr<Rml::Decorator> InstanceFallbackDecorator(const Rml::String& name, const Rml::PropertyDictionary& properties,
+		const Rml::DecoratorInstancerInterface& instancer_interface)
+	{
+		if (!fallback_instancer)
+			return nullptr;
+
+		// Property ids are specific to each instancer, translate them by name.
+		const Rml::PropertySpecification& specification = GetPropertySpecification();
+		const Rml::PropertySpecification& fallback_specification = fallback_instancer->GetPropertySpecification();
+
+		Rml::PropertyDictionary fallback_properties;
+		for (const Rml::String& property_name : property_names)
+		{
+			const Rml::PropertyDefinition* definition = specification.GetProperty(property_name);
+			const Rml::PropertyDefinition* fallback_definition = fallback_specification.GetProperty(property_name);
+			if (!definition || !fallback_definition)
+				continue;
+
+			if (const Rml::Property* property = properties.GetProperty(definition->GetId()))
+				fallback_properties.SetProperty(fallback_definition->GetId(), *property);
+		}
+
+		return fallback_instancer->InstanceDecorator(name, fallback_properties, instancer_interface);
+	}
+
+	RenderInterface_GL3* render_interface;
+
+private:
+	Rml::DecoratorInstancer* fallback_instancer;
+	Rml::StringList property_names;
+};
+
+template <typename DecoratorType>
+class DecoratorInstancedTiledInstancer : public DecoratorInstancedInstancer {
+public:
+	DecoratorInstancedTiledInstancer(RenderInterface_GL3* render_interface, Rml::DecoratorInstancer* fallback_instancer,
+		std::initializer_list<const char*> tile_names) :
+		DecoratorInstancedInstancer(render_interface, fallback_instancer)
+	{
+		RMLUI_ASSERT(tile_names.size() == DecoratorType::COUNT);
+
+		Rml::String shorthand;
+		for (const char* tile_name : tile_names)
+		{
+			tile_property_ids.push_back(RegisterTileProperty(tile_name));
+			shorthand += (shorthand.empty() ? "" : ", ") + Rml::String(tile_name);
+		}
+		RegisterShorthand("decorator", shorthand, Rml::ShorthandType::RecursiveCommaSeparated);
+	}
+
+	Rml::SharedPtr<Rml::Decorator> InstanceDecorator(const Rml::String& name, const Rml::PropertyDictionary& properties,
+		const Rml::DecoratorInstancerInterface& instancer_interface) override
+	{
+		// The tiles are read first so that their textures are registered with the decorator, then moved into it.
+		Rml::SharedPtr<DecoratorType> decorator = Rml::MakeShared<DecoratorType>(render_interface);
+
+		Tile tiles[DecoratorType::COUNT];
+		for (int i = 0; i < DecoratorType::COUNT; i++)
+		{
+			if (!GetTileProperties(tiles[i], *decorator, tile_property_ids[i], properties, instancer_interface))
+				return InstanceFallbackDecorator(name, properties, instancer_interface);
+		}
+
+		MirrorTiles(tiles);
+
+		bool any_valid = false;
+		for (const Tile& tile : tiles)
+			any_valid |= tile.valid;
+		if (!any_valid)
+			return nullptr;
+
+		decorator->SetTiles(tiles, DecoratorType::COUNT);
+		return decorator;
+	}
+
+private:
+	static void MirrorTiles(Tile* tiles);
+
+	Rml::Vector<TilePropertyIds> tile_property_ids;
+};
+
+template <>
+void DecoratorInstancedTiledInstancer<DecoratorInstancedTiledHorizontal>::MirrorTiles(Tile* tiles)
+{
+	using D = DecoratorInstancedTiledHorizontal;
+	MirrorMissingTile(tiles[D::LEFT], tiles[D::RIGHT], OrientationFlipHorizontal);
+}
+
+template <>
+void DecoratorInstancedTiledInstancer<DecoratorInstancedTiledVertical>::MirrorTiles(Tile* tiles)
+{
+	using D = DecoratorInstancedTiledVertical;
+	MirrorMissingTile(tiles[D::TOP], tiles[D::BOTTOM], OrientationFlipVertical);
+}
+
+template <>
+void DecoratorInstancedTiledInstancer<DecoratorInstancedTiledBox>::MirrorTiles(Tile* tiles)
+{
+	using D = DecoratorInstancedTiledBox;
+	MirrorMissingTile(tiles[D::TOP_LEFT], tiles[D::TOP_RIGHT], OrientationFlipHorizontal);
+	MirrorMissingTile(tiles[D::LEFT], tiles[D::RIGHT], OrientationFlipHorizontal);
+	MirrorMissingTile(tiles[D::BOTTOM_LEFT], tiles[D::BOTTOM_RIGHT], OrientationFlipHorizontal);
+	MirrorMissingTile(tiles[D::TOP_LEFT], tiles[D::BOTTOM_LEFT], OrientationFlipVertical);
+	MirrorMissingTile(tiles[D::TOP], tiles[D::BOTTOM], OrientationFlipVertical);
+	MirrorMissingTile(tiles[D::TOP_RIGHT], tiles[D::BOTTOM_RIGHT], OrientationFlipVertical);
+}
+
+class DecoratorInstancedNinePatchInstancer : public DecoratorInstancedInstancer {
+public:
+	DecoratorInstancedNinePatchInstancer(RenderInterface_GL3* render_interface, Rml::DecoratorInstancer* fallback_instancer) :
+		DecoratorInstancedInstancer(render_interface, fallback_instancer)
+	{
+		outer_id = RegisterTrackedProperty("outer", "", "string");
+		inner_id = RegisterTrackedProperty("inner", "", "string");
+		edge_ids[0] = RegisterTrackedProperty("edge-top", "0px", "number_length_percent");
+		edge_ids[1] = RegisterTrackedProperty("edge-right", "0px", "number_length_percent");
+		edge_ids[2] = RegisterTrackedProperty("edge-bottom", "0px", "number_length_percent");
+		edge_ids[3] = RegisterTrackedProperty("edge-left", "0px", "number_length_percent");
+		RegisterShorthand("edge", "edge-top, edge-right, edge-bottom, edge-left", Rml::ShorthandType::Box);
+		RegisterShorthand("decorator", "outer, inner, edge?", Rml::ShorthandType::RecursiveCommaSeparated);
+	}
+
+	Rml::SharedPtr<Rml::Decorator> InstanceDecorator(const Rml::String& name, const Rml::PropertyDictionary& properties,
+		const Rml::DecoratorInstancerInterface& instancer_interface) override
+	{
+		const Rml::String outer_name = properties.GetProperty(outer_id)->Get<Rml::String>();
+		const Rml::String inner_name = properties.GetProperty(inner_id)->Get<Rml::String>();
+
+		const Rml::Sprite* sprite_outer = instancer_interface.GetSprite(outer_name);
+		const Rml::Sprite* sprite_inner = instancer_interface.GetSprite(inner_name);
+		if (!sprite_outer || !sprite_inner)
+			return InstanceFallbackDecorator(name, properties, instancer_interface);
+
+		if (sprite_outer->sprite_sheet != sprite_inner->sprite_sheet)
+		{
+			Rml::Log::Message(Rml::Log::LT_WARNING, "The outer and inner ninepatch sprites '%s' and '%s' must be located in the same spritesheet.",
+				outer_name.c_str(), inner_name.c_str());
+			return nullptr;
+		}
+
+		// Only use the edges if any of them are set.
+		DecoratorInstancedNinePatch::Edges edges = {};
+		Rml::NumericValue* edge_values[4] = {&edges.top, &edges.right, &edges.bottom, &edges.left};
+		bool edges_set = false;
+		for (int i = 0; i < 4; i++)
+		{
+			*edge_values[i] = properties.GetProperty(edge_ids[i])->GetNumericValue();
+			edges_set |= (edge_values[i]->number != 0.f);
+		}
+
+		auto decorator = Rml::MakeShared<DecoratorInstancedNinePatch>(render_interface, sprite_outer->rectangle, sprite_inner->rectangle,
+			sprite_outer->sprite_sheet->display_scale, edges_set ? &edges : nullptr);
+		if (decorator->AddSpriteTexture(*sprite_outer, instancer_interface.GetRenderManager()) < 0)
+			return nullptr;
+
+		return decorator;
+	}
+
+private:
+	Rml::PropertyId outer_id, inner_id;
+	Rml::PropertyId edge_ids[4];
+};
+
+struct InstancerData {
+	Rml::UniquePtr<DecoratorInstancedTiledInstancer<DecoratorInstancedTiledHorizontal>> tiled_horizontal;
+	Rml::UniquePtr<DecoratorInstancedTiledInstancer<DecoratorInstancedTiledVertical>> tiled_vertical;
+	Rml::UniquePtr<DecoratorInstancedTiledInstancer<DecoratorInstancedTiledBox>> tiled_box;
+	Rml::UniquePtr<DecoratorInstancedNinePatchInstancer> ninepatch;
+};
+
+static Rml::UniquePtr<InstancerData> instancers;
+
+void InstancedDecorators::Initialize(RenderInterface_GL3* render_interface)
+{
+	RMLUI_ASSERT(render_interface && !instancers);
+	using Rml::Factory;
+
+	instancers = Rml::MakeUnique<InstancerData>();
+
+	instancers->tiled_horizontal = Rml::MakeUnique<DecoratorInstancedTiledInstancer<DecoratorInstancedTiledHorizontal>>(render_interface,
+		Factory::GetDecoratorInstancer("tiled-horizontal"), std::initializer_list<const char*>{"left-image", "center-image", "right-image"});
+	instancers->tiled_vertical = Rml::MakeUnique<DecoratorInstancedTiledInstancer<DecoratorInstancedTiledVertical>>(render_interface,
+		Factory::GetDecoratorInstancer("tiled-vertical"), std::initializer_list<const char*>{"top-image", "center-image", "bottom-image"});
+	instancers->tiled_box = Rml::MakeUnique<DecoratorInstancedTiledInstancer<DecoratorInstancedTiledBox>>(render_interface,
+		Factory::GetDecoratorInstancer("tiled-box"),
+		std::initializer_list<const char*>{"top-left-image", "top-image", "top-right-image", "left-image", "center-image", "right-image",
+			"bottom-left-image", "bottom-image", "bottom-right-image"});
+	instancers->ninepatch = Rml::MakeUnique<DecoratorInstancedNinePatchInstancer>(render_interface, Factory::GetDecoratorInstancer("ninepatch"));
+
+	Factory::RegisterDecoratorInstancer("tiled-horizontal", instancers->tiled_horizontal.get());
+	Factory::RegisterDecoratorInstancer("tiled-vertical", instancers->tiled_vertical.get());
+	Factory::RegisterDecoratorInstancer("tiled-box", instancers->tiled_box.get());
+	Factory::RegisterDecoratorInstancer("ninepatch", instancers->ninepatch.get());
+}
+
+void InstancedDecorators::Shutdown()
+{
+	instancers.reset();
+}
@@ -0,0 +1,52 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef RMLUI_BACKENDS_INSTANCEDDECORATORS_H
+#define RMLUI_BACKENDS_INSTANCEDDECORATORS_H
+
+class RenderInterface_GL3;
+
+/**
+    Replacements for the built-in 'tiled-horizontal', 'tiled-vertical', 'tiled-box' and 'ninepatch' decorators.
+
+    Instead of compiling a mesh for every decorated element, the decorators submit one textured quad per tile to
+    RenderInterface_GL3::RenderQuadInstances(). Elements decorated from the same sprite sheet are then drawn together
+    with a single instanced draw call, as long as no other geometry is rendered in between. Decorators that refer to
+    plain images instead of sprites are handed over to the built-in instancers.
+ */
+namespace InstancedDecorators {
+
+// Registers the decorator instancers, overriding the built-in ones. Call after Rml::Initialise().
+void Initialize(RenderInterface_GL3* render_interface);
+
+// Releases the decorator instancers. Call after Rml::Shutdown().
+void Shutdown();
+
+} // namespace InstancedDecorators
+
+#endif
@@ -31,6 +31,10 @@
 
 #include <GLFW/glfw3.h>
 
+#include "AsyncLogSink.h"
+#include "IdleTaskScheduler.h"
+#include "RmlUi_Platform_GLFW.h"
+
 #include <RmlUi/Core/Input.h>
 #include <RmlUi/Core/RenderInterface.h>
 #include <RmlUi/Core/SystemInterface.h>
@@ -48,8 +52,9 @@ using KeyDownCallback = bool (*)(Rml::Context* context, Rml::Input::KeyIdentifie
  */
 namespace Backend {
 
-// Initializes the backend, including the custom system and render interfaces, and opens a window for rendering the RmlUi context.
-bool Initialize(const char* window_name, int width, int height, bool allow_resize);
+// Initializes the backend, including the custom system and render interfaces, and opens a window for rendering the RmlUi context. A hidden
+// window still provides the GL context, for rendering without showing anything such as in benchmarks.
+bool Initialize(const char* window_name, int width, int height, bool allow_resize, bool visible = true);
 // Closes the window and release all resources owned by the backend, including the system and render interfaces.
 void Shutdown();
 
@@ -68,9 +73,72 @@ void RequestExit();
 void BeginFrame();
 // Presents the rendered frame to the screen, call after rendering the RmlUi context.
 void PresentFrame();
+// Clears the window for a frame drawn by the application, such as a host scene with a composited user interface. Call in place of
+// BeginFrame(), so that the renderer still runs its per-frame work.
+void BeginHostFrame();
+// Presents a frame started with BeginHostFrame().
+void PresentHostFrame();
+
+struct LoopStatistics {
+	size_t num_iterations;
+	size_t num_rendered_frames;
+	size_t num_idle_frames;       // Iterations where rendering was skipped because nothing visual changed.
+	size_t num_input_wakeups;     // Frames rendered because of input.
+	size_t num_update_wakeups;    // Frames rendered because the context requested an update, e.g. for animations and transitions.
+	size_t num_requested_wakeups; // Frames rendered because of RequestRedraw() or window events such as resizing.
+	double time_waiting;          // Seconds spent blocked waiting for events.
+	double time_active;           // Seconds spent outside of event processing.
+	double time_idle_tasks;       // Seconds spent running idle tasks before waiting for events.
+	size_t num_resize_events;     // Framebuffer size changes reported by the window.
+	size_t num_resizes_applied;   // Size changes applied to the context and renderer, at most one per frame.
+	size_t num_window_frames;     // Frames rendered in additional windows.
+};
+
+// Returns true if the context needs to be rendered, call every iteration after updating the context. Together with power saving event
+// processing, this lets the application sleep and skip rendering and presenting entirely while the user interface is unchanged. A frame is
+// rendered after input, window events, redraw requests, and whenever the update delay requested by the context has elapsed.
+bool ShouldRender(Rml::Context* context);
+// Wakes up event processing and renders the next frame. Call this after changes the backend does not know about, such as modifying data
+// model variables or completing asynchronous loading. Thread-safe.
+void RequestRedraw();
+const LoopStatistics& GetLoopStatistics();
+
+// Queues a task to run in the idle time of the main loop, such as warming up resources for documents about to be opened. Tasks are run
+// during event processing, before the loop sleeps, within the time left until the next frame must start to meet the following vertical
+// sync. Tasks honouring their budget use any such time. Other tasks are only started when their expected cost in seconds fits, those of
+// unknown cost wait for an idle period without any frame pending, or while rendering continuously, run right after a present at most
+// every quarter second. See IdleTasks for common tasks.
+void SubmitIdleTask(const Rml::String& name, IdleTaskScheduler::Task task,
+	IdleTaskScheduler::Budget budget = IdleTaskScheduler::Budget::Ignored, double expected_cost = -1.0);
+const IdleTaskScheduler::Statistics& GetIdleTaskStatistics();
+// Returns the names of the tasks not yet completed.
+Rml::StringList GetPendingIdleTasks();
+
+// Returns the number of log messages written, and those filtered, collapsed, or dropped to avoid blocking the caller.
+AsyncLogSink::Statistics GetLogStatistics();
+
+// Records the input events of the main window with their timestamps, to be replayed headless with InputReplay::Player.
+void StartInputRecording();
+// Stops recording and writes the recorded events to the file. Returns false if not recording or the file could not be written.
+bool StopInputRecording(const Rml::String& path);
+
+// Returns the number of cursor position events received from the window, and the number of mouse moves they were coalesced into.
+const MouseMoveCoalescer_GLFW::Statistics& GetMouseMoveStatistics();
 
 GLFWwindow* GetWindow();  // Add this line
 
+// Opens an additional window, e.g. for a detached debugger or a second monitor. Its GL context shares the objects of the main window, so
+// that programs, fonts, textures and geometry are shared between all windows through the same render interface. Returns null on failure.
+GLFWwindow* OpenWindow(const char* window_name, int width, int height, bool allow_resize);
+// Closes an additional window. Closing it from its title bar only hides it until shown again by the application.
+void CloseWindow(GLFWwindow* window);
+// Sets the context rendered into an additional window and receiving its input during ProcessEvents(). The context dimensions are kept at
+// the framebuffer size of the window. Contexts of additional windows are updated by the application, like the main context.
+void SetWindowContext(GLFWwindow* window, Rml::Context* context);
+// Renders and presents the additional windows whose contexts need it, under the same conditions as ShouldRender(). Call every iteration
+// after updating their contexts. Only the main window waits for vertical sync when presented.
+void RenderWindows();
+
 } // namespace Backend
 
 #endif
@@ -27,12 +27,27 @@
  */
 
 #include "RmlUi_Backend.h"
+#include "AsyncLogSink.h"
+#include "FrameTiming.h"
+#include "IdleTaskScheduler.h"
+#include "InputReplay.h"
 #include "RmlUi_Platform_GLFW.h"
 #include "RmlUi_Renderer_GL3.h"
 #include <RmlUi/Core/Context.h>
 #include <RmlUi/Core/Input.h>
 #include <RmlUi/Core/Profiling.h>
 #include <GLFW/glfw3.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <utility>
+
+// Time in seconds kept free before the start of the next frame when running idle tasks, to absorb variations in the frame work.
+static constexpr double IDLE_TASK_SAFETY_MARGIN = 0.001;
+// Time in seconds without presenting a frame after which idle tasks may exceed the frame budget.
+static constexpr double IDLE_OVERSIZED_DELAY = 0.25;
+// Factor applied to the frame work estimate every frame, so that it recovers slowly from spikes.
+static constexpr double FRAME_WORK_DECAY = 0.95;
 
 static void SetupCallbacks(GLFWwindow* window);
 
@@ -41,33 +56,132 @@ static void LogErrorFromGLFW(int error, const char* description)
 	Rml::Log::Message(Rml::Log::LT_ERROR, "GLFW error (0x%x): %s", error, description);
 }
 
+/**
+    Input and window state of each window, set as the GLFW window user pointer so that events are routed to the context of the window
+    they occur in.
+ */
+struct WindowData {
+	GLFWwindow* window = nullptr;
+	// The context receiving input. For the main window, this is set during event processing and nulled otherwise.
+	Rml::Context* context = nullptr;
+	int glfw_active_modifiers = 0;
+	MouseMoveCoalescer_GLFW mouse_moves;
+
+	bool input_received = false;
+	double update_deadline = 0.0;
+
+	// Window resizing can report many framebuffer sizes during a single poll, only the latest one is applied after polling.
+	Rml::Vector2i pending_framebuffer_size;
+	bool framebuffer_size_dirty = false;
+
+	// Used by additional windows only, the main window renders through the main frame and is redrawn by Backend::RequestRedraw().
+	RenderInterface_GL3::SurfaceHandle surface = {};
+	bool redraw_requested = true;
+};
+
 /**
     Global data used by this backend.
 
     Lifetime governed by the calls to Backend::Initialize() and Backend::Shutdown().
  */
 struct BackendData {
+	// Declared first so that messages logged while destroying the other members are still written.
+	AsyncLogSink log_sink;
 	SystemInterface_GLFW system_interface;
 	RenderInterface_GL3 render_interface;
-	GLFWwindow* window = nullptr;
-	int glfw_active_modifiers = 0;
+	WindowData main_window;
+	// Additional windows, with GL contexts sharing the objects of the main window's context.
+	Rml::Vector<Rml::UniquePtr<WindowData>> windows;
+
+	// Adaptive loop state, see Backend::ShouldRender(). Redraws may be requested from other threads.
+	std::atomic<bool> redraw_requested{true};
+	double active_begin_time = 0.0;
+	Backend::LoopStatistics loop_statistics = {};
 	bool context_dimensions_dirty = true;
 
+	// Records the input of the main window while enabled.
+	InputReplay::Recorder input_recorder;
+
+	// Idle tasks run during event processing, in the time left before the next vertical sync once the next frame is accounted for.
+	IdleTaskScheduler idle_tasks;
+	double refresh_period = 1.0 / 60.0;
+	double last_present_time = 0.0;
+	double last_oversized_task_time = 0.0;
+	// Decaying peak of the time from event processing until presenting, a conservative estimate of the work for the next frame.
+	double frame_work_estimate = 0.0;
+
 	// Arguments set during event processing and nulled otherwise.
-	Rml::Context* context = nullptr;
 	KeyDownCallback key_down_callback = nullptr;
 };
 static Rml::UniquePtr<BackendData> data;
 
-bool Backend::Initialize(const char* name, int width, int height, bool allow_resize)
+static WindowData& GetWindowData(GLFWwindow* window)
 {
-	RMLUI_ASSERT(!data);
+	return *static_cast<WindowData*>(glfwGetWindowUserPointer(window));
+}
 
-	glfwSetErrorCallback(LogErrorFromGLFW);
+static void RecordInput(const WindowData& window_data, InputReplay::EventType type, int code, int action, int mods, double x = 0.0,
+	double y = 0.0)
+{
+	if (&window_data == &data->main_window)
+		data->input_recorder.Record(type, code, action, mods, x, y);
+}
 
-	if (!glfwInit())
-		return false;
+static void RequestWindowRedraw(WindowData& window_data)
+{
+	if (&window_data == &data->main_window)
+		data->redraw_requested.store(true);
+	else
+		window_data.redraw_requested = true;
+}
+
+// Presents the main window, and records the frame work and present times used to schedule idle tasks.
+static void SwapMainWindow()
+{
+	data->frame_work_estimate = Rml::Math::Max(glfwGetTime() - data->active_begin_time, data->frame_work_estimate * FRAME_WORK_DECAY);
+	{
+		FrameTiming::ScopedPhase phase(FrameTiming::Phase::SwapBuffers);
+		glfwSwapBuffers(data->main_window.window);
+	}
+	data->last_present_time = glfwGetTime();
+
+	// Optional, used to mark frames during performance profiling.
+	RMLUI_FrameMark;
+}
+
+// Runs idle tasks until shortly before the next frame must start so that it is presented at the following vertical sync.
+static void RunIdleTasks(bool frame_pending)
+{
+	if (!data->idle_tasks.HasPendingTasks())
+		return;
+
+	const double current_time = glfwGetTime();
+	const double period = data->refresh_period;
+	const double since_present = current_time - data->last_present_time;
+	const double next_vsync = data->last_present_time + (std::floor(since_present / period) + 1.0) * period;
+	const double budget = next_vsync - current_time - data->frame_work_estimate - IDLE_TASK_SAFETY_MARGIN;
+
+	// When no frame has been presented for a while, nothing is waiting on the deadline, let tasks longer than any frame budget run then.
+	const bool idle = (!frame_pending && since_present > IDLE_OVERSIZED_DELAY);
+
+	// Such periods never come while rendering continuously. Then these tasks are let through right after a present, where the most time
+	// is left until the next one, at most once every IDLE_OVERSIZED_DELAY and at the cost of an occasional late frame.
+	const bool frame_start = (since_present < 0.5 * period);
+	const bool oversized_due = (frame_pending && frame_start && current_time - data->last_oversized_task_time >= IDLE_OVERSIZED_DELAY &&
+		data->idle_tasks.HasOversizedTasks(budget));
+
+	const bool allow_oversized = (idle || oversized_due);
+	if (budget > 0.0 || allow_oversized)
+	{
+		const size_t num_oversized_slices = data->idle_tasks.GetStatistics().num_oversized_slices;
+		data->idle_tasks.Run(budget, allow_oversized);
+		if (data->idle_tasks.GetStatistics().num_oversized_slices != num_oversized_slices)
+			data->last_oversized_task_time = glfwGetTime();
+	}
+}
 
+static void SetWindowHints(bool allow_resize, bool visible)
+{
 	// Set window hints for OpenGL 3.3 Core context creation.
 	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
 	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
@@ -76,9 +190,60 @@ bool Backend::Initialize(const char* name, int width, int height, bool allow_res
 
 	// Apply window properties and create it.
 	glfwWindowHint(GLFW_RESIZABLE, allow_resize ? GLFW_TRUE : GLFW_FALSE);
+	glfwWindowHint(GLFW_VISIBLE, visible ? GLFW_TRUE : GLFW_FALSE);
 	glfwWindowHint(GLFW_SCALE_TO_MONITOR, GLFW_TRUE);
 
     glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+}
+
+// Returns true if the context of the window must be rendered, the conditions are described with Backend::ShouldRender().
+static bool UpdateRenderState(WindowData& window_data, Rml::Context* context, bool requested, double current_time)
+{
+	const double next_update_delay = context->GetNextUpdateDelay();
+	const bool input = window_data.input_received;
+	// The context asked to be updated again by now, or during this update, such as for animations, transitions, and the caret blink.
+	const bool update_due = (current_time >= window_data.update_deadline || next_update_delay <= 0.0);
+
+	window_data.input_received = false;
+	window_data.update_deadline = current_time + next_update_delay;
+
+	Backend::LoopStatistics& stats = data->loop_statistics;
+	if (requested)
+		stats.num_requested_wakeups += 1;
+	else if (input)
+		stats.num_input_wakeups += 1;
+	else if (update_due)
+		stats.num_update_wakeups += 1;
+
+	return (requested || input || update_due);
+}
+
+// Applies the latest framebuffer size reported during polling, and submits the coalesced cursor position.
+static void ApplyWindowEvents(WindowData& window_data)
+{
+	if (window_data.framebuffer_size_dirty)
+	{
+		window_data.framebuffer_size_dirty = false;
+		data->loop_statistics.num_resizes_applied += 1;
+		if (&window_data == &data->main_window)
+			data->render_interface.SetViewport(window_data.pending_framebuffer_size.x, window_data.pending_framebuffer_size.y);
+		RmlGLFW::ProcessFramebufferSizeCallback(window_data.context, window_data.pending_framebuffer_size.x,
+			window_data.pending_framebuffer_size.y);
+	}
+
+	window_data.mouse_moves.Flush(window_data.context);
+}
+
+bool Backend::Initialize(const char* name, int width, int height, bool allow_resize, bool visible)
+{
+	RMLUI_ASSERT(!data);
+
+	glfwSetErrorCallback(LogErrorFromGLFW);
+
+	if (!glfwInit())
+		return false;
+
+	SetWindowHints(allow_resize, visible);
 
 	GLFWwindow* window = glfwCreateWindow(width, height, name, nullptr, nullptr);
 	if (!window)
@@ -97,13 +262,22 @@ bool Backend::Initialize(const char* name, int width, int height, bool allow_res
 	if (!data || !data->render_interface)
 		return false;
 
-	data->window = window;
+	data->main_window.window = window;
+	glfwSetWindowUserPointer(window, &data->main_window);
 	data->system_interface.SetWindow(window);
+	data->system_interface.SetLogSink(&data->log_sink);
+	data->log_sink.InstallCrashHandlers();
 	data->system_interface.LogMessage(Rml::Log::LT_INFO, renderer_message);
 
 	// The window size may have been scaled by DPI settings, get the actual pixel size.
 	glfwGetFramebufferSize(window, &width, &height);
 	data->render_interface.SetViewport(width, height);
+	data->main_window.mouse_moves.SetWindow(window);
+
+	// Idle tasks are scheduled against the refresh rate of the monitor, which is assumed to contain the window.
+	const GLFWvidmode* video_mode = glfwGetVideoMode(glfwGetPrimaryMonitor());
+	if (video_mode && video_mode->refreshRate > 0)
+		data->refresh_period = 1.0 / double(video_mode->refreshRate);
 
 	// Receive num lock and caps lock modifiers for proper handling of numpad inputs in text fields.
 	glfwSetInputMode(window, GLFW_LOCK_KEY_MODS, GLFW_TRUE);
@@ -117,7 +291,10 @@ bool Backend::Initialize(const char* name, int width, int height, bool allow_res
 void Backend::Shutdown()
 {
 	RMLUI_ASSERT(data);
-	glfwDestroyWindow(data->window);
+	data->log_sink.Flush();
+	while (!data->windows.empty())
+		Backend::CloseWindow(data->windows.back()->window);
+	glfwDestroyWindow(data->main_window.window);
 	data.reset();
 	RmlGL3::Shutdown();
 	glfwTerminate();
@@ -146,33 +323,80 @@ bool Backend::ProcessEvents(Rml::Context* context, KeyDownCallback key_down_call
 
 		Rml::Vector2i window_size;
 		float dp_ratio = 1.f;
-		glfwGetFramebufferSize(data->window, &window_size.x, &window_size.y);
-		glfwGetWindowContentScale(data->window, &dp_ratio, nullptr);
+		glfwGetFramebufferSize(data->main_window.window, &window_size.x, &window_size.y);
+		glfwGetWindowContentScale(data->main_window.window, &dp_ratio, nullptr);
 
 		context->SetDimensions(window_size);
 		context->SetDensityIndependentPixelRatio(dp_ratio);
 	}
 
-	data->context = context;
+	data->main_window.context = context;
 	data->key_down_callback = key_down_callback;
 
-	if (power_save)
-		glfwWaitEventsTimeout(Rml::Math::Min(context->GetNextUpdateDelay(), 10.0));
+	// Apply the frame limit before polling, so that the input is as recent as possible when the context is updated.
+	FrameTiming::NewFrame();
+	FrameTiming::WaitForNextFrame();
+
+	const double idle_begin_time = glfwGetTime();
+	if (data->active_begin_time > 0.0)
+		data->loop_statistics.time_active += idle_begin_time - data->active_begin_time;
+
+	// Don't block when a redraw is already pending, otherwise sleep until input arrives or any context needs to be updated again.
+	bool redraw_pending = data->redraw_requested.load();
+	double wait_timeout = Rml::Math::Min(context->GetNextUpdateDelay(), 10.0);
+	for (const Rml::UniquePtr<WindowData>& window_data : data->windows)
+	{
+		if (!window_data->context || !glfwGetWindowAttrib(window_data->window, GLFW_VISIBLE))
+			continue;
+		redraw_pending |= window_data->redraw_requested;
+		wait_timeout = Rml::Math::Min(wait_timeout, window_data->context->GetNextUpdateDelay());
+	}
+
+	// Idle tasks are timed on their own, so that neither the waiting time nor event processing includes them.
+	{
+		FrameTiming::ScopedPhase phase(FrameTiming::Phase::IdleTasks);
+		RunIdleTasks(redraw_pending || !power_save || wait_timeout <= 0.0);
+	}
+
+	FrameTiming::BeginPhase(FrameTiming::Phase::ProcessEvents);
+	const double wait_begin_time = glfwGetTime();
+	data->loop_statistics.time_idle_tasks += wait_begin_time - idle_begin_time;
+
+	// Wake up by the next vertical sync to continue with remaining idle tasks.
+	if (data->idle_tasks.HasPendingTasks())
+		wait_timeout = Rml::Math::Min(wait_timeout, data->refresh_period);
+
+	if (power_save && !redraw_pending)
+		glfwWaitEventsTimeout(wait_timeout);
 	else
 		glfwPollEvents();
 
-	data->context = nullptr;
+	data->active_begin_time = glfwGetTime();
+	data->loop_statistics.time_waiting += data->active_begin_time - wait_begin_time;
+
+	// Apply the final size of a resize first, so that each context is laid out once per frame at most. Cursor movement is coalesced
+	// during the poll, submit the final position now that all events are processed.
+	ApplyWindowEvents(data->main_window);
+	for (const Rml::UniquePtr<WindowData>& window_data : data->windows)
+		ApplyWindowEvents(*window_data);
+
+	// Marks the end of the events of this frame, so that a replay submits the same events together.
+	data->input_recorder.Record(InputReplay::EventType::Frame, 0, 0, 0);
+
+	FrameTiming::EndPhase(FrameTiming::Phase::ProcessEvents);
+
+	data->main_window.context = nullptr;
 	data->key_down_callback = nullptr;
 
-	const bool result = !glfwWindowShouldClose(data->window);
-	glfwSetWindowShouldClose(data->window, GLFW_FALSE);
+	const bool result = !glfwWindowShouldClose(data->main_window.window);
+	glfwSetWindowShouldClose(data->main_window.window, GLFW_FALSE);
 	return result;
 }
 
 void Backend::RequestExit()
 {
 	RMLUI_ASSERT(data);
-	glfwSetWindowShouldClose(data->window, GLFW_TRUE);
+	glfwSetWindowShouldClose(data->main_window.window, GLFW_TRUE);
 }
 
 void Backend::BeginFrame()
@@ -185,17 +409,226 @@ void Backend::BeginFrame()
 void Backend::PresentFrame()
 {
 	RMLUI_ASSERT(data);
-	data->render_interface.EndFrame();
-	glfwSwapBuffers(data->window);
+	{
+		FrameTiming::ScopedPhase phase(FrameTiming::Phase::EndFrame);
+		data->render_interface.EndFrame();
+	}
+	SwapMainWindow();
+}
 
-	// Optional, used to mark frames during performance profiling.
-	RMLUI_FrameMark;
+void Backend::BeginHostFrame()
+{
+	RMLUI_ASSERT(data);
+	data->render_interface.Clear();
+	data->render_interface.BeginHostFrame();
+}
+
+void Backend::PresentHostFrame()
+{
+	RMLUI_ASSERT(data);
+	{
+		FrameTiming::ScopedPhase phase(FrameTiming::Phase::EndFrame);
+		data->render_interface.EndHostFrame();
+	}
+	SwapMainWindow();
+}
+
+bool Backend::ShouldRender(Rml::Context* context)
+{
+	RMLUI_ASSERT(data && context);
+
+	Backend::LoopStatistics& stats = data->loop_statistics;
+	stats.num_iterations += 1;
+
+	const bool render = UpdateRenderState(data->main_window, context, data->redraw_requested.exchange(false), glfwGetTime());
+
+	if (render)
+		stats.num_rendered_frames += 1;
+	else
+		stats.num_idle_frames += 1;
+
+	return render;
+}
+
+void Backend::SubmitIdleTask(const Rml::String& name, IdleTaskScheduler::Task task, IdleTaskScheduler::Budget budget, double expected_cost)
+{
+	RMLUI_ASSERT(data);
+	data->idle_tasks.Submit(name, std::move(task), budget, expected_cost);
+}
+
+Rml::StringList Backend::GetPendingIdleTasks()
+{
+	RMLUI_ASSERT(data);
+	return data->idle_tasks.GetPendingTaskNames();
+}
+
+const IdleTaskScheduler::Statistics& Backend::GetIdleTaskStatistics()
+{
+	RMLUI_ASSERT(data);
+	return data->idle_tasks.GetStatistics();
+}
+
+void Backend::RequestRedraw()
+{
+	RMLUI_ASSERT(data);
+	data->redraw_requested.store(true);
+	glfwPostEmptyEvent();
+}
+
+const Backend::LoopStatistics& Backend::GetLoopStatistics()
+{
+	RMLUI_ASSERT(data);
+	return data->loop_statistics;
+}
+
+AsyncLogSink::Statistics Backend::GetLogStatistics()
+{
+	RMLUI_ASSERT(data);
+	return data->log_sink.GetStatistics();
+}
+
+const MouseMoveCoalescer_GLFW::Statistics& Backend::GetMouseMoveStatistics()
+{
+	RMLUI_ASSERT(data);
+	return data->main_window.mouse_moves.GetStatistics();
 }
 
 GLFWwindow* Backend::GetWindow()
 {
 	RMLUI_ASSERT(data);
-	return data->window;
+	return data->main_window.window;
+}
+
+void Backend::StartInputRecording()
+{
+	RMLUI_ASSERT(data);
+
+	Rml::Vector2i window_size, framebuffer_size;
+	glfwGetWindowSize(data->main_window.window, &window_size.x, &window_size.y);
+	glfwGetFramebufferSize(data->main_window.window, &framebuffer_size.x, &framebuffer_size.y);
+	float content_scale = 1.f;
+	glfwGetWindowContentScale(data->main_window.window, &content_scale, nullptr);
+	data->input_recorder.Start(window_size, framebuffer_size, content_scale);
+}
+
+bool Backend::StopInputRecording(const Rml::String& path)
+{
+	RMLUI_ASSERT(data);
+	if (!data->input_recorder.IsRecording())
+		return false;
+
+	data->input_recorder.Stop();
+	return InputReplay::Save(path, data->input_recorder.GetEvents());
+}
+
+GLFWwindow* Backend::OpenWindow(const char* name, int width, int height, bool allow_resize)
+{
+	RMLUI_ASSERT(data);
+
+	// Share the GL objects of the main window, so that programs, textures and geometry are created only once for all windows.
+	SetWindowHints(allow_resize, true);
+	GLFWwindow* window = glfwCreateWindow(width, height, name, nullptr, data->main_window.window);
+	if (!window)
+		return nullptr;
+
+	Rml::UniquePtr<WindowData> window_data = Rml::MakeUnique<WindowData>();
+	window_data->window = window;
+	window_data->mouse_moves.SetWindow(window);
+
+	// Only the main window waits for vertical sync, additional windows present without blocking so that they do not divide the frame
+	// rate of the main loop between them.
+	glfwMakeContextCurrent(window);
+	glfwSwapInterval(0);
+	window_data->surface = data->render_interface.CreateSurface();
+	glfwMakeContextCurrent(data->main_window.window);
+
+	glfwSetWindowUserPointer(window, window_data.get());
+	glfwSetInputMode(window, GLFW_LOCK_KEY_MODS, GLFW_TRUE);
+	SetupCallbacks(window);
+
+	// Closing an additional window only hides it, the application decides when to close it.
+	glfwSetWindowCloseCallback(window, [](GLFWwindow* closed_window) {
+		glfwSetWindowShouldClose(closed_window, GLFW_FALSE);
+		glfwHideWindow(closed_window);
+	});
+
+	data->windows.push_back(std::move(window_data));
+	return window;
+}
+
+void Backend::CloseWindow(GLFWwindow* window)
+{
+	RMLUI_ASSERT(data);
+
+	auto it = std::find_if(data->windows.begin(), data->windows.end(),
+		[window](const Rml::UniquePtr<WindowData>& window_data) { return window_data->window == window; });
+	if (it == data->windows.end())
+		return;
+
+	glfwMakeContextCurrent(window);
+	data->render_interface.ReleaseSurface((*it)->surface);
+	glfwMakeContextCurrent(data->main_window.window);
+
+	glfwDestroyWindow(window);
+	data->windows.erase(it);
+}
+
+void Backend::SetWindowContext(GLFWwindow* window, Rml::Context* context)
+{
+	RMLUI_ASSERT(data && window != data->main_window.window);
+
+	WindowData& window_data = GetWindowData(window);
+	window_data.context = context;
+	window_data.redraw_requested = true;
+
+	if (context)
+	{
+		Rml::Vector2i framebuffer_size;
+		float dp_ratio = 1.f;
+		glfwGetFramebufferSize(window, &framebuffer_size.x, &framebuffer_size.y);
+		glfwGetWindowContentScale(window, &dp_ratio, nullptr);
+
+		context->SetDimensions(framebuffer_size);
+		context->SetDensityIndependentPixelRatio(dp_ratio);
+	}
+}
+
+void Backend::RenderWindows()
+{
+	RMLUI_ASSERT(data);
+
+	const double current_time = glfwGetTime();
+	bool context_switched = false;
+
+	for (const Rml::UniquePtr<WindowData>& window_data : data->windows)
+	{
+		if (!window_data->context || !glfwGetWindowAttrib(window_data->window, GLFW_VISIBLE))
+			continue;
+
+		const bool requested = window_data->redraw_requested;
+		window_data->redraw_requested = false;
+		if (!UpdateRenderState(*window_data, window_data->context, requested, current_time))
+			continue;
+
+		Rml::Vector2i framebuffer_size;
+		glfwGetFramebufferSize(window_data->window, &framebuffer_size.x, &framebuffer_size.y);
+		if (framebuffer_size.x <= 0 || framebuffer_size.y <= 0)
+			continue;
+
+		glfwMakeContextCurrent(window_data->window);
+		context_switched = true;
+
+		data->render_interface.Clear();
+		data->render_interface.BeginSurfaceFrame(window_data->surface, framebuffer_size.x, framebuffer_size.y);
+		window_data->context->Render();
+		data->render_interface.EndSurfaceFrame();
+
+		glfwSwapBuffers(window_data->window);
+		data->loop_statistics.num_window_frames += 1;
+	}
+
+	if (context_switched)
+		glfwMakeContextCurrent(data->main_window.window);
 }
 
 static void SetupCallbacks(GLFWwindow* window)
@@ -203,15 +636,20 @@ static void SetupCallbacks(GLFWwindow* window)
 	RMLUI_ASSERT(data);
 
 	// Key input
-	glfwSetKeyCallback(window, [](GLFWwindow* /*window*/, int glfw_key, int /*scancode*/, int glfw_action, int glfw_mods) {
-		if (!data->context)
+	glfwSetKeyCallback(window, [](GLFWwindow* window, int glfw_key, int /*scancode*/, int glfw_action, int glfw_mods) {
+		WindowData& window_data = GetWindowData(window);
+		RecordInput(window_data, InputReplay::EventType::Key, glfw_key, glfw_action, glfw_mods);
+		if (!window_data.context)
 			return;
 
+		window_data.mouse_moves.Flush(window_data.context);
+		window_data.input_received = true;
+
 		// Store the active modifiers for later because GLFW doesn't provide them in the callbacks to the mouse input events.
-		data->glfw_active_modifiers = glfw_mods;
+		window_data.glfw_active_modifiers = glfw_mods;
 
 		// Override the default key event callback to add global shortcuts for the samples.
-		Rml::Context* context = data->context;
+		Rml::Context* context = window_data.context;
 		KeyDownCallback key_down_callback = data->key_down_callback;
 
 		switch (glfw_action)
@@ -222,7 +660,7 @@ static void SetupCallbacks(GLFWwindow* window)
 			const Rml::Input::KeyIdentifier key = RmlGLFW::ConvertKey(glfw_key);
 			const int key_modifier = RmlGLFW::ConvertKeyModifiers(glfw_mods);
 			float dp_ratio = 1.f;
-			glfwGetWindowContentScale(data->window, &dp_ratio, nullptr);
+			glfwGetWindowContentScale(window, &dp_ratio, nullptr);
 
 			// See if we have any global shortcuts that take priority over the context.
 			if (key_down_callback && !key_down_callback(context, key, key_modifier, dp_ratio, true))
@@ -239,30 +677,71 @@ static void SetupCallbacks(GLFWwindow* window)
 		}
 	});
 
-	glfwSetCharCallback(window, [](GLFWwindow* /*window*/, unsigned int codepoint) { RmlGLFW::ProcessCharCallback(data->context, codepoint); });
+	glfwSetCharCallback(window, [](GLFWwindow* window, unsigned int codepoint) {
+		WindowData& window_data = GetWindowData(window);
+		RecordInput(window_data, InputReplay::EventType::Char, (int)codepoint, 0, 0);
+		window_data.mouse_moves.Flush(window_data.context);
+		window_data.input_received = true;
+		RmlGLFW::ProcessCharCallback(window_data.context, codepoint);
+	});
 
-	glfwSetCursorEnterCallback(window, [](GLFWwindow* /*window*/, int entered) { RmlGLFW::ProcessCursorEnterCallback(data->context, entered); });
+	glfwSetCursorEnterCallback(window, [](GLFWwindow* window, int entered) {
+		WindowData& window_data = GetWindowData(window);
+		RecordInput(window_data, InputReplay::EventType::CursorEnter, entered, 0, 0);
+		window_data.mouse_moves.Flush(window_data.context);
+		window_data.input_received = true;
+		RmlGLFW::ProcessCursorEnterCallback(window_data.context, entered);
+	});
 
-	// Mouse input
+	// Mouse input, cursor movement is only recorded here and submitted before the next event or at the end of the poll.
 	glfwSetCursorPosCallback(window, [](GLFWwindow* window, double xpos, double ypos) {
-		RmlGLFW::ProcessCursorPosCallback(data->context, window, xpos, ypos, data->glfw_active_modifiers);
+		WindowData& window_data = GetWindowData(window);
+		RecordInput(window_data, InputReplay::EventType::CursorPos, 0, 0, window_data.glfw_active_modifiers, xpos, ypos);
+		window_data.mouse_moves.QueueMove(xpos, ypos, window_data.glfw_active_modifiers);
+		window_data.input_received = true;
 	});
 
-	glfwSetMouseButtonCallback(window, [](GLFWwindow* /*window*/, int button, int action, int mods) {
-		data->glfw_active_modifiers = mods;
-		RmlGLFW::ProcessMouseButtonCallback(data->context, button, action, mods);
+	glfwSetMouseButtonCallback(window, [](GLFWwindow* window, int button, int action, int mods) {
+		WindowData& window_data = GetWindowData(window);
+		RecordInput(window_data, InputReplay::EventType::MouseButton, button, action, mods);
+		window_data.mouse_moves.Flush(window_data.context);
+		window_data.input_received = true;
+		window_data.glfw_active_modifiers = mods;
+		RmlGLFW::ProcessMouseButtonCallback(window_data.context, button, action, mods);
 	});
 
-	glfwSetScrollCallback(window, [](GLFWwindow* /*window*/, double /*xoffset*/, double yoffset) {
-		RmlGLFW::ProcessScrollCallback(data->context, yoffset, data->glfw_active_modifiers);
+	glfwSetScrollCallback(window, [](GLFWwindow* window, double xoffset, double yoffset) {
+		WindowData& window_data = GetWindowData(window);
+		RecordInput(window_data, InputReplay::EventType::Scroll, 0, 0, window_data.glfw_active_modifiers, xoffset, yoffset);
+		window_data.mouse_moves.Flush(window_data.context);
+		window_data.input_received = true;
+		RmlGLFW::ProcessScrollCallback(window_data.context, yoffset, window_data.glfw_active_modifiers);
 	});
 
 	// Window events
-	glfwSetFramebufferSizeCallback(window, [](GLFWwindow* /*window*/, int width, int height) {
-		data->render_interface.SetViewport(width, height);
-		RmlGLFW::ProcessFramebufferSizeCallback(data->context, width, height);
+	glfwSetWindowSizeCallback(window, [](GLFWwindow* window, int width, int height) {
+		WindowData& window_data = GetWindowData(window);
+		RecordInput(window_data, InputReplay::EventType::WindowSize, 0, 0, 0, width, height);
+		window_data.mouse_moves.SetWindowSize(width, height);
+	});
+
+	glfwSetFramebufferSizeCallback(window, [](GLFWwindow* window, int width, int height) {
+		WindowData& window_data = GetWindowData(window);
+		RecordInput(window_data, InputReplay::EventType::FramebufferSize, 0, 0, 0, width, height);
+		window_data.mouse_moves.SetFramebufferSize(width, height);
+		window_data.pending_framebuffer_size = Rml::Vector2i(width, height);
+		window_data.framebuffer_size_dirty = true;
+		data->loop_statistics.num_resize_events += 1;
+		RequestWindowRedraw(window_data);
+	});
+
+	glfwSetWindowContentScaleCallback(window, [](GLFWwindow* window, float xscale, float /*yscale*/) {
+		WindowData& window_data = GetWindowData(window);
+		RecordInput(window_data, InputReplay::EventType::ContentScale, 0, 0, 0, xscale);
+		RequestWindowRedraw(window_data);
+		RmlGLFW::ProcessContentScaleCallback(window_data.context, xscale);
 	});
 
-	glfwSetWindowContentScaleCallback(window,
-		[](GLFWwindow* /*window*/, float xscale, float /*yscale*/) { RmlGLFW::ProcessContentScaleCallback(data->context, xscale); });
+	// The window contents were damaged, e.g. after being uncovered or restored, and must be drawn again even if nothing changed.
+	glfwSetWindowRefreshCallback(window, [](GLFWwindow* window) { RequestWindowRedraw(GetWindowData(window)); });
 }
@@ -27,6 +27,7 @@
  */
 
 #include "RmlUi_Platform_GLFW.h"
+#include "AsyncLogSink.h"
 #include <RmlUi/Core/Context.h>
 #include <RmlUi/Core/Input.h>
 #include <RmlUi/Core/Math.h>
@@ -68,11 +69,25 @@ void SystemInterface_GLFW::SetWindow(GLFWwindow* in_window)
 	window = in_window;
 }
 
+void SystemInterface_GLFW::SetLogSink(AsyncLogSink* in_log_sink)
+{
+	log_sink = in_log_sink;
+}
+
 double SystemInterface_GLFW::GetElapsedTime()
 {
 	return glfwGetTime();
 }
 
+bool SystemInterface_GLFW::LogMessage(Rml::Log::Type type, const Rml::String& message)
+{
+	if (!log_sink)
+		return Rml::SystemInterface::LogMessage(type, message);
+
+	log_sink->Write(type, message);
+	return true;
+}
+
 void SystemInterface_GLFW::SetMouseCursor(const Rml::String& cursor_name)
 {
 	GLFWcursor* cursor = nullptr;
@@ -110,6 +125,44 @@ void SystemInterface_GLFW::GetClipboardText(Rml::String& text)
 		text = Rml::String(glfwGetClipboardString(window));
 }
 
+void MouseMoveCoalescer_GLFW::SetWindow(GLFWwindow* window)
+{
+	glfwGetWindowSize(window, &window_size.x, &window_size.y);
+	glfwGetFramebufferSize(window, &framebuffer_size.x, &framebuffer_size.y);
+}
+
+void MouseMoveCoalescer_GLFW::SetWindowSize(int width, int height)
+{
+	window_size = Rml::Vector2i(width, height);
+}
+
+void MouseMoveCoalescer_GLFW::SetFramebufferSize(int width, int height)
+{
+	framebuffer_size = Rml::Vector2i(width, height);
+}
+
+void MouseMoveCoalescer_GLFW::QueueMove(double xpos, double ypos, int mods)
+{
+	move_pending = true;
+	pending_xpos = xpos;
+	pending_ypos = ypos;
+	pending_mods = mods;
+	statistics.num_raw_moves += 1;
+}
+
+bool MouseMoveCoalescer_GLFW::Flush(Rml::Context* context)
+{
+	if (!move_pending)
+		return true;
+
+	move_pending = false;
+	if (!context)
+		return true;
+
+	statistics.num_dispatched_moves += 1;
+	return RmlGLFW::ProcessCursorPosCallback(context, window_size, framebuffer_size, pending_xpos, pending_ypos, pending_mods);
+}
+
 bool RmlGLFW::ProcessKeyCallback(Rml::Context* context, int key, int action, int mods)
 {
 	if (!context)
@@ -151,6 +204,19 @@ bool RmlGLFW::ProcessCursorEnterCallback(Rml::Context* context, int entered)
 }
 
 bool RmlGLFW::ProcessCursorPosCallback(Rml::Context* context, GLFWwindow* window, double xpos, double ypos, int mods)
+{
+	if (!context)
+		return true;
+
+	Rml::Vector2i window_size, framebuffer_size;
+	glfwGetWindowSize(window, &window_size.x, &window_size.y);
+	glfwGetFramebufferSize(window, &framebuffer_size.x, &framebuffer_size.y);
+
+	return ProcessCursorPosCallback(context, window_size, framebuffer_size, xpos, ypos, mods);
+}
+
+bool RmlGLFW::ProcessCursorPosCallback(Rml::Context* context, Rml::Vector2i window_size, Rml::Vector2i framebuffer_size, double xpos, double ypos,
+	int mods)
 {
 	if (!context)
 		return true;
@@ -158,9 +224,9 @@ bool RmlGLFW::ProcessCursorPosCallback(Rml::Context* context, GLFWwindow* window
 	using Rml::Vector2i;
 	using Vector2d = Rml::Vector2<double>;
 
-	Vector2i window_size, framebuffer_size;
-	glfwGetWindowSize(window, &window_size.x, &window_size.y);
-	glfwGetFramebufferSize(window, &framebuffer_size.x, &framebuffer_size.y);
+	// A minimized window may report a zero size.
+	if (window_size.x <= 0 || window_size.y <= 0)
+		return true;
 
 	// Convert from mouse position in GLFW screen coordinates to framebuffer coordinates (pixels) used by RmlUi.
 	const Vector2d mouse_pos = Vector2d(xpos, ypos) * (Vector2d(framebuffer_size) / Vector2d(window_size));
@@ -34,6 +34,8 @@
 #include <RmlUi/Core/Types.h>
 #include <GLFW/glfw3.h>
 
+class AsyncLogSink;
+
 class SystemInterface_GLFW : public Rml::SystemInterface {
 public:
 	SystemInterface_GLFW();
@@ -41,11 +43,15 @@ public:
 
 	// Optionally, provide or change the window to be used for setting the mouse cursors and clipboard text.
 	void SetWindow(GLFWwindow* window);
+	// Optionally, route log messages through a sink which writes them from a background thread.
+	void SetLogSink(AsyncLogSink* log_sink);
 
 	// -- Inherited from Rml::SystemInterface  --
 
 	double GetElapsedTime() override;
 
+	bool LogMessage(Rml::Log::Type type, const Rml::String& message) override;
+
 	void SetMouseCursor(const Rml::String& cursor_name) override;
 
 	void SetClipboardText(const Rml::String& text) override;
@@ -53,6 +59,7 @@ public:
 
 private:
 	GLFWwindow* window = nullptr;
+	AsyncLogSink* log_sink = nullptr;
 
 	GLFWcursor* cursor_pointer = nullptr;
 	GLFWcursor* cursor_cross = nullptr;
@@ -62,6 +69,44 @@ private:
 	GLFWcursor* cursor_unavailable = nullptr;
 };
 
+/**
+    Coalesces cursor movement of a window into a single mouse move per batch of events.
+
+    Cursor positions are only recorded as they arrive, and dispatched to the context with the final position when flushed. The pending
+    move should be flushed before any other input event is submitted so that ordering is preserved, e.g. a click is applied at the
+    position the cursor had when the button was pressed, and once more after all events of a poll have been processed. The window and
+    framebuffer sizes used to convert the position to pixels are cached, and should be kept updated from the size callbacks.
+ */
+class MouseMoveCoalescer_GLFW {
+public:
+	struct Statistics {
+		size_t num_raw_moves;        // Cursor position events received from GLFW.
+		size_t num_dispatched_moves; // Mouse moves submitted to the context.
+	};
+
+	// Initializes the cached metrics by querying the window.
+	void SetWindow(GLFWwindow* window);
+	void SetWindowSize(int width, int height);
+	void SetFramebufferSize(int width, int height);
+
+	// Records the cursor position in GLFW screen coordinates, replacing any pending position.
+	void QueueMove(double xpos, double ypos, int mods);
+	// Submits the pending move to the context, if any. Returns true if the event is propagating, i.e. was not handled by the context.
+	bool Flush(Rml::Context* context);
+
+	const Statistics& GetStatistics() const { return statistics; }
+
+private:
+	Rml::Vector2i window_size = {1, 1};
+	Rml::Vector2i framebuffer_size = {1, 1};
+
+	bool move_pending = false;
+	double pending_xpos = 0.0, pending_ypos = 0.0;
+	int pending_mods = 0;
+
+	Statistics statistics = {};
+};
+
 /**
     Optional helper functions for the GLFW plaform.
  */
@@ -74,6 +119,8 @@ bool ProcessKeyCallback(Rml::Context* context, int key, int action, int mods);
 bool ProcessCharCallback(Rml::Context* context, unsigned int codepoint);
 bool ProcessCursorEnterCallback(Rml::Context* context, int entered);
 bool ProcessCursorPosCallback(Rml::Context* context, GLFWwindow* window, double xpos, double ypos, int mods);
+// Same as above, using window and framebuffer sizes known by the caller instead of querying them from the window.
+bool ProcessCursorPosCallback(Rml::Context* context, Rml::Vector2i window_size, Rml::Vector2i framebuffer_size, double xpos, double ypos, int mods);
 bool ProcessMouseButtonCallback(Rml::Context* context, int button, int action, int mods);
 bool ProcessScrollCallback(Rml::Context* context, double yoffset, int mods);
 void ProcessFramebufferSizeCallback(Rml::Context* context, int width, int height);
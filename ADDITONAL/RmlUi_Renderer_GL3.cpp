@@ -27,6 +27,8 @@
  */
 
 #include "RmlUi_Renderer_GL3.h"
+#include "BakedTexture.h"
+#include <RmlUi/Core/Context.h>
 #include <RmlUi/Core/Core.h>
 #include <RmlUi/Core/DecorationTypes.h>
 #include <RmlUi/Core/FileInterface.h>
@@ -35,6 +37,8 @@
 #include <RmlUi/Core/MeshUtilities.h>
 #include <RmlUi/Core/Platform.h>
 #include <RmlUi/Core/SystemInterface.h>
+#include <algorithm>
+#include <chrono>
 #include <string.h>
 
 #if defined(RMLUI_PLATFORM_WIN32) && !defined(__MINGW32__)
@@ -56,8 +60,24 @@
 	#include "RmlUi_Include_GL3.h"
 #endif
 
-// Determines the anti-aliasing quality when creating layers. Enables better-looking visuals, especially when transforms are applied.
-static constexpr int NUM_MSAA_SAMPLES = 2;
+// Render quality levels selected by the adaptive quality controller, from lowest to highest. Multisampling determines the anti-aliasing
+// quality when creating layers, and enables better-looking visuals especially when transforms are applied. The default level renders
+// layers at full resolution with 2x MSAA.
+static const RenderInterface_GL3::RenderQuality render_quality_levels[] = {
+	{0, 2, 0.5f},
+	{0, 1, 0.75f},
+	{0, 0, 1.f},
+	{2, 0, 1.f},
+	{4, 0, 1.f},
+	{8, 0, 1.f},
+};
+static constexpr int NUM_RENDER_QUALITY_LEVELS = int(sizeof(render_quality_levels) / sizeof(render_quality_levels[0]));
+static constexpr int DEFAULT_RENDER_QUALITY_LEVEL = 3;
+
+// Layer framebuffers are allocated in multiples of this size while the window is being resized, and recreated at the exact size once
+// the size has stayed the same for the settle time.
+static constexpr int RESIZE_BUCKET_SIZE = 256;
+static constexpr double RESIZE_SETTLE_TIME = 0.5;
 
 #define MAX_NUM_STOPS 16
 #define BLUR_SIZE 7
@@ -69,9 +89,16 @@ static constexpr int NUM_MSAA_SAMPLES = 2;
 #define RMLUI_SHADER_HEADER \
 	RMLUI_SHADER_HEADER_VERSION "#define MAX_NUM_STOPS " RMLUI_STRINGIFY(MAX_NUM_STOPS) "\n#line " RMLUI_STRINGIFY(__LINE__) "\n"
 
-static const char* shader_vert_main = RMLUI_SHADER_HEADER R"(
+// Data shared by all programs, stored in a uniform buffer which is updated once per change instead of once per program.
+// Must match the layout of Gfx::SharedUniformData.
+#define RMLUI_SHADER_SHARED_UNIFORMS \
+	"layout(std140) uniform SharedUniforms {\n" \
+	"	mat4 _transform;    // Projection multiplied by the current transform.\n" \
+	"	vec2 _viewportSize; // Viewport size in pixels.\n" \
+	"};\n"
+
+static const char* shader_vert_main = RMLUI_SHADER_HEADER RMLUI_SHADER_SHARED_UNIFORMS R"(
 uniform vec2 _translate;
-uniform mat4 _transform;
 
 in vec2 inPosition;
 in vec4 inColor0;
@@ -90,6 +117,27 @@ void main() {
     gl_Position = outPos;
 }
 )";
+static const char* shader_vert_instanced = RMLUI_SHADER_HEADER RMLUI_SHADER_SHARED_UNIFORMS R"(
+uniform vec2 _translate;
+
+in vec2 inPosition; // Unit quad corner.
+in vec4 inColor0;
+in vec4 inRect;     // Per instance: top-left position, size.
+in vec4 inTexRect;  // Per instance: top-left texture coordinates, bottom-right texture coordinates.
+
+out vec2 fragTexCoord;
+out vec4 fragColor;
+
+void main() {
+	fragTexCoord = mix(inTexRect.xy, inTexRect.zw, inPosition);
+	fragColor = inColor0;
+
+	vec2 translatedPos = inRect.xy + inPosition * inRect.zw + _translate;
+	vec4 outPos = _transform * vec4(translatedPos, 0.0, 1.0);
+
+    gl_Position = outPos;
+}
+)";
 static const char* shader_frag_texture = RMLUI_SHADER_HEADER R"(
 uniform sampler2D _tex;
 in vec2 fragTexCoord;
@@ -311,6 +359,7 @@ enum class ProgramId {
 	None,
 	Color,
 	Texture,
+	TextureInstanced,
 	Gradient,
 	Creation,
 	Passthrough,
@@ -322,6 +371,7 @@ enum class ProgramId {
 };
 enum class VertShaderId {
 	Main,
+	Instanced,
 	Passthrough,
 	Blur,
 	Count,
@@ -340,7 +390,6 @@ enum class FragShaderId {
 };
 enum class UniformId {
 	Translate,
-	Transform,
 	Tex,
 	Color,
 	ColorMatrix,
@@ -362,12 +411,12 @@ enum class UniformId {
 
 namespace Gfx {
 
-static const char* const program_uniform_names[(size_t)UniformId::Count] = {"_translate", "_transform", "_tex", "_color", "_color_matrix",
+static const char* const program_uniform_names[(size_t)UniformId::Count] = {"_translate", "_tex", "_color", "_color_matrix",
 	"_texelOffset", "_texCoordMin", "_texCoordMax", "_texMask", "_weights[0]", "_func", "_p", "_v", "_stop_colors[0]", "_stop_positions[0]",
 	"_num_stops", "_value", "_dimensions"};
 
-enum class VertexAttribute { Position, Color0, TexCoord0, Count };
-static const char* const vertex_attribute_names[(size_t)VertexAttribute::Count] = {"inPosition", "inColor0", "inTexCoord0"};
+enum class VertexAttribute { Position, Color0, TexCoord0, InstanceRect, InstanceTexRect, Count };
+static const char* const vertex_attribute_names[(size_t)VertexAttribute::Count] = {"inPosition", "inColor0", "inTexCoord0", "inRect", "inTexRect"};
 
 struct VertShaderDefinition {
 	VertShaderId id;
@@ -389,6 +438,7 @@ struct ProgramDefinition {
 // clang-format off
 static const VertShaderDefinition vert_shader_definitions[] = {
 	{VertShaderId::Main,        "main",         shader_vert_main},
+	{VertShaderId::Instanced,   "instanced",    shader_vert_instanced},
 	{VertShaderId::Passthrough, "passthrough",  shader_vert_passthrough},
 	{VertShaderId::Blur,        "blur",         shader_vert_blur},
 };
@@ -406,6 +456,7 @@ static const FragShaderDefinition frag_shader_definitions[] = {
 static const ProgramDefinition program_definitions[] = {
 	{ProgramId::Color,       "color",        VertShaderId::Main,        FragShaderId::Color},
 	{ProgramId::Texture,     "texture",      VertShaderId::Main,        FragShaderId::Texture},
+	{ProgramId::TextureInstanced, "texture_instanced", VertShaderId::Instanced, FragShaderId::Texture},
 	{ProgramId::Gradient,    "gradient",     VertShaderId::Main,        FragShaderId::Gradient},
 	{ProgramId::Creation,    "creation",     VertShaderId::Main,        FragShaderId::Creation},
 	{ProgramId::Passthrough, "passthrough",  VertShaderId::Passthrough, FragShaderId::Passthrough},
@@ -442,19 +493,30 @@ using FragShaders = EnumArray<GLuint, FragShaderId>;
 
 class Uniforms {
 public:
-	GLint Get(ProgramId id, UniformId uniform) const
+	Uniforms()
 	{
-		auto it = map.find(ToKey(id, uniform));
-		if (it != map.end())
-			return it->second;
-		return -1;
+		for (size_t id = 0; id < (size_t)ProgramId::Count; id++)
+		{
+			for (size_t uniform = 0; uniform < (size_t)UniformId::Count; uniform++)
+				locations[ProgramId(id)][UniformId(uniform)] = -1;
+		}
 	}
-	void Insert(ProgramId id, UniformId uniform, GLint location) { map[ToKey(id, uniform)] = location; }
+	GLint Get(ProgramId id, UniformId uniform) const { return locations[id][uniform]; }
+	void Insert(ProgramId id, UniformId uniform, GLint location) { locations[id][uniform] = location; }
 
 private:
-	using Key = uint64_t;
-	Key ToKey(ProgramId id, UniformId uniform) const { return (static_cast<Key>(id) << 32) | static_cast<Key>(uniform); }
-	Rml::UnorderedMap<Key, GLint> map;
+	EnumArray<EnumArray<GLint, UniformId>, ProgramId> locations;
+};
+
+// Binding point of the shared uniform buffer, matches the 'SharedUniforms' block in the shaders.
+static constexpr GLuint SharedUniformsBinding = 0;
+static const char* const shared_uniforms_block_name = "SharedUniforms";
+
+// Layout of the 'SharedUniforms' block following the std140 rules.
+struct SharedUniformData {
+	float transform[16];
+	float viewport_size[2];
+	float padding[2];
 };
 
 struct ProgramData {
@@ -471,8 +533,28 @@ struct CompiledGeometryData {
 	GLsizei draw_count;
 };
 
+// Unit quad geometry with a streamed per-instance attribute buffer, see RenderInterface_GL3::RenderQuadInstances().
+struct QuadInstanceBufferData {
+	GLuint vao;
+	GLuint quad_vbo;
+	GLuint quad_ibo;
+	GLuint instance_vbo;
+};
+
+struct TextureData {
+	GLuint texture_id; // Zero while evicted.
+	Rml::Vector2i dimensions;
+	int num_levels;
+	size_t byte_size;
+	Rml::String source; // Empty for generated textures, which cannot be reloaded and are therefore never evicted.
+	uint64_t last_used_frame;
+	bool reload_failed;
+};
+
 struct FramebufferData {
+	// The rendered area, which can be smaller than the allocated storage while the window is being resized.
 	int width, height;
+	int storage_width, storage_height;
 	GLuint framebuffer;
 	GLuint color_tex_buffer;
 	GLuint color_render_buffer;
@@ -570,6 +652,10 @@ static bool CreateProgram(GLuint& out_program, Uniforms& inout_uniform_map, Prog
 
 	out_program = id;
 
+	const GLuint shared_uniforms_index = glGetUniformBlockIndex(id, shared_uniforms_block_name);
+	if (shared_uniforms_index != GL_INVALID_INDEX)
+		glUniformBlockBinding(id, shared_uniforms_index, SharedUniformsBinding);
+
 	// Make a lookup table for the uniform locations.
 	GLint num_active_uniforms = 0;
 	glGetProgramiv(id, GL_ACTIVE_UNIFORMS, &num_active_uniforms);
@@ -582,6 +668,14 @@ static bool CreateProgram(GLuint& out_program, Uniforms& inout_uniform_map, Prog
 		GLenum type = 0;
 		GLsizei actual_length = 0;
 		glGetActiveUniform(id, unif, name_size, &actual_length, &array_size, &type, name_buf);
+
+		// Members of uniform blocks have no location, they are set through the buffer.
+		const GLuint uniform_index = GLuint(unif);
+		GLint block_index = -1;
+		glGetActiveUniformsiv(id, 1, &uniform_index, GL_UNIFORM_BLOCK_INDEX, &block_index);
+		if (block_index != -1)
+			continue;
+
 		GLint location = glGetUniformLocation(id, name_buf);
 
 		// See if we have the name in our pre-defined name list.
@@ -694,6 +788,8 @@ static bool CreateFramebuffer(FramebufferData& out_fb, int width, int height, in
 	out_fb = {};
 	out_fb.width = width;
 	out_fb.height = height;
+	out_fb.storage_width = width;
+	out_fb.storage_height = height;
 	out_fb.framebuffer = framebuffer;
 	out_fb.color_tex_buffer = color_tex_buffer;
 	out_fb.color_render_buffer = color_render_buffer;
@@ -716,6 +812,135 @@ static void DestroyFramebuffer(FramebufferData& fb)
 	fb = {};
 }
 
+static GLuint CreateTexture(Rml::Span<const Rml::byte> source_data, Rml::Vector2i source_dimensions)
+{
+	GLuint texture_id = 0;
+	glGenTextures(1, &texture_id);
+	if (texture_id == 0)
+	{
+		Rml::Log::Message(Rml::Log::LT_ERROR, "Failed to generate texture.");
+		return 0;
+	}
+
+	glBindTexture(GL_TEXTURE_2D, texture_id);
+
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, source_dimensions.x, source_dimensions.y, 0, GL_RGBA, GL_UNSIGNED_BYTE, source_data.data());
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	return texture_id;
+}
+
+// Vertex arrays are not shared between GL contexts, each context drawing the instances creates its own from the shared buffers.
+static GLuint CreateQuadInstanceVAO(const QuadInstanceBufferData& buffer)
+{
+	using QuadInstance = RenderInterface_GL3::QuadInstance;
+
+	GLuint vao = 0;
+	glGenVertexArrays(1, &vao);
+	glBindVertexArray(vao);
+
+	glBindBuffer(GL_ARRAY_BUFFER, buffer.quad_vbo);
+	glEnableVertexAttribArray((GLuint)VertexAttribute::Position);
+	glVertexAttribPointer((GLuint)VertexAttribute::Position, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (const GLvoid*)0);
+
+	// The instance buffer storage is respecified every time the instances are drawn, only the attribute layout is recorded here.
+	glBindBuffer(GL_ARRAY_BUFFER, buffer.instance_vbo);
+
+	glEnableVertexAttribArray((GLuint)VertexAttribute::InstanceRect);
+	glVertexAttribPointer((GLuint)VertexAttribute::InstanceRect, 4, GL_FLOAT, GL_FALSE, sizeof(QuadInstance),
+		(const GLvoid*)(offsetof(QuadInstance, position)));
+	glVertexAttribDivisor((GLuint)VertexAttribute::InstanceRect, 1);
+
+	glEnableVertexAttribArray((GLuint)VertexAttribute::InstanceTexRect);
+	glVertexAttribPointer((GLuint)VertexAttribute::InstanceTexRect, 4, GL_FLOAT, GL_FALSE, sizeof(QuadInstance),
+		(const GLvoid*)(offsetof(QuadInstance, tex_coord_min)));
+	glVertexAttribDivisor((GLuint)VertexAttribute::InstanceTexRect, 1);
+
+	glEnableVertexAttribArray((GLuint)VertexAttribute::Color0);
+	glVertexAttribPointer((GLuint)VertexAttribute::Color0, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(QuadInstance),
+		(const GLvoid*)(offsetof(QuadInstance, colour)));
+	glVertexAttribDivisor((GLuint)VertexAttribute::Color0, 1);
+
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffer.quad_ibo);
+
+	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	return vao;
+}
+
+static GLuint CreateGeometryVAO(const CompiledGeometryData& geometry)
+{
+	GLuint vao = 0;
+	glGenVertexArrays(1, &vao);
+	glBindVertexArray(vao);
+
+	glBindBuffer(GL_ARRAY_BUFFER, geometry.vbo);
+
+	glEnableVertexAttribArray((GLuint)VertexAttribute::Position);
+	glVertexAttribPointer((GLuint)VertexAttribute::Position, 2, GL_FLOAT, GL_FALSE, sizeof(Rml::Vertex),
+		(const GLvoid*)(offsetof(Rml::Vertex, position)));
+
+	glEnableVertexAttribArray((GLuint)VertexAttribute::Color0);
+	glVertexAttribPointer((GLuint)VertexAttribute::Color0, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(Rml::Vertex),
+		(const GLvoid*)(offsetof(Rml::Vertex, colour)));
+
+	glEnableVertexAttribArray((GLuint)VertexAttribute::TexCoord0);
+	glVertexAttribPointer((GLuint)VertexAttribute::TexCoord0, 2, GL_FLOAT, GL_FALSE, sizeof(Rml::Vertex),
+		(const GLvoid*)(offsetof(Rml::Vertex, tex_coord)));
+
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, geometry.ibo);
+
+	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	return vao;
+}
+
+static void CreateQuadInstanceBuffer(QuadInstanceBufferData& out_buffer)
+{
+	static const float quad_corners[] = {0.f, 0.f, 1.f, 0.f, 1.f, 1.f, 0.f, 1.f};
+	static const GLuint quad_indices[] = {0, 1, 2, 0, 2, 3};
+
+	glGenBuffers(1, &out_buffer.quad_vbo);
+	glGenBuffers(1, &out_buffer.quad_ibo);
+	glGenBuffers(1, &out_buffer.instance_vbo);
+
+	// Buffers are uploaded through the array buffer target, since the element array binding belongs to the vertex array state.
+	glBindBuffer(GL_ARRAY_BUFFER, out_buffer.quad_vbo);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(quad_corners), quad_corners, GL_STATIC_DRAW);
+	glBindBuffer(GL_ARRAY_BUFFER, out_buffer.quad_ibo);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(quad_indices), quad_indices, GL_STATIC_DRAW);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	out_buffer.vao = CreateQuadInstanceVAO(out_buffer);
+
+	CheckGLError("CreateQuadInstanceBuffer");
+}
+
+static void DestroyQuadInstanceBuffer(QuadInstanceBufferData& buffer)
+{
+	glDeleteVertexArrays(1, &buffer.vao);
+	glDeleteBuffers(1, &buffer.quad_vbo);
+	glDeleteBuffers(1, &buffer.quad_ibo);
+	glDeleteBuffers(1, &buffer.instance_vbo);
+	buffer = {};
+}
+
+static size_t GetTextureByteSize(Rml::Vector2i dimensions, int num_levels)
+{
+	size_t byte_size = 0;
+	for (int i = 0; i < num_levels; i++)
+		byte_size += size_t(Rml::Math::Max(dimensions.x >> i, 1)) * size_t(Rml::Math::Max(dimensions.y >> i, 1)) * 4;
+	return byte_size;
+}
+
 static void BindTexture(const FramebufferData& fb)
 {
 	if (!fb.color_tex_buffer)
@@ -786,17 +1011,57 @@ RenderInterface_GL3::RenderInterface_GL3()
 		Rml::Mesh mesh;
 		Rml::MeshUtilities::GenerateQuad(mesh, Rml::Vector2f(-1), Rml::Vector2f(2), {});
 		fullscreen_quad_geometry = RenderInterface_GL3::CompileGeometry(mesh.vertices, mesh.indices);
+
+		quad_instance_buffer = Rml::MakeUnique<Gfx::QuadInstanceBufferData>();
+		Gfx::CreateQuadInstanceBuffer(*quad_instance_buffer);
+
+		glGenBuffers(1, &shared_uniform_buffer);
+		glBindBuffer(GL_UNIFORM_BUFFER, shared_uniform_buffer);
+		glBufferData(GL_UNIFORM_BUFFER, sizeof(Gfx::SharedUniformData), nullptr, GL_DYNAMIC_DRAW);
+		glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+		glGetIntegerv(GL_MAX_SAMPLES, &max_msaa_samples);
+		quality_controller.SetLevel(DEFAULT_RENDER_QUALITY_LEVEL);
+		render_quality = render_quality_levels[DEFAULT_RENDER_QUALITY_LEVEL];
 	}
 }
 
 RenderInterface_GL3::~RenderInterface_GL3()
 {
+	RMLUI_ASSERTMSG(surfaces.empty(), "Surfaces must be released with their own context current before destroying the renderer.");
+
+	if (!released_vaos.empty())
+	{
+		glDeleteVertexArrays((GLsizei)released_vaos.size(), released_vaos.data());
+		released_vaos.clear();
+	}
+
+	for (const Rml::UniquePtr<TextureTarget>& target : texture_targets)
+	{
+		glDeleteFramebuffers(1, &target->framebuffer);
+		if (target->owns_texture)
+			glDeleteTextures(1, &target->texture_id);
+	}
+	texture_targets.clear();
+
 	if (fullscreen_quad_geometry)
 	{
 		RenderInterface_GL3::ReleaseGeometry(fullscreen_quad_geometry);
 		fullscreen_quad_geometry = {};
 	}
 
+	if (quad_instance_buffer)
+	{
+		Gfx::DestroyQuadInstanceBuffer(*quad_instance_buffer);
+		quad_instance_buffer.reset();
+	}
+
+	if (shared_uniform_buffer)
+	{
+		glDeleteBuffers(1, &shared_uniform_buffer);
+		shared_uniform_buffer = 0;
+	}
+
 	if (program_data)
 	{
 		Gfx::DestroyShaders(*program_data);
@@ -809,13 +1074,113 @@ void RenderInterface_GL3::SetViewport(int width, int height)
 	viewport_width = Rml::Math::Max(width, 1);
 	viewport_height = Rml::Math::Max(height, 1);
 	projection = Rml::Matrix4f::ProjectOrtho(0, (float)viewport_width, (float)viewport_height, 0, -10000, 10000);
+	shared_uniforms_dirty = true;
 }
 
 void RenderInterface_GL3::BeginFrame()
 {
 	RMLUI_ASSERT(viewport_width >= 1 && viewport_height >= 1);
+	RMLUI_ASSERT(!active_surface);
+
+	if (!released_vaos.empty())
+	{
+		glDeleteVertexArrays((GLsizei)released_vaos.size(), released_vaos.data());
+		released_vaos.clear();
+	}
+
+	BackupGLState();
+	ApplyRenderQuality();
+	BeginRenderTarget();
+
+	texture_residency.BeginFrame();
+	frame_timer.BeginFrame();
+
+	Gfx::CheckGLError("BeginFrame");
+}
+
+void RenderInterface_GL3::EndFrame()
+{
+	DrawLayersToBackbuffer();
+
+	EndFrameTracking();
+
+	RestoreGLState();
+
+	Gfx::CheckGLError("EndFrame");
+}
+
+void RenderInterface_GL3::BeginHostFrame()
+{
+	RMLUI_ASSERT(!active_surface);
+
+	if (!released_vaos.empty())
+	{
+		glDeleteVertexArrays((GLsizei)released_vaos.size(), released_vaos.data());
+		released_vaos.clear();
+	}
+
+	// Texture targets apply the render quality themselves when rendered.
+	texture_residency.BeginFrame();
+	frame_timer.BeginFrame();
+
+	Gfx::CheckGLError("BeginHostFrame");
+}
+
+void RenderInterface_GL3::EndHostFrame()
+{
+	EndFrameTracking();
 
-	// Backup GL state.
+	Gfx::CheckGLError("EndHostFrame");
+}
+
+void RenderInterface_GL3::EndFrameTracking()
+{
+	texture_residency.EndFrame();
+
+	frame_timer.EndFrame();
+	if (quality_controller.GetBudget() > 0.0)
+	{
+		const double frame_ms = Rml::Math::Max(frame_timer.GetCpuFrameTime(), frame_timer.GetGpuFrameTime());
+		if (quality_controller.Update(frame_ms))
+			render_quality = render_quality_levels[quality_controller.GetLevel()];
+	}
+}
+
+void RenderInterface_GL3::DrawLayersToBackbuffer()
+{
+	FlushQuadInstances();
+
+	const Gfx::FramebufferData& fb_active = render_layers.GetTopLayer();
+
+	// Without multisampling the layer can be sampled directly, otherwise resolve MSAA to postprocess framebuffer.
+	const Gfx::FramebufferData* fb_source = &fb_active;
+	if (!fb_active.color_tex_buffer)
+	{
+		const Gfx::FramebufferData& fb_postprocess = render_layers.GetPostprocessPrimary();
+		glBindFramebuffer(GL_READ_FRAMEBUFFER, fb_active.framebuffer);
+		glBindFramebuffer(GL_DRAW_FRAMEBUFFER, fb_postprocess.framebuffer);
+
+		glBlitFramebuffer(0, 0, fb_active.width, fb_active.height, 0, 0, fb_postprocess.width, fb_postprocess.height, GL_COLOR_BUFFER_BIT,
+			GL_NEAREST);
+		fb_source = &fb_postprocess;
+	}
+
+	// Draw to backbuffer, scaling up from the layer resolution if needed.
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	glViewport(0, 0, viewport_width, viewport_height);
+
+	// Assuming we have an opaque background, we can just write to it with the premultiplied alpha blend mode and we'll get the correct result.
+	// Instead, if we had a transparent destination that didn't use premultiplied alpha, we would need to perform a manual un-premultiplication step.
+	glActiveTexture(GL_TEXTURE0);
+	Gfx::BindTexture(*fb_source);
+	UseProgram(ProgramId::Passthrough);
+	DrawFullscreenQuad();
+
+	render_layers.EndFrame();
+}
+
+void RenderInterface_GL3::BackupGLState()
+{
 	glstate_backup.enable_cull_face = glIsEnabled(GL_CULL_FACE);
 	glstate_backup.enable_blend = glIsEnabled(GL_BLEND);
 	glstate_backup.enable_stencil_test = glIsEnabled(GL_STENCIL_TEST);
@@ -853,9 +1218,12 @@ void RenderInterface_GL3::BeginFrame()
 	glGetIntegerv(GL_STENCIL_BACK_FAIL, &glstate_backup.stencil_back.fail);
 	glGetIntegerv(GL_STENCIL_BACK_PASS_DEPTH_FAIL, &glstate_backup.stencil_back.pass_depth_fail);
 	glGetIntegerv(GL_STENCIL_BACK_PASS_DEPTH_PASS, &glstate_backup.stencil_back.pass_depth_pass);
+}
 
+void RenderInterface_GL3::BeginRenderTarget()
+{
 	// Setup expected GL state.
-	glViewport(0, 0, viewport_width, viewport_height);
+	glViewport(0, 0, target_width, target_height);
 
 	glClearStencil(0);
 	glClearColor(0, 0, 0, 0);
@@ -884,41 +1252,19 @@ void RenderInterface_GL3::BeginFrame()
 
 	SetTransform(nullptr);
 
-	render_layers.BeginFrame(viewport_width, viewport_height);
+	render_layers.BeginFrame(target_width, target_height, active_render_quality.msaa_samples);
+	layer_uv_scale = render_layers.GetUVScale();
 	glBindFramebuffer(GL_FRAMEBUFFER, render_layers.GetTopLayer().framebuffer);
 	glClear(GL_COLOR_BUFFER_BIT);
 
 	UseProgram(ProgramId::None);
-	program_transform_dirty.set();
+	glBindBufferBase(GL_UNIFORM_BUFFER, Gfx::SharedUniformsBinding, shared_uniform_buffer);
+	shared_uniforms_dirty = true;
 	scissor_state = Rml::Rectanglei::MakeInvalid();
-
-	Gfx::CheckGLError("BeginFrame");
 }
 
-void RenderInterface_GL3::EndFrame()
+void RenderInterface_GL3::RestoreGLState()
 {
-	const Gfx::FramebufferData& fb_active = render_layers.GetTopLayer();
-	const Gfx::FramebufferData& fb_postprocess = render_layers.GetPostprocessPrimary();
-
-	// Resolve MSAA to postprocess framebuffer.
-	glBindFramebuffer(GL_READ_FRAMEBUFFER, fb_active.framebuffer);
-	glBindFramebuffer(GL_DRAW_FRAMEBUFFER, fb_postprocess.framebuffer);
-
-	glBlitFramebuffer(0, 0, fb_active.width, fb_active.height, 0, 0, fb_postprocess.width, fb_postprocess.height, GL_COLOR_BUFFER_BIT, GL_NEAREST);
-
-	// Draw to backbuffer
-	glBindFramebuffer(GL_FRAMEBUFFER, 0);
-
-	// Assuming we have an opaque background, we can just write to it with the premultiplied alpha blend mode and we'll get the correct result.
-	// Instead, if we had a transparent destination that didn't use premultiplied alpha, we would need to perform a manual un-premultiplication step.
-	glActiveTexture(GL_TEXTURE0);
-	Gfx::BindTexture(fb_postprocess);
-	UseProgram(ProgramId::Passthrough);
-	DrawFullscreenQuad();
-
-	render_layers.EndFrame();
-
-	// Restore GL state.
 	if (glstate_backup.enable_cull_face)
 		glEnable(GL_CULL_FACE);
 	else
@@ -967,8 +1313,361 @@ void RenderInterface_GL3::EndFrame()
 	glStencilMaskSeparate(GL_BACK, glstate_backup.stencil_back.writemask);
 	glStencilOpSeparate(GL_BACK, glstate_backup.stencil_back.fail, glstate_backup.stencil_back.pass_depth_fail,
 		glstate_backup.stencil_back.pass_depth_pass);
+}
 
-	Gfx::CheckGLError("EndFrame");
+RenderInterface_GL3::TextureTargetHandle RenderInterface_GL3::CreateTextureTarget(unsigned int texture_id, int width, int height)
+{
+	GLint previous_framebuffer = 0;
+	glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previous_framebuffer);
+
+	GLuint framebuffer = 0;
+	glGenFramebuffers(1, &framebuffer);
+	glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture_id, 0);
+
+	const GLuint framebuffer_status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+	glBindFramebuffer(GL_FRAMEBUFFER, (GLuint)previous_framebuffer);
+
+	if (framebuffer_status != GL_FRAMEBUFFER_COMPLETE)
+	{
+		Rml::Log::Message(Rml::Log::LT_ERROR, "Texture %u could not be used as a render target. Error code %x.", texture_id, framebuffer_status);
+		glDeleteFramebuffers(1, &framebuffer);
+		return {};
+	}
+
+	Rml::UniquePtr<TextureTarget> target = Rml::MakeUnique<TextureTarget>();
+	target->texture_id = texture_id;
+	target->framebuffer = framebuffer;
+	target->width = Rml::Math::Max(width, 1);
+	target->height = Rml::Math::Max(height, 1);
+	target->refresh_interval = 0.0;
+	target->last_render_time = 0.0;
+	target->next_update_time = 0.0;
+	target->invalidated = true;
+	target->owns_texture = false;
+
+	Gfx::CheckGLError("CreateTextureTarget");
+
+	texture_targets.push_back(std::move(target));
+	return reinterpret_cast<TextureTargetHandle>(texture_targets.back().get());
+}
+
+RenderInterface_GL3::TextureTargetHandle RenderInterface_GL3::CreateTextureTarget(int width, int height)
+{
+	width = Rml::Math::Max(width, 1);
+	height = Rml::Math::Max(height, 1);
+
+	GLuint texture_id = 0;
+	glGenTextures(1, &texture_id);
+	glBindTexture(GL_TEXTURE_2D, texture_id);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	const TextureTargetHandle target_handle = CreateTextureTarget(texture_id, width, height);
+	if (!target_handle)
+	{
+		glDeleteTextures(1, &texture_id);
+		return {};
+	}
+
+	reinterpret_cast<TextureTarget*>(target_handle)->owns_texture = true;
+	return target_handle;
+}
+
+void RenderInterface_GL3::ReleaseTextureTarget(TextureTargetHandle target_handle)
+{
+	auto it = std::find_if(texture_targets.begin(), texture_targets.end(),
+		[&](const Rml::UniquePtr<TextureTarget>& target) { return reinterpret_cast<TextureTargetHandle>(target.get()) == target_handle; });
+	if (it == texture_targets.end())
+		return;
+
+	glDeleteFramebuffers(1, &(*it)->framebuffer);
+	if ((*it)->owns_texture)
+		glDeleteTextures(1, &(*it)->texture_id);
+	texture_targets.erase(it);
+}
+
+void RenderInterface_GL3::ResizeTextureTarget(TextureTargetHandle target_handle, int width, int height)
+{
+	TextureTarget& target = *reinterpret_cast<TextureTarget*>(target_handle);
+	target.width = Rml::Math::Max(width, 1);
+	target.height = Rml::Math::Max(height, 1);
+	target.invalidated = true;
+
+	// Respecifying the storage keeps the texture attached to the target framebuffer.
+	if (target.owns_texture)
+	{
+		glBindTexture(GL_TEXTURE_2D, target.texture_id);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, target.width, target.height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+		glBindTexture(GL_TEXTURE_2D, 0);
+	}
+}
+
+void RenderInterface_GL3::SetTextureTargetRefreshInterval(TextureTargetHandle target_handle, double interval)
+{
+	reinterpret_cast<TextureTarget*>(target_handle)->refresh_interval = Rml::Math::Max(interval, 0.0);
+}
+
+void RenderInterface_GL3::InvalidateTextureTarget(TextureTargetHandle target_handle)
+{
+	reinterpret_cast<TextureTarget*>(target_handle)->invalidated = true;
+}
+
+bool RenderInterface_GL3::RenderTextureTarget(TextureTargetHandle target_handle, Rml::Context* context, double current_time)
+{
+	TextureTarget& target = *reinterpret_cast<TextureTarget*>(target_handle);
+
+	const bool update_requested = (current_time >= target.next_update_time);
+	const bool refresh_elapsed = (target.refresh_interval > 0.0 && current_time - target.last_render_time >= target.refresh_interval);
+	if (!target.invalidated && !update_requested && !refresh_elapsed)
+	{
+		num_texture_target_skips += 1;
+		return false;
+	}
+
+	// Render at the resolution of the texture using the programs and resources of the main frame, by temporarily taking over the
+	// viewport and the layer stack. The render quality applies except for the layer scale, which would only blur the texture.
+	const int main_viewport_width = viewport_width;
+	const int main_viewport_height = viewport_height;
+	const RenderQuality main_render_quality = active_render_quality;
+	const int main_target_width = target_width;
+	const int main_target_height = target_height;
+
+	GLint previous_framebuffer = 0;
+	glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previous_framebuffer);
+
+	BackupGLState();
+
+	SetViewport(target.width, target.height);
+	active_render_quality.msaa_samples = Rml::Math::Clamp(render_quality.msaa_samples, 0, max_msaa_samples);
+	active_render_quality.blur_downsample = Rml::Math::Clamp(render_quality.blur_downsample, 0, 4);
+	active_render_quality.layer_scale = 1.f;
+	target_width = target.width;
+	target_height = target.height;
+
+	render_layers.Swap(target.layers);
+	BeginRenderTarget();
+
+	context->Render();
+	FlushQuadInstances();
+
+	// The layer has the size of the texture, so a blit both resolves multisampling and copies the result into the texture.
+	const Gfx::FramebufferData& fb_active = render_layers.GetTopLayer();
+	glBindFramebuffer(GL_READ_FRAMEBUFFER, fb_active.framebuffer);
+	glBindFramebuffer(GL_DRAW_FRAMEBUFFER, target.framebuffer);
+	glBlitFramebuffer(0, 0, fb_active.width, fb_active.height, 0, 0, target.width, target.height, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+
+	render_layers.EndFrame();
+	render_layers.Swap(target.layers);
+
+	SetViewport(main_viewport_width, main_viewport_height);
+	active_render_quality = main_render_quality;
+	target_width = main_target_width;
+	target_height = main_target_height;
+
+	glBindFramebuffer(GL_FRAMEBUFFER, (GLuint)previous_framebuffer);
+	RestoreGLState();
+
+	// The context resets its requested update delay on every update, so the delay seen now holds until the next render.
+	target.invalidated = false;
+	target.last_render_time = current_time;
+	target.next_update_time = current_time + context->GetNextUpdateDelay();
+	num_texture_target_refreshes += 1;
+
+	Gfx::CheckGLError("RenderTextureTarget");
+
+	return true;
+}
+
+void RenderInterface_GL3::CompositeTextureTarget(TextureTargetHandle target_handle)
+{
+	const TextureTarget& target = *reinterpret_cast<TextureTarget*>(target_handle);
+
+	GLint previous_framebuffer = 0;
+	glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previous_framebuffer);
+
+	BackupGLState();
+
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	glViewport(0, 0, viewport_width, viewport_height);
+
+	glDisable(GL_SCISSOR_TEST);
+	glDisable(GL_STENCIL_TEST);
+	glDisable(GL_DEPTH_TEST);
+	glDisable(GL_CULL_FACE);
+
+	glEnable(GL_BLEND);
+	glBlendEquation(GL_FUNC_ADD);
+	glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+
+	glActiveTexture(GL_TEXTURE0);
+	glBindTexture(GL_TEXTURE_2D, target.texture_id);
+
+	// The texture covers the whole quad, unlike the layers which may be larger than the rendered area.
+	layer_uv_scale = Rml::Vector2f(1.f);
+	UseProgram(ProgramId::Passthrough);
+	DrawFullscreenQuad();
+	UseProgram(ProgramId::None);
+
+	glBindTexture(GL_TEXTURE_2D, 0);
+	glBindFramebuffer(GL_FRAMEBUFFER, (GLuint)previous_framebuffer);
+	RestoreGLState();
+
+	Gfx::CheckGLError("CompositeTextureTarget");
+}
+
+void RenderInterface_GL3::ReadTextureTarget(TextureTargetHandle target_handle, Rml::Vector<Rml::byte>& pixels)
+{
+	const TextureTarget& target = *reinterpret_cast<TextureTarget*>(target_handle);
+	const size_t row_size = size_t(target.width) * 4;
+	pixels.resize(row_size * target.height);
+
+	GLint previous_framebuffer = 0;
+	glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &previous_framebuffer);
+
+	glBindFramebuffer(GL_READ_FRAMEBUFFER, target.framebuffer);
+	glPixelStorei(GL_PACK_ALIGNMENT, 1);
+	glReadPixels(0, 0, target.width, target.height, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+	glPixelStorei(GL_PACK_ALIGNMENT, 4);
+	glBindFramebuffer(GL_READ_FRAMEBUFFER, (GLuint)previous_framebuffer);
+
+	// Render targets are stored bottom-up.
+	for (int y = 0; y < target.height / 2; y++)
+		std::swap_ranges(pixels.begin() + y * row_size, pixels.begin() + (y + 1) * row_size, pixels.begin() + (target.height - 1 - y) * row_size);
+
+	Gfx::CheckGLError("ReadTextureTarget");
+}
+
+RenderInterface_GL3::SurfaceHandle RenderInterface_GL3::CreateSurface()
+{
+	Rml::UniquePtr<Surface> surface = Rml::MakeUnique<Surface>();
+	surface->quad_instance_vao = Gfx::CreateQuadInstanceVAO(*quad_instance_buffer);
+	surface->main_viewport_width = 0;
+	surface->main_viewport_height = 0;
+	surface->main_target_width = 0;
+	surface->main_target_height = 0;
+
+	Gfx::CheckGLError("CreateSurface");
+
+	surfaces.push_back(std::move(surface));
+	return reinterpret_cast<SurfaceHandle>(surfaces.back().get());
+}
+
+void RenderInterface_GL3::ReleaseSurface(SurfaceHandle surface_handle)
+{
+	RMLUI_ASSERT(!active_surface);
+
+	auto it = std::find_if(surfaces.begin(), surfaces.end(),
+		[&](const Rml::UniquePtr<Surface>& surface) { return reinterpret_cast<SurfaceHandle>(surface.get()) == surface_handle; });
+	if (it == surfaces.end())
+		return;
+
+	Surface& surface = **it;
+	for (const auto& geometry_vao : surface.geometry_vaos)
+		surface.released_vaos.push_back(geometry_vao.second);
+	surface.released_vaos.push_back(surface.quad_instance_vao);
+	glDeleteVertexArrays((GLsizei)surface.released_vaos.size(), surface.released_vaos.data());
+
+	// Destroys the layer framebuffers, which belong to the surface's context as well.
+	surfaces.erase(it);
+
+	Gfx::CheckGLError("ReleaseSurface");
+}
+
+void RenderInterface_GL3::BeginSurfaceFrame(SurfaceHandle surface_handle, int width, int height)
+{
+	RMLUI_ASSERT(!active_surface);
+
+	Surface& surface = *reinterpret_cast<Surface*>(surface_handle);
+	active_surface = &surface;
+
+	if (!surface.released_vaos.empty())
+	{
+		glDeleteVertexArrays((GLsizei)surface.released_vaos.size(), surface.released_vaos.data());
+		surface.released_vaos.clear();
+	}
+
+	// Render at the size of the surface by temporarily taking over the viewport and the layer stack of the main frame.
+	surface.main_viewport_width = viewport_width;
+	surface.main_viewport_height = viewport_height;
+	surface.main_target_width = target_width;
+	surface.main_target_height = target_height;
+
+	BackupGLState();
+
+	SetViewport(width, height);
+	ApplyRenderQuality();
+
+	render_layers.Swap(surface.layers);
+	BeginRenderTarget();
+
+	Gfx::CheckGLError("BeginSurfaceFrame");
+}
+
+void RenderInterface_GL3::EndSurfaceFrame()
+{
+	RMLUI_ASSERT(active_surface);
+	Surface& surface = *active_surface;
+
+	DrawLayersToBackbuffer();
+	render_layers.Swap(surface.layers);
+
+	SetViewport(surface.main_viewport_width, surface.main_viewport_height);
+	target_width = surface.main_target_width;
+	target_height = surface.main_target_height;
+
+	RestoreGLState();
+	active_surface = nullptr;
+
+	Gfx::CheckGLError("EndSurfaceFrame");
+}
+
+unsigned int RenderInterface_GL3::GetGeometryVAO(Gfx::CompiledGeometryData& geometry)
+{
+	if (!active_surface)
+	{
+		if (!geometry.vao)
+			geometry.vao = Gfx::CreateGeometryVAO(geometry);
+		return geometry.vao;
+	}
+
+	GLuint& vao = active_surface->geometry_vaos[&geometry];
+	if (!vao)
+		vao = Gfx::CreateGeometryVAO(geometry);
+	return vao;
+}
+
+unsigned int RenderInterface_GL3::GetQuadInstanceVAO()
+{
+	return active_surface ? active_surface->quad_instance_vao : quad_instance_buffer->vao;
+}
+
+RenderInterface_GL3::RenderTargetReport RenderInterface_GL3::GetRenderTargetReport() const
+{
+	return render_layers.GetReport();
+}
+
+void RenderInterface_GL3::SetSharedUniformsPerProgram(bool per_program)
+{
+	shared_uniforms_per_program = per_program;
+}
+
+RenderInterface_GL3::UniformReport RenderInterface_GL3::GetUniformReport() const
+{
+	return uniform_report;
+}
+
+RenderInterface_GL3::TextureTargetReport RenderInterface_GL3::GetTextureTargetReport() const
+{
+	TextureTargetReport report = {};
+	report.num_targets = (int)texture_targets.size();
+	report.num_refreshes = num_texture_target_refreshes;
+	report.num_skipped = num_texture_target_skips;
+	return report;
 }
 
 void RenderInterface_GL3::Clear()
@@ -981,49 +1680,38 @@ Rml::CompiledGeometryHandle RenderInterface_GL3::CompileGeometry(Rml::Span<const
 {
 	constexpr GLenum draw_usage = GL_STATIC_DRAW;
 
-	GLuint vao = 0;
 	GLuint vbo = 0;
 	GLuint ibo = 0;
 
-	glGenVertexArrays(1, &vao);
 	glGenBuffers(1, &vbo);
 	glGenBuffers(1, &ibo);
-	glBindVertexArray(vao);
 
+	// Both buffers are uploaded through the array buffer target, since the element array binding belongs to the vertex array state.
 	glBindBuffer(GL_ARRAY_BUFFER, vbo);
 	glBufferData(GL_ARRAY_BUFFER, sizeof(Rml::Vertex) * vertices.size(), (const void*)vertices.data(), draw_usage);
-
-	glEnableVertexAttribArray((GLuint)Gfx::VertexAttribute::Position);
-	glVertexAttribPointer((GLuint)Gfx::VertexAttribute::Position, 2, GL_FLOAT, GL_FALSE, sizeof(Rml::Vertex),
-		(const GLvoid*)(offsetof(Rml::Vertex, position)));
-
-	glEnableVertexAttribArray((GLuint)Gfx::VertexAttribute::Color0);
-	glVertexAttribPointer((GLuint)Gfx::VertexAttribute::Color0, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(Rml::Vertex),
-		(const GLvoid*)(offsetof(Rml::Vertex, colour)));
-
-	glEnableVertexAttribArray((GLuint)Gfx::VertexAttribute::TexCoord0);
-	glVertexAttribPointer((GLuint)Gfx::VertexAttribute::TexCoord0, 2, GL_FLOAT, GL_FALSE, sizeof(Rml::Vertex),
-		(const GLvoid*)(offsetof(Rml::Vertex, tex_coord)));
-
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ibo);
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(int) * indices.size(), (const void*)indices.data(), draw_usage);
-
-	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, ibo);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(int) * indices.size(), (const void*)indices.data(), draw_usage);
 	glBindBuffer(GL_ARRAY_BUFFER, 0);
 
 	Gfx::CheckGLError("CompileGeometry");
 
 	Gfx::CompiledGeometryData* geometry = new Gfx::CompiledGeometryData;
-	geometry->vao = vao;
+	geometry->vao = 0;
 	geometry->vbo = vbo;
 	geometry->ibo = ibo;
 	geometry->draw_count = (GLsizei)indices.size();
 
+	// Geometry compiled while rendering a surface gets its vertex array in the renderer's own context once drawn there.
+	if (!active_surface)
+		geometry->vao = Gfx::CreateGeometryVAO(*geometry);
+
 	return (Rml::CompiledGeometryHandle)geometry;
 }
 
 void RenderInterface_GL3::RenderGeometry(Rml::CompiledGeometryHandle handle, Rml::Vector2f translation, Rml::TextureHandle texture)
 {
+	FlushQuadInstances();
+
 	Gfx::CompiledGeometryData* geometry = (Gfx::CompiledGeometryData*)handle;
 
 	if (texture == TexturePostprocess)
@@ -1035,7 +1723,7 @@ void RenderInterface_GL3::RenderGeometry(Rml::CompiledGeometryHandle handle, Rml
 		UseProgram(ProgramId::Texture);
 		SubmitTransformUniform(translation);
 		if (texture != TextureEnableWithoutBinding)
-			glBindTexture(GL_TEXTURE_2D, (GLuint)texture);
+			BindTextureHandle(texture);
 	}
 	else
 	{
@@ -1044,7 +1732,7 @@ void RenderInterface_GL3::RenderGeometry(Rml::CompiledGeometryHandle handle, Rml
 		SubmitTransformUniform(translation);
 	}
 
-	glBindVertexArray(geometry->vao);
+	glBindVertexArray(GetGeometryVAO(*geometry));
 	glDrawElements(GL_TRIANGLES, geometry->draw_count, GL_UNSIGNED_INT, (const GLvoid*)0);
 
 	glBindVertexArray(0);
@@ -1057,7 +1745,28 @@ void RenderInterface_GL3::ReleaseGeometry(Rml::CompiledGeometryHandle handle)
 {
 	Gfx::CompiledGeometryData* geometry = (Gfx::CompiledGeometryData*)handle;
 
-	glDeleteVertexArrays(1, &geometry->vao);
+	// Vertex arrays can only be deleted in the context they were created in, those of other contexts are deleted when next current.
+	if (geometry->vao)
+	{
+		if (active_surface)
+			released_vaos.push_back(geometry->vao);
+		else
+			glDeleteVertexArrays(1, &geometry->vao);
+	}
+
+	for (const Rml::UniquePtr<Surface>& surface : surfaces)
+	{
+		auto it = surface->geometry_vaos.find(geometry);
+		if (it == surface->geometry_vaos.end())
+			continue;
+
+		if (surface.get() == active_surface)
+			glDeleteVertexArrays(1, &it->second);
+		else
+			surface->released_vaos.push_back(it->second);
+		surface->geometry_vaos.erase(it);
+	}
+
 	glDeleteBuffers(1, &geometry->vbo);
 	glDeleteBuffers(1, &geometry->ibo);
 
@@ -1078,6 +1787,8 @@ static Rml::Rectanglei VerticallyFlipped(Rml::Rectanglei rect, int viewport_heig
 
 void RenderInterface_GL3::SetScissor(Rml::Rectanglei region, bool vertically_flip)
 {
+	FlushQuadInstances();
+
 	if (region.Valid() != scissor_state.Valid())
 	{
 		if (region.Valid())
@@ -1087,13 +1798,13 @@ void RenderInterface_GL3::SetScissor(Rml::Rectanglei region, bool vertically_fli
 	}
 
 	if (region.Valid() && vertically_flip)
-		region = VerticallyFlipped(region, viewport_height);
+		region = VerticallyFlipped(region, target_height);
 
 	if (region.Valid() && region != scissor_state)
 	{
 		// Some render APIs don't like offscreen positions (WebGL in particular), so clamp them to the viewport.
-		const int x = Rml::Math::Clamp(region.Left(), 0, viewport_width);
-		const int y = Rml::Math::Clamp(viewport_height - region.Bottom(), 0, viewport_height);
+		const int x = Rml::Math::Clamp(region.Left(), 0, target_width);
+		const int y = Rml::Math::Clamp(target_height - region.Bottom(), 0, target_height);
 
 		glScissor(x, y, region.Width(), region.Height());
 	}
@@ -1109,13 +1820,29 @@ void RenderInterface_GL3::EnableScissorRegion(bool enable)
 		SetScissor(Rml::Rectanglei::MakeInvalid(), false);
 }
 
-void RenderInterface_GL3::SetScissorRegion(Rml::Rectanglei region)
+void RenderInterface_GL3::SetScissorRegion(Rml::Rectanglei region)
+{
+	SetScissor(ToRenderTarget(region));
+}
+
+Rml::Rectanglei RenderInterface_GL3::ToRenderTarget(Rml::Rectanglei region) const
 {
-	SetScissor(region);
+	// Scissor regions are given in viewport coordinates, while all internal state refers to the layer framebuffers. Round outwards so
+	// that partially covered pixels are kept.
+	if (!region.Valid() || (target_width == viewport_width && target_height == viewport_height))
+		return region;
+
+	const Rml::Vector2f scale = Rml::Vector2f(float(target_width), float(target_height)) / Rml::Vector2f(float(viewport_width), float(viewport_height));
+	const Rml::Vector2f p0 = Rml::Vector2f(region.p0) * scale;
+	const Rml::Vector2f p1 = Rml::Vector2f(region.p1) * scale;
+	return Rml::Rectanglei::FromCorners(Rml::Vector2i(Rml::Math::RoundDownToInteger(p0.x), Rml::Math::RoundDownToInteger(p0.y)),
+		Rml::Vector2i(Rml::Math::RoundUpToInteger(p1.x), Rml::Math::RoundUpToInteger(p1.y)));
 }
 
 void RenderInterface_GL3::EnableClipMask(bool enable)
 {
+	FlushQuadInstances();
+
 	if (enable)
 		glEnable(GL_STENCIL_TEST);
 	else
@@ -1127,6 +1854,8 @@ void RenderInterface_GL3::RenderToClipMask(Rml::ClipMaskOperation operation, Rml
 	RMLUI_ASSERT(glIsEnabled(GL_STENCIL_TEST));
 	using Rml::ClipMaskOperation;
 
+	FlushQuadInstances();
+
 	const bool clear_stencil = (operation == ClipMaskOperation::Set || operation == ClipMaskOperation::SetInverse);
 	if (clear_stencil)
 	{
@@ -1190,8 +1919,87 @@ struct TGAHeader {
 // Restore packing
 #pragma pack()
 
-Rml::TextureHandle RenderInterface_GL3::LoadTexture(Rml::Vector2i& texture_dimensions, const Rml::String& source)
+static GLuint UploadBakedTexture(const BakedTexture::Image& image)
+{
+	GLuint texture_id = 0;
+	glGenTextures(1, &texture_id);
+	if (texture_id == 0)
+	{
+		Rml::Log::Message(Rml::Log::LT_ERROR, "Failed to generate texture.");
+		return 0;
+	}
+
+	glBindTexture(GL_TEXTURE_2D, texture_id);
+
+	// Each level is uploaded straight from the file data, the rows are already premultiplied and in upload order.
+	for (int i = 0; i < image.num_levels; i++)
+	{
+		const BakedTexture::Level& level = image.levels[i];
+		glTexImage2D(GL_TEXTURE_2D, i, GL_RGBA8, level.width, level.height, 0, GL_RGBA, GL_UNSIGNED_BYTE, level.data);
+	}
+
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, image.num_levels - 1);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, image.num_levels > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	Gfx::CheckGLError("UploadBakedTexture");
+
+	return texture_id;
+}
+
+static GLuint LoadBakedTexture(Rml::Vector2i& texture_dimensions, int& out_num_levels, const Rml::String& source)
+{
+	// Prefer mapping the file directly so that the pixel data is never copied on the client side. If the source can only be resolved
+	// through a custom file interface, fall back to reading it into memory.
+	BakedTexture::MappedFile mapped_file;
+	Rml::Vector<Rml::byte> buffer;
+	Rml::Span<const Rml::byte> file_data;
+
+	if (mapped_file.Open(source))
+	{
+		file_data = mapped_file.GetData();
+	}
+	else
+	{
+		Rml::FileInterface* file_interface = Rml::GetFileInterface();
+		Rml::FileHandle file_handle = file_interface->Open(source);
+		if (!file_handle)
+			return 0;
+
+		buffer.resize(file_interface->Length(file_handle));
+		const size_t read_size = file_interface->Read(buffer.data(), buffer.size(), file_handle);
+		file_interface->Close(file_handle);
+		buffer.resize(read_size);
+		file_data = buffer;
+	}
+
+	BakedTexture::Image image;
+	Rml::String error_message;
+	if (!BakedTexture::Parse(file_data, image, &error_message))
+	{
+		Rml::Log::Message(Rml::Log::LT_ERROR, "Could not load baked texture '%s': %s", source.c_str(), error_message.c_str());
+		return 0;
+	}
+
+	texture_dimensions = {image.width, image.height};
+	out_num_levels = image.num_levels;
+
+	return UploadBakedTexture(image);
+}
+
+// Loads and uploads the texture from file, returns the GL texture or zero on failure.
+static GLuint LoadTextureFromSource(Rml::Vector2i& texture_dimensions, int& out_num_levels, const Rml::String& source)
 {
+	out_num_levels = 1;
+
+	if (BakedTexture::IsBakedTextureSource(source))
+		return LoadBakedTexture(texture_dimensions, out_num_levels, source);
+
 	Rml::FileInterface* file_interface = Rml::GetFileInterface();
 	Rml::FileHandle file_handle = file_interface->Open(source);
 	if (!file_handle)
@@ -1266,46 +2074,44 @@ Rml::TextureHandle RenderInterface_GL3::LoadTexture(Rml::Vector2i& texture_dimen
 	texture_dimensions.x = header.width;
 	texture_dimensions.y = header.height;
 
-	return GenerateTexture({image_dest, image_size}, texture_dimensions);
+	return Gfx::CreateTexture({image_dest, image_size}, texture_dimensions);
 }
 
-Rml::TextureHandle RenderInterface_GL3::GenerateTexture(Rml::Span<const Rml::byte> source_data, Rml::Vector2i source_dimensions)
+Rml::TextureHandle RenderInterface_GL3::LoadTexture(Rml::Vector2i& texture_dimensions, const Rml::String& source)
 {
-	GLuint texture_id = 0;
-	glGenTextures(1, &texture_id);
-	if (texture_id == 0)
-	{
-		Rml::Log::Message(Rml::Log::LT_ERROR, "Failed to generate texture.");
-		return false;
-	}
-
-	glBindTexture(GL_TEXTURE_2D, texture_id);
-
-	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, source_dimensions.x, source_dimensions.y, 0, GL_RGBA, GL_UNSIGNED_BYTE, source_data.data());
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	int num_levels = 1;
+	const GLuint texture_id = LoadTextureFromSource(texture_dimensions, num_levels, source);
+	if (!texture_id)
+		return {};
 
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+	return texture_residency.Register(texture_id, texture_dimensions, num_levels, source);
+}
 
-	glBindTexture(GL_TEXTURE_2D, 0);
+Rml::TextureHandle RenderInterface_GL3::GenerateTexture(Rml::Span<const Rml::byte> source_data, Rml::Vector2i source_dimensions)
+{
+	const GLuint texture_id = Gfx::CreateTexture(source_data, source_dimensions);
+	if (!texture_id)
+		return {};
 
-	return (Rml::TextureHandle)texture_id;
+	return texture_residency.Register(texture_id, source_dimensions, 1, Rml::String());
 }
 
 void RenderInterface_GL3::DrawFullscreenQuad()
 {
-	RenderGeometry(fullscreen_quad_geometry, {}, RenderInterface_GL3::TexturePostprocess);
+	if (layer_uv_scale != Rml::Vector2f(1.f))
+		DrawFullscreenQuad({}, Rml::Vector2f(1.f));
+	else
+		RenderGeometry(fullscreen_quad_geometry, {}, RenderInterface_GL3::TexturePostprocess);
 }
 
 void RenderInterface_GL3::DrawFullscreenQuad(Rml::Vector2f uv_offset, Rml::Vector2f uv_scaling)
 {
 	Rml::Mesh mesh;
 	Rml::MeshUtilities::GenerateQuad(mesh, Rml::Vector2f(-1), Rml::Vector2f(2), {});
-	if (uv_offset != Rml::Vector2f() || uv_scaling != Rml::Vector2f(1.f))
+	if (uv_offset != Rml::Vector2f() || uv_scaling != Rml::Vector2f(1.f) || layer_uv_scale != Rml::Vector2f(1.f))
 	{
 		for (Rml::Vertex& vertex : mesh.vertices)
-			vertex.tex_coord = (vertex.tex_coord * uv_scaling) + uv_offset;
+			vertex.tex_coord = ((vertex.tex_coord * uv_scaling) + uv_offset) * layer_uv_scale;
 	}
 	const Rml::CompiledGeometryHandle geometry = CompileGeometry(mesh.vertices, mesh.indices);
 	RenderGeometry(geometry, {}, RenderInterface_GL3::TexturePostprocess);
@@ -1320,12 +2126,13 @@ static Rml::Colourf ConvertToColorf(Rml::ColourbPremultiplied c0)
 	return result;
 }
 
-static void SigmaToParameters(const float desired_sigma, int& out_pass_level, float& out_sigma)
+static void SigmaToParameters(const float desired_sigma, const int additional_passes, int& out_pass_level, float& out_sigma)
 {
 	constexpr int max_num_passes = 10;
 	static_assert(max_num_passes < 31, "");
 	constexpr float max_single_pass_sigma = 3.0f;
-	out_pass_level = Rml::Math::Clamp(Rml::Math::Log2(int(desired_sigma * (2.f / max_single_pass_sigma))), 0, max_num_passes);
+	out_pass_level =
+		Rml::Math::Clamp(Rml::Math::Log2(int(desired_sigma * (2.f / max_single_pass_sigma))) + additional_passes, 0, max_num_passes);
 	out_sigma = Rml::Math::Clamp(desired_sigma / float(1 << out_pass_level), 0.0f, max_single_pass_sigma);
 }
 
@@ -1368,7 +2175,7 @@ void RenderInterface_GL3::RenderBlur(float sigma, const Gfx::FramebufferData& so
 	RMLUI_ASSERT(window_flipped.Valid());
 
 	int pass_level = 0;
-	SigmaToParameters(sigma, pass_level, sigma);
+	SigmaToParameters(sigma, active_render_quality.blur_downsample, pass_level, sigma);
 
 	const Rml::Rectanglei original_scissor = scissor_state;
 
@@ -1413,7 +2220,7 @@ void RenderInterface_GL3::RenderBlur(float sigma, const Gfx::FramebufferData& so
 	UseProgram(ProgramId::Blur);
 	SetBlurWeights(GetUniformLocation(UniformId::Weights), sigma);
 	SetTexCoordLimits(GetUniformLocation(UniformId::TexCoordMin), GetUniformLocation(UniformId::TexCoordMax), scissor,
-		{source_destination.width, source_destination.height});
+		{source_destination.storage_width, source_destination.storage_height});
 
 	const GLint texel_offset_location = GetUniformLocation(UniformId::TexelOffset);
 	auto SetTexelOffset = [texel_offset_location](Rml::Vector2f blur_direction, int texture_dimension) {
@@ -1425,7 +2232,7 @@ void RenderInterface_GL3::RenderBlur(float sigma, const Gfx::FramebufferData& so
 	Gfx::BindTexture(temp);
 	glBindFramebuffer(GL_FRAMEBUFFER, source_destination.framebuffer);
 
-	SetTexelOffset({0.f, 1.f}, temp.height);
+	SetTexelOffset({0.f, 1.f}, temp.storage_height);
 	DrawFullscreenQuad();
 
 	// Blur render pass - horizontal.
@@ -1441,7 +2248,7 @@ void RenderInterface_GL3::RenderBlur(float sigma, const Gfx::FramebufferData& so
 	glClear(GL_COLOR_BUFFER_BIT);
 	SetScissor(scissor, true);
 
-	SetTexelOffset({1.f, 0.f}, source_destination.width);
+	SetTexelOffset({1.f, 0.f}, source_destination.storage_width);
 	DrawFullscreenQuad();
 
 	// Blit the blurred image to the scissor region with upscaling.
@@ -1476,13 +2283,122 @@ void RenderInterface_GL3::RenderBlur(float sigma, const Gfx::FramebufferData& so
 
 void RenderInterface_GL3::ReleaseTexture(Rml::TextureHandle texture_handle)
 {
-	glDeleteTextures(1, (GLuint*)&texture_handle);
+	if (texture_handle == quad_instances_texture)
+		FlushQuadInstances();
+
+	texture_residency.Release(texture_handle);
+}
+
+void RenderInterface_GL3::BindTextureHandle(Rml::TextureHandle texture_handle)
+{
+	glBindTexture(GL_TEXTURE_2D, texture_residency.MakeResident(texture_handle));
+}
+
+void RenderInterface_GL3::RenderQuadInstances(Rml::Span<const QuadInstance> instances, Rml::Vector2f translation, Rml::TextureHandle texture)
+{
+	RMLUI_ASSERT(texture && texture != TextureEnableWithoutBinding && texture != TexturePostprocess);
+
+	if (texture != quad_instances_texture)
+		FlushQuadInstances();
+
+	quad_instances_texture = texture;
+
+	// Bake the translation into the instances so that quads from different elements can be drawn together.
+	for (const QuadInstance& instance : instances)
+	{
+		quad_instances.push_back(instance);
+		quad_instances.back().position += translation;
+	}
+}
+
+void RenderInterface_GL3::FlushQuadInstances()
+{
+	if (quad_instances.empty())
+		return;
+
+	UseProgram(ProgramId::TextureInstanced);
+	SubmitTransformUniform({});
+	BindTextureHandle(quad_instances_texture);
+
+	glBindVertexArray(GetQuadInstanceVAO());
+	glBindBuffer(GL_ARRAY_BUFFER, quad_instance_buffer->instance_vbo);
+
+	// Respecify the storage on every draw, letting the driver hand out fresh memory instead of synchronizing with previous draws.
+	glBufferData(GL_ARRAY_BUFFER, sizeof(QuadInstance) * quad_instances.size(), quad_instances.data(), GL_STREAM_DRAW);
+	glDrawElementsInstanced(GL_TRIANGLES, 6, GL_UNSIGNED_INT, (const GLvoid*)0, (GLsizei)quad_instances.size());
+
+	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	quad_instances.clear();
+	quad_instances_texture = {};
+
+	Gfx::CheckGLError("FlushQuadInstances");
+}
+
+void RenderInterface_GL3::SetTextureMemoryBudget(size_t budget_bytes)
+{
+	texture_residency.SetBudget(budget_bytes);
+}
+
+RenderInterface_GL3::TextureMemoryReport RenderInterface_GL3::GetTextureMemoryReport() const
+{
+	return texture_residency.GetReport();
+}
+
+void RenderInterface_GL3::SetRenderQuality(RenderQuality quality)
+{
+	render_quality = quality;
+	render_quality_manual = true;
+	quality_controller.SetBudget(0.0);
+}
+
+void RenderInterface_GL3::SetFrameTimeBudget(double budget_ms)
+{
+	quality_controller.SetBudget(budget_ms);
+	if (budget_ms > 0.0)
+	{
+		render_quality = render_quality_levels[quality_controller.GetLevel()];
+		render_quality_manual = false;
+	}
+}
+
+RenderInterface_GL3::RenderQualityReport RenderInterface_GL3::GetRenderQualityReport() const
+{
+	RenderQualityReport report = {};
+	report.quality = active_render_quality;
+	report.level = (render_quality_manual ? -1 : quality_controller.GetLevel());
+	report.num_levels = NUM_RENDER_QUALITY_LEVELS;
+	report.frame_budget_ms = quality_controller.GetBudget();
+	report.cpu_frame_ms = frame_timer.GetCpuFrameTime();
+	report.gpu_frame_ms = frame_timer.GetGpuFrameTime();
+	report.num_level_changes = quality_controller.GetNumChanges();
+	return report;
+}
+
+void RenderInterface_GL3::ApplyRenderQuality()
+{
+	active_render_quality = render_quality;
+	active_render_quality.msaa_samples = Rml::Math::Clamp(render_quality.msaa_samples, 0, max_msaa_samples);
+	active_render_quality.blur_downsample = Rml::Math::Clamp(render_quality.blur_downsample, 0, 4);
+	active_render_quality.layer_scale = Rml::Math::Clamp(render_quality.layer_scale, 0.25f, 1.f);
+
+	target_width = Rml::Math::Max(int(float(viewport_width) * active_render_quality.layer_scale + 0.5f), 1);
+	target_height = Rml::Math::Max(int(float(viewport_height) * active_render_quality.layer_scale + 0.5f), 1);
+}
+
+Rml::TextureHandle RenderInterface_GL3::FindLoadedTexture(const Rml::String& source) const
+{
+	return texture_residency.Find(source);
 }
 
 void RenderInterface_GL3::SetTransform(const Rml::Matrix4f* new_transform)
 {
+	FlushQuadInstances();
+
 	transform = (new_transform ? (projection * (*new_transform)) : projection);
-	program_transform_dirty.set();
+	shared_uniforms_dirty = true;
 }
 
 enum class FilterType { Invalid = 0, Passthrough, Blur, DropShadow, ColorMatrix, MaskImage };
@@ -1705,9 +2621,11 @@ void RenderInterface_GL3::RenderShader(Rml::CompiledShaderHandle shader_handle,
 	Rml::Vector2f translation, Rml::TextureHandle /*texture*/)
 {
 	RMLUI_ASSERT(shader_handle && geometry_handle);
+	FlushQuadInstances();
+
 	const CompiledShader& shader = *reinterpret_cast<CompiledShader*>(shader_handle);
 	const CompiledShaderType type = shader.type;
-	const Gfx::CompiledGeometryData& geometry = *reinterpret_cast<Gfx::CompiledGeometryData*>(geometry_handle);
+	Gfx::CompiledGeometryData& geometry = *reinterpret_cast<Gfx::CompiledGeometryData*>(geometry_handle);
 
 	switch (type)
 	{
@@ -1725,7 +2643,7 @@ void RenderInterface_GL3::RenderShader(Rml::CompiledShaderHandle shader_handle,
 		glUniform4fv(GetUniformLocation(UniformId::StopColors), num_stops, shader.stop_colors[0]);
 
 		SubmitTransformUniform(translation);
-		glBindVertexArray(geometry.vao);
+		glBindVertexArray(GetGeometryVAO(geometry));
 		glDrawElements(GL_TRIANGLES, geometry.draw_count, GL_UNSIGNED_INT, (const GLvoid*)0);
 		glBindVertexArray(0);
 	}
@@ -1739,7 +2657,7 @@ void RenderInterface_GL3::RenderShader(Rml::CompiledShaderHandle shader_handle,
 		glUniform2f(GetUniformLocation(UniformId::Dimensions), shader.dimensions.x, shader.dimensions.y);
 
 		SubmitTransformUniform(translation);
-		glBindVertexArray(geometry.vao);
+		glBindVertexArray(GetGeometryVAO(geometry));
 		glDrawElements(GL_TRIANGLES, geometry.draw_count, GL_UNSIGNED_INT, (const GLvoid*)0);
 		glBindVertexArray(0);
 	}
@@ -1803,8 +2721,8 @@ void RenderInterface_GL3::RenderFilters(Rml::Span<const Rml::CompiledFilterHandl
 			const Gfx::FramebufferData& source_destination = render_layers.GetPostprocessPrimary();
 			const Gfx::FramebufferData& temp = render_layers.GetPostprocessSecondary();
 
-			const Rml::Rectanglei window_flipped = VerticallyFlipped(scissor_state, viewport_height);
-			RenderBlur(filter.sigma, source_destination, temp, window_flipped);
+			const Rml::Rectanglei window_flipped = VerticallyFlipped(scissor_state, target_height);
+			RenderBlur(filter.sigma * active_render_quality.layer_scale, source_destination, temp, window_flipped);
 
 			glEnable(GL_BLEND);
 		}
@@ -1822,9 +2740,9 @@ void RenderInterface_GL3::RenderFilters(Rml::Span<const Rml::CompiledFilterHandl
 			Gfx::BindTexture(primary);
 			glBindFramebuffer(GL_FRAMEBUFFER, secondary.framebuffer);
 
-			const Rml::Rectanglei window_flipped = VerticallyFlipped(scissor_state, viewport_height);
+			const Rml::Rectanglei window_flipped = VerticallyFlipped(scissor_state, target_height);
 			SetTexCoordLimits(GetUniformLocation(UniformId::TexCoordMin), GetUniformLocation(UniformId::TexCoordMax), window_flipped,
-				{primary.width, primary.height});
+				{primary.storage_width, primary.storage_height});
 
 			const Rml::Vector2f uv_offset = filter.offset / Rml::Vector2f(-(float)viewport_width, (float)viewport_height);
 			DrawFullscreenQuad(uv_offset);
@@ -1832,7 +2750,7 @@ void RenderInterface_GL3::RenderFilters(Rml::Span<const Rml::CompiledFilterHandl
 			if (filter.sigma >= 0.5f)
 			{
 				const Gfx::FramebufferData& tertiary = render_layers.GetPostprocessTertiary();
-				RenderBlur(filter.sigma, secondary, tertiary, window_flipped);
+				RenderBlur(filter.sigma * active_render_quality.layer_scale, secondary, tertiary, window_flipped);
 			}
 
 			UseProgram(ProgramId::Passthrough);
@@ -1898,6 +2816,8 @@ void RenderInterface_GL3::RenderFilters(Rml::Span<const Rml::CompiledFilterHandl
 
 Rml::LayerHandle RenderInterface_GL3::PushLayer()
 {
+	FlushQuadInstances();
+
 	const Rml::LayerHandle layer_handle = render_layers.PushLayer();
 
 	glBindFramebuffer(GL_FRAMEBUFFER, render_layers.GetLayer(layer_handle).framebuffer);
@@ -1911,17 +2831,25 @@ void RenderInterface_GL3::CompositeLayers(Rml::LayerHandle source_handle, Rml::L
 {
 	using Rml::BlendMode;
 
-	// Blit source layer to postprocessing buffer. Do this regardless of whether we actually have any filters to be
-	// applied, because we need to resolve the multi-sampled framebuffer in any case.
+	FlushQuadInstances();
+
+	// Without filters and multisampling, the source layer can be sampled directly. Otherwise, blit the source layer to the postprocessing
+	// buffer, because we need to resolve the multi-sampled framebuffer and the filters operate on the postprocessing buffers.
 	// @performance If we have BlendMode::Replace and no filters or mask then we can just blit directly to the destination.
-	BlitLayerToPostprocessPrimary(source_handle);
+	const Gfx::FramebufferData& source = render_layers.GetLayer(source_handle);
+	const bool sample_source_directly = (filters.empty() && source.color_tex_buffer && source_handle != destination_handle);
 
-	// Render the filters, the PostprocessPrimary framebuffer is used for both input and output.
-	RenderFilters(filters);
+	if (!sample_source_directly)
+	{
+		BlitLayerToPostprocessPrimary(source_handle);
+
+		// Render the filters, the PostprocessPrimary framebuffer is used for both input and output.
+		RenderFilters(filters);
+	}
 
 	// Render to the destination layer.
 	glBindFramebuffer(GL_FRAMEBUFFER, render_layers.GetLayer(destination_handle).framebuffer);
-	Gfx::BindTexture(render_layers.GetPostprocessPrimary());
+	Gfx::BindTexture(sample_source_directly ? source : render_layers.GetPostprocessPrimary());
 
 	UseProgram(ProgramId::Passthrough);
 
@@ -1941,6 +2869,8 @@ void RenderInterface_GL3::CompositeLayers(Rml::LayerHandle source_handle, Rml::L
 
 void RenderInterface_GL3::PopLayer()
 {
+	FlushQuadInstances();
+
 	render_layers.PopLayer();
 	glBindFramebuffer(GL_FRAMEBUFFER, render_layers.GetTopLayer().framebuffer);
 }
@@ -1948,6 +2878,8 @@ void RenderInterface_GL3::PopLayer()
 Rml::TextureHandle RenderInterface_GL3::SaveLayerAsTexture()
 {
 	RMLUI_ASSERT(scissor_state.Valid());
+	FlushQuadInstances();
+
 	const Rml::Rectanglei bounds = scissor_state;
 
 	Rml::TextureHandle render_texture = GenerateTexture({}, bounds.Size());
@@ -1972,7 +2904,7 @@ Rml::TextureHandle RenderInterface_GL3::SaveLayerAsTexture()
 		GL_COLOR_BUFFER_BIT, GL_NEAREST                 //
 	);
 
-	glBindTexture(GL_TEXTURE_2D, (GLuint)render_texture);
+	BindTextureHandle(render_texture);
 
 	const Gfx::FramebufferData& texture_source = destination;
 	glBindFramebuffer(GL_READ_FRAMEBUFFER, texture_source.framebuffer);
@@ -1987,6 +2919,8 @@ Rml::TextureHandle RenderInterface_GL3::SaveLayerAsTexture()
 
 Rml::CompiledFilterHandle RenderInterface_GL3::SaveLayerAsMaskImage()
 {
+	FlushQuadInstances();
+
 	BlitLayerToPostprocessPrimary(render_layers.GetTopLayerHandle());
 
 	const Gfx::FramebufferData& source = render_layers.GetPostprocessPrimary();
@@ -2014,7 +2948,11 @@ void RenderInterface_GL3::UseProgram(ProgramId program_id)
 	if (active_program != program_id)
 	{
 		if (program_id != ProgramId::None)
+		{
 			glUseProgram(program_data->programs[program_id]);
+			uniform_report.num_program_switches += 1;
+			shared_uniforms_dirty |= shared_uniforms_per_program;
+		}
 		active_program = program_id;
 	}
 }
@@ -2026,16 +2964,23 @@ int RenderInterface_GL3::GetUniformLocation(UniformId uniform_id) const
 
 void RenderInterface_GL3::SubmitTransformUniform(Rml::Vector2f translation)
 {
-	static_assert((size_t)ProgramId::Count < MaxNumPrograms, "Maximum number of programs exceeded.");
-	const size_t program_index = (size_t)active_program;
-
-	if (program_transform_dirty.test(program_index))
+	// The shared uniforms are only uploaded when changed, switching programs does not require sending them again.
+	if (shared_uniforms_dirty)
 	{
-		glUniformMatrix4fv(GetUniformLocation(UniformId::Transform), 1, false, transform.data());
-		program_transform_dirty.set(program_index, false);
+		Gfx::SharedUniformData data = {};
+		memcpy(data.transform, transform.data(), sizeof(data.transform));
+		data.viewport_size[0] = float(viewport_width);
+		data.viewport_size[1] = float(viewport_height);
+
+		glBindBuffer(GL_UNIFORM_BUFFER, shared_uniform_buffer);
+		glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(data), &data);
+		glBindBuffer(GL_UNIFORM_BUFFER, 0);
+		shared_uniforms_dirty = false;
+		uniform_report.num_shared_uniform_uploads += 1;
 	}
 
 	glUniform2fv(GetUniformLocation(UniformId::Translate), 1, &translation.x);
+	uniform_report.num_transform_submissions += 1;
 
 	Gfx::CheckGLError("SubmitTransformUniform");
 }
@@ -2060,7 +3005,10 @@ Rml::LayerHandle RenderInterface_GL3::RenderLayerStack::PushLayer()
 		GLuint shared_depth_stencil = (fb_layers.empty() ? 0 : fb_layers.front().depth_stencil_buffer);
 
 		fb_layers.push_back(Gfx::FramebufferData{});
-		Gfx::CreateFramebuffer(fb_layers.back(), width, height, NUM_MSAA_SAMPLES, Gfx::FramebufferAttachment::DepthStencil, shared_depth_stencil);
+		Gfx::CreateFramebuffer(fb_layers.back(), allocated_width, allocated_height, samples, Gfx::FramebufferAttachment::DepthStencil,
+			shared_depth_stencil);
+		SetActiveSize(fb_layers.back());
+		num_framebuffers_created += 1;
 	}
 
 	layers_size += 1;
@@ -2095,21 +3043,90 @@ void RenderInterface_GL3::RenderLayerStack::SwapPostprocessPrimarySecondary()
 	std::swap(fb_postprocess[0], fb_postprocess[1]);
 }
 
-void RenderInterface_GL3::RenderLayerStack::BeginFrame(int new_width, int new_height)
+void RenderInterface_GL3::RenderLayerStack::Swap(RenderLayerStack& other)
+{
+	std::swap(width, other.width);
+	std::swap(height, other.height);
+	std::swap(allocated_width, other.allocated_width);
+	std::swap(allocated_height, other.allocated_height);
+	std::swap(samples, other.samples);
+	std::swap(last_resize_time, other.last_resize_time);
+	std::swap(num_resizes, other.num_resizes);
+	std::swap(num_reallocations, other.num_reallocations);
+	std::swap(num_framebuffers_created, other.num_framebuffers_created);
+	std::swap(layers_size, other.layers_size);
+	fb_layers.swap(other.fb_layers);
+	fb_postprocess.swap(other.fb_postprocess);
+}
+
+void RenderInterface_GL3::RenderLayerStack::BeginFrame(int new_width, int new_height, int new_samples)
 {
 	RMLUI_ASSERT(layers_size == 0);
 
-	if (new_width != width || new_height != height)
+	const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+	const bool resized = (new_width != width || new_height != height);
+	if (resized)
 	{
 		width = new_width;
 		height = new_height;
+		last_resize_time = now;
+		num_resizes += 1;
+	}
 
+	const bool exceeds_allocation = (width > allocated_width || height > allocated_height);
+	const bool settled = (std::chrono::duration<double>(now - last_resize_time).count() >= RESIZE_SETTLE_TIME);
+	const bool oversized = (width != allocated_width || height != allocated_height);
+
+	if (new_samples != samples || exceeds_allocation || (settled && oversized))
+	{
 		DestroyFramebuffers();
+		samples = new_samples;
+		num_reallocations += 1;
+
+		// Make room to grow while the size is still changing, the first allocation and settled sizes get exact framebuffers instead.
+		const bool bucketed = (exceeds_allocation && !settled && allocated_width > 0);
+		auto round_up = [](int size) { return ((size + RESIZE_BUCKET_SIZE - 1) / RESIZE_BUCKET_SIZE) * RESIZE_BUCKET_SIZE; };
+		allocated_width = (bucketed ? Rml::Math::Max(round_up(width), allocated_width) : width);
+		allocated_height = (bucketed ? Rml::Math::Max(round_up(height), allocated_height) : height);
+	}
+	else if (resized)
+	{
+		for (Gfx::FramebufferData& fb : fb_layers)
+			SetActiveSize(fb);
+		for (Gfx::FramebufferData& fb : fb_postprocess)
+		{
+			if (fb.framebuffer)
+				SetActiveSize(fb);
+		}
 	}
 
 	PushLayer();
 }
 
+Rml::Vector2f RenderInterface_GL3::RenderLayerStack::GetUVScale() const
+{
+	return Rml::Vector2f(float(width), float(height)) / Rml::Vector2f(float(allocated_width), float(allocated_height));
+}
+
+RenderInterface_GL3::RenderTargetReport RenderInterface_GL3::RenderLayerStack::GetReport() const
+{
+	RenderTargetReport report = {};
+	report.width = width;
+	report.height = height;
+	report.allocated_width = allocated_width;
+	report.allocated_height = allocated_height;
+	report.num_resizes = num_resizes;
+	report.num_reallocations = num_reallocations;
+	report.num_framebuffers_created = num_framebuffers_created;
+	return report;
+}
+
+void RenderInterface_GL3::RenderLayerStack::SetActiveSize(Gfx::FramebufferData& fb) const
+{
+	fb.width = width;
+	fb.height = height;
+}
+
 void RenderInterface_GL3::RenderLayerStack::EndFrame()
 {
 	RMLUI_ASSERT(layers_size == 1);
@@ -2134,10 +3151,271 @@ const Gfx::FramebufferData& RenderInterface_GL3::RenderLayerStack::EnsureFramebu
 	RMLUI_ASSERT(index < (int)fb_postprocess.size())
 	Gfx::FramebufferData& fb = fb_postprocess[index];
 	if (!fb.framebuffer)
-		Gfx::CreateFramebuffer(fb, width, height, 0, Gfx::FramebufferAttachment::None, 0);
+	{
+		Gfx::CreateFramebuffer(fb, allocated_width, allocated_height, 0, Gfx::FramebufferAttachment::None, 0);
+		SetActiveSize(fb);
+		num_framebuffers_created += 1;
+	}
 	return fb;
 }
 
+RenderInterface_GL3::TextureResidencyManager::~TextureResidencyManager()
+{
+	for (Gfx::TextureData* texture : textures)
+	{
+		if (texture->texture_id)
+			glDeleteTextures(1, &texture->texture_id);
+		delete texture;
+	}
+}
+
+Rml::TextureHandle RenderInterface_GL3::TextureResidencyManager::Register(unsigned int texture_id, Rml::Vector2i dimensions, int num_levels,
+	const Rml::String& source)
+{
+	Gfx::TextureData* texture = new Gfx::TextureData{};
+	texture->texture_id = texture_id;
+	texture->dimensions = dimensions;
+	texture->num_levels = num_levels;
+	texture->byte_size = Gfx::GetTextureByteSize(dimensions, num_levels);
+	texture->source = source;
+	texture->last_used_frame = frame_index;
+
+	textures.insert(texture);
+	if (!source.empty())
+		textures_by_source[source] = texture;
+	resident_bytes += texture->byte_size;
+
+	return reinterpret_cast<Rml::TextureHandle>(texture);
+}
+
+void RenderInterface_GL3::TextureResidencyManager::Release(Rml::TextureHandle texture_handle)
+{
+	Gfx::TextureData* texture = reinterpret_cast<Gfx::TextureData*>(texture_handle);
+	if (texture->texture_id)
+	{
+		glDeleteTextures(1, &texture->texture_id);
+		resident_bytes -= texture->byte_size;
+	}
+
+	auto it_source = textures_by_source.find(texture->source);
+	if (it_source != textures_by_source.end() && it_source->second == texture)
+		textures_by_source.erase(it_source);
+
+	textures.erase(texture);
+	delete texture;
+}
+
+unsigned int RenderInterface_GL3::TextureResidencyManager::MakeResident(Rml::TextureHandle texture_handle)
+{
+	Gfx::TextureData& texture = *reinterpret_cast<Gfx::TextureData*>(texture_handle);
+	texture.last_used_frame = frame_index;
+
+	if (!texture.texture_id && !texture.reload_failed)
+	{
+		Rml::Vector2i dimensions;
+		int num_levels = 1;
+		texture.texture_id = LoadTextureFromSource(dimensions, num_levels, texture.source);
+
+		if (texture.texture_id && dimensions == texture.dimensions && num_levels == texture.num_levels)
+		{
+			resident_bytes += texture.byte_size;
+			total_reloads += 1;
+		}
+		else
+		{
+			// The source changed or disappeared since it was first loaded, we can't substitute it for the original texture.
+			Rml::Log::Message(Rml::Log::LT_ERROR, "Could not reload evicted texture '%s'.", texture.source.c_str());
+			if (texture.texture_id)
+				glDeleteTextures(1, &texture.texture_id);
+			texture.texture_id = 0;
+			texture.reload_failed = true;
+		}
+	}
+
+	return texture.texture_id;
+}
+
+Rml::TextureHandle RenderInterface_GL3::TextureResidencyManager::Find(const Rml::String& source) const
+{
+	auto it = textures_by_source.find(source);
+	if (it == textures_by_source.end())
+		return {};
+	return reinterpret_cast<Rml::TextureHandle>(it->second);
+}
+
+void RenderInterface_GL3::TextureResidencyManager::BeginFrame()
+{
+	frame_index += 1;
+}
+
+void RenderInterface_GL3::TextureResidencyManager::EndFrame()
+{
+	if (budget > 0 && resident_bytes > budget)
+		EvictToBudget();
+}
+
+void RenderInterface_GL3::TextureResidencyManager::EvictToBudget()
+{
+	// Only consider textures that can be reloaded, and that were not drawn during the current frame.
+	Rml::Vector<Gfx::TextureData*> candidates;
+	for (Gfx::TextureData* texture : textures)
+	{
+		if (texture->texture_id && !texture->source.empty() && texture->last_used_frame < frame_index)
+			candidates.push_back(texture);
+	}
+
+	std::sort(candidates.begin(), candidates.end(),
+		[](const Gfx::TextureData* a, const Gfx::TextureData* b) { return a->last_used_frame < b->last_used_frame; });
+
+	for (Gfx::TextureData* texture : candidates)
+	{
+		if (resident_bytes <= budget)
+			break;
+
+		glDeleteTextures(1, &texture->texture_id);
+		texture->texture_id = 0;
+		resident_bytes -= texture->byte_size;
+		total_evictions += 1;
+	}
+}
+
+RenderInterface_GL3::TextureMemoryReport RenderInterface_GL3::TextureResidencyManager::GetReport() const
+{
+	TextureMemoryReport report = {};
+	report.budget_bytes = budget;
+	report.resident_bytes = resident_bytes;
+	report.num_textures = (int)textures.size();
+	report.total_evictions = total_evictions;
+	report.total_reloads = total_reloads;
+
+	for (const Gfx::TextureData* texture : textures)
+	{
+		if (texture->texture_id)
+		{
+			report.num_resident += 1;
+			if (!texture->source.empty())
+				report.evictable_bytes += texture->byte_size;
+		}
+		else
+		{
+			report.num_evicted += 1;
+		}
+	}
+
+	return report;
+}
+
+static double GetCpuTime()
+{
+	using namespace std::chrono;
+	return duration<double>(steady_clock::now().time_since_epoch()).count();
+}
+
+RenderInterface_GL3::FrameTimer::~FrameTimer()
+{
+	if (queries[0])
+		glDeleteQueries(NumQueries, queries);
+}
+
+void RenderInterface_GL3::FrameTimer::BeginFrame()
+{
+	cpu_begin_time = GetCpuTime();
+
+#ifndef RMLUI_PLATFORM_EMSCRIPTEN
+	if (!queries[0])
+		glGenQueries(NumQueries, queries);
+
+	// Collect results from earlier frames without waiting for the GPU.
+	for (int i = 0; i < NumQueries; i++)
+	{
+		const int index = (query_index + i) % NumQueries;
+		if (!query_pending[index])
+			continue;
+
+		GLint available = 0;
+		glGetQueryObjectiv(queries[index], GL_QUERY_RESULT_AVAILABLE, &available);
+		if (!available)
+			break;
+
+		GLuint64 elapsed_ns = 0;
+		glGetQueryObjectui64v(queries[index], GL_QUERY_RESULT, &elapsed_ns);
+		gpu_frame_ms = double(elapsed_ns) * 1.0e-6;
+		query_pending[index] = false;
+	}
+
+	// Skip measuring this frame if the GPU is more than a few frames behind.
+	query_active = !query_pending[query_index];
+	if (query_active)
+		glBeginQuery(GL_TIME_ELAPSED, queries[query_index]);
+#endif
+}
+
+void RenderInterface_GL3::FrameTimer::EndFrame()
+{
+#ifndef RMLUI_PLATFORM_EMSCRIPTEN
+	if (query_active)
+	{
+		glEndQuery(GL_TIME_ELAPSED);
+		query_pending[query_index] = true;
+		query_index = (query_index + 1) % NumQueries;
+		query_active = false;
+	}
+#endif
+
+	cpu_frame_ms = (GetCpuTime() - cpu_begin_time) * 1000.0;
+}
+
+void RenderInterface_GL3::RenderQualityController::SetBudget(double new_budget_ms)
+{
+	budget_ms = Rml::Math::Max(new_budget_ms, 0.0);
+	smoothed_frame_ms = 0.0;
+	frames_over_budget = 0;
+	frames_under_budget = 0;
+}
+
+bool RenderInterface_GL3::RenderQualityController::Update(double frame_ms)
+{
+	// Smoothing factor for the frame time, so that single slow frames, such as when loading a document, are not acted upon.
+	constexpr double smoothing = 0.1;
+	// Only raise the quality when the frame time is well within budget, this gap prevents flickering between two levels.
+	constexpr double raise_threshold = 0.75;
+	constexpr int frames_to_lower = 15;
+	constexpr int frames_to_raise = 90;
+	constexpr int frames_to_settle = 30;
+
+	smoothed_frame_ms = (smoothed_frame_ms <= 0.0 ? frame_ms : smoothed_frame_ms + smoothing * (frame_ms - smoothed_frame_ms));
+
+	if (settle_frames > 0)
+	{
+		settle_frames -= 1;
+		return false;
+	}
+
+	frames_over_budget = (smoothed_frame_ms > budget_ms ? frames_over_budget + 1 : 0);
+	frames_under_budget = (smoothed_frame_ms < budget_ms * raise_threshold ? frames_under_budget + 1 : 0);
+
+	int new_level = level;
+	if (frames_over_budget >= frames_to_lower && level > 0)
+		new_level = level - 1;
+	else if (frames_under_budget >= frames_to_raise && level < NUM_RENDER_QUALITY_LEVELS - 1)
+		new_level = level + 1;
+
+	if (new_level == level)
+		return false;
+
+	SetLevel(new_level);
+	settle_frames = frames_to_settle;
+	num_changes += 1;
+	return true;
+}
+
+void RenderInterface_GL3::RenderQualityController::SetLevel(int new_level)
+{
+	level = Rml::Math::Clamp(new_level, 0, NUM_RENDER_QUALITY_LEVELS - 1);
+	frames_over_budget = 0;
+	frames_under_budget = 0;
+}
+
 bool RmlGL3::Initialize(Rml::String* out_message)
 {
 #if defined RMLUI_PLATFORM_EMSCRIPTEN
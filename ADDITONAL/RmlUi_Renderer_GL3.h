@@ -31,7 +31,11 @@
 
 #include <RmlUi/Core/RenderInterface.h>
 #include <RmlUi/Core/Types.h>
-#include <bitset>
+#include <chrono>
+
+namespace Rml {
+class Context;
+}
 
 enum class ProgramId;
 enum class UniformId;
@@ -39,6 +43,9 @@ class RenderLayerStack;
 namespace Gfx {
 struct ProgramData;
 struct FramebufferData;
+struct CompiledGeometryData;
+struct TextureData;
+struct QuadInstanceBufferData;
 } // namespace Gfx
 
 class RenderInterface_GL3 : public Rml::RenderInterface {
@@ -57,9 +64,149 @@ public:
 	// Draws the result to the backbuffer and restores OpenGL state.
 	void EndFrame();
 
+	// Used in place of BeginFrame() and EndFrame() when the application draws the frame itself, and the user interface is only rendered
+	// into texture targets and composited. Runs the per-frame work of the renderer, i.e. texture residency, frame timing and adaptive
+	// render quality, without taking over the framebuffer. The frame time covers everything rendered in between.
+	void BeginHostFrame();
+	void EndHostFrame();
+
 	// Optional, can be used to clear the active framebuffer.
 	void Clear();
 
+	struct TextureMemoryReport {
+		size_t budget_bytes;    // Zero when eviction is disabled.
+		size_t resident_bytes;  // Texture memory currently held on the GPU.
+		size_t evictable_bytes; // Resident memory of textures that can be reloaded from their source.
+		int num_textures;
+		int num_resident;
+		int num_evicted;
+		size_t total_evictions;
+		size_t total_reloads;
+	};
+
+	// Sets the texture memory budget in bytes. When exceeded at the end of a frame, textures loaded from file which were not drawn during
+	// the frame are evicted in least-recently-used order, and transparently reloaded from their source when drawn again. Zero disables
+	// eviction, which is the default.
+	void SetTextureMemoryBudget(size_t budget_bytes);
+	TextureMemoryReport GetTextureMemoryReport() const;
+
+	// Returns the handle of a texture previously loaded through LoadTexture() from the given source, or zero if not loaded.
+	Rml::TextureHandle FindLoadedTexture(const Rml::String& source) const;
+
+	struct RenderQuality {
+		int msaa_samples;    // Samples of the multisampled layers, zero disables multisampling along with the resolve steps it requires.
+		int blur_downsample; // Additional downscaling passes before blurring, trading blur quality for speed.
+		float layer_scale;   // Resolution of the layers relative to the viewport, in the range (0, 1].
+	};
+	struct RenderQualityReport {
+		RenderQuality quality; // Quality applied to the current or last rendered frame.
+		int level;             // Adaptive quality level, or -1 when the quality was set manually.
+		int num_levels;
+		double frame_budget_ms;
+		double cpu_frame_ms; // CPU time spent between BeginFrame() and EndFrame() during the last frame.
+		double gpu_frame_ms; // GPU time of the most recently measured frame.
+		size_t num_level_changes;
+	};
+
+	// Sets the render quality explicitly and disables adaptive quality. Takes effect from the next frame.
+	void SetRenderQuality(RenderQuality quality);
+	// Enables adaptive render quality. Between frames, the quality is lowered or raised one level at a time to keep the frame time within
+	// the budget, given in milliseconds. The frame time is the larger of the CPU and GPU time spent rendering a frame. Zero disables it.
+	void SetFrameTimeBudget(double budget_ms);
+	RenderQualityReport GetRenderQualityReport() const;
+
+	struct RenderTargetReport {
+		int width, height;                     // Size of the area rendered to in the layer framebuffers.
+		int allocated_width, allocated_height; // Size of the layer framebuffers, larger than the rendered area while the size is changing.
+		size_t num_resizes;                    // Frames rendered at a different size than the previous frame.
+		size_t num_reallocations;              // Times the layer and postprocess framebuffers were recreated.
+		size_t num_framebuffers_created;
+	};
+
+	// Reports how the layer framebuffers of the main frame follow changes to the viewport size and render quality.
+	RenderTargetReport GetRenderTargetReport() const;
+
+	struct UniformReport {
+		size_t num_shared_uniform_uploads; // Uploads of the uniform buffer holding the transform and viewport size shared by all programs.
+		size_t num_program_switches;
+		size_t num_transform_submissions; // Draws submitting their translation.
+	};
+
+	// Uploads the shared uniforms again after every program switch, as required when each program holds its own transform uniform.
+	// Only intended for measuring the uploads saved by sharing the uniform buffer, disabled by default.
+	void SetSharedUniformsPerProgram(bool per_program);
+	// The counters accumulate over the lifetime of the renderer.
+	UniformReport GetUniformReport() const;
+
+	struct QuadInstance {
+		Rml::Vector2f position; // Top-left corner, relative to the translation given when rendering.
+		Rml::Vector2f size;
+		Rml::Vector2f tex_coord_min;
+		Rml::Vector2f tex_coord_max;
+		Rml::ColourbPremultiplied colour;
+	};
+
+	// Draws textured quads using a single unit quad geometry and per-instance attributes, without compiling any geometry. Instances
+	// are queued and submitted with one instanced draw call, consecutive calls using the same texture are merged into the same draw.
+	// The queue is flushed whenever any other render command is issued, so the current render state applies as usual.
+	void RenderQuadInstances(Rml::Span<const QuadInstance> instances, Rml::Vector2f translation, Rml::TextureHandle texture);
+
+	// Texture targets render a context into a caller-owned texture instead of the backbuffer, such as for UI panels placed in a 3D
+	// scene. Each target has its own layer stack sized to the texture, while programs, geometry and textures are shared with the main
+	// frame and all other targets. The texture must be a complete GL_RGBA8 texture of the given size, and the context should have the
+	// same dimensions. Its contents are premultiplied alpha and stored bottom-up, as usual for OpenGL render targets.
+	using TextureTargetHandle = uintptr_t;
+
+	struct TextureTargetReport {
+		int num_targets;
+		size_t num_refreshes; // Number of times any target was rendered.
+		size_t num_skipped;   // Number of times rendering a target was skipped because nothing changed.
+	};
+
+	// Returns zero if the texture could not be attached to a framebuffer.
+	TextureTargetHandle CreateTextureTarget(unsigned int texture_id, int width, int height);
+	// Creates a target rendering into a texture owned by the renderer, which is reallocated when the target is resized.
+	TextureTargetHandle CreateTextureTarget(int width, int height);
+	void ReleaseTextureTarget(TextureTargetHandle target_handle);
+	// Call when the texture has been reallocated with new dimensions, the target is refreshed on the next render.
+	void ResizeTextureTarget(TextureTargetHandle target_handle, int width, int height);
+
+	// Forces the target to be refreshed at least every interval, in seconds. Zero disables periodic refreshes, which is the default.
+	void SetTextureTargetRefreshInterval(TextureTargetHandle target_handle, double interval);
+	// Marks the target for refresh on its next render. Call this after submitting input to the context, which may change its appearance
+	// without the context requesting an update, such as when hovering elements.
+	void InvalidateTextureTarget(TextureTargetHandle target_handle);
+
+	// Renders the context into the texture of the target, if the target was invalidated, the update delay last requested by the context
+	// has elapsed, or the refresh interval has elapsed. The context should be updated beforehand, and the time should be given on the
+	// same clock as the system interface. Must be called outside of BeginFrame() and EndFrame(). Returns true if the texture was rendered.
+	bool RenderTextureTarget(TextureTargetHandle target_handle, Rml::Context* context, double current_time);
+
+	TextureTargetReport GetTextureTargetReport() const;
+
+	// Draws the texture of the target over the whole default framebuffer with a single quad, blending its premultiplied alpha. Used to
+	// composite a cached user interface over every host frame, while the target itself is only rendered when needed. Must be called
+	// outside of BeginFrame() and EndFrame().
+	void CompositeTextureTarget(TextureTargetHandle target_handle);
+
+	// Reads back the texture of the target as premultiplied RGBA rows from top to bottom, such as for comparing the output against
+	// another renderer. Stalls until the GPU has finished rendering the target. Must be called outside of BeginFrame() and EndFrame().
+	void ReadTextureTarget(TextureTargetHandle target_handle, Rml::Vector<Rml::byte>& pixels);
+
+	// Surfaces render into the default framebuffer of additional windows, whose GL contexts share objects with the context the renderer
+	// was constructed in. Programs, geometry, textures and texture targets are shared with the main frame, while each surface has its own
+	// layer stack and vertex array objects, as framebuffers and vertex arrays are never shared between contexts. Create, render and
+	// release a surface with its own context current, the renderer's context must be current again for all other calls.
+	using SurfaceHandle = uintptr_t;
+
+	SurfaceHandle CreateSurface();
+	void ReleaseSurface(SurfaceHandle surface_handle);
+
+	// Used in place of BeginFrame() and EndFrame() to render a context into the surface, the size is given in pixels. Must be called
+	// outside of the main frame.
+	void BeginSurfaceFrame(SurfaceHandle surface_handle, int width, int height);
+	void EndSurfaceFrame();
+
 	// -- Inherited from Rml::RenderInterface --
 
 	Rml::CompiledGeometryHandle CompileGeometry(Rml::Span<const Rml::Vertex> vertices, Rml::Span<const int> indices) override;
@@ -110,13 +257,38 @@ private:
 
 	void SetScissor(Rml::Rectanglei region, bool vertically_flip = false);
 
+	void ApplyRenderQuality();
+	Rml::Rectanglei ToRenderTarget(Rml::Rectanglei region) const;
+
+	// Fullscreen quads sample the rendered area of the layer framebuffers, scaled by this factor when they are larger than the area.
+	Rml::Vector2f layer_uv_scale = Rml::Vector2f(1.f);
+
 	void DrawFullscreenQuad();
 	void DrawFullscreenQuad(Rml::Vector2f uv_offset, Rml::Vector2f uv_scaling = Rml::Vector2f(1.f));
 
 	void RenderBlur(float sigma, const Gfx::FramebufferData& source_destination, const Gfx::FramebufferData& temp, Rml::Rectanglei window_flipped);
 
-	static constexpr size_t MaxNumPrograms = 32;
-	std::bitset<MaxNumPrograms> program_transform_dirty;
+	void BindTextureHandle(Rml::TextureHandle texture_handle);
+
+	// Returns the vertex array object for drawing the geometry in the current GL context, creating it on first use.
+	unsigned int GetGeometryVAO(Gfx::CompiledGeometryData& geometry);
+	unsigned int GetQuadInstanceVAO();
+
+	void FlushQuadInstances();
+
+	void BackupGLState();
+	void RestoreGLState();
+	// Sets up the GL state and the layer stack for rendering into the active layer stack at the current target size.
+	void BeginRenderTarget();
+	// Draws the top layer to the default framebuffer of the current context and ends the frame of the layer stack.
+	void DrawLayersToBackbuffer();
+	// Ends the frame of the texture residency and the frame timer, and adapts the render quality to the measured frame time.
+	void EndFrameTracking();
+
+	unsigned int shared_uniform_buffer = 0;
+	bool shared_uniforms_dirty = true;
+	bool shared_uniforms_per_program = false;
+	UniformReport uniform_report = {};
 
 	Rml::Matrix4f transform;
 	Rml::Matrix4f projection;
@@ -127,10 +299,23 @@ private:
 	int viewport_width = 0;
 	int viewport_height = 0;
 
+	// Size of the layers and postprocessing framebuffers, the viewport scaled by the layer scale of the active render quality.
+	int target_width = 0;
+	int target_height = 0;
+
+	RenderQuality render_quality = {};
+	RenderQuality active_render_quality = {};
+	bool render_quality_manual = false;
+	int max_msaa_samples = 0;
+
 	Rml::CompiledGeometryHandle fullscreen_quad_geometry = {};
 
 	Rml::UniquePtr<const Gfx::ProgramData> program_data;
 
+	Rml::UniquePtr<Gfx::QuadInstanceBufferData> quad_instance_buffer;
+	Rml::Vector<QuadInstance> quad_instances;
+	Rml::TextureHandle quad_instances_texture = {};
+
 	/*
 	    Manages render targets, including the layer stack and postprocessing framebuffers.
 
@@ -162,14 +347,31 @@ private:
 
 		void SwapPostprocessPrimarySecondary();
 
-		void BeginFrame(int new_width, int new_height);
+		// Exchanges all framebuffers and state with another stack, used to render texture targets with their own stack.
+		void Swap(RenderLayerStack& other);
+
+		// Framebuffers are recreated when the number of samples has changed, or the size has grown beyond the allocated framebuffers.
+		// While the size keeps changing, framebuffers are allocated in larger buckets and rendered to partially, and only recreated at
+		// the exact size once the size has settled.
+		void BeginFrame(int new_width, int new_height, int new_samples);
 		void EndFrame();
 
+		Rml::Vector2f GetUVScale() const;
+		RenderTargetReport GetReport() const;
+
 	private:
 		void DestroyFramebuffers();
 		const Gfx::FramebufferData& EnsureFramebufferPostprocess(int index);
+		void SetActiveSize(Gfx::FramebufferData& fb) const;
 
 		int width = 0, height = 0;
+		int allocated_width = 0, allocated_height = 0;
+		int samples = 0;
+
+		std::chrono::steady_clock::time_point last_resize_time;
+		size_t num_resizes = 0;
+		size_t num_reallocations = 0;
+		size_t num_framebuffers_created = 0;
 
 		// The number of active layers is manually tracked since we re-use the framebuffers stored in the fb_layers stack.
 		int layers_size = 0;
@@ -180,6 +382,142 @@ private:
 
 	RenderLayerStack render_layers;
 
+	struct TextureTarget {
+		unsigned int texture_id;
+		unsigned int framebuffer;
+		int width, height;
+		bool owns_texture;
+
+		// Swapped with the main layer stack while the target is being rendered.
+		RenderLayerStack layers;
+
+		double refresh_interval;
+		double last_render_time;
+		double next_update_time; // Time at which the update delay requested by the context during the last render elapses.
+		bool invalidated;
+	};
+
+	Rml::Vector<Rml::UniquePtr<TextureTarget>> texture_targets;
+	size_t num_texture_target_refreshes = 0;
+	size_t num_texture_target_skips = 0;
+
+	struct Surface {
+		// Swapped with the main layer stack while the surface is being rendered.
+		RenderLayerStack layers;
+
+		Rml::UnorderedMap<const Gfx::CompiledGeometryData*, unsigned int> geometry_vaos;
+		unsigned int quad_instance_vao;
+
+		// Vertex arrays of geometry released while another context was current, deleted the next time the surface is rendered.
+		Rml::Vector<unsigned int> released_vaos;
+
+		int main_viewport_width, main_viewport_height;
+		int main_target_width, main_target_height;
+	};
+
+	Rml::Vector<Rml::UniquePtr<Surface>> surfaces;
+	// The surface currently being rendered, or null when the renderer's own context is current.
+	Surface* active_surface = nullptr;
+	// Vertex arrays of the renderer's context, from geometry released while a surface was being rendered.
+	Rml::Vector<unsigned int> released_vaos;
+
+	/*
+	    Owns the renderer's textures and accounts for their GPU memory.
+
+	    Texture handles given to RmlUi point to a texture record rather than the GL texture itself, so that the GL storage of textures
+	    loaded from file can be dropped when over budget, and recreated from the source when the texture is next drawn. Generated textures
+	    have no source to reload from, they are accounted for but never evicted.
+	*/
+	class TextureResidencyManager {
+	public:
+		~TextureResidencyManager();
+
+		Rml::TextureHandle Register(unsigned int texture_id, Rml::Vector2i dimensions, int num_levels, const Rml::String& source);
+		void Release(Rml::TextureHandle texture_handle);
+
+		// Returns the GL texture of the given handle, reloading it from its source if it has been evicted.
+		unsigned int MakeResident(Rml::TextureHandle texture_handle);
+
+		Rml::TextureHandle Find(const Rml::String& source) const;
+
+		void BeginFrame();
+		void EndFrame();
+
+		void SetBudget(size_t budget_bytes) { budget = budget_bytes; }
+		TextureMemoryReport GetReport() const;
+
+	private:
+		void EvictToBudget();
+
+		Rml::UnorderedSet<Gfx::TextureData*> textures;
+		Rml::UnorderedMap<Rml::String, Gfx::TextureData*> textures_by_source;
+
+		uint64_t frame_index = 0;
+		size_t budget = 0;
+		size_t resident_bytes = 0;
+		size_t total_evictions = 0;
+		size_t total_reloads = 0;
+	};
+
+	TextureResidencyManager texture_residency;
+
+	/*
+	    Measures the CPU time spent rendering each frame, and the GPU time using timer queries which are read back a few frames later to
+	    avoid stalling the pipeline.
+	*/
+	class FrameTimer {
+	public:
+		~FrameTimer();
+
+		void BeginFrame();
+		void EndFrame();
+
+		double GetCpuFrameTime() const { return cpu_frame_ms; }
+		double GetGpuFrameTime() const { return gpu_frame_ms; }
+
+	private:
+		static constexpr int NumQueries = 4;
+		unsigned int queries[NumQueries] = {};
+		bool query_pending[NumQueries] = {};
+		int query_index = 0;
+		bool query_active = false;
+
+		double cpu_begin_time = 0.0;
+		double cpu_frame_ms = 0.0;
+		double gpu_frame_ms = 0.0;
+	};
+
+	FrameTimer frame_timer;
+
+	/*
+	    Chooses a render quality level from the measured frame times. The quality is lowered when the smoothed frame time stays over
+	    budget, and only raised again when it stays well within budget for a longer time. Each change is followed by a settling period,
+	    during which the framebuffers are rebuilt and new measurements come in.
+	*/
+	class RenderQualityController {
+	public:
+		void SetBudget(double new_budget_ms);
+		double GetBudget() const { return budget_ms; }
+
+		// Submits the frame time of the last frame, returns true if the quality level changed.
+		bool Update(double frame_ms);
+
+		void SetLevel(int new_level);
+		int GetLevel() const { return level; }
+		size_t GetNumChanges() const { return num_changes; }
+
+	private:
+		double budget_ms = 0.0;
+		double smoothed_frame_ms = 0.0;
+		int level = 0;
+		int frames_over_budget = 0;
+		int frames_under_budget = 0;
+		int settle_frames = 0;
+		size_t num_changes = 0;
+	};
+
+	RenderQualityController quality_controller;
+
 	struct GLStateBackup {
 		bool enable_cull_face;
 		bool enable_blend;
@@ -0,0 +1,235 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include "RmlUi_Renderer_Null.h"
+#include "BakedTexture.h"
+#include <RmlUi/Core/Core.h>
+#include <RmlUi/Core/FileInterface.h>
+#include <RmlUi/Core/Log.h>
+#include <string.h>
+
+static void Accumulate(RenderInterface_Null::FrameStatistics& total, const RenderInterface_Null::FrameStatistics& frame)
+{
+	total.num_compile_geometry_calls += frame.num_compile_geometry_calls;
+	total.num_release_geometry_calls += frame.num_release_geometry_calls;
+	total.num_render_geometry_calls += frame.num_render_geometry_calls;
+	total.num_compiled_vertices += frame.num_compiled_vertices;
+	total.num_compiled_indices += frame.num_compiled_indices;
+	total.num_rendered_vertices += frame.num_rendered_vertices;
+	total.num_rendered_indices += frame.num_rendered_indices;
+	total.num_texture_loads += frame.num_texture_loads;
+	total.num_texture_generations += frame.num_texture_generations;
+	total.num_texture_releases += frame.num_texture_releases;
+	total.texture_bytes += frame.texture_bytes;
+	total.num_scissor_changes += frame.num_scissor_changes;
+	total.num_clip_mask_renders += frame.num_clip_mask_renders;
+	total.num_transform_changes += frame.num_transform_changes;
+	total.num_layers_pushed += frame.num_layers_pushed;
+	total.num_layer_composites += frame.num_layer_composites;
+	total.num_filters_compiled += frame.num_filters_compiled;
+	total.num_filters_applied += frame.num_filters_applied;
+	total.num_shaders_compiled += frame.num_shaders_compiled;
+	total.num_shader_renders += frame.num_shader_renders;
+}
+
+// Reads only the start of the file to find the texture dimensions, the pixel data is never decoded.
+static bool ReadTextureDimensions(const Rml::String& source, Rml::Vector2i& out_dimensions)
+{
+	Rml::FileInterface* file_interface = Rml::GetFileInterface();
+	Rml::FileHandle file_handle = file_interface->Open(source);
+	if (!file_handle)
+		return false;
+
+	Rml::byte header[sizeof(BakedTexture::FileHeader)] = {};
+	const size_t read_size = file_interface->Read(header, sizeof(header), file_handle);
+	file_interface->Close(file_handle);
+
+	if (BakedTexture::IsBakedTextureSource(source))
+	{
+		BakedTexture::FileHeader file_header;
+		if (read_size < sizeof(file_header))
+			return false;
+		memcpy(&file_header, header, sizeof(file_header));
+		out_dimensions = Rml::Vector2i((int)file_header.width, (int)file_header.height);
+		return true;
+	}
+
+	// Uncompressed TGA, the width and height are stored as 16-bit little-endian values at offset 12.
+	constexpr size_t tga_header_size = 18;
+	if (read_size < tga_header_size || header[2] != 2)
+	{
+		Rml::Log::Message(Rml::Log::LT_ERROR, "Only 24/32bit uncompressed TGAs are supported.");
+		return false;
+	}
+
+	out_dimensions = Rml::Vector2i(int(header[12]) | (int(header[13]) << 8), int(header[14]) | (int(header[15]) << 8));
+	return true;
+}
+
+RenderInterface_Null::RenderInterface_Null() {}
+
+void RenderInterface_Null::EndFrame()
+{
+	last_frame = frame;
+	Accumulate(total, frame);
+	frame = {};
+}
+
+Rml::CompiledGeometryHandle RenderInterface_Null::CompileGeometry(Rml::Span<const Rml::Vertex> vertices, Rml::Span<const int> indices)
+{
+	frame.num_compile_geometry_calls += 1;
+	frame.num_compiled_vertices += vertices.size();
+	frame.num_compiled_indices += indices.size();
+	num_geometries += 1;
+
+	GeometryView* data = new GeometryView{vertices, indices};
+	return reinterpret_cast<Rml::CompiledGeometryHandle>(data);
+}
+
+void RenderInterface_Null::RenderGeometry(Rml::CompiledGeometryHandle handle, Rml::Vector2f /*translation*/, Rml::TextureHandle /*texture*/)
+{
+	const GeometryView* geometry = reinterpret_cast<const GeometryView*>(handle);
+	frame.num_render_geometry_calls += 1;
+	frame.num_rendered_vertices += geometry->vertices.size();
+	frame.num_rendered_indices += geometry->indices.size();
+}
+
+void RenderInterface_Null::ReleaseGeometry(Rml::CompiledGeometryHandle handle)
+{
+	frame.num_release_geometry_calls += 1;
+	num_geometries -= 1;
+	delete reinterpret_cast<GeometryView*>(handle);
+}
+
+Rml::TextureHandle RenderInterface_Null::LoadTexture(Rml::Vector2i& texture_dimensions, const Rml::String& source)
+{
+	if (!ReadTextureDimensions(source, texture_dimensions))
+		return {};
+
+	frame.num_texture_loads += 1;
+	frame.texture_bytes += size_t(texture_dimensions.x) * size_t(texture_dimensions.y) * 4;
+	num_textures += 1;
+	return Rml::TextureHandle(next_handle++);
+}
+
+Rml::TextureHandle RenderInterface_Null::GenerateTexture(Rml::Span<const Rml::byte> source_data, Rml::Vector2i /*source_dimensions*/)
+{
+	frame.num_texture_generations += 1;
+	frame.texture_bytes += source_data.size();
+	num_textures += 1;
+	return Rml::TextureHandle(next_handle++);
+}
+
+void RenderInterface_Null::ReleaseTexture(Rml::TextureHandle /*texture_handle*/)
+{
+	frame.num_texture_releases += 1;
+	num_textures -= 1;
+}
+
+void RenderInterface_Null::EnableScissorRegion(bool /*enable*/)
+{
+	frame.num_scissor_changes += 1;
+}
+
+void RenderInterface_Null::SetScissorRegion(Rml::Rectanglei /*region*/)
+{
+	frame.num_scissor_changes += 1;
+}
+
+void RenderInterface_Null::EnableClipMask(bool /*enable*/) {}
+
+void RenderInterface_Null::RenderToClipMask(Rml::ClipMaskOperation /*mask_operation*/, Rml::CompiledGeometryHandle geometry,
+	Rml::Vector2f /*translation*/)
+{
+	const GeometryView* view = reinterpret_cast<const GeometryView*>(geometry);
+	frame.num_clip_mask_renders += 1;
+	frame.num_rendered_vertices += view->vertices.size();
+	frame.num_rendered_indices += view->indices.size();
+}
+
+void RenderInterface_Null::SetTransform(const Rml::Matrix4f* /*transform*/)
+{
+	frame.num_transform_changes += 1;
+}
+
+Rml::LayerHandle RenderInterface_Null::PushLayer()
+{
+	frame.num_layers_pushed += 1;
+	num_layers += 1;
+	return Rml::LayerHandle(num_layers);
+}
+
+void RenderInterface_Null::CompositeLayers(Rml::LayerHandle /*source*/, Rml::LayerHandle /*destination*/, Rml::BlendMode /*blend_mode*/,
+	Rml::Span<const Rml::CompiledFilterHandle> filters)
+{
+	frame.num_layer_composites += 1;
+	frame.num_filters_applied += (int)filters.size();
+}
+
+void RenderInterface_Null::PopLayer()
+{
+	num_layers -= 1;
+}
+
+Rml::TextureHandle RenderInterface_Null::SaveLayerAsTexture()
+{
+	frame.num_texture_generations += 1;
+	num_textures += 1;
+	return Rml::TextureHandle(next_handle++);
+}
+
+Rml::CompiledFilterHandle RenderInterface_Null::SaveLayerAsMaskImage()
+{
+	frame.num_filters_compiled += 1;
+	return Rml::CompiledFilterHandle(next_handle++);
+}
+
+Rml::CompiledFilterHandle RenderInterface_Null::CompileFilter(const Rml::String& /*name*/, const Rml::Dictionary& /*parameters*/)
+{
+	frame.num_filters_compiled += 1;
+	return Rml::CompiledFilterHandle(next_handle++);
+}
+
+void RenderInterface_Null::ReleaseFilter(Rml::CompiledFilterHandle /*filter*/) {}
+
+Rml::CompiledShaderHandle RenderInterface_Null::CompileShader(const Rml::String& /*name*/, const Rml::Dictionary& /*parameters*/)
+{
+	frame.num_shaders_compiled += 1;
+	return Rml::CompiledShaderHandle(next_handle++);
+}
+
+void RenderInterface_Null::RenderShader(Rml::CompiledShaderHandle /*shader_handle*/, Rml::CompiledGeometryHandle geometry_handle,
+	Rml::Vector2f /*translation*/, Rml::TextureHandle /*texture*/)
+{
+	const GeometryView* geometry = reinterpret_cast<const GeometryView*>(geometry_handle);
+	frame.num_shader_renders += 1;
+	frame.num_rendered_vertices += geometry->vertices.size();
+	frame.num_rendered_indices += geometry->indices.size();
+}
+
+void RenderInterface_Null::ReleaseShader(Rml::CompiledShaderHandle /*shader_handle*/) {}
@@ -0,0 +1,134 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef RMLUI_BACKENDS_RENDERER_NULL_H
+#define RMLUI_BACKENDS_RENDERER_NULL_H
+
+#include <RmlUi/Core/RenderInterface.h>
+#include <RmlUi/Core/Types.h>
+
+/**
+    Render interface that renders nothing, for measuring the CPU cost of RmlUi itself.
+
+    Compiled geometry only references the spans passed in by RmlUi, and textures are never decoded, only their dimensions are read from
+    the file header. All calls are counted per frame.
+ */
+class RenderInterface_Null : public Rml::RenderInterface {
+public:
+	struct FrameStatistics {
+		int num_compile_geometry_calls = 0;
+		int num_release_geometry_calls = 0;
+		int num_render_geometry_calls = 0;
+		size_t num_compiled_vertices = 0;
+		size_t num_compiled_indices = 0;
+		size_t num_rendered_vertices = 0;
+		size_t num_rendered_indices = 0;
+
+		int num_texture_loads = 0;
+		int num_texture_generations = 0;
+		int num_texture_releases = 0;
+		size_t texture_bytes = 0; // Bytes of texture data loaded or generated.
+
+		int num_scissor_changes = 0;
+		int num_clip_mask_renders = 0;
+		int num_transform_changes = 0;
+
+		int num_layers_pushed = 0;
+		int num_layer_composites = 0;
+		int num_filters_compiled = 0;
+		int num_filters_applied = 0;
+		int num_shaders_compiled = 0;
+		int num_shader_renders = 0;
+	};
+
+	RenderInterface_Null();
+
+	// Ends the current frame. Its counters include all calls made since the previous frame ended, and can then be retrieved with
+	// GetLastFrameStatistics().
+	void EndFrame();
+
+	const FrameStatistics& GetLastFrameStatistics() const { return last_frame; }
+	// Counters accumulated over all frames.
+	const FrameStatistics& GetTotalStatistics() const { return total; }
+
+	// Number of geometries and textures currently alive.
+	int GetNumGeometries() const { return num_geometries; }
+	int GetNumTextures() const { return num_textures; }
+
+	// -- Inherited from Rml::RenderInterface --
+
+	Rml::CompiledGeometryHandle CompileGeometry(Rml::Span<const Rml::Vertex> vertices, Rml::Span<const int> indices) override;
+	void RenderGeometry(Rml::CompiledGeometryHandle handle, Rml::Vector2f translation, Rml::TextureHandle texture) override;
+	void ReleaseGeometry(Rml::CompiledGeometryHandle handle) override;
+
+	Rml::TextureHandle LoadTexture(Rml::Vector2i& texture_dimensions, const Rml::String& source) override;
+	Rml::TextureHandle GenerateTexture(Rml::Span<const Rml::byte> source_data, Rml::Vector2i source_dimensions) override;
+	void ReleaseTexture(Rml::TextureHandle texture_handle) override;
+
+	void EnableScissorRegion(bool enable) override;
+	void SetScissorRegion(Rml::Rectanglei region) override;
+
+	void EnableClipMask(bool enable) override;
+	void RenderToClipMask(Rml::ClipMaskOperation mask_operation, Rml::CompiledGeometryHandle geometry, Rml::Vector2f translation) override;
+
+	void SetTransform(const Rml::Matrix4f* transform) override;
+
+	Rml::LayerHandle PushLayer() override;
+	void CompositeLayers(Rml::LayerHandle source, Rml::LayerHandle destination, Rml::BlendMode blend_mode,
+		Rml::Span<const Rml::CompiledFilterHandle> filters) override;
+	void PopLayer() override;
+
+	Rml::TextureHandle SaveLayerAsTexture() override;
+
+	Rml::CompiledFilterHandle SaveLayerAsMaskImage() override;
+
+	Rml::CompiledFilterHandle CompileFilter(const Rml::String& name, const Rml::Dictionary& parameters) override;
+	void ReleaseFilter(Rml::CompiledFilterHandle filter) override;
+
+	Rml::CompiledShaderHandle CompileShader(const Rml::String& name, const Rml::Dictionary& parameters) override;
+	void RenderShader(Rml::CompiledShaderHandle shader_handle, Rml::CompiledGeometryHandle geometry_handle, Rml::Vector2f translation,
+		Rml::TextureHandle texture) override;
+	void ReleaseShader(Rml::CompiledShaderHandle shader_handle) override;
+
+private:
+	struct GeometryView {
+		Rml::Span<const Rml::Vertex> vertices;
+		Rml::Span<const int> indices;
+	};
+
+	FrameStatistics frame;
+	FrameStatistics last_frame;
+	FrameStatistics total;
+
+	int num_geometries = 0;
+	int num_textures = 0;
+	int num_layers = 0;
+	uintptr_t next_handle = 1;
+};
+
+#endif
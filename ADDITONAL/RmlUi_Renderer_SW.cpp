@@ -0,0 +1,1332 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include "RmlUi_Renderer_SW.h"
+#include "BakedTexture.h"
+#include <RmlUi/Core/Core.h>
+#include <RmlUi/Core/DecorationTypes.h>
+#include <RmlUi/Core/FileInterface.h>
+#include <RmlUi/Core/Log.h>
+#include <RmlUi/Core/Math.h>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <math.h>
+#include <mutex>
+#include <string.h>
+#include <thread>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#include <emmintrin.h>
+	#define RMLUI_SW_SSE2
+#endif
+#if defined(__AVX2__)
+	#include <immintrin.h>
+	#define RMLUI_SW_AVX2
+#endif
+
+// Tiles are square, one tile is rasterized by a single thread at a time.
+static constexpr int TileSize = 64;
+
+/**
+    Minimal fork-join thread pool, the calling thread works on the job alongside the workers.
+ */
+class SoftwareThreadPool {
+public:
+	explicit SoftwareThreadPool(int num_threads)
+	{
+		for (int i = 0; i < num_threads - 1; i++)
+			workers.emplace_back([this] { WorkerMain(); });
+	}
+	~SoftwareThreadPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			quit = true;
+		}
+		wake_condition.notify_all();
+		for (std::thread& worker : workers)
+			worker.join();
+	}
+
+	// Calls the function for every index in [0, count), returns when all calls have completed.
+	void ParallelFor(int count, const std::function<void(int)>& function)
+	{
+		if (count <= 0)
+			return;
+
+		if (workers.empty() || count == 1)
+		{
+			for (int i = 0; i < count; i++)
+				function(i);
+			return;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			job = &function;
+			job_count = count;
+			next_index = 0;
+			num_busy_workers = (int)workers.size();
+			generation += 1;
+		}
+		wake_condition.notify_all();
+
+		RunJob();
+
+		std::unique_lock<std::mutex> lock(mutex);
+		done_condition.wait(lock, [this] { return num_busy_workers == 0; });
+		job = nullptr;
+	}
+
+private:
+	void WorkerMain()
+	{
+		uint64_t seen_generation = 0;
+		while (true)
+		{
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				wake_condition.wait(lock, [&] { return quit || generation != seen_generation; });
+				if (quit)
+					return;
+				seen_generation = generation;
+			}
+
+			RunJob();
+
+			std::lock_guard<std::mutex> lock(mutex);
+			num_busy_workers -= 1;
+			if (num_busy_workers == 0)
+				done_condition.notify_one();
+		}
+	}
+
+	void RunJob()
+	{
+		for (int i = next_index.fetch_add(1); i < job_count; i = next_index.fetch_add(1))
+			(*job)(i);
+	}
+
+	Rml::Vector<std::thread> workers;
+	std::mutex mutex;
+	std::condition_variable wake_condition;
+	std::condition_variable done_condition;
+
+	const std::function<void(int)>* job = nullptr;
+	int job_count = 0;
+	std::atomic<int> next_index{0};
+	int num_busy_workers = 0;
+	uint64_t generation = 0;
+	bool quit = false;
+};
+
+enum class FilterType { Invalid = 0, Passthrough, Blur, DropShadow, ColorMatrix, MaskImage };
+
+struct RenderInterface_SW::Geometry {
+	Rml::Span<const Rml::Vertex> vertices;
+	Rml::Span<const int> indices;
+};
+
+struct RenderInterface_SW::Texture {
+	Image pixels;
+	int width = 0;
+	int height = 0;
+};
+
+struct RenderInterface_SW::Filter {
+	FilterType type;
+	float blend_factor;
+	float sigma;
+	Rml::Vector2f offset;
+	Rml::ColourbPremultiplied color;
+	Rml::Matrix4f color_matrix;
+};
+
+struct RenderInterface_SW::Command {
+	CommandType type;
+	const Texture* texture;
+	bool clip_mask_test;
+	bool clip_mask_increment;
+	uint8_t clip_mask_reference;
+};
+
+struct RenderInterface_SW::Triangle {
+	uint32_t command;
+	// Pixel bounds, already clipped to the scissor region.
+	int x0, y0, x1, y1;
+	// Edge functions 'a*x + b*y + c', positive inside the triangle. Pixels exactly on an edge belong to the triangle only if the edge is
+	// marked as owning them, so that pixels on edges shared by two triangles are drawn once.
+	float edge_a[3], edge_b[3], edge_c[3];
+	bool edge_owns[3];
+	// Attribute planes 'p[0]*x + p[1]*y + p[2]'. With perspective, the attributes are divided by w and 'inv_w' restores them.
+	float inv_w[3];
+	float tex_coord[2][3];
+	float color[4][3];
+	bool perspective;
+};
+
+struct RenderInterface_SW::ScreenVertex {
+	float x, y, inv_w;
+};
+
+static inline uint32_t Div255(uint32_t value)
+{
+	value += 128;
+	return (value + (value >> 8)) >> 8;
+}
+
+static inline uint32_t PackColor(uint32_t r, uint32_t g, uint32_t b, uint32_t a)
+{
+	return r | (g << 8) | (b << 16) | (a << 24);
+}
+
+static inline uint32_t ToColorChannel(float value)
+{
+	return (uint32_t)Rml::Math::Clamp(int(value + 0.5f), 0, 255);
+}
+
+// Multiplies each channel of the two premultiplied colors.
+static inline uint32_t Modulate(uint32_t a, uint32_t b)
+{
+	uint32_t result = 0;
+	for (int shift = 0; shift < 32; shift += 8)
+		result |= Div255(((a >> shift) & 0xff) * ((b >> shift) & 0xff)) << shift;
+	return result;
+}
+
+static inline uint32_t ScaleColor(uint32_t color, uint32_t factor)
+{
+	return Modulate(color, factor * 0x01010101u);
+}
+
+static inline uint32_t BlendPixel(uint32_t source, uint32_t destination)
+{
+	const uint32_t inverse_alpha = 255 - (source >> 24);
+	uint32_t result = 0;
+	for (int shift = 0; shift < 32; shift += 8)
+	{
+		const uint32_t channel = ((source >> shift) & 0xff) + Div255(((destination >> shift) & 0xff) * inverse_alpha);
+		result |= Rml::Math::Min(channel, 255u) << shift;
+	}
+	return result;
+}
+
+#ifdef RMLUI_SW_SSE2
+static inline __m128i Div255_SSE2(__m128i value)
+{
+	value = _mm_add_epi16(value, _mm_set1_epi16(128));
+	return _mm_srli_epi16(_mm_add_epi16(value, _mm_srli_epi16(value, 8)), 8);
+}
+
+// Spreads the alpha of each pixel over all four of its channels, as '255 - alpha'.
+static inline __m128i InverseAlpha_SSE2(__m128i pixels)
+{
+	__m128i alpha = _mm_srli_epi32(pixels, 24);
+	alpha = _mm_or_si128(alpha, _mm_slli_epi32(alpha, 8));
+	alpha = _mm_or_si128(alpha, _mm_slli_epi32(alpha, 16));
+	return _mm_sub_epi8(_mm_set1_epi8(-1), alpha);
+}
+
+static inline __m128i BlendPixels_SSE2(__m128i source, __m128i destination)
+{
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i inverse_alpha = InverseAlpha_SSE2(source);
+
+	const __m128i low = Div255_SSE2(_mm_mullo_epi16(_mm_unpacklo_epi8(destination, zero), _mm_unpacklo_epi8(inverse_alpha, zero)));
+	const __m128i high = Div255_SSE2(_mm_mullo_epi16(_mm_unpackhi_epi8(destination, zero), _mm_unpackhi_epi8(inverse_alpha, zero)));
+
+	return _mm_adds_epu8(source, _mm_packus_epi16(low, high));
+}
+#endif
+
+#ifdef RMLUI_SW_AVX2
+static inline __m256i Div255_AVX2(__m256i value)
+{
+	value = _mm256_add_epi16(value, _mm256_set1_epi16(128));
+	return _mm256_srli_epi16(_mm256_add_epi16(value, _mm256_srli_epi16(value, 8)), 8);
+}
+
+static inline __m256i BlendPixels_AVX2(__m256i source, __m256i destination)
+{
+	const __m256i zero = _mm256_setzero_si256();
+
+	__m256i alpha = _mm256_srli_epi32(source, 24);
+	alpha = _mm256_or_si256(alpha, _mm256_slli_epi32(alpha, 8));
+	alpha = _mm256_or_si256(alpha, _mm256_slli_epi32(alpha, 16));
+	const __m256i inverse_alpha = _mm256_sub_epi8(_mm256_set1_epi8(-1), alpha);
+
+	// Unpacking and packing both work within 128-bit lanes, so the pixel order is preserved.
+	const __m256i low = Div255_AVX2(_mm256_mullo_epi16(_mm256_unpacklo_epi8(destination, zero), _mm256_unpacklo_epi8(inverse_alpha, zero)));
+	const __m256i high = Div255_AVX2(_mm256_mullo_epi16(_mm256_unpackhi_epi8(destination, zero), _mm256_unpackhi_epi8(inverse_alpha, zero)));
+
+	return _mm256_adds_epu8(source, _mm256_packus_epi16(low, high));
+}
+#endif
+
+// Blends premultiplied source pixels over the destination pixels. Fully transparent source pixels leave the destination unchanged.
+static void BlendSpan(uint32_t* destination, const uint32_t* source, int count)
+{
+	int i = 0;
+
+#if defined(RMLUI_SW_AVX2)
+	for (; i + 8 <= count; i += 8)
+	{
+		const __m256i src = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i));
+		const __m256i dst = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(destination + i));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i), BlendPixels_AVX2(src, dst));
+	}
+#endif
+#if defined(RMLUI_SW_SSE2)
+	for (; i + 4 <= count; i += 4)
+	{
+		const __m128i src = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+		const __m128i dst = _mm_loadu_si128(reinterpret_cast<const __m128i*>(destination + i));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), BlendPixels_SSE2(src, dst));
+	}
+#endif
+
+	for (; i < count; i++)
+		destination[i] = BlendPixel(source[i], destination[i]);
+}
+
+// Samples the texture with bilinear filtering and repeat wrapping, matching GL_LINEAR with GL_REPEAT.
+static uint32_t SampleBilinear(const uint32_t* pixels, int width, int height, float u, float v)
+{
+	const float fx = Rml::Math::Clamp(u * float(width) - 0.5f, -1.0e6f, 1.0e6f);
+	const float fy = Rml::Math::Clamp(v * float(height) - 0.5f, -1.0e6f, 1.0e6f);
+	const float floor_x = floorf(fx);
+	const float floor_y = floorf(fy);
+
+	int x0 = int(floor_x) % width;
+	int y0 = int(floor_y) % height;
+	if (x0 < 0)
+		x0 += width;
+	if (y0 < 0)
+		y0 += height;
+	const int x1 = (x0 + 1 == width ? 0 : x0 + 1);
+	const int y1 = (y0 + 1 == height ? 0 : y0 + 1);
+
+	// Eight bits of sub-texel precision, the four weights always add up to 256.
+	const int wx = int((fx - floor_x) * 256.f + 0.5f);
+	const int wy = int((fy - floor_y) * 256.f + 0.5f);
+	const int w11 = (wx * wy) >> 8;
+	const int w10 = wx - w11;
+	const int w01 = wy - w11;
+	const int w00 = 256 - wx - wy + w11;
+
+	const uint32_t t00 = pixels[y0 * width + x0];
+	const uint32_t t10 = pixels[y0 * width + x1];
+	const uint32_t t01 = pixels[y1 * width + x0];
+	const uint32_t t11 = pixels[y1 * width + x1];
+
+#ifdef RMLUI_SW_SSE2
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i row0 = _mm_unpacklo_epi8(_mm_unpacklo_epi32(_mm_cvtsi32_si128((int)t00), _mm_cvtsi32_si128((int)t10)), zero);
+	const __m128i row1 = _mm_unpacklo_epi8(_mm_unpacklo_epi32(_mm_cvtsi32_si128((int)t01), _mm_cvtsi32_si128((int)t11)), zero);
+	const __m128i weights0 = _mm_set_epi16(short(w10), short(w10), short(w10), short(w10), short(w00), short(w00), short(w00), short(w00));
+	const __m128i weights1 = _mm_set_epi16(short(w11), short(w11), short(w11), short(w11), short(w01), short(w01), short(w01), short(w01));
+
+	// The weighted sum is at most 255 * 256, which still fits in the unsigned 16-bit lanes.
+	__m128i sum = _mm_add_epi16(_mm_mullo_epi16(row0, weights0), _mm_mullo_epi16(row1, weights1));
+	sum = _mm_add_epi16(sum, _mm_srli_si128(sum, 8));
+	sum = _mm_srli_epi16(sum, 8);
+	return (uint32_t)_mm_cvtsi128_si32(_mm_packus_epi16(sum, zero));
+#else
+	uint32_t result = 0;
+	for (int shift = 0; shift < 32; shift += 8)
+	{
+		const uint32_t channel = (((t00 >> shift) & 0xff) * w00 + ((t10 >> shift) & 0xff) * w10 + ((t01 >> shift) & 0xff) * w01 +
+			((t11 >> shift) & 0xff) * w11);
+		result |= (channel >> 8) << shift;
+	}
+	return result;
+#endif
+}
+
+static inline float EvaluatePlane(const float plane[3], float x, float y)
+{
+	return plane[0] * x + plane[1] * y + plane[2];
+}
+
+// Sets up the plane interpolating the given values at the three vertices, using the edge functions of the triangle.
+static void SetupPlane(float plane[3], const float edge_a[3], const float edge_b[3], const float edge_c[3], float inv_area, float v0, float v1,
+	float v2)
+{
+	// The edge opposite to each vertex weights the value of that vertex.
+	plane[0] = (v0 * edge_a[1] + v1 * edge_a[2] + v2 * edge_a[0]) * inv_area;
+	plane[1] = (v0 * edge_b[1] + v1 * edge_b[2] + v2 * edge_b[0]) * inv_area;
+	plane[2] = (v0 * edge_c[1] + v1 * edge_c[2] + v2 * edge_c[0]) * inv_area;
+}
+
+RenderInterface_SW::RenderInterface_SW(int num_threads)
+{
+	if (num_threads <= 0)
+		num_threads = Rml::Math::Max((int)std::thread::hardware_concurrency(), 1);
+
+	thread_pool = Rml::MakeUnique<SoftwareThreadPool>(num_threads);
+	transform = Rml::Matrix4f::Identity();
+}
+
+RenderInterface_SW::~RenderInterface_SW() {}
+
+void RenderInterface_SW::SetRenderTarget(Rml::byte* pixels, int width, int height, int stride)
+{
+	target_pixels = pixels;
+	target_stride = stride;
+	viewport_width = Rml::Math::Max(width, 0);
+	viewport_height = Rml::Math::Max(height, 0);
+
+	projection = Rml::Matrix4f::ProjectOrtho(0, (float)viewport_width, (float)viewport_height, 0, -10000, 10000);
+
+	num_tiles_x = (viewport_width + TileSize - 1) / TileSize;
+	num_tiles_y = (viewport_height + TileSize - 1) / TileSize;
+	tile_bins.resize(size_t(num_tiles_x * num_tiles_y));
+}
+
+void RenderInterface_SW::BeginFrame()
+{
+	RMLUI_ASSERT(target_pixels && viewport_width > 0 && viewport_height > 0);
+
+	clip_mask.assign(size_t(viewport_width * viewport_height), 0);
+
+	num_layers = 0;
+	PushLayer();
+
+	transform_enabled = false;
+	scissor_enabled = false;
+	clip_mask_enabled = false;
+	clip_mask_reference = 0;
+}
+
+void RenderInterface_SW::EndFrame()
+{
+	Flush();
+	RMLUI_ASSERT(num_layers == 1);
+
+	const Image& base_layer = layers[0];
+	for (int y = 0; y < viewport_height; y++)
+		memcpy(target_pixels + size_t(y) * target_stride, &base_layer[size_t(y * viewport_width)], size_t(viewport_width) * sizeof(uint32_t));
+}
+
+void RenderInterface_SW::Clear()
+{
+	Flush();
+
+	Image& layer = layers[num_layers - 1];
+	std::fill(layer.begin(), layer.end(), 0u);
+	std::fill(clip_mask.begin(), clip_mask.end(), uint8_t(0));
+}
+
+Rml::CompiledGeometryHandle RenderInterface_SW::CompileGeometry(Rml::Span<const Rml::Vertex> vertices, Rml::Span<const int> indices)
+{
+	Geometry* geometry = new Geometry{vertices, indices};
+	return reinterpret_cast<Rml::CompiledGeometryHandle>(geometry);
+}
+
+void RenderInterface_SW::RenderGeometry(Rml::CompiledGeometryHandle handle, Rml::Vector2f translation, Rml::TextureHandle texture)
+{
+	QueueGeometry(CommandType::Draw, *reinterpret_cast<const Geometry*>(handle), translation, reinterpret_cast<const Texture*>(texture));
+}
+
+void RenderInterface_SW::ReleaseGeometry(Rml::CompiledGeometryHandle handle)
+{
+	// Queued triangles keep their own copy of the transformed vertex data.
+	delete reinterpret_cast<Geometry*>(handle);
+}
+
+Rml::Rectanglei RenderInterface_SW::GetActiveRegion() const
+{
+	const Rml::Rectanglei viewport = Rml::Rectanglei::FromSize({viewport_width, viewport_height});
+	if (!scissor_enabled)
+		return viewport;
+
+	const Rml::Rectanglei region = scissor_region.IntersectIfValid(viewport);
+	return region.Valid() ? region : Rml::Rectanglei::FromSize({0, 0});
+}
+
+void RenderInterface_SW::QueueGeometry(CommandType type, const Geometry& geometry, Rml::Vector2f translation, const Texture* texture)
+{
+	const Rml::Rectanglei region = GetActiveRegion();
+	if (region.Width() <= 0 || region.Height() <= 0 || geometry.indices.empty())
+		return;
+
+	Command command = {};
+	command.type = type;
+	command.texture = texture;
+	command.clip_mask_test = (type == CommandType::Draw && clip_mask_enabled);
+	command.clip_mask_increment = false;
+	command.clip_mask_reference = uint8_t(clip_mask_reference);
+	if (type == CommandType::WriteClipMask)
+		command.clip_mask_increment = (clip_mask_operation == Rml::ClipMaskOperation::Intersect);
+
+	const uint32_t command_index = (uint32_t)commands.size();
+	commands.push_back(command);
+
+	// Transform all vertices to screen space up front, the triangles then only refer to them while being set up.
+	const Rml::Matrix4f full_transform = projection * transform;
+	screen_vertices.resize(geometry.vertices.size());
+	for (size_t i = 0; i < geometry.vertices.size(); i++)
+	{
+		const Rml::Vector2f position = geometry.vertices[i].position + translation;
+		ScreenVertex& out = screen_vertices[i];
+
+		if (!transform_enabled)
+		{
+			out = {position.x, position.y, 1.f};
+			continue;
+		}
+
+		const Rml::Vector4f clip = full_transform * Rml::Vector4f(position.x, position.y, 0.f, 1.f);
+		if (clip.w <= 1.0e-6f)
+		{
+			// Behind the viewer, triangles using this vertex are skipped.
+			out = {0.f, 0.f, 0.f};
+			continue;
+		}
+
+		const float inv_w = 1.f / clip.w;
+		out.x = (clip.x * inv_w * 0.5f + 0.5f) * float(viewport_width);
+		out.y = (0.5f - clip.y * inv_w * 0.5f) * float(viewport_height);
+		out.inv_w = inv_w;
+	}
+
+	const Rml::Span<const int> indices = geometry.indices;
+	for (size_t i = 0; i + 2 < indices.size(); i += 3)
+	{
+		int vertex_indices[3] = {indices[i], indices[i + 1], indices[i + 2]};
+		const ScreenVertex* v[3] = {&screen_vertices[vertex_indices[0]], &screen_vertices[vertex_indices[1]], &screen_vertices[vertex_indices[2]]};
+
+		if (v[0]->inv_w <= 0.f || v[1]->inv_w <= 0.f || v[2]->inv_w <= 0.f)
+			continue;
+
+		float area = (v[1]->x - v[0]->x) * (v[2]->y - v[0]->y) - (v[1]->y - v[0]->y) * (v[2]->x - v[0]->x);
+		if (area == 0.f || !(area == area))
+			continue;
+
+		// Use a consistent winding so that the edge functions are positive inside.
+		if (area < 0.f)
+		{
+			std::swap(v[1], v[2]);
+			std::swap(vertex_indices[1], vertex_indices[2]);
+			area = -area;
+		}
+
+		const float min_x = Rml::Math::Min(v[0]->x, Rml::Math::Min(v[1]->x, v[2]->x));
+		const float max_x = Rml::Math::Max(v[0]->x, Rml::Math::Max(v[1]->x, v[2]->x));
+		const float min_y = Rml::Math::Min(v[0]->y, Rml::Math::Min(v[1]->y, v[2]->y));
+		const float max_y = Rml::Math::Max(v[0]->y, Rml::Math::Max(v[1]->y, v[2]->y));
+
+		// Pixels are sampled at their centers.
+		Triangle triangle;
+		triangle.command = command_index;
+		triangle.x0 = Rml::Math::Max(region.Left(), (int)Rml::Math::Clamp(ceilf(min_x - 0.5f), -1.0e6f, 1.0e6f));
+		triangle.y0 = Rml::Math::Max(region.Top(), (int)Rml::Math::Clamp(ceilf(min_y - 0.5f), -1.0e6f, 1.0e6f));
+		triangle.x1 = Rml::Math::Min(region.Right(), (int)Rml::Math::Clamp(floorf(max_x - 0.5f), -1.0e6f, 1.0e6f) + 1);
+		triangle.y1 = Rml::Math::Min(region.Bottom(), (int)Rml::Math::Clamp(floorf(max_y - 0.5f), -1.0e6f, 1.0e6f) + 1);
+		if (triangle.x0 >= triangle.x1 || triangle.y0 >= triangle.y1)
+			continue;
+
+		for (int edge = 0; edge < 3; edge++)
+		{
+			const ScreenVertex& a = *v[edge];
+			const ScreenVertex& b = *v[(edge + 1) % 3];
+			triangle.edge_a[edge] = -(b.y - a.y);
+			triangle.edge_b[edge] = (b.x - a.x);
+			triangle.edge_c[edge] = -(triangle.edge_a[edge] * a.x + triangle.edge_b[edge] * a.y);
+			// Two triangles sharing an edge see it with opposite signs, so exactly one of them owns it.
+			triangle.edge_owns[edge] = (triangle.edge_a[edge] > 0.f || (triangle.edge_a[edge] == 0.f && triangle.edge_b[edge] > 0.f));
+		}
+
+		const float inv_area = 1.f / area;
+		const Rml::Vertex* vertex[3] = {&geometry.vertices[vertex_indices[0]], &geometry.vertices[vertex_indices[1]],
+			&geometry.vertices[vertex_indices[2]]};
+		const float w[3] = {v[0]->inv_w, v[1]->inv_w, v[2]->inv_w};
+
+		triangle.perspective = (w[0] != 1.f || w[1] != 1.f || w[2] != 1.f);
+
+		auto setup_plane = [&](float plane[3], float a0, float a1, float a2) {
+			SetupPlane(plane, triangle.edge_a, triangle.edge_b, triangle.edge_c, inv_area, a0 * w[0], a1 * w[1], a2 * w[2]);
+		};
+
+		setup_plane(triangle.inv_w, 1.f, 1.f, 1.f);
+		setup_plane(triangle.tex_coord[0], vertex[0]->tex_coord.x, vertex[1]->tex_coord.x, vertex[2]->tex_coord.x);
+		setup_plane(triangle.tex_coord[1], vertex[0]->tex_coord.y, vertex[1]->tex_coord.y, vertex[2]->tex_coord.y);
+		for (int channel = 0; channel < 4; channel++)
+			setup_plane(triangle.color[channel], vertex[0]->colour[channel], vertex[1]->colour[channel], vertex[2]->colour[channel]);
+
+		const uint32_t triangle_index = (uint32_t)triangles.size();
+		triangles.push_back(triangle);
+
+		for (int tile_y = triangle.y0 / TileSize; tile_y <= (triangle.y1 - 1) / TileSize; tile_y++)
+			for (int tile_x = triangle.x0 / TileSize; tile_x <= (triangle.x1 - 1) / TileSize; tile_x++)
+				tile_bins[size_t(tile_y * num_tiles_x + tile_x)].push_back(triangle_index);
+	}
+}
+
+void RenderInterface_SW::QueueClipMaskClear()
+{
+	const Rml::Rectanglei region = GetActiveRegion();
+	if (region.Width() <= 0 || region.Height() <= 0)
+		return;
+
+	Command command = {};
+	command.type = CommandType::ClearClipMask;
+	const uint32_t command_index = (uint32_t)commands.size();
+	commands.push_back(command);
+
+	Triangle clear = {};
+	clear.command = command_index;
+	clear.x0 = region.Left();
+	clear.y0 = region.Top();
+	clear.x1 = region.Right();
+	clear.y1 = region.Bottom();
+
+	const uint32_t triangle_index = (uint32_t)triangles.size();
+	triangles.push_back(clear);
+
+	for (int tile_y = clear.y0 / TileSize; tile_y <= (clear.y1 - 1) / TileSize; tile_y++)
+		for (int tile_x = clear.x0 / TileSize; tile_x <= (clear.x1 - 1) / TileSize; tile_x++)
+			tile_bins[size_t(tile_y * num_tiles_x + tile_x)].push_back(triangle_index);
+}
+
+void RenderInterface_SW::Flush()
+{
+	if (commands.empty())
+		return;
+
+	thread_pool->ParallelFor(num_tiles_x * num_tiles_y, [this](int tile_index) { RasterizeTile(tile_index); });
+
+	commands.clear();
+	triangles.clear();
+	for (Rml::Vector<uint32_t>& bin : tile_bins)
+		bin.clear();
+}
+
+void RenderInterface_SW::RasterizeTile(int tile_index)
+{
+	const Rml::Vector<uint32_t>& bin = tile_bins[tile_index];
+	if (bin.empty())
+		return;
+
+	Image& layer = layers[num_layers - 1];
+	const int tile_x0 = (tile_index % num_tiles_x) * TileSize;
+	const int tile_y0 = (tile_index / num_tiles_x) * TileSize;
+
+	uint32_t fragments[TileSize];
+
+	for (const uint32_t triangle_index : bin)
+	{
+		const Triangle& triangle = triangles[triangle_index];
+		const Command& command = commands[triangle.command];
+
+		const int x0 = Rml::Math::Max(triangle.x0, tile_x0);
+		const int y0 = Rml::Math::Max(triangle.y0, tile_y0);
+		const int x1 = Rml::Math::Min(triangle.x1, tile_x0 + TileSize);
+		const int y1 = Rml::Math::Min(triangle.y1, tile_y0 + TileSize);
+
+		if (command.type == CommandType::ClearClipMask)
+		{
+			for (int y = y0; y < y1; y++)
+				memset(&clip_mask[size_t(y * viewport_width + x0)], 0, size_t(x1 - x0));
+			continue;
+		}
+
+		const Texture* texture = command.texture;
+
+		for (int y = y0; y < y1; y++)
+		{
+			const float py = float(y) + 0.5f;
+			const float px0 = float(x0) + 0.5f;
+			float edge[3];
+			for (int i = 0; i < 3; i++)
+				edge[i] = triangle.edge_a[i] * px0 + triangle.edge_b[i] * py + triangle.edge_c[i];
+
+			const size_t row_offset = size_t(y * viewport_width);
+			int first = -1, last = -1;
+
+			for (int x = x0; x < x1; x++)
+			{
+				bool inside = true;
+				for (int i = 0; i < 3; i++)
+				{
+					inside &= (edge[i] > 0.f || (edge[i] == 0.f && triangle.edge_owns[i]));
+					edge[i] += triangle.edge_a[i];
+				}
+
+				const size_t pixel = row_offset + x;
+				if (inside && command.clip_mask_test)
+					inside = (clip_mask[pixel] == command.clip_mask_reference);
+
+				if (command.type == CommandType::WriteClipMask)
+				{
+					if (inside)
+						clip_mask[pixel] = (command.clip_mask_increment ? uint8_t(Rml::Math::Min(clip_mask[pixel] + 1, 255)) : uint8_t(1));
+					continue;
+				}
+
+				uint32_t& fragment = fragments[x - x0];
+				if (!inside)
+				{
+					fragment = 0;
+					continue;
+				}
+
+				if (first < 0)
+					first = x - x0;
+				last = x - x0;
+
+				const float fx = float(x) + 0.5f;
+				const float w = (triangle.perspective ? 1.f / EvaluatePlane(triangle.inv_w, fx, py) : 1.f);
+
+				uint32_t color = PackColor(ToColorChannel(EvaluatePlane(triangle.color[0], fx, py) * w),
+					ToColorChannel(EvaluatePlane(triangle.color[1], fx, py) * w), ToColorChannel(EvaluatePlane(triangle.color[2], fx, py) * w),
+					ToColorChannel(EvaluatePlane(triangle.color[3], fx, py) * w));
+
+				if (texture)
+				{
+					const float u = EvaluatePlane(triangle.tex_coord[0], fx, py) * w;
+					const float v = EvaluatePlane(triangle.tex_coord[1], fx, py) * w;
+					color = Modulate(color, SampleBilinear(texture->pixels.data(), texture->width, texture->height, u, v));
+				}
+
+				fragment = color;
+			}
+
+			if (first >= 0)
+				BlendSpan(&layer[row_offset + x0 + first], &fragments[first], last - first + 1);
+		}
+	}
+}
+
+void RenderInterface_SW::EnableScissorRegion(bool enable)
+{
+	scissor_enabled = enable;
+}
+
+void RenderInterface_SW::SetScissorRegion(Rml::Rectanglei region)
+{
+	scissor_region = region;
+}
+
+void RenderInterface_SW::EnableClipMask(bool enable)
+{
+	clip_mask_enabled = enable;
+}
+
+void RenderInterface_SW::RenderToClipMask(Rml::ClipMaskOperation operation, Rml::CompiledGeometryHandle geometry, Rml::Vector2f translation)
+{
+	using Rml::ClipMaskOperation;
+
+	if (operation == ClipMaskOperation::Set || operation == ClipMaskOperation::SetInverse)
+		QueueClipMaskClear();
+
+	clip_mask_operation = operation;
+	QueueGeometry(CommandType::WriteClipMask, *reinterpret_cast<const Geometry*>(geometry), translation, nullptr);
+
+	switch (operation)
+	{
+	case ClipMaskOperation::Set: clip_mask_reference = 1; break;
+	case ClipMaskOperation::SetInverse: clip_mask_reference = 0; break;
+	case ClipMaskOperation::Intersect: clip_mask_reference = Rml::Math::Min(clip_mask_reference + 1, 255); break;
+	}
+}
+
+void RenderInterface_SW::SetTransform(const Rml::Matrix4f* new_transform)
+{
+	transform_enabled = (new_transform != nullptr);
+	transform = (new_transform ? *new_transform : Rml::Matrix4f::Identity());
+}
+
+RenderInterface_SW::Image& RenderInterface_SW::GetLayer(Rml::LayerHandle handle)
+{
+	RMLUI_ASSERT((int)handle < num_layers);
+	return layers[handle];
+}
+
+Rml::LayerHandle RenderInterface_SW::PushLayer()
+{
+	Flush();
+
+	if ((int)layers.size() <= num_layers)
+		layers.emplace_back();
+
+	layers[num_layers].assign(size_t(viewport_width * viewport_height), 0u);
+	num_layers += 1;
+
+	return Rml::LayerHandle(num_layers - 1);
+}
+
+void RenderInterface_SW::PopLayer()
+{
+	Flush();
+	RMLUI_ASSERT(num_layers > 1);
+	num_layers -= 1;
+}
+
+void RenderInterface_SW::CompositeLayers(Rml::LayerHandle source_handle, Rml::LayerHandle destination_handle, Rml::BlendMode blend_mode,
+	Rml::Span<const Rml::CompiledFilterHandle> filters)
+{
+	Flush();
+
+	const Image* source = &GetLayer(source_handle);
+	if (!filters.empty() || source_handle == destination_handle)
+	{
+		// The filters only affect the active region, and sample nothing outside of it.
+		const Rml::Rectanglei region = GetActiveRegion();
+		postprocess_primary.resize(source->size());
+		for (int y = region.Top(); y < region.Bottom(); y++)
+		{
+			const size_t offset = size_t(y * viewport_width + region.Left());
+			memcpy(&postprocess_primary[offset], &(*source)[offset], size_t(region.Width()) * sizeof(uint32_t));
+		}
+
+		RenderFilters(filters);
+		source = &postprocess_primary;
+	}
+
+	CompositeImage(*source, GetLayer(destination_handle), blend_mode == Rml::BlendMode::Blend);
+}
+
+void RenderInterface_SW::CompositeImage(const Image& source, Image& destination, bool blend)
+{
+	const Rml::Rectanglei region = GetActiveRegion();
+	const bool clip_mask_test = clip_mask_enabled;
+	const uint8_t reference = uint8_t(clip_mask_reference);
+
+	thread_pool->ParallelFor(region.Height(), [&](int row) {
+		const int y = region.Top() + row;
+		const size_t offset = size_t(y * viewport_width + region.Left());
+		const int width = region.Width();
+
+		if (!clip_mask_test)
+		{
+			if (blend)
+				BlendSpan(&destination[offset], &source[offset], width);
+			else
+				memcpy(&destination[offset], &source[offset], size_t(width) * sizeof(uint32_t));
+			return;
+		}
+
+		for (int x = 0; x < width; x++)
+		{
+			if (clip_mask[offset + x] != reference)
+				continue;
+			destination[offset + x] = (blend ? BlendPixel(source[offset + x], destination[offset + x]) : source[offset + x]);
+		}
+	});
+}
+
+Rml::TextureHandle RenderInterface_SW::SaveLayerAsTexture()
+{
+	RMLUI_ASSERT(scissor_region.Valid());
+	Flush();
+
+	const Rml::Rectanglei bounds = GetActiveRegion();
+	if (bounds.Width() <= 0 || bounds.Height() <= 0)
+		return {};
+
+	Texture* texture = new Texture;
+	texture->width = bounds.Width();
+	texture->height = bounds.Height();
+	texture->pixels.resize(size_t(texture->width * texture->height));
+
+	const Image& layer = layers[num_layers - 1];
+	for (int y = 0; y < texture->height; y++)
+		memcpy(&texture->pixels[size_t(y * texture->width)], &layer[size_t((bounds.Top() + y) * viewport_width + bounds.Left())],
+			size_t(texture->width) * sizeof(uint32_t));
+
+	return reinterpret_cast<Rml::TextureHandle>(texture);
+}
+
+Rml::CompiledFilterHandle RenderInterface_SW::SaveLayerAsMaskImage()
+{
+	Flush();
+
+	blend_mask = layers[num_layers - 1];
+
+	Filter* filter = new Filter{};
+	filter->type = FilterType::MaskImage;
+	return reinterpret_cast<Rml::CompiledFilterHandle>(filter);
+}
+
+Rml::CompiledFilterHandle RenderInterface_SW::CompileFilter(const Rml::String& name, const Rml::Dictionary& parameters)
+{
+	Filter filter = {};
+	filter.color_matrix = Rml::Matrix4f::Identity();
+
+	if (name == "opacity")
+	{
+		filter.type = FilterType::Passthrough;
+		filter.blend_factor = Rml::Get(parameters, "value", 1.0f);
+	}
+	else if (name == "blur")
+	{
+		filter.type = FilterType::Blur;
+		filter.sigma = Rml::Get(parameters, "sigma", 1.0f);
+	}
+	else if (name == "drop-shadow")
+	{
+		filter.type = FilterType::DropShadow;
+		filter.sigma = Rml::Get(parameters, "sigma", 0.f);
+		filter.color = Rml::Get(parameters, "color", Rml::Colourb()).ToPremultiplied();
+		filter.offset = Rml::Get(parameters, "offset", Rml::Vector2f(0.f));
+	}
+	else if (name == "brightness")
+	{
+		filter.type = FilterType::ColorMatrix;
+		const float value = Rml::Get(parameters, "value", 1.0f);
+		filter.color_matrix = Rml::Matrix4f::Diag(value, value, value, 1.f);
+	}
+	else if (name == "contrast")
+	{
+		filter.type = FilterType::ColorMatrix;
+		const float value = Rml::Get(parameters, "value", 1.0f);
+		const float grayness = 0.5f - 0.5f * value;
+		filter.color_matrix = Rml::Matrix4f::Diag(value, value, value, 1.f);
+		filter.color_matrix.SetColumn(3, Rml::Vector4f(grayness, grayness, grayness, 1.f));
+	}
+	else if (name == "invert")
+	{
+		filter.type = FilterType::ColorMatrix;
+		const float value = Rml::Math::Clamp(Rml::Get(parameters, "value", 1.0f), 0.f, 1.f);
+		const float inverted = 1.f - 2.f * value;
+		filter.color_matrix = Rml::Matrix4f::Diag(inverted, inverted, inverted, 1.f);
+		filter.color_matrix.SetColumn(3, Rml::Vector4f(value, value, value, 1.f));
+	}
+	else if (name == "grayscale")
+	{
+		filter.type = FilterType::ColorMatrix;
+		const float value = Rml::Get(parameters, "value", 1.0f);
+		const float rev_value = 1.f - value;
+		const Rml::Vector3f gray = value * Rml::Vector3f(0.2126f, 0.7152f, 0.0722f);
+		// clang-format off
+		filter.color_matrix = Rml::Matrix4f::FromRows(
+			{gray.x + rev_value, gray.y,             gray.z,             0.f},
+			{gray.x,             gray.y + rev_value, gray.z,             0.f},
+			{gray.x,             gray.y,             gray.z + rev_value, 0.f},
+			{0.f,                0.f,                0.f,                1.f}
+		);
+		// clang-format on
+	}
+	else if (name == "sepia")
+	{
+		filter.type = FilterType::ColorMatrix;
+		const float value = Rml::Get(parameters, "value", 1.0f);
+		const float rev_value = 1.f - value;
+		const Rml::Vector3f r_mix = value * Rml::Vector3f(0.393f, 0.769f, 0.189f);
+		const Rml::Vector3f g_mix = value * Rml::Vector3f(0.349f, 0.686f, 0.168f);
+		const Rml::Vector3f b_mix = value * Rml::Vector3f(0.272f, 0.534f, 0.131f);
+		// clang-format off
+		filter.color_matrix = Rml::Matrix4f::FromRows(
+			{r_mix.x + rev_value, r_mix.y,             r_mix.z,             0.f},
+			{g_mix.x,             g_mix.y + rev_value, g_mix.z,             0.f},
+			{b_mix.x,             b_mix.y,             b_mix.z + rev_value, 0.f},
+			{0.f,                 0.f,                 0.f,                 1.f}
+		);
+		// clang-format on
+	}
+	else if (name == "hue-rotate")
+	{
+		// Hue-rotation and saturation values based on: https://www.w3.org/TR/filter-effects-1/#attr-valuedef-type-huerotate
+		filter.type = FilterType::ColorMatrix;
+		const float value = Rml::Get(parameters, "value", 1.0f);
+		const float s = Rml::Math::Sin(value);
+		const float c = Rml::Math::Cos(value);
+		// clang-format off
+		filter.color_matrix = Rml::Matrix4f::FromRows(
+			{0.213f + 0.787f * c - 0.213f * s,  0.715f - 0.715f * c - 0.715f * s,  0.072f - 0.072f * c + 0.928f * s,  0.f},
+			{0.213f - 0.213f * c + 0.143f * s,  0.715f + 0.285f * c + 0.140f * s,  0.072f - 0.072f * c - 0.283f * s,  0.f},
+			{0.213f - 0.213f * c - 0.787f * s,  0.715f - 0.715f * c + 0.715f * s,  0.072f + 0.928f * c + 0.072f * s,  0.f},
+			{0.f,                               0.f,                               0.f,                               1.f}
+		);
+		// clang-format on
+	}
+	else if (name == "saturate")
+	{
+		filter.type = FilterType::ColorMatrix;
+		const float value = Rml::Get(parameters, "value", 1.0f);
+		// clang-format off
+		filter.color_matrix = Rml::Matrix4f::FromRows(
+			{0.213f + 0.787f * value,  0.715f - 0.715f * value,  0.072f - 0.072f * value,  0.f},
+			{0.213f - 0.213f * value,  0.715f + 0.285f * value,  0.072f - 0.072f * value,  0.f},
+			{0.213f - 0.213f * value,  0.715f - 0.715f * value,  0.072f + 0.928f * value,  0.f},
+			{0.f,                      0.f,                      0.f,                      1.f}
+		);
+		// clang-format on
+	}
+
+	if (filter.type != FilterType::Invalid)
+		return reinterpret_cast<Rml::CompiledFilterHandle>(new Filter(std::move(filter)));
+
+	Rml::Log::Message(Rml::Log::LT_WARNING, "Unsupported filter type '%s'.", name.c_str());
+	return {};
+}
+
+void RenderInterface_SW::ReleaseFilter(Rml::CompiledFilterHandle filter)
+{
+	delete reinterpret_cast<Filter*>(filter);
+}
+
+void RenderInterface_SW::RenderFilters(Rml::Span<const Rml::CompiledFilterHandle> filter_handles)
+{
+	const Rml::Rectanglei region = GetActiveRegion();
+	if (region.Width() <= 0 || region.Height() <= 0)
+		return;
+
+	// Runs the function on every pixel of the active region of the image, in parallel over the rows.
+	auto for_each_pixel = [&](Image& image, auto&& function) {
+		thread_pool->ParallelFor(region.Height(), [&](int row) {
+			const int y = region.Top() + row;
+			for (int x = region.Left(); x < region.Right(); x++)
+				function(image[size_t(y * viewport_width + x)], x, y);
+		});
+	};
+
+	for (const Rml::CompiledFilterHandle filter_handle : filter_handles)
+	{
+		const Filter& filter = *reinterpret_cast<const Filter*>(filter_handle);
+
+		switch (filter.type)
+		{
+		case FilterType::Passthrough:
+		{
+			const uint32_t factor = ToColorChannel(filter.blend_factor * 255.f);
+			for_each_pixel(postprocess_primary, [&](uint32_t& pixel, int, int) { pixel = ScaleColor(pixel, factor); });
+		}
+		break;
+		case FilterType::Blur:
+		{
+			Blur(postprocess_primary, filter.sigma, region);
+		}
+		break;
+		case FilterType::DropShadow:
+		{
+			// The shadow is made from the alpha of the source, sampled at the offset position within the active region.
+			const int offset_x = int(roundf(filter.offset.x));
+			const int offset_y = int(roundf(filter.offset.y));
+			const uint32_t shadow_color = PackColor(filter.color.red, filter.color.green, filter.color.blue, filter.color.alpha);
+
+			postprocess_secondary.resize(postprocess_primary.size());
+			for_each_pixel(postprocess_secondary, [&](uint32_t& pixel, int x, int y) {
+				const int source_x = x - offset_x;
+				const int source_y = y - offset_y;
+				const bool in_region =
+					(source_x >= region.Left() && source_x < region.Right() && source_y >= region.Top() && source_y < region.Bottom());
+				pixel = (in_region ? ScaleColor(shadow_color, postprocess_primary[size_t(source_y * viewport_width + source_x)] >> 24) : 0u);
+			});
+
+			if (filter.sigma >= 0.5f)
+				Blur(postprocess_secondary, filter.sigma, region);
+
+			// Draw the source on top of its shadow.
+			thread_pool->ParallelFor(region.Height(), [&](int row) {
+				const size_t offset = size_t((region.Top() + row) * viewport_width + region.Left());
+				BlendSpan(&postprocess_secondary[offset], &postprocess_primary[offset], region.Width());
+			});
+			std::swap(postprocess_primary, postprocess_secondary);
+		}
+		break;
+		case FilterType::ColorMatrix:
+		{
+			// Like the GL3 renderer, only the color channels are transformed and this is done directly in premultiplied space.
+			float m[3][4];
+			for (int column = 0; column < 4; column++)
+			{
+				Rml::Vector4f basis;
+				basis[column] = 1.f;
+				const Rml::Vector4f result = filter.color_matrix * basis;
+				for (int row = 0; row < 3; row++)
+					m[row][column] = result[row];
+			}
+
+			for_each_pixel(postprocess_primary, [&](uint32_t& pixel, int, int) {
+				const float c[4] = {float(pixel & 0xff), float((pixel >> 8) & 0xff), float((pixel >> 16) & 0xff), float(pixel >> 24)};
+				uint32_t channels[3];
+				for (int row = 0; row < 3; row++)
+				{
+					const float value = m[row][0] * c[0] + m[row][1] * c[1] + m[row][2] * c[2] + m[row][3] * c[3];
+					channels[row] = ToColorChannel(Rml::Math::Min(value, c[3]));
+				}
+				pixel = PackColor(channels[0], channels[1], channels[2], pixel >> 24);
+			});
+		}
+		break;
+		case FilterType::MaskImage:
+		{
+			if (blend_mask.size() != postprocess_primary.size())
+				break;
+			for_each_pixel(postprocess_primary,
+				[&](uint32_t& pixel, int x, int y) { pixel = ScaleColor(pixel, blend_mask[size_t(y * viewport_width + x)] >> 24); });
+		}
+		break;
+		case FilterType::Invalid:
+		{
+			Rml::Log::Message(Rml::Log::LT_WARNING, "Unhandled render filter %d.", (int)filter.type);
+		}
+		break;
+		}
+	}
+}
+
+// Blurs a single line of pixels with the given kernel, clamping the samples to the line.
+static void BlurLine(uint32_t* destination, const uint32_t* source, int count, int stride, const Rml::Vector<int>& weights)
+{
+	const int radius = (int)weights.size() / 2;
+
+	for (int i = 0; i < count; i++)
+	{
+		uint32_t sum[4] = {};
+		for (int k = -radius; k <= radius; k++)
+		{
+			const int sample_index = Rml::Math::Clamp(i + k, 0, count - 1);
+			const uint32_t sample = source[size_t(sample_index) * stride];
+			const uint32_t weight = (uint32_t)weights[size_t(k + radius)];
+			sum[0] += (sample & 0xff) * weight;
+			sum[1] += ((sample >> 8) & 0xff) * weight;
+			sum[2] += ((sample >> 16) & 0xff) * weight;
+			sum[3] += (sample >> 24) * weight;
+		}
+
+		// The weights add up to 1 << 16.
+		destination[size_t(i) * stride] = PackColor(Rml::Math::Min((sum[0] + 0x8000) >> 16, 255u), Rml::Math::Min((sum[1] + 0x8000) >> 16, 255u),
+			Rml::Math::Min((sum[2] + 0x8000) >> 16, 255u), Rml::Math::Min((sum[3] + 0x8000) >> 16, 255u));
+	}
+}
+
+void RenderInterface_SW::Blur(Image& image, float sigma, Rml::Rectanglei region)
+{
+	if (sigma < 0.1f || region.Width() <= 0 || region.Height() <= 0)
+		return;
+
+	// Gaussian kernel in 16-bit fixed point. Large kernels are expensive on the CPU, so the radius is capped, matching the limited blur
+	// size of the GPU renderers which instead downscale for large sigma.
+	constexpr int max_radius = 64;
+	const int radius = Rml::Math::Min(int(ceilf(3.f * sigma)), max_radius);
+
+	Rml::Vector<float> weights_float(size_t(2 * radius + 1));
+	float normalization = 0.f;
+	for (int i = -radius; i <= radius; i++)
+	{
+		weights_float[size_t(i + radius)] = expf(-float(i * i) / (2.f * sigma * sigma));
+		normalization += weights_float[size_t(i + radius)];
+	}
+
+	Rml::Vector<int> weights(weights_float.size());
+	int weight_sum = 0;
+	for (size_t i = 0; i < weights.size(); i++)
+	{
+		weights[i] = int(weights_float[i] / normalization * 65536.f + 0.5f);
+		weight_sum += weights[i];
+	}
+	weights[size_t(radius)] += (1 << 16) - weight_sum;
+
+	postprocess_tertiary.resize(image.size());
+
+	// Horizontal pass into the temporary image, then the vertical pass back into the image.
+	thread_pool->ParallelFor(region.Height(), [&](int row) {
+		const size_t offset = size_t((region.Top() + row) * viewport_width + region.Left());
+		BlurLine(&postprocess_tertiary[offset], &image[offset], region.Width(), 1, weights);
+	});
+	thread_pool->ParallelFor(region.Width(), [&](int column) {
+		const size_t offset = size_t(region.Top() * viewport_width + region.Left() + column);
+		BlurLine(&image[offset], &postprocess_tertiary[offset], region.Height(), viewport_width, weights);
+	});
+}
+
+// Set to byte packing, or the compiler will expand our struct, which means it won't read correctly from file
+#pragma pack(1)
+struct TGAHeader {
+	char idLength;
+	char colourMapType;
+	char dataType;
+	short int colourMapOrigin;
+	short int colourMapLength;
+	char colourMapDepth;
+	short int xOrigin;
+	short int yOrigin;
+	short int width;
+	short int height;
+	char bitsPerPixel;
+	char imageDescriptor;
+};
+// Restore packing
+#pragma pack()
+
+static bool LoadBakedTexture(Rml::Vector2i& texture_dimensions, Rml::Vector<Rml::byte>& out_pixels, const Rml::String& source)
+{
+	BakedTexture::MappedFile mapped_file;
+	Rml::Vector<Rml::byte> buffer;
+	Rml::Span<const Rml::byte> file_data;
+
+	if (mapped_file.Open(source))
+	{
+		file_data = mapped_file.GetData();
+	}
+	else
+	{
+		Rml::FileInterface* file_interface = Rml::GetFileInterface();
+		Rml::FileHandle file_handle = file_interface->Open(source);
+		if (!file_handle)
+			return false;
+
+		buffer.resize(file_interface->Length(file_handle));
+		const size_t read_size = file_interface->Read(buffer.data(), buffer.size(), file_handle);
+		file_interface->Close(file_handle);
+		buffer.resize(read_size);
+		file_data = buffer;
+	}
+
+	BakedTexture::Image image;
+	Rml::String error_message;
+	if (!BakedTexture::Parse(file_data, image, &error_message))
+	{
+		Rml::Log::Message(Rml::Log::LT_ERROR, "Could not load baked texture '%s': %s", source.c_str(), error_message.c_str());
+		return false;
+	}
+
+	// Only the base level is used, the rows are already premultiplied and stored top to bottom.
+	const BakedTexture::Level& level = image.levels[0];
+	texture_dimensions = {level.width, level.height};
+	out_pixels.assign(level.data, level.data + size_t(level.width * level.height * 4));
+	return true;
+}
+
+Rml::TextureHandle RenderInterface_SW::LoadTexture(Rml::Vector2i& texture_dimensions, const Rml::String& source)
+{
+	if (BakedTexture::IsBakedTextureSource(source))
+	{
+		Rml::Vector<Rml::byte> pixels;
+		if (!LoadBakedTexture(texture_dimensions, pixels, source))
+			return {};
+		return GenerateTexture(pixels, texture_dimensions);
+	}
+
+	Rml::FileInterface* file_interface = Rml::GetFileInterface();
+	Rml::FileHandle file_handle = file_interface->Open(source);
+	if (!file_handle)
+	{
+		return false;
+	}
+
+	file_interface->Seek(file_handle, 0, SEEK_END);
+	size_t buffer_size = file_interface->Tell(file_handle);
+	file_interface->Seek(file_handle, 0, SEEK_SET);
+
+	if (buffer_size <= sizeof(TGAHeader))
+	{
+		Rml::Log::Message(Rml::Log::LT_ERROR, "Texture file size is smaller than TGAHeader, file is not a valid TGA image.");
+		file_interface->Close(file_handle);
+		return false;
+	}
+
+	using Rml::byte;
+	Rml::UniquePtr<byte[]> buffer(new byte[buffer_size]);
+	file_interface->Read(buffer.get(), buffer_size, file_handle);
+	file_interface->Close(file_handle);
+
+	TGAHeader header;
+	memcpy(&header, buffer.get(), sizeof(TGAHeader));
+
+	int color_mode = header.bitsPerPixel / 8;
+	const size_t image_size = header.width * header.height * 4; // We always make 32bit textures
+
+	if (header.dataType != 2)
+	{
+		Rml::Log::Message(Rml::Log::LT_ERROR, "Only 24/32bit uncompressed TGAs are supported.");
+		return false;
+	}
+
+	// Ensure we have at least 3 colors
+	if (color_mode < 3)
+	{
+		Rml::Log::Message(Rml::Log::LT_ERROR, "Only 24 and 32bit textures are supported.");
+		return false;
+	}
+
+	const byte* image_src = buffer.get() + sizeof(TGAHeader);
+	Rml::UniquePtr<byte[]> image_dest_buffer(new byte[image_size]);
+	byte* image_dest = image_dest_buffer.get();
+
+	// Targa is BGR, swap to RGB, flip Y axis, and convert to premultiplied alpha.
+	for (long y = 0; y < header.height; y++)
+	{
+		long read_index = y * header.width * color_mode;
+		long write_index = ((header.imageDescriptor & 32) != 0) ? read_index : (header.height - y - 1) * header.width * 4;
+		for (long x = 0; x < header.width; x++)
+		{
+			image_dest[write_index] = image_src[read_index + 2];
+			image_dest[write_index + 1] = image_src[read_index + 1];
+			image_dest[write_index + 2] = image_src[read_index];
+			if (color_mode == 4)
+			{
+				const byte alpha = image_src[read_index + 3];
+				for (size_t j = 0; j < 3; j++)
+					image_dest[write_index + j] = byte((image_dest[write_index + j] * alpha) / 255);
+				image_dest[write_index + 3] = alpha;
+			}
+			else
+				image_dest[write_index + 3] = 255;
+
+			write_index += 4;
+			read_index += color_mode;
+		}
+	}
+
+	texture_dimensions.x = header.width;
+	texture_dimensions.y = header.height;
+
+	return GenerateTexture({image_dest, image_size}, texture_dimensions);
+}
+
+Rml::TextureHandle RenderInterface_SW::GenerateTexture(Rml::Span<const Rml::byte> source_data, Rml::Vector2i source_dimensions)
+{
+	if (source_dimensions.x <= 0 || source_dimensions.y <= 0)
+	{
+		Rml::Log::Message(Rml::Log::LT_ERROR, "Failed to generate texture, invalid dimensions %d x %d.", source_dimensions.x, source_dimensions.y);
+		return {};
+	}
+
+	Texture* texture = new Texture;
+	texture->width = source_dimensions.x;
+	texture->height = source_dimensions.y;
+	texture->pixels.resize(size_t(texture->width * texture->height));
+
+	if (source_data.size() >= texture->pixels.size() * sizeof(uint32_t))
+		memcpy(texture->pixels.data(), source_data.data(), texture->pixels.size() * sizeof(uint32_t));
+
+	return reinterpret_cast<Rml::TextureHandle>(texture);
+}
+
+void RenderInterface_SW::ReleaseTexture(Rml::TextureHandle texture_handle)
+{
+	// Queued draws may still sample from the texture.
+	Flush();
+	delete reinterpret_cast<Texture*>(texture_handle);
+}
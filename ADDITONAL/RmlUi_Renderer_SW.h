@@ -0,0 +1,150 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef RMLUI_BACKENDS_RENDERER_SW_H
+#define RMLUI_BACKENDS_RENDERER_SW_H
+
+#include <RmlUi/Core/RenderInterface.h>
+#include <RmlUi/Core/Types.h>
+
+class SoftwareThreadPool;
+
+/**
+    Render interface rasterizing on the CPU, for machines without a GPU.
+
+    Draw calls are transformed and binned into screen tiles as they are issued, and the tiles are rasterized in parallel on a thread pool
+    whenever the pixels are needed: when layers are composited, saved or popped, and at the end of the frame. Colors are stored as 8-bit
+    premultiplied RGBA, like the textures passed in by RmlUi.
+ */
+class RenderInterface_SW : public Rml::RenderInterface {
+public:
+	// Zero threads uses one thread per hardware thread, the calling thread always takes part in rendering.
+	explicit RenderInterface_SW(int num_threads = 0);
+	~RenderInterface_SW();
+
+	// Sets the caller-owned RGBA buffer the frame is written to during EndFrame(), rows are 'stride' bytes apart. The viewport takes the
+	// dimensions of the target.
+	void SetRenderTarget(Rml::byte* pixels, int width, int height, int stride);
+
+	void BeginFrame();
+	// Finishes rendering and writes the result to the render target.
+	void EndFrame();
+
+	// Optional, can be used to clear the active layer.
+	void Clear();
+
+	// -- Inherited from Rml::RenderInterface --
+
+	Rml::CompiledGeometryHandle CompileGeometry(Rml::Span<const Rml::Vertex> vertices, Rml::Span<const int> indices) override;
+	void RenderGeometry(Rml::CompiledGeometryHandle handle, Rml::Vector2f translation, Rml::TextureHandle texture) override;
+	void ReleaseGeometry(Rml::CompiledGeometryHandle handle) override;
+
+	Rml::TextureHandle LoadTexture(Rml::Vector2i& texture_dimensions, const Rml::String& source) override;
+	Rml::TextureHandle GenerateTexture(Rml::Span<const Rml::byte> source_data, Rml::Vector2i source_dimensions) override;
+	void ReleaseTexture(Rml::TextureHandle texture_handle) override;
+
+	void EnableScissorRegion(bool enable) override;
+	void SetScissorRegion(Rml::Rectanglei region) override;
+
+	void EnableClipMask(bool enable) override;
+	void RenderToClipMask(Rml::ClipMaskOperation mask_operation, Rml::CompiledGeometryHandle geometry, Rml::Vector2f translation) override;
+
+	void SetTransform(const Rml::Matrix4f* transform) override;
+
+	Rml::LayerHandle PushLayer() override;
+	void CompositeLayers(Rml::LayerHandle source, Rml::LayerHandle destination, Rml::BlendMode blend_mode,
+		Rml::Span<const Rml::CompiledFilterHandle> filters) override;
+	void PopLayer() override;
+
+	Rml::TextureHandle SaveLayerAsTexture() override;
+
+	Rml::CompiledFilterHandle SaveLayerAsMaskImage() override;
+
+	Rml::CompiledFilterHandle CompileFilter(const Rml::String& name, const Rml::Dictionary& parameters) override;
+	void ReleaseFilter(Rml::CompiledFilterHandle filter) override;
+
+private:
+	struct Geometry;
+	struct Texture;
+	struct Filter;
+	struct Command;
+	struct Triangle;
+	struct ScreenVertex;
+
+	using Image = Rml::Vector<uint32_t>;
+
+	enum class CommandType { Draw, WriteClipMask, ClearClipMask };
+
+	// Transforms the geometry and bins its triangles into the tiles they cover, to be rasterized on the next flush.
+	void QueueGeometry(CommandType type, const Geometry& geometry, Rml::Vector2f translation, const Texture* texture);
+	void QueueClipMaskClear();
+	// Rasterizes all queued commands into the active layer.
+	void Flush();
+	void RasterizeTile(int tile_index);
+
+	void RenderFilters(Rml::Span<const Rml::CompiledFilterHandle> filter_handles);
+	void Blur(Image& image, float sigma, Rml::Rectanglei region);
+	void CompositeImage(const Image& source, Image& destination, bool blend);
+
+	Rml::Rectanglei GetActiveRegion() const;
+	Image& GetLayer(Rml::LayerHandle handle);
+
+	Rml::UniquePtr<SoftwareThreadPool> thread_pool;
+
+	Rml::byte* target_pixels = nullptr;
+	int target_stride = 0;
+	int viewport_width = 0;
+	int viewport_height = 0;
+
+	Rml::Matrix4f projection;
+	Rml::Matrix4f transform;
+	bool transform_enabled = false;
+
+	bool scissor_enabled = false;
+	Rml::Rectanglei scissor_region;
+
+	bool clip_mask_enabled = false;
+	int clip_mask_reference = 0;
+	Rml::ClipMaskOperation clip_mask_operation = Rml::ClipMaskOperation::Set;
+
+	// Layer storage is retained between frames, only the first 'num_layers' entries are in use.
+	Rml::Vector<Image> layers;
+	int num_layers = 0;
+	Rml::Vector<uint8_t> clip_mask;
+	Image postprocess_primary, postprocess_secondary, postprocess_tertiary, blend_mask;
+
+	// Commands queued since the last flush, all of them target the top layer.
+	Rml::Vector<Command> commands;
+	Rml::Vector<Triangle> triangles;
+	Rml::Vector<ScreenVertex> screen_vertices;
+	Rml::Vector<Rml::Vector<uint32_t>> tile_bins;
+	int num_tiles_x = 0;
+	int num_tiles_y = 0;
+};
+
+#endif
@@ -0,0 +1,128 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include "UICompositor.h"
+#include <RmlUi/Core/Context.h>
+#include <RmlUi/Core/Element.h>
+#include <RmlUi/Core/Log.h>
+#include <chrono>
+
+UICompositor::UICompositor(RenderInterface_GL3& in_render_interface, Rml::Context* in_context) :
+	render_interface(in_render_interface), context(in_context)
+{
+	target_dimensions = context->GetDimensions();
+	target = render_interface.CreateTextureTarget(target_dimensions.x, target_dimensions.y);
+	if (!target)
+		Rml::Log::Message(Rml::Log::LT_ERROR, "Could not create the texture target for compositing context '%s'.", context->GetName().c_str());
+}
+
+UICompositor::~UICompositor()
+{
+	if (target)
+		render_interface.ReleaseTextureTarget(target);
+}
+
+void UICompositor::SetUpdateRate(double updates_per_second)
+{
+	update_interval = (updates_per_second > 0.0 ? 1.0 / updates_per_second : 0.0);
+}
+
+void UICompositor::RequestFullRate(double duration)
+{
+	full_rate_end_time = Rml::Math::Max(full_rate_end_time, host_time + duration);
+}
+
+bool UICompositor::Update(bool changed, double current_time)
+{
+	host_time = current_time;
+	statistics.num_host_frames += 1;
+	if (!target)
+		return false;
+
+	const Rml::Vector2i dimensions = context->GetDimensions();
+	if (dimensions != target_dimensions)
+	{
+		target_dimensions = dimensions;
+		render_interface.ResizeTextureTarget(target, dimensions.x, dimensions.y);
+		changed = true;
+	}
+
+	if ((changed || current_time >= next_update_time) && change_time < 0.0)
+		change_time = current_time;
+
+	if (change_time < 0.0)
+		return false;
+
+	const bool full_rate = IsFullRateRequested(current_time);
+	if (!full_rate && current_time - last_update_time < update_interval)
+		return false;
+
+	const auto begin_time = std::chrono::steady_clock::now();
+
+	context->Update();
+	render_interface.InvalidateTextureTarget(target);
+	render_interface.RenderTextureTarget(target, context, current_time);
+
+	statistics.ui_time += std::chrono::duration<double>(std::chrono::steady_clock::now() - begin_time).count();
+
+	// The context resets its requested update delay on every update, so the delay seen now holds until the next update.
+	const double next_update_delay = context->GetNextUpdateDelay();
+	animating = (next_update_delay <= 0.0);
+	next_update_time = current_time + next_update_delay;
+
+	const double latency = current_time - change_time;
+	statistics.num_ui_frames += 1;
+	statistics.num_full_rate_frames += (full_rate && current_time - last_update_time < update_interval ? 1 : 0);
+	statistics.num_changes += 1;
+	statistics.total_latency += latency;
+	statistics.max_latency = Rml::Math::Max(statistics.max_latency, latency);
+
+	change_time = -1.0;
+	last_update_time = current_time;
+	return true;
+}
+
+void UICompositor::Composite()
+{
+	if (target)
+		render_interface.CompositeTextureTarget(target);
+}
+
+bool UICompositor::IsFullRateRequested(double current_time) const
+{
+	if (animating || current_time < full_rate_end_time)
+		return true;
+
+	for (Rml::Element* element = context->GetHoverElement(); element; element = element->GetParentNode())
+	{
+		if (element->HasAttribute("ui-full-rate"))
+			return true;
+	}
+
+	return false;
+}
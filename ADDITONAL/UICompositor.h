@@ -0,0 +1,99 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef RMLUI_BACKENDS_UICOMPOSITOR_H
+#define RMLUI_BACKENDS_UICOMPOSITOR_H
+
+#include "RmlUi_Renderer_GL3.h"
+#include <RmlUi/Core/Types.h>
+
+namespace Rml {
+class Context;
+}
+
+/**
+    Renders a context into a cached texture at a reduced rate, and composites the texture over every host frame.
+
+    When the host renders a scene at a high frame rate, updating and rendering the user interface on every frame is mostly wasted work.
+    The compositor only updates and renders the context after it changed, at most at the configured update rate, and otherwise draws the
+    texture from the last update with a single textured quad.
+
+    Changes that should follow the host rate bypass the rate limit: while the context requests immediate updates, e.g. during animations
+    and transitions, while the hovered element or one of its ancestors has the 'ui-full-rate' attribute, and during periods requested
+    through RequestFullRate(). The delay between a change and the frame showing it is measured, along with the time spent on the context.
+ */
+class UICompositor {
+public:
+	UICompositor(RenderInterface_GL3& render_interface, Rml::Context* context);
+	~UICompositor();
+
+	// Limits the updates of the context to the given number per second. Zero updates the context whenever it changed, which is the default.
+	void SetUpdateRate(double updates_per_second);
+	// Updates at the full host rate for the given duration in seconds, such as while dragging.
+	void RequestFullRate(double duration);
+
+	// Call every host frame after processing events. Changes are signaled by the caller, e.g. by the result of Backend::ShouldRender(), as
+	// well as the update delay requested by the context. Returns true if the context was updated and rendered into the texture.
+	bool Update(bool changed, double current_time);
+	// Draws the cached user interface over the default framebuffer, call every host frame.
+	void Composite();
+
+	struct Statistics {
+		size_t num_host_frames;
+		size_t num_ui_frames;        // Host frames in which the context was updated and rendered.
+		size_t num_full_rate_frames; // UI frames rendered early, bypassing the rate limit.
+		size_t num_changes;          // Changes shown by UI frames, several changes between two UI frames count once.
+		double total_latency;        // Sum of the delays between each change and the UI frame showing it, in seconds.
+		double max_latency;
+		double ui_time;              // Seconds spent updating and rendering the context.
+	};
+
+	const Statistics& GetStatistics() const { return statistics; }
+
+private:
+	bool IsFullRateRequested(double current_time) const;
+
+	RenderInterface_GL3& render_interface;
+	Rml::Context* context;
+	RenderInterface_GL3::TextureTargetHandle target = {};
+	Rml::Vector2i target_dimensions;
+
+	double update_interval = 0.0;
+	double full_rate_end_time = 0.0;
+	double host_time = 0.0;
+
+	// Time of the first change not yet shown, negative when there is none.
+	double change_time = -1.0;
+	double last_update_time = 0.0;
+	double next_update_time = 0.0;
+	bool animating = false;
+
+	Statistics statistics = {};
+};
+
+#endif
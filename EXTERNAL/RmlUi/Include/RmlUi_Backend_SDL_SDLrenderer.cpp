@@ -49,6 +49,12 @@ struct BackendData {
 	SDL_Renderer* renderer = nullptr;
 
 	bool running = true;
+
+	// Renderer statistics summed over all frames, logged on shutdown.
+	int num_frames = 0;
+	double total_frame_ms = 0.0;
+	size_t total_render_geometry_calls = 0;
+	size_t total_batches = 0;
 };
 static Rml::UniquePtr<BackendData> data;
 
@@ -103,6 +109,16 @@ void Backend::Shutdown()
 {
 	RMLUI_ASSERT(data);
 
+	SDL_RendererInfo renderer_info;
+	if (data->num_frames > 0 && SDL_GetRendererInfo(data->renderer, &renderer_info) == 0)
+	{
+		const double num_frames = double(data->num_frames);
+		data->system_interface.LogMessage(Rml::Log::LT_INFO,
+			Rml::CreateString("SDL renderer '%s': %d frames, %.3f ms per frame, %.1f draws submitted in %.1f batches per frame\n",
+				renderer_info.name, data->num_frames, data->total_frame_ms / num_frames, double(data->total_render_geometry_calls) / num_frames,
+				double(data->total_batches) / num_frames));
+	}
+
 	SDL_DestroyRenderer(data->renderer);
 	SDL_DestroyWindow(data->window);
 
@@ -195,5 +211,12 @@ void Backend::PresentFrame()
 	RMLUI_ASSERT(data);
 
 	data->render_interface.EndFrame();
+
+	const RenderInterface_SDL::FrameStatistics& stats = data->render_interface.GetLastFrameStatistics();
+	data->num_frames += 1;
+	data->total_frame_ms += stats.frame_ms;
+	data->total_render_geometry_calls += stats.num_render_geometry_calls;
+	data->total_batches += stats.num_batches;
+
 	SDL_RenderPresent(data->renderer);
 }
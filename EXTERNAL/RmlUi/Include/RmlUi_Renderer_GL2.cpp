@@ -31,6 +31,9 @@
 #include <RmlUi/Core/FileInterface.h>
 #include <RmlUi/Core/Log.h>
 #include <RmlUi/Core/Platform.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
 #include <string.h>
 
 #if defined RMLUI_PLATFORM_WIN32
@@ -49,8 +52,103 @@
 
 #define GL_CLAMP_TO_EDGE 0x812F
 
+#ifndef GL_ARRAY_BUFFER
+	#define GL_ARRAY_BUFFER 0x8892
+	#define GL_ELEMENT_ARRAY_BUFFER 0x8893
+	#define GL_STATIC_DRAW 0x88E4
+#endif
+#ifndef APIENTRY
+	#define APIENTRY
+#endif
+
+// Buffer objects are core since OpenGL 1.5 and available through GL_ARB_vertex_buffer_object before that, either way they are not exported by
+// the OpenGL 1.1 libraries we link against, so the entry points are resolved at runtime.
+typedef void(APIENTRY* RmlGL2_GenBuffers)(GLsizei n, GLuint* buffers);
+typedef void(APIENTRY* RmlGL2_DeleteBuffers)(GLsizei n, const GLuint* buffers);
+typedef void(APIENTRY* RmlGL2_BindBuffer)(GLenum target, GLuint buffer);
+typedef void(APIENTRY* RmlGL2_BufferData)(GLenum target, ptrdiff_t size, const void* data, GLenum usage);
+
+static RmlGL2_GenBuffers gl2_gen_buffers = nullptr;
+static RmlGL2_DeleteBuffers gl2_delete_buffers = nullptr;
+static RmlGL2_BindBuffer gl2_bind_buffer = nullptr;
+static RmlGL2_BufferData gl2_buffer_data = nullptr;
+
+static void* GetBufferFunctionAddress(const char* name)
+{
+#if defined RMLUI_PLATFORM_WIN32
+	void* address = (void*)wglGetProcAddress(name);
+	// Some drivers return small sentinel values instead of null for functions they don't provide.
+	const intptr_t value = (intptr_t)address;
+	if (value >= -1 && value <= 3)
+		return nullptr;
+	return address;
+#elif defined RMLUI_PLATFORM_UNIX
+	return (void*)glXGetProcAddressARB((const GLubyte*)name);
+#else
+	(void)name;
+	return nullptr;
+#endif
+}
+
+// Index pattern of the quads generated by RmlUi, geometry consisting only of such quads can share a single index buffer.
+static constexpr int quad_indices[6] = {0, 3, 1, 1, 3, 2};
+
 RenderInterface_GL2::RenderInterface_GL2() {}
 
+void RenderInterface_GL2::SetMaxGeometryMode(GeometryMode mode)
+{
+	max_geometry_mode = mode;
+}
+
+RenderInterface_GL2::GeometryStatistics RenderInterface_GL2::GetGeometryStatistics() const
+{
+	return statistics;
+}
+
+void RenderInterface_GL2::LoadBufferFunctions()
+{
+	if (buffer_functions_loaded)
+		return;
+
+	// Nothing can be resolved until a context is current, try again on the next call.
+	const char* version = (const char*)glGetString(GL_VERSION);
+	if (!version)
+		return;
+
+	buffer_functions_loaded = true;
+
+	int major = 0, minor = 0;
+	sscanf(version, "%d.%d", &major, &minor);
+
+	const char* extensions = (const char*)glGetString(GL_EXTENSIONS);
+	const bool has_core_buffers = (major > 1 || (major == 1 && minor >= 5));
+	const bool has_arb_buffers = (extensions && strstr(extensions, "GL_ARB_vertex_buffer_object"));
+
+#if defined RMLUI_PLATFORM_MACOSX
+	if (has_core_buffers)
+	{
+		gl2_gen_buffers = glGenBuffers;
+		gl2_delete_buffers = glDeleteBuffers;
+		gl2_bind_buffer = glBindBuffer;
+		gl2_buffer_data = (RmlGL2_BufferData)glBufferData;
+	}
+#else
+	if (has_core_buffers || has_arb_buffers)
+	{
+		const Rml::String suffix = (has_core_buffers ? "" : "ARB");
+		gl2_gen_buffers = (RmlGL2_GenBuffers)GetBufferFunctionAddress(("glGenBuffers" + suffix).c_str());
+		gl2_delete_buffers = (RmlGL2_DeleteBuffers)GetBufferFunctionAddress(("glDeleteBuffers" + suffix).c_str());
+		gl2_bind_buffer = (RmlGL2_BindBuffer)GetBufferFunctionAddress(("glBindBuffer" + suffix).c_str());
+		gl2_buffer_data = (RmlGL2_BufferData)GetBufferFunctionAddress(("glBufferData" + suffix).c_str());
+	}
+#endif
+
+	buffer_functions_available = (gl2_gen_buffers && gl2_delete_buffers && gl2_bind_buffer && gl2_buffer_data);
+
+	if (!buffer_functions_available)
+		Rml::Log::Message(Rml::Log::LT_INFO, "OpenGL %s has no vertex buffer objects, compiling geometry into display lists instead.", version);
+}
+
 void RenderInterface_GL2::SetViewport(int in_viewport_width, int in_viewport_height)
 {
 	viewport_width = in_viewport_width;
@@ -62,6 +160,8 @@ void RenderInterface_GL2::BeginFrame()
 	RMLUI_ASSERT(viewport_width >= 0 && viewport_height >= 0);
 	glViewport(0, 0, viewport_width, viewport_height);
 
+	LoadBufferFunctions();
+
 	glEnableClientState(GL_VERTEX_ARRAY);
 	glEnableClientState(GL_COLOR_ARRAY);
 	glDisableClientState(GL_TEXTURE_COORD_ARRAY);
@@ -96,18 +196,158 @@ void RenderInterface_GL2::Clear()
 
 Rml::CompiledGeometryHandle RenderInterface_GL2::CompileGeometry(Rml::Span<const Rml::Vertex> vertices, Rml::Span<const int> indices)
 {
-	GeometryView* data = new GeometryView{vertices, indices};
-	return reinterpret_cast<Rml::CompiledGeometryHandle>(data);
+	LoadBufferFunctions();
+
+	CompiledGeometry* geometry = new CompiledGeometry{};
+	geometry->vertices = vertices;
+	geometry->indices = indices;
+
+	if (max_geometry_mode == GeometryMode::VertexBuffers && buffer_functions_available)
+	{
+		geometry->mode = GeometryMode::VertexBuffers;
+
+		const size_t vertex_bytes = vertices.size() * sizeof(Rml::Vertex);
+		gl2_gen_buffers(1, &geometry->vertex_buffer);
+		gl2_bind_buffer(GL_ARRAY_BUFFER, geometry->vertex_buffer);
+		gl2_buffer_data(GL_ARRAY_BUFFER, (ptrdiff_t)vertex_bytes, vertices.data(), GL_STATIC_DRAW);
+		gl2_bind_buffer(GL_ARRAY_BUFFER, 0);
+		statistics.buffer_bytes += vertex_bytes;
+
+		if (IsQuadList(indices) && ReserveSharedQuadIndices((int)indices.size() / 6))
+		{
+			statistics.num_shared_quad_index_geometries += 1;
+		}
+		else
+		{
+			const size_t index_bytes = indices.size() * sizeof(int);
+			gl2_gen_buffers(1, &geometry->index_buffer);
+			gl2_bind_buffer(GL_ELEMENT_ARRAY_BUFFER, geometry->index_buffer);
+			gl2_buffer_data(GL_ELEMENT_ARRAY_BUFFER, (ptrdiff_t)index_bytes, indices.data(), GL_STATIC_DRAW);
+			gl2_bind_buffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+			statistics.buffer_bytes += index_bytes;
+		}
+
+		statistics.num_vertex_buffer_geometries += 1;
+	}
+	else if (max_geometry_mode >= GeometryMode::DisplayLists)
+	{
+		// The lists are recorded on first use, since only then we know whether texture coordinates are needed.
+		geometry->mode = GeometryMode::DisplayLists;
+		statistics.num_display_list_geometries += 1;
+	}
+	else
+	{
+		geometry->mode = GeometryMode::ClientArrays;
+		statistics.num_client_array_geometries += 1;
+	}
+
+	return reinterpret_cast<Rml::CompiledGeometryHandle>(geometry);
 }
 
-void RenderInterface_GL2::ReleaseGeometry(Rml::CompiledGeometryHandle geometry)
+void RenderInterface_GL2::ReleaseGeometry(Rml::CompiledGeometryHandle handle)
 {
-	delete reinterpret_cast<GeometryView*>(geometry);
+	CompiledGeometry* geometry = reinterpret_cast<CompiledGeometry*>(handle);
+
+	switch (geometry->mode)
+	{
+	case GeometryMode::VertexBuffers:
+	{
+		gl2_delete_buffers(1, &geometry->vertex_buffer);
+		statistics.buffer_bytes -= geometry->vertices.size() * sizeof(Rml::Vertex);
+
+		if (geometry->index_buffer)
+		{
+			gl2_delete_buffers(1, &geometry->index_buffer);
+			statistics.buffer_bytes -= geometry->indices.size() * sizeof(int);
+		}
+		else
+		{
+			ReleaseSharedQuadIndices();
+		}
+
+		statistics.num_vertex_buffer_geometries -= 1;
+	}
+	break;
+	case GeometryMode::DisplayLists:
+	{
+		for (GLuint display_list : geometry->display_lists)
+		{
+			if (display_list)
+				glDeleteLists(display_list, 1);
+		}
+
+		statistics.num_display_list_geometries -= 1;
+	}
+	break;
+	case GeometryMode::ClientArrays:
+	{
+		statistics.num_client_array_geometries -= 1;
+	}
+	break;
+	}
+
+	delete geometry;
+}
+
+bool RenderInterface_GL2::IsQuadList(Rml::Span<const int> indices) const
+{
+	if (indices.empty() || indices.size() % 6 != 0)
+		return false;
+
+	for (size_t i = 0; i < indices.size(); i++)
+	{
+		const int base_vertex = int(i / 6) * 4;
+		if (indices[i] != base_vertex + quad_indices[i % 6])
+			return false;
+	}
+
+	return true;
+}
+
+bool RenderInterface_GL2::ReserveSharedQuadIndices(int num_quads)
+{
+	if (num_quads <= shared_quad_index_capacity)
+		return true;
+
+	// Grow geometrically so that large text runs don't cause a re-upload for every new size.
+	const int new_capacity = Rml::Math::Max(num_quads, Rml::Math::Max(2 * shared_quad_index_capacity, 256));
+
+	Rml::Vector<int> indices((size_t)new_capacity * 6);
+	for (size_t i = 0; i < indices.size(); i++)
+		indices[i] = int(i / 6) * 4 + quad_indices[i % 6];
+
+	if (!shared_quad_index_buffer)
+		gl2_gen_buffers(1, &shared_quad_index_buffer);
+	if (!shared_quad_index_buffer)
+		return false;
+
+	gl2_bind_buffer(GL_ELEMENT_ARRAY_BUFFER, shared_quad_index_buffer);
+	gl2_buffer_data(GL_ELEMENT_ARRAY_BUFFER, (ptrdiff_t)(indices.size() * sizeof(int)), indices.data(), GL_STATIC_DRAW);
+	gl2_bind_buffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+	statistics.buffer_bytes += size_t(new_capacity - shared_quad_index_capacity) * 6 * sizeof(int);
+	shared_quad_index_capacity = new_capacity;
+
+	return true;
+}
+
+void RenderInterface_GL2::ReleaseSharedQuadIndices()
+{
+	statistics.num_shared_quad_index_geometries -= 1;
+
+	// Released together with the last geometry using it, so that no buffers outlive the context.
+	if (statistics.num_shared_quad_index_geometries == 0 && shared_quad_index_buffer)
+	{
+		gl2_delete_buffers(1, &shared_quad_index_buffer);
+		statistics.buffer_bytes -= size_t(shared_quad_index_capacity) * 6 * sizeof(int);
+		shared_quad_index_buffer = 0;
+		shared_quad_index_capacity = 0;
+	}
 }
 
 void RenderInterface_GL2::RenderGeometry(Rml::CompiledGeometryHandle handle, Rml::Vector2f translation, Rml::TextureHandle texture)
 {
-	const GeometryView* geometry = reinterpret_cast<GeometryView*>(handle);
+	CompiledGeometry* geometry = reinterpret_cast<CompiledGeometry*>(handle);
 	const Rml::Vertex* vertices = geometry->vertices.data();
 	const int* indices = geometry->indices.data();
 	const int num_indices = (int)geometry->indices.size();
@@ -115,9 +355,6 @@ void RenderInterface_GL2::RenderGeometry(Rml::CompiledGeometryHandle handle, Rml
 	glPushMatrix();
 	glTranslatef(translation.x, translation.y, 0);
 
-	glVertexPointer(2, GL_FLOAT, sizeof(Rml::Vertex), &vertices[0].position);
-	glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(Rml::Vertex), &vertices[0].colour);
-
 	if (!texture)
 	{
 		glDisable(GL_TEXTURE_2D);
@@ -131,10 +368,51 @@ void RenderInterface_GL2::RenderGeometry(Rml::CompiledGeometryHandle handle, Rml
 			glBindTexture(GL_TEXTURE_2D, (GLuint)texture);
 
 		glEnableClientState(GL_TEXTURE_COORD_ARRAY);
-		glTexCoordPointer(2, GL_FLOAT, sizeof(Rml::Vertex), &vertices[0].tex_coord);
 	}
 
-	glDrawElements(GL_TRIANGLES, num_indices, GL_UNSIGNED_INT, indices);
+	if (geometry->mode == GeometryMode::VertexBuffers)
+	{
+		// With a buffer bound, the array pointers are offsets into the buffer.
+		gl2_bind_buffer(GL_ARRAY_BUFFER, geometry->vertex_buffer);
+		gl2_bind_buffer(GL_ELEMENT_ARRAY_BUFFER, geometry->index_buffer ? geometry->index_buffer : shared_quad_index_buffer);
+
+		glVertexPointer(2, GL_FLOAT, sizeof(Rml::Vertex), (const void*)offsetof(Rml::Vertex, position));
+		glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(Rml::Vertex), (const void*)offsetof(Rml::Vertex, colour));
+		if (texture)
+			glTexCoordPointer(2, GL_FLOAT, sizeof(Rml::Vertex), (const void*)offsetof(Rml::Vertex, tex_coord));
+
+		glDrawElements(GL_TRIANGLES, num_indices, GL_UNSIGNED_INT, nullptr);
+
+		// Unbind again, otherwise the pointers of client array draws would be taken as buffer offsets.
+		gl2_bind_buffer(GL_ARRAY_BUFFER, 0);
+		gl2_bind_buffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+	}
+	else
+	{
+		glVertexPointer(2, GL_FLOAT, sizeof(Rml::Vertex), &vertices[0].position);
+		glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(Rml::Vertex), &vertices[0].colour);
+		if (texture)
+			glTexCoordPointer(2, GL_FLOAT, sizeof(Rml::Vertex), &vertices[0].tex_coord);
+
+		GLuint* display_list = (geometry->mode == GeometryMode::DisplayLists ? &geometry->display_lists[texture ? 1 : 0] : nullptr);
+
+		if (display_list && *display_list == 0)
+		{
+			// The vertex data is copied out of the arrays while recording, later calls don't touch client memory.
+			*display_list = glGenLists(1);
+			if (*display_list)
+			{
+				glNewList(*display_list, GL_COMPILE);
+				glDrawElements(GL_TRIANGLES, num_indices, GL_UNSIGNED_INT, indices);
+				glEndList();
+			}
+		}
+
+		if (display_list && *display_list)
+			glCallList(*display_list);
+		else
+			glDrawElements(GL_TRIANGLES, num_indices, GL_UNSIGNED_INT, indices);
+	}
 
 	glPopMatrix();
 }
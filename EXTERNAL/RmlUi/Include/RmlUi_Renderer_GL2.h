@@ -33,8 +33,29 @@
 
 class RenderInterface_GL2 : public Rml::RenderInterface {
 public:
+	// How compiled geometry is stored, from the slowest to the fastest path.
+	enum class GeometryMode {
+		ClientArrays,  // Vertices are read from client memory on every draw.
+		DisplayLists,  // Draws are recorded into display lists the first time they are rendered.
+		VertexBuffers, // Vertices and indices are uploaded to buffer objects when compiled.
+	};
+
+	struct GeometryStatistics {
+		int num_client_array_geometries = 0;
+		int num_display_list_geometries = 0;
+		int num_vertex_buffer_geometries = 0;
+		// Number of vertex buffer geometries drawn with the shared quad index buffer instead of their own.
+		int num_shared_quad_index_geometries = 0;
+		size_t buffer_bytes = 0;
+	};
+
 	RenderInterface_GL2();
 
+	// Limits the geometry mode used for geometry compiled from now on, the fastest mode supported by the driver up to this limit is used.
+	// Mainly useful to compare the paths against each other, e.g. on a software implementation of OpenGL.
+	void SetMaxGeometryMode(GeometryMode mode);
+	GeometryStatistics GetGeometryStatistics() const;
+
 	// The viewport should be updated whenever the window size changes.
 	void SetViewport(int viewport_width, int viewport_height);
 
@@ -67,14 +88,38 @@ public:
 	static const Rml::TextureHandle TextureEnableWithoutBinding = Rml::TextureHandle(-1);
 
 private:
-	struct GeometryView {
+	struct CompiledGeometry {
+		GeometryMode mode;
 		Rml::Span<const Rml::Vertex> vertices;
 		Rml::Span<const int> indices;
+
+		// Vertex buffer mode, the index buffer is zero when the geometry uses the shared quad index buffer.
+		unsigned int vertex_buffer = 0;
+		unsigned int index_buffer = 0;
+
+		// Display list mode, one list for drawing without and one for drawing with texture coordinates. The bound texture is not part of the
+		// list, so they are shared by all textures the geometry is rendered with.
+		unsigned int display_lists[2] = {};
 	};
 
+	// Resolves the buffer object functions once a context is current, they are not exported by the OpenGL 1.1 libraries.
+	void LoadBufferFunctions();
+	bool IsQuadList(Rml::Span<const int> indices) const;
+	bool ReserveSharedQuadIndices(int num_quads);
+	void ReleaseSharedQuadIndices();
+
 	int viewport_width = 0;
 	int viewport_height = 0;
 	bool transform_enabled = false;
+
+	GeometryMode max_geometry_mode = GeometryMode::VertexBuffers;
+	bool buffer_functions_loaded = false;
+	bool buffer_functions_available = false;
+
+	unsigned int shared_quad_index_buffer = 0;
+	int shared_quad_index_capacity = 0;
+
+	GeometryStatistics statistics;
 };
 
 #endif
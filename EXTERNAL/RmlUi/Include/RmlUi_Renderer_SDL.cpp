@@ -33,6 +33,34 @@
 #include <SDL.h>
 #include <SDL_image.h>
 
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#include <emmintrin.h>
+	#define RMLUI_SDL_RENDERER_SSE2
+#endif
+
+// Writes the translated positions of the vertices to a tightly packed array.
+static void TranslatePositions(SDL_FPoint* out_positions, const Rml::Vertex* vertices, size_t num_vertices, Rml::Vector2f translation)
+{
+	size_t i = 0;
+
+#ifdef RMLUI_SDL_RENDERER_SSE2
+	// Two vertices per iteration, their positions are gathered from the interleaved vertex data into one register.
+	const __m128 offset = _mm_setr_ps(translation.x, translation.y, translation.x, translation.y);
+	for (; i + 2 <= num_vertices; i += 2)
+	{
+		__m128 position = _mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(&vertices[i].position.x));
+		position = _mm_loadh_pi(position, reinterpret_cast<const __m64*>(&vertices[i + 1].position.x));
+		_mm_storeu_ps(&out_positions[i].x, _mm_add_ps(position, offset));
+	}
+#endif
+
+	for (; i < num_vertices; i++)
+	{
+		out_positions[i].x = vertices[i].position.x + translation.x;
+		out_positions[i].y = vertices[i].position.y + translation.y;
+	}
+}
+
 RenderInterface_SDL::RenderInterface_SDL(SDL_Renderer* renderer) : renderer(renderer)
 {
 	// RmlUi serves vertex colors and textures with premultiplied alpha, set the blend mode accordingly.
@@ -43,13 +71,22 @@ RenderInterface_SDL::RenderInterface_SDL(SDL_Renderer* renderer) : renderer(rend
 
 void RenderInterface_SDL::BeginFrame()
 {
+	frame_statistics = {};
+	frame_begin_counter = SDL_GetPerformanceCounter();
+
 	SDL_RenderSetViewport(renderer, nullptr);
 	SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
 	SDL_RenderClear(renderer);
 	SDL_SetRenderDrawBlendMode(renderer, blend_mode);
 }
 
-void RenderInterface_SDL::EndFrame() {}
+void RenderInterface_SDL::EndFrame()
+{
+	FlushBatch();
+
+	frame_statistics.frame_ms = double(SDL_GetPerformanceCounter() - frame_begin_counter) * 1000.0 / double(SDL_GetPerformanceFrequency());
+	last_frame_statistics = frame_statistics;
+}
 
 Rml::CompiledGeometryHandle RenderInterface_SDL::CompileGeometry(Rml::Span<const Rml::Vertex> vertices, Rml::Span<const int> indices)
 {
@@ -70,24 +107,53 @@ void RenderInterface_SDL::RenderGeometry(Rml::CompiledGeometryHandle handle, Rml
 	const int* indices = geometry->indices.data();
 	const size_t num_indices = geometry->indices.size();
 
-	SDL_FPoint* positions = new SDL_FPoint[num_vertices];
+	SDL_Texture* sdl_texture = (SDL_Texture*)texture;
+	frame_statistics.num_render_geometry_calls += 1;
 
-	for (size_t i = 0; i < num_vertices; i++)
+	if (sdl_texture != batch_texture)
 	{
-		positions[i].x = vertices[i].position.x + translation.x;
-		positions[i].y = vertices[i].position.y + translation.y;
+		FlushBatch();
+		batch_texture = sdl_texture;
 	}
 
-	SDL_Texture* sdl_texture = (SDL_Texture*)texture;
+	const size_t base_vertex = batch_vertices.size();
+	const size_t base_index = batch_indices.size();
+
+	batch_positions.resize(base_vertex + num_vertices);
+	TranslatePositions(&batch_positions[base_vertex], vertices, num_vertices, translation);
+
+	// Colors and texture coordinates are read from the copied vertices, so the batch doesn't depend on the lifetime of the geometry.
+	batch_vertices.insert(batch_vertices.end(), vertices, vertices + num_vertices);
+
+	batch_indices.resize(base_index + num_indices);
+	int* batch_index = &batch_indices[base_index];
+	for (size_t i = 0; i < num_indices; i++)
+		batch_index[i] = indices[i] + (int)base_vertex;
+}
+
+void RenderInterface_SDL::FlushBatch()
+{
+	if (batch_indices.empty())
+		return;
+
+	SDL_RenderGeometryRaw(renderer, batch_texture, &batch_positions[0].x, sizeof(SDL_FPoint), (const SDL_Color*)&batch_vertices[0].colour,
+		sizeof(Rml::Vertex), &batch_vertices[0].tex_coord.x, sizeof(Rml::Vertex), (int)batch_vertices.size(), batch_indices.data(),
+		(int)batch_indices.size(), 4);
 
-	SDL_RenderGeometryRaw(renderer, sdl_texture, &positions[0].x, sizeof(SDL_FPoint), (const SDL_Color*)&vertices->colour, sizeof(Rml::Vertex),
-		&vertices->tex_coord.x, sizeof(Rml::Vertex), (int)num_vertices, indices, (int)num_indices, 4);
+	frame_statistics.num_batches += 1;
+	frame_statistics.num_vertices += batch_vertices.size();
+	frame_statistics.num_indices += batch_indices.size();
 
-	delete[] positions;
+	batch_positions.clear();
+	batch_vertices.clear();
+	batch_indices.clear();
 }
 
 void RenderInterface_SDL::EnableScissorRegion(bool enable)
 {
+	if (enable != scissor_region_enabled)
+		FlushBatch();
+
 	if (enable)
 		SDL_RenderSetClipRect(renderer, &rect_scissor);
 	else
@@ -98,6 +164,10 @@ void RenderInterface_SDL::EnableScissorRegion(bool enable)
 
 void RenderInterface_SDL::SetScissorRegion(Rml::Rectanglei region)
 {
+	if (scissor_region_enabled &&
+		(rect_scissor.x != region.Left() || rect_scissor.y != region.Top() || rect_scissor.w != region.Width() || rect_scissor.h != region.Height()))
+		FlushBatch();
+
 	rect_scissor.x = region.Left();
 	rect_scissor.y = region.Top();
 	rect_scissor.w = region.Width();
@@ -175,5 +245,11 @@ Rml::TextureHandle RenderInterface_SDL::GenerateTexture(Rml::Span<const Rml::byt
 
 void RenderInterface_SDL::ReleaseTexture(Rml::TextureHandle texture_handle)
 {
+	if ((SDL_Texture*)texture_handle == batch_texture)
+	{
+		FlushBatch();
+		batch_texture = nullptr;
+	}
+
 	SDL_DestroyTexture((SDL_Texture*)texture_handle);
 }
@@ -40,6 +40,18 @@ public:
 	void BeginFrame();
 	void EndFrame();
 
+	struct FrameStatistics {
+		size_t num_render_geometry_calls;
+		size_t num_batches; // Draw calls submitted to SDL after merging consecutive geometry.
+		size_t num_vertices;
+		size_t num_indices;
+		double frame_ms; // CPU time between BeginFrame() and EndFrame(), including the time spent in SDL.
+	};
+
+	// Statistics of the last completed frame. The renderer can be measured without a display or GPU by running with the environment
+	// variables SDL_VIDEODRIVER=dummy and SDL_RENDER_DRIVER=software.
+	const FrameStatistics& GetLastFrameStatistics() const { return last_frame_statistics; }
+
 	// -- Inherited from Rml::RenderInterface --
 
 	Rml::CompiledGeometryHandle CompileGeometry(Rml::Span<const Rml::Vertex> vertices, Rml::Span<const int> indices) override;
@@ -59,10 +71,24 @@ private:
 		Rml::Span<const int> indices;
 	};
 
+	// Submits the accumulated draws in a single call, needed before the texture or the clip rect changes.
+	void FlushBatch();
+
 	SDL_Renderer* renderer;
 	SDL_BlendMode blend_mode = {};
 	SDL_Rect rect_scissor = {};
 	bool scissor_region_enabled = false;
+
+	// Consecutive draws with the same texture and clip rect are accumulated here. The buffers keep their capacity between frames, so drawing
+	// doesn't allocate once they have grown to the size of a frame.
+	SDL_Texture* batch_texture = nullptr;
+	Rml::Vector<SDL_FPoint> batch_positions;
+	Rml::Vector<Rml::Vertex> batch_vertices;
+	Rml::Vector<int> batch_indices;
+
+	Uint64 frame_begin_counter = 0;
+	FrameStatistics frame_statistics = {};
+	FrameStatistics last_frame_statistics = {};
 };
 
 #endif
@@ -35,6 +35,8 @@
 #include <RmlUi/Core/Platform.h>
 #include <RmlUi/Core/Profiling.h>
 #include <algorithm>
+#include <chrono>
+#include <stdio.h>
 #include <string.h>
 
 // AlignUp(314, 256) = 512
@@ -86,18 +88,19 @@ static VKAPI_ATTR VkBool32 VKAPI_CALL MyDebugReportCallback(VkDebugUtilsMessageS
 #endif
 
 RenderInterface_VK::RenderInterface_VK() :
-	m_is_transform_enabled{false}, m_is_apply_to_regular_geometry_stencil{false}, m_is_use_scissor_specified{false}, m_is_use_stencil_pipeline{false},
-	m_width{}, m_height{}, m_queue_index_present{}, m_queue_index_graphics{}, m_queue_index_compute{}, m_semaphore_index{},
+	m_is_recording_secondary{}, m_width{}, m_height{}, m_queue_index_present{}, m_queue_index_graphics{}, m_queue_index_compute{}, m_semaphore_index{},
 	m_semaphore_index_previous{}, m_image_index{}, m_p_instance{}, m_p_device{}, m_p_physical_device{}, m_p_surface{}, m_p_swapchain{},
 	m_p_allocator{}, m_p_current_command_buffer{}, m_p_descriptor_set_layout_vertex_transform{}, m_p_descriptor_set_layout_texture{},
 	m_p_pipeline_layout{}, m_p_pipeline_with_textures{}, m_p_pipeline_without_textures{},
 	m_p_pipeline_stencil_for_region_where_geometry_will_be_drawn{}, m_p_pipeline_stencil_for_regular_geometry_that_applied_to_region_with_textures{},
-	m_p_pipeline_stencil_for_regular_geometry_that_applied_to_region_without_textures{}, m_p_descriptor_set{}, m_p_render_pass{},
-	m_p_sampler_linear{}, m_scissor{}, m_scissor_original{}, m_viewport{}, m_p_queue_present{}, m_p_queue_graphics{}, m_p_queue_compute{},
+	m_p_pipeline_stencil_for_regular_geometry_that_applied_to_region_without_textures{}, m_p_pipeline_cache{}, m_pipeline_cache_header{},
+	m_pipeline_cache_path{"RmlUi_VK_PipelineCache.bin"}, m_is_pipeline_cache_warm{}, m_is_pipeline_creation_reported{}, m_pipeline_creation_time{},
+	m_p_render_pass{},
+	m_p_sampler_linear{}, m_scissor_original{}, m_viewport{}, m_p_queue_present{}, m_p_queue_graphics{}, m_p_queue_compute{},
 #ifdef RMLUI_VK_DEBUG
 	m_debug_messenger{},
 #endif
-	m_swapchain_format{}, m_texture_depthstencil{}, m_pending_for_deletion_textures_by_frames{}
+	m_swapchain_format{}, m_texture_depthstencil{}, m_recording{}, m_pending_for_deletion_textures_by_frames{}
 {}
 
 RenderInterface_VK::~RenderInterface_VK() {}
@@ -106,12 +109,7 @@ Rml::CompiledGeometryHandle RenderInterface_VK::CompileGeometry(Rml::Span<const
 {
 	RMLUI_ZoneScopedN("Vulkan - CompileGeometry");
 
-	VkDescriptorSet p_current_descriptor_set = nullptr;
-	p_current_descriptor_set = m_p_descriptor_set;
-
-	RMLUI_VK_ASSERTMSG(p_current_descriptor_set,
-		"you can't have here an invalid pointer of VkDescriptorSet. Two reason might be. 1. - you didn't allocate it "
-		"at all or 2. - Somehing is wrong with allocation and somehow it was corrupted by something.");
+	std::lock_guard<std::mutex> lock(m_resource_mutex);
 
 	auto* p_geometry_handle = new geometry_handle_t{};
 
@@ -119,14 +117,27 @@ Rml::CompiledGeometryHandle RenderInterface_VK::CompileGeometry(Rml::Span<const
 	const void* pData = reinterpret_cast<const void*>(vertices.data());
 
 	bool status = m_memory_pool.Alloc_VertexBuffer((uint32_t)vertices.size(), sizeof(Rml::Vertex), reinterpret_cast<void**>(&pCopyDataToBuffer),
-		&p_geometry_handle->m_p_vertex, &p_geometry_handle->m_p_vertex_allocation);
-	RMLUI_VK_ASSERTMSG(status, "failed to AllocVertexBuffer");
+		&p_geometry_handle->m_p_vertex, &p_geometry_handle->m_p_vertex_allocation, &p_geometry_handle->m_vertex_block_index);
+
+	if (!status)
+	{
+		Rml::Log::Message(Rml::Log::LT_ERROR, "[Vulkan] failed to allocate %zu bytes of vertex data", sizeof(Rml::Vertex) * vertices.size());
+		delete p_geometry_handle;
+		return {};
+	}
 
 	memcpy(pCopyDataToBuffer, pData, sizeof(Rml::Vertex) * vertices.size());
 
 	status = m_memory_pool.Alloc_IndexBuffer((uint32_t)indices.size(), sizeof(int), reinterpret_cast<void**>(&pCopyDataToBuffer),
-		&p_geometry_handle->m_p_index, &p_geometry_handle->m_p_index_allocation);
-	RMLUI_VK_ASSERTMSG(status, "failed to AllocIndexBuffer");
+		&p_geometry_handle->m_p_index, &p_geometry_handle->m_p_index_allocation, &p_geometry_handle->m_index_block_index);
+
+	if (!status)
+	{
+		Rml::Log::Message(Rml::Log::LT_ERROR, "[Vulkan] failed to allocate %zu bytes of index data", sizeof(int) * indices.size());
+		m_memory_pool.Free_GeometryHandle(p_geometry_handle);
+		delete p_geometry_handle;
+		return {};
+	}
 
 	memcpy(pCopyDataToBuffer, indices.data(), sizeof(int) * indices.size());
 
@@ -139,142 +150,7 @@ void RenderInterface_VK::RenderGeometry(Rml::CompiledGeometryHandle geometry, Rm
 {
 	RMLUI_ZoneScopedN("Vulkan - RenderCompiledGeometry");
 
-	if (m_p_current_command_buffer == nullptr)
-		return;
-
-	RMLUI_VK_ASSERTMSG(m_p_current_command_buffer, "must be valid otherwise you can't render now!!! (can't be)");
-
-	texture_data_t* p_texture = reinterpret_cast<texture_data_t*>(texture);
-
-	VkDescriptorImageInfo info_descriptor_image = {};
-	if (p_texture && p_texture->m_p_vk_descriptor_set == nullptr)
-	{
-		VkDescriptorSet p_texture_set = nullptr;
-		m_manager_descriptors.Alloc_Descriptor(m_p_device, &m_p_descriptor_set_layout_texture, &p_texture_set);
-
-		info_descriptor_image.imageView = p_texture->m_p_vk_image_view;
-		info_descriptor_image.sampler = p_texture->m_p_vk_sampler;
-		info_descriptor_image.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-
-		VkWriteDescriptorSet info_write = {};
-
-		info_write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-		info_write.dstSet = p_texture_set;
-		info_write.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-		info_write.dstBinding = 2;
-		info_write.pImageInfo = &info_descriptor_image;
-		info_write.descriptorCount = 1;
-
-		vkUpdateDescriptorSets(m_p_device, 1, &info_write, 0, nullptr);
-		p_texture->m_p_vk_descriptor_set = p_texture_set;
-	}
-
-	geometry_handle_t* p_casted_compiled_geometry = reinterpret_cast<geometry_handle_t*>(geometry);
-
-	m_user_data_for_vertex_shader.m_translate = translation;
-
-	VkDescriptorSet p_current_descriptor_set = nullptr;
-	p_current_descriptor_set = m_p_descriptor_set;
-
-	RMLUI_VK_ASSERTMSG(p_current_descriptor_set,
-		"you can't have here an invalid pointer of VkDescriptorSet. Two reason might be. 1. - you didn't allocate it "
-		"at all or 2. - Somehing is wrong with allocation and somehow it was corrupted by something.");
-
-	shader_vertex_user_data_t* p_data = nullptr;
-
-	if (p_casted_compiled_geometry->m_p_shader_allocation == nullptr)
-	{
-		// it means it was freed in ReleaseCompiledGeometry method
-		bool status = m_memory_pool.Alloc_GeneralBuffer(sizeof(m_user_data_for_vertex_shader), reinterpret_cast<void**>(&p_data),
-			&p_casted_compiled_geometry->m_p_shader, &p_casted_compiled_geometry->m_p_shader_allocation);
-		RMLUI_VK_ASSERTMSG(status, "failed to allocate VkDescriptorBufferInfo for uniform data to shaders");
-	}
-	else
-	{
-		// it means our state is dirty and we need to update data, but it is not right in terms of architecture, for real better experience would
-		// be great to free all "compiled" geometries and "re-build" them in one general way, but here I got only three callings for
-		// font-face-layer textures (load_document example) and that shit. So better to think how to make it right, if it is fine okay, if it is
-		// not okay and like we really expect that ReleaseCompiledGeometry for all objects that needs to be rebuilt so better to implement that,
-		// but still it is a big architectural thing (or at least you need to do something big commits here to implement a such feature), so my
-		// implementation doesn't break anything what we had, but still it looks strange. If I get callings for releasing maybe I need to use it
-		// for all objects not separately????? Otherwise it is better to provide method for resizing (or some kind of "resizing" callback) for
-		// recalculating all geometry IDK, so it means you pass the existed geometry that wasn't pass to ReleaseCompiledGeometry, but from another
-		// hand you need to re-build compiled geometry again so we have two kinds of geometry one is compiled and never changes and one is dynamic
-		// and it goes through pipeline InitializationOfProgram...->Compile->Render->Release->Compile->Render->Release...
-
-		m_memory_pool.Free_GeometryHandle_ShaderDataOnly(p_casted_compiled_geometry);
-		bool status = m_memory_pool.Alloc_GeneralBuffer(sizeof(m_user_data_for_vertex_shader), reinterpret_cast<void**>(&p_data),
-			&p_casted_compiled_geometry->m_p_shader, &p_casted_compiled_geometry->m_p_shader_allocation);
-		RMLUI_VK_ASSERTMSG(status, "failed to allocate VkDescriptorBufferInfo for uniform data to shaders");
-	}
-
-	if (p_data)
-	{
-		p_data->m_transform = m_user_data_for_vertex_shader.m_transform;
-		p_data->m_translate = m_user_data_for_vertex_shader.m_translate;
-	}
-	else
-	{
-		RMLUI_VK_ASSERTMSG(p_data, "you can't reach this zone, it means something bad");
-	}
-
-	const uint32_t pDescriptorOffsets = static_cast<uint32_t>(p_casted_compiled_geometry->m_p_shader.offset);
-
-	VkDescriptorSet p_texture_descriptor_set = nullptr;
-
-	if (p_texture)
-	{
-		p_texture_descriptor_set = p_texture->m_p_vk_descriptor_set;
-	}
-
-	VkDescriptorSet p_sets[] = {p_current_descriptor_set, p_texture_descriptor_set};
-	int real_size_of_sets = 2;
-
-	if (p_texture == nullptr)
-		real_size_of_sets = 1;
-
-	vkCmdBindDescriptorSets(m_p_current_command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_p_pipeline_layout, 0, real_size_of_sets, p_sets, 1,
-		&pDescriptorOffsets);
-
-	if (m_is_use_stencil_pipeline)
-	{
-		vkCmdBindPipeline(m_p_current_command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_p_pipeline_stencil_for_region_where_geometry_will_be_drawn);
-	}
-	else
-	{
-		if (p_texture)
-		{
-			if (m_is_apply_to_regular_geometry_stencil)
-			{
-				vkCmdBindPipeline(m_p_current_command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
-					m_p_pipeline_stencil_for_regular_geometry_that_applied_to_region_with_textures);
-			}
-			else
-			{
-				vkCmdBindPipeline(m_p_current_command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_p_pipeline_with_textures);
-			}
-		}
-		else
-		{
-			if (m_is_apply_to_regular_geometry_stencil)
-			{
-				vkCmdBindPipeline(m_p_current_command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
-					m_p_pipeline_stencil_for_regular_geometry_that_applied_to_region_without_textures);
-			}
-			else
-			{
-				vkCmdBindPipeline(m_p_current_command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_p_pipeline_without_textures);
-			}
-		}
-	}
-
-	vkCmdBindVertexBuffers(m_p_current_command_buffer, 0, 1, &p_casted_compiled_geometry->m_p_vertex.buffer,
-		&p_casted_compiled_geometry->m_p_vertex.offset);
-
-	vkCmdBindIndexBuffer(m_p_current_command_buffer, p_casted_compiled_geometry->m_p_index.buffer, p_casted_compiled_geometry->m_p_index.offset,
-		VK_INDEX_TYPE_UINT32);
-
-	vkCmdDrawIndexed(m_p_current_command_buffer, p_casted_compiled_geometry->m_num_indices, 1, 0, 0, 0);
+	Record_Geometry(m_recording, geometry, translation, texture);
 }
 
 void RenderInterface_VK::ReleaseGeometry(Rml::CompiledGeometryHandle geometry)
@@ -283,106 +159,18 @@ void RenderInterface_VK::ReleaseGeometry(Rml::CompiledGeometryHandle geometry)
 
 	geometry_handle_t* p_casted_geometry = reinterpret_cast<geometry_handle_t*>(geometry);
 
+	std::lock_guard<std::mutex> lock(m_resource_mutex);
 	m_pending_for_deletion_geometries.push_back(p_casted_geometry);
 }
 
 void RenderInterface_VK::EnableScissorRegion(bool enable)
 {
-	if (m_p_current_command_buffer == nullptr)
-		return;
-
-	if (m_is_transform_enabled)
-	{
-		m_is_apply_to_regular_geometry_stencil = true;
-	}
-
-	m_is_use_scissor_specified = enable;
-
-	if (m_is_use_scissor_specified == false)
-	{
-		m_is_apply_to_regular_geometry_stencil = false;
-		vkCmdSetScissor(m_p_current_command_buffer, 0, 1, &m_scissor_original);
-	}
+	Record_EnableScissorRegion(m_recording, enable);
 }
 
 void RenderInterface_VK::SetScissorRegion(Rml::Rectanglei region)
 {
-	if (m_is_use_scissor_specified)
-	{
-		if (m_is_transform_enabled)
-		{
-			Rml::Vertex vertices[4];
-
-			vertices[0].position = Rml::Vector2f(region.TopLeft());
-			vertices[1].position = Rml::Vector2f(region.TopRight());
-			vertices[2].position = Rml::Vector2f(region.BottomRight());
-			vertices[3].position = Rml::Vector2f(region.BottomLeft());
-
-			int indices[6] = {0, 2, 1, 0, 3, 2};
-
-			m_is_use_stencil_pipeline = true;
-
-#ifdef RMLUI_DEBUG
-			VkDebugUtilsLabelEXT info{};
-			info.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_LABEL_EXT;
-			info.color[0] = 1.0f;
-			info.color[1] = 1.0f;
-			info.color[2] = 0.0f;
-			info.color[3] = 1.0f;
-			info.pLabelName = "SetScissorRegion (generated region)";
-
-			vkCmdInsertDebugUtilsLabelEXT(m_p_current_command_buffer, &info);
-#endif
-
-			VkClearDepthStencilValue info_clear_color{};
-
-			info_clear_color.depth = 1.0f;
-			info_clear_color.stencil = 0;
-
-			VkClearAttachment clear_attachment = {};
-			clear_attachment.aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT;
-			clear_attachment.clearValue.depthStencil = info_clear_color;
-			clear_attachment.colorAttachment = 1;
-
-			VkClearRect clear_rect = {};
-			clear_rect.layerCount = 1;
-			clear_rect.rect.extent.width = m_width;
-			clear_rect.rect.extent.height = m_height;
-
-			vkCmdClearAttachments(m_p_current_command_buffer, 1, &clear_attachment, 1, &clear_rect);
-
-			if (Rml::CompiledGeometryHandle handle = CompileGeometry({vertices, 4}, {indices, 6}))
-			{
-				RenderGeometry(handle, {}, {});
-				ReleaseGeometry(handle);
-			}
-
-			m_is_use_stencil_pipeline = false;
-
-			m_is_apply_to_regular_geometry_stencil = true;
-		}
-		else
-		{
-			m_scissor.extent.width = region.Width();
-			m_scissor.extent.height = region.Height();
-			m_scissor.offset.x = Rml::Math::Clamp(region.Left(), 0, m_width);
-			m_scissor.offset.y = Rml::Math::Clamp(region.Top(), 0, m_height);
-
-#ifdef RMLUI_DEBUG
-			VkDebugUtilsLabelEXT info{};
-			info.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_LABEL_EXT;
-			info.color[0] = 1.0f;
-			info.color[1] = 0.0f;
-			info.color[2] = 0.0f;
-			info.color[3] = 1.0f;
-			info.pLabelName = "SetScissorRegion (offset)";
-
-			vkCmdInsertDebugUtilsLabelEXT(m_p_current_command_buffer, &info);
-#endif
-
-			vkCmdSetScissor(m_p_current_command_buffer, 0, 1, &m_scissor);
-		}
-	}
+	Record_SetScissorRegion(m_recording, region);
 }
 
 // Set to byte packing, or the compiler will expand our struct, which means it won't read correctly from file
@@ -522,13 +310,6 @@ Rml::TextureHandle RenderInterface_VK::CreateTexture(Rml::Span<const Rml::byte>
 	VkDeviceSize image_size = source.size();
 	VkFormat format = VkFormat::VK_FORMAT_R8G8B8A8_UNORM;
 
-	buffer_data_t cpu_buffer = CreateResource_StagingBuffer(image_size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT);
-
-	void* data;
-	vmaMapMemory(m_p_allocator, cpu_buffer.m_p_vma_allocation, &data);
-	memcpy(data, source.data(), static_cast<size_t>(image_size));
-	vmaUnmapMemory(m_p_allocator, cpu_buffer.m_p_vma_allocation);
-
 	VkExtent3D extent_image = {};
 	extent_image.width = static_cast<uint32_t>(width);
 	extent_image.height = static_cast<uint32_t>(height);
@@ -571,80 +352,21 @@ Rml::TextureHandle RenderInterface_VK::CreateTexture(Rml::Span<const Rml::byte>
 #endif
 
 	/*
-	 * So Vulkan works only through VkCommandBuffer, it is for remembering API commands what you want to call from GPU
-	 * So on CPU side you need to create a scope that consists of two things
-	 * vkBeginCommandBuffer
-	 * ... <= here your commands what you want to place into your command buffer and send it to GPU through vkQueueSubmit function
-	 * vkEndCommandBuffer
-	 *
-	 * So commands start to work ONLY when you called the vkQueueSubmit otherwise you just "place" commands into your command buffer but you
-	 * didn't issue any thing in order to start the work on GPU side. ALWAYS remember that just sumbit means execute async mode, so you have to wait
-	 * operations before they exeecute fully otherwise you will get some errors or write/read concurrent state and all other stuff, vulkan validation
-	 * will notify you :) (in most cases)
-	 *
-	 * BUT you need always sync what you have done when you called your vkQueueSubmit function, so it is wait method, but generally you can create
-	 * another queue and isolate all stuff tbh
-	 *
-	 * So understing these principles you understand how to work with API and your GPU
-	 *
-	 * There's nothing hard, but it makes all stuff on programmer side if you remember OpenGL and how it was easy to load texture upload it and create
-	 * buffers and it In OpenGL all stuff is handled by driver and other things, not a programmer definitely
-	 *
-	 * What we do here? We need to change the layout of our image. it means where we want to use it. So in our case we want to see that this image
-	 * will be in shaders Because the initial state of create object is VK_IMAGE_LAYOUT_UNDEFINED means you can't just pass that VkImage handle to
-	 * your functions and wait that it comes to shaders for exmaple No it doesn't work like that you have to have the explicit states of your resource
-	 * and where it goes
-	 *
-	 * In our case we want to see in our pixel shader so we need to change transfer into this flag VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, because we
-	 * want to copy so it means some transfer thing, but after we say it goes to pixel after our copying operation
+	 * So Vulkan works only through VkCommandBuffer, it is for remembering API commands what you want to call from GPU, and commands start to work
+	 * ONLY when you submit them. Uploading each texture with its own submit and waiting for it serialises loading on full GPU round trips, so the
+	 * pixels are copied into staging memory here and the copy, together with the layout transitions from VK_IMAGE_LAYOUT_UNDEFINED to
+	 * VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL and then to VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, is recorded for all queued textures at once when
+	 * the frame is submitted (see UploadResourceManager).
 	 */
-	m_upload_manager.UploadToGPU([p_image, extent_image, cpu_buffer](VkCommandBuffer p_cmd) {
-		VkImageSubresourceRange range = {};
-		range.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-		range.baseMipLevel = 0;
-		range.baseArrayLayer = 0;
-		range.levelCount = 1;
-		range.layerCount = 1;
-
-		VkImageMemoryBarrier info_barrier = {};
-		info_barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-		info_barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-		info_barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-		info_barrier.image = p_image;
-		info_barrier.subresourceRange = range;
-		info_barrier.srcAccessMask = 0;
-		info_barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-
-		vkCmdPipelineBarrier(p_cmd, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &info_barrier);
-
-		VkBufferImageCopy region = {};
-		region.bufferOffset = 0;
-		region.bufferRowLength = 0;
-		region.bufferImageHeight = 0;
-
-		region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-		region.imageSubresource.mipLevel = 0;
-		region.imageSubresource.baseArrayLayer = 0;
-		region.imageSubresource.layerCount = 1;
-		region.imageExtent = extent_image;
+	std::lock_guard<std::mutex> lock(m_resource_mutex);
 
-		vkCmdCopyBufferToImage(p_cmd, cpu_buffer.m_p_vk_buffer, p_image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
-
-		VkImageMemoryBarrier info_barrier_shader_read = {};
-		info_barrier_shader_read.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-		info_barrier_shader_read.pNext = nullptr;
-		info_barrier_shader_read.image = p_image;
-		info_barrier_shader_read.subresourceRange = range;
-		info_barrier_shader_read.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-		info_barrier_shader_read.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-		info_barrier_shader_read.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-		info_barrier_shader_read.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
-
-		vkCmdPipelineBarrier(p_cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1,
-			&info_barrier_shader_read);
-	});
-
-	DestroyResource_StagingBuffer(cpu_buffer);
+	if (!m_upload_manager.Queue_TextureUpload(p_image, extent_image, source.data(), image_size))
+	{
+		Rml::Log::Message(Rml::Log::LT_ERROR, "[Vulkan] failed to queue the upload of texture '%s'", name.c_str());
+		vmaDestroyImage(m_p_allocator, p_image, p_allocation);
+		delete p_texture;
+		return {};
+	}
 
 	VkImageViewCreateInfo info_image_view = {};
 	info_image_view.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
@@ -665,6 +387,13 @@ Rml::TextureHandle RenderInterface_VK::CreateTexture(Rml::Span<const Rml::byte>
 	p_texture->m_p_vk_image_view = p_image_view;
 	p_texture->m_p_vk_sampler = m_p_sampler_linear;
 
+	// @ the descriptor is written once here rather than on the first draw that uses the texture
+	VkDescriptorSet p_texture_set = nullptr;
+	m_manager_descriptors.Alloc_Descriptor(m_p_device, &m_p_descriptor_set_layout_texture, &p_texture_set);
+	m_memory_pool.SetDescriptorSet(2, m_p_sampler_linear, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, p_image_view,
+		VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, p_texture_set);
+	p_texture->m_p_vk_descriptor_set = p_texture_set;
+
 	return reinterpret_cast<Rml::TextureHandle>(p_texture);
 }
 
@@ -674,98 +403,396 @@ void RenderInterface_VK::ReleaseTexture(Rml::TextureHandle texture_handle)
 
 	if (p_texture)
 	{
+		std::lock_guard<std::mutex> lock(m_resource_mutex);
 		m_pending_for_deletion_textures_by_frames[m_semaphore_index_previous].push_back(p_texture);
 	}
 }
 
 void RenderInterface_VK::SetTransform(const Rml::Matrix4f* transform)
 {
-	m_is_transform_enabled = !!(transform);
-	m_user_data_for_vertex_shader.m_transform = m_projection * (transform ? *transform : Rml::Matrix4f::Identity());
+	Record_SetTransform(m_recording, transform);
 }
 
-void RenderInterface_VK::BeginFrame()
+void RenderInterface_VK::Record_Geometry(recording_state_t& state, Rml::CompiledGeometryHandle geometry, Rml::Vector2f translation,
+	Rml::TextureHandle texture) noexcept
 {
-	Wait();
+	if (state.m_p_command_buffer == nullptr)
+		return;
 
-	Update_PendingForDeletion_Textures_By_Frames();
-	Update_PendingForDeletion_Geometries();
+	texture_data_t* p_texture = reinterpret_cast<texture_data_t*>(texture);
+	geometry_handle_t* p_casted_compiled_geometry = reinterpret_cast<geometry_handle_t*>(geometry);
 
-	m_command_buffer_ring.OnBeginFrame();
-	m_p_current_command_buffer = m_command_buffer_ring.GetCommandBufferForActiveFrame(CommandBufferName::Primary);
+	state.m_user_data_for_vertex_shader.m_translate = translation;
 
-	VkCommandBufferBeginInfo info = {};
+	// The uniform data only has to live until the GPU is done with this frame, so it goes into the per-frame ring.
+	shader_vertex_user_data_t* p_data = nullptr;
+	uint32_t pDescriptorOffsets = 0;
+	VkDescriptorSet p_current_descriptor_set = nullptr;
+	bool is_allocated = false;
+	{
+		std::lock_guard<std::mutex> lock(m_resource_mutex);
+		is_allocated = m_memory_pool.Alloc_UniformBuffer(sizeof(state.m_user_data_for_vertex_shader), reinterpret_cast<void**>(&p_data),
+			&pDescriptorOffsets, &p_current_descriptor_set);
+	}
 
-	info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-	info.pInheritanceInfo = nullptr;
-	info.pNext = nullptr;
-	info.flags = VkCommandBufferUsageFlagBits::VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+	if (!is_allocated)
+	{
+		Rml::Log::Message(Rml::Log::LT_ERROR, "[Vulkan] failed to allocate uniform data for shaders, skipping draw call");
+		return;
+	}
 
-	auto status = vkBeginCommandBuffer(m_p_current_command_buffer, &info);
+	p_data->m_transform = state.m_user_data_for_vertex_shader.m_transform;
+	p_data->m_translate = state.m_user_data_for_vertex_shader.m_translate;
 
-	RMLUI_VK_ASSERTMSG(status == VkResult::VK_SUCCESS, "failed to vkBeginCommandBuffer");
+	// @ the dynamic offset changes with every draw, but binding set 0 alone keeps the texture set bound
+	vkCmdBindDescriptorSets(state.m_p_command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_p_pipeline_layout, 0, 1, &p_current_descriptor_set,
+		1, &pDescriptorOffsets);
 
-	VkClearValue for_filling_back_buffer_color;
-	VkClearValue for_stencil_depth;
+	if (p_texture && p_texture->m_p_vk_descriptor_set != state.m_p_bound_texture_descriptor_set)
+	{
+		vkCmdBindDescriptorSets(state.m_p_command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_p_pipeline_layout, 1, 1,
+			&p_texture->m_p_vk_descriptor_set, 0, nullptr);
+		state.m_p_bound_texture_descriptor_set = p_texture->m_p_vk_descriptor_set;
+	}
 
-	for_stencil_depth.depthStencil = {1.0f, 0};
-	for_filling_back_buffer_color.color = {{0.0f, 0.0f, 0.0f, 1.0f}};
+	VkPipeline p_pipeline = nullptr;
 
-	const VkClearValue p_color_rt[] = {for_filling_back_buffer_color, for_stencil_depth};
+	if (state.m_is_use_stencil_pipeline)
+	{
+		p_pipeline = m_p_pipeline_stencil_for_region_where_geometry_will_be_drawn;
+	}
+	else if (p_texture)
+	{
+		p_pipeline = state.m_is_apply_to_regular_geometry_stencil ? m_p_pipeline_stencil_for_regular_geometry_that_applied_to_region_with_textures
+															: m_p_pipeline_with_textures;
+	}
+	else
+	{
+		p_pipeline = state.m_is_apply_to_regular_geometry_stencil ? m_p_pipeline_stencil_for_regular_geometry_that_applied_to_region_without_textures
+															: m_p_pipeline_without_textures;
+	}
 
-	VkRenderPassBeginInfo info_pass = {};
+	if (p_pipeline != state.m_p_bound_pipeline)
+	{
+		vkCmdBindPipeline(state.m_p_command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, p_pipeline);
+		state.m_p_bound_pipeline = p_pipeline;
+	}
 
-	info_pass.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-	info_pass.pNext = nullptr;
-	info_pass.renderPass = m_p_render_pass;
-	info_pass.framebuffer = m_swapchain_frame_buffers[m_image_index];
-	info_pass.pClearValues = p_color_rt;
-	info_pass.clearValueCount = 2;
-	info_pass.renderArea.offset.x = 0;
-	info_pass.renderArea.offset.y = 0;
-	info_pass.renderArea.extent.width = m_width;
-	info_pass.renderArea.extent.height = m_height;
+	vkCmdBindVertexBuffers(state.m_p_command_buffer, 0, 1, &p_casted_compiled_geometry->m_p_vertex.buffer,
+		&p_casted_compiled_geometry->m_p_vertex.offset);
 
-	vkCmdBeginRenderPass(m_p_current_command_buffer, &info_pass, VkSubpassContents::VK_SUBPASS_CONTENTS_INLINE);
-	vkCmdSetViewport(m_p_current_command_buffer, 0, 1, &m_viewport);
+	vkCmdBindIndexBuffer(state.m_p_command_buffer, p_casted_compiled_geometry->m_p_index.buffer, p_casted_compiled_geometry->m_p_index.offset,
+		VK_INDEX_TYPE_UINT32);
 
-	m_is_apply_to_regular_geometry_stencil = false;
+	vkCmdDrawIndexed(state.m_p_command_buffer, p_casted_compiled_geometry->m_num_indices, 1, 0, 0, 0);
 }
 
-void RenderInterface_VK::EndFrame()
+void RenderInterface_VK::Record_EnableScissorRegion(recording_state_t& state, bool enable) noexcept
 {
-	if (m_p_current_command_buffer == nullptr)
+	if (state.m_p_command_buffer == nullptr)
 		return;
 
-	vkCmdEndRenderPass(m_p_current_command_buffer);
-
-	auto status = vkEndCommandBuffer(m_p_current_command_buffer);
-
-	RMLUI_VK_ASSERTMSG(status == VkResult::VK_SUCCESS, "failed to vkEndCommandBuffer");
+	if (state.m_is_transform_enabled)
+	{
+		state.m_is_apply_to_regular_geometry_stencil = true;
+	}
 
-	Submit();
-	Present();
+	state.m_is_use_scissor_specified = enable;
 
-	m_p_current_command_buffer = nullptr;
+	if (state.m_is_use_scissor_specified == false)
+	{
+		state.m_is_apply_to_regular_geometry_stencil = false;
+		vkCmdSetScissor(state.m_p_command_buffer, 0, 1, &m_scissor_original);
+	}
 }
 
-void RenderInterface_VK::SetViewport(int width, int height)
+void RenderInterface_VK::Record_SetScissorRegion(recording_state_t& state, Rml::Rectanglei region) noexcept
 {
-	auto status = vkDeviceWaitIdle(m_p_device);
-	RMLUI_VK_ASSERTMSG(status == VkResult::VK_SUCCESS, "failed to vkDeviceWaitIdle");
-
-	if (width > 0 && height > 0)
+	if (state.m_is_use_scissor_specified)
 	{
-		m_width = width;
-		m_height = height;
-	}
+		if (state.m_is_transform_enabled)
+		{
+			Rml::Vertex vertices[4];
 
-	if (m_p_swapchain)
-	{
-		Destroy_Swapchain();
-		DestroyResourcesDependentOnSize();
-		m_p_swapchain = {};
-	}
+			vertices[0].position = Rml::Vector2f(region.TopLeft());
+			vertices[1].position = Rml::Vector2f(region.TopRight());
+			vertices[2].position = Rml::Vector2f(region.BottomRight());
+			vertices[3].position = Rml::Vector2f(region.BottomLeft());
+
+			int indices[6] = {0, 2, 1, 0, 3, 2};
+
+			state.m_is_use_stencil_pipeline = true;
+
+#ifdef RMLUI_DEBUG
+			VkDebugUtilsLabelEXT info{};
+			info.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_LABEL_EXT;
+			info.color[0] = 1.0f;
+			info.color[1] = 1.0f;
+			info.color[2] = 0.0f;
+			info.color[3] = 1.0f;
+			info.pLabelName = "SetScissorRegion (generated region)";
+
+			vkCmdInsertDebugUtilsLabelEXT(state.m_p_command_buffer, &info);
+#endif
+
+			VkClearDepthStencilValue info_clear_color{};
+
+			info_clear_color.depth = 1.0f;
+			info_clear_color.stencil = 0;
+
+			VkClearAttachment clear_attachment = {};
+			clear_attachment.aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT;
+			clear_attachment.clearValue.depthStencil = info_clear_color;
+			clear_attachment.colorAttachment = 1;
+
+			VkClearRect clear_rect = {};
+			clear_rect.layerCount = 1;
+			clear_rect.rect.extent.width = m_width;
+			clear_rect.rect.extent.height = m_height;
+
+			vkCmdClearAttachments(state.m_p_command_buffer, 1, &clear_attachment, 1, &clear_rect);
+
+			if (Rml::CompiledGeometryHandle handle = CompileGeometry({vertices, 4}, {indices, 6}))
+			{
+				Record_Geometry(state, handle, {}, {});
+				ReleaseGeometry(handle);
+			}
+
+			state.m_is_use_stencil_pipeline = false;
+
+			state.m_is_apply_to_regular_geometry_stencil = true;
+		}
+		else
+		{
+			state.m_scissor.extent.width = region.Width();
+			state.m_scissor.extent.height = region.Height();
+			state.m_scissor.offset.x = Rml::Math::Clamp(region.Left(), 0, m_width);
+			state.m_scissor.offset.y = Rml::Math::Clamp(region.Top(), 0, m_height);
+
+#ifdef RMLUI_DEBUG
+			VkDebugUtilsLabelEXT info{};
+			info.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_LABEL_EXT;
+			info.color[0] = 1.0f;
+			info.color[1] = 0.0f;
+			info.color[2] = 0.0f;
+			info.color[3] = 1.0f;
+			info.pLabelName = "SetScissorRegion (offset)";
+
+			vkCmdInsertDebugUtilsLabelEXT(state.m_p_command_buffer, &info);
+#endif
+
+			vkCmdSetScissor(state.m_p_command_buffer, 0, 1, &state.m_scissor);
+		}
+	}
+}
+
+void RenderInterface_VK::Record_SetTransform(recording_state_t& state, const Rml::Matrix4f* transform) noexcept
+{
+	state.m_is_transform_enabled = !!(transform);
+	state.m_user_data_for_vertex_shader.m_transform = m_projection * (transform ? *transform : Rml::Matrix4f::Identity());
+}
+
+void RenderInterface_VK::Reset_RecordingState(recording_state_t& state, VkCommandBuffer p_command_buffer) noexcept
+{
+	state.m_p_command_buffer = p_command_buffer;
+	state.m_is_apply_to_regular_geometry_stencil = false;
+	state.m_p_bound_pipeline = nullptr;
+	state.m_p_bound_texture_descriptor_set = nullptr;
+}
+
+void RenderInterface_VK::Begin_SecondaryCommandBuffer(VkCommandBuffer p_command_buffer) noexcept
+{
+	VkCommandBufferInheritanceInfo info_inheritance = {};
+	info_inheritance.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+	info_inheritance.pNext = nullptr;
+	info_inheritance.renderPass = m_p_render_pass;
+	info_inheritance.subpass = 0;
+	info_inheritance.framebuffer = m_swapchain_frame_buffers[m_image_index];
+
+	VkCommandBufferBeginInfo info = {};
+	info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+	info.pNext = nullptr;
+	info.pInheritanceInfo = &info_inheritance;
+	info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+
+	auto status = vkBeginCommandBuffer(p_command_buffer, &info);
+	RMLUI_VK_ASSERTMSG(status == VkResult::VK_SUCCESS, "failed to vkBeginCommandBuffer");
+
+	// @ dynamic state isn't inherited from the primary command buffer
+	vkCmdSetViewport(p_command_buffer, 0, 1, &m_viewport);
+	vkCmdSetScissor(p_command_buffer, 0, 1, &m_scissor_original);
+}
+
+void RenderInterface_VK::BeginFrame()
+{
+	Wait();
+
+	Update_PendingForDeletion_Textures_By_Frames();
+	Update_PendingForDeletion_Geometries();
+
+	m_memory_pool.OnBeginFrame(m_semaphore_index);
+	m_upload_manager.OnBeginFrame(m_semaphore_index);
+	m_command_buffer_ring.OnBeginFrame();
+	m_p_current_command_buffer = m_command_buffer_ring.GetCommandBufferForActiveFrame(CommandBufferName::Primary);
+
+	// @ a render pass instance either records draws inline or only executes secondary command buffers, so with recorders the draws issued on
+	// the renderer itself go into a secondary command buffer as well
+	m_is_recording_secondary = !m_context_recorders.empty();
+	m_ended_context_recorders.clear();
+
+	VkCommandBufferBeginInfo info = {};
+
+	info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+	info.pInheritanceInfo = nullptr;
+	info.pNext = nullptr;
+	info.flags = VkCommandBufferUsageFlagBits::VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+	auto status = vkBeginCommandBuffer(m_p_current_command_buffer, &info);
+
+	RMLUI_VK_ASSERTMSG(status == VkResult::VK_SUCCESS, "failed to vkBeginCommandBuffer");
+
+	VkClearValue for_filling_back_buffer_color;
+	VkClearValue for_stencil_depth;
+
+	for_stencil_depth.depthStencil = {1.0f, 0};
+	for_filling_back_buffer_color.color = {{0.0f, 0.0f, 0.0f, 1.0f}};
+
+	const VkClearValue p_color_rt[] = {for_filling_back_buffer_color, for_stencil_depth};
+
+	VkRenderPassBeginInfo info_pass = {};
+
+	info_pass.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+	info_pass.pNext = nullptr;
+	info_pass.renderPass = m_p_render_pass;
+	info_pass.framebuffer = m_swapchain_frame_buffers[m_image_index];
+	info_pass.pClearValues = p_color_rt;
+	info_pass.clearValueCount = 2;
+	info_pass.renderArea.offset.x = 0;
+	info_pass.renderArea.offset.y = 0;
+	info_pass.renderArea.extent.width = m_width;
+	info_pass.renderArea.extent.height = m_height;
+
+	if (m_is_recording_secondary)
+	{
+		vkCmdBeginRenderPass(m_p_current_command_buffer, &info_pass, VkSubpassContents::VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+
+		VkCommandBuffer p_secondary_command_buffer = m_command_buffer_ring.GetCommandBufferForActiveFrame(CommandBufferName::Secondary);
+		Begin_SecondaryCommandBuffer(p_secondary_command_buffer);
+		Reset_RecordingState(m_recording, p_secondary_command_buffer);
+	}
+	else
+	{
+		vkCmdBeginRenderPass(m_p_current_command_buffer, &info_pass, VkSubpassContents::VK_SUBPASS_CONTENTS_INLINE);
+		vkCmdSetViewport(m_p_current_command_buffer, 0, 1, &m_viewport);
+		Reset_RecordingState(m_recording, m_p_current_command_buffer);
+	}
+}
+
+void RenderInterface_VK::EndFrame()
+{
+	if (m_p_current_command_buffer == nullptr)
+		return;
+
+	if (m_is_recording_secondary)
+	{
+		auto status = vkEndCommandBuffer(m_recording.m_p_command_buffer);
+		RMLUI_VK_ASSERTMSG(status == VkResult::VK_SUCCESS, "failed to vkEndCommandBuffer");
+
+		m_secondary_command_buffers.clear();
+		m_secondary_command_buffers.push_back(m_recording.m_p_command_buffer);
+
+		for (const auto& p_recorder : m_context_recorders)
+		{
+			RMLUI_VK_ASSERTMSG(!p_recorder->m_state.m_p_command_buffer, "a context recorder is still recording, call End before EndFrame");
+		}
+
+		for (ContextRecorder* p_recorder : m_ended_context_recorders)
+		{
+			m_secondary_command_buffers.push_back(p_recorder->m_command_buffers[m_semaphore_index]);
+		}
+
+		m_ended_context_recorders.clear();
+
+		vkCmdExecuteCommands(m_p_current_command_buffer, static_cast<uint32_t>(m_secondary_command_buffers.size()),
+			m_secondary_command_buffers.data());
+	}
+
+	m_recording.m_p_command_buffer = nullptr;
+
+	vkCmdEndRenderPass(m_p_current_command_buffer);
+
+	auto status = vkEndCommandBuffer(m_p_current_command_buffer);
+
+	RMLUI_VK_ASSERTMSG(status == VkResult::VK_SUCCESS, "failed to vkEndCommandBuffer");
+
+	Submit();
+	Present();
+
+	m_p_current_command_buffer = nullptr;
+}
+
+RenderInterface_VK::MemoryStatistics RenderInterface_VK::GetMemoryStatistics() const
+{
+	MemoryStatistics result = {};
+	std::lock_guard<std::mutex> lock(m_resource_mutex);
+	m_memory_pool.Get_Statistics(result);
+	return result;
+}
+
+void RenderInterface_VK::SetPipelineCachePath(const Rml::String& path)
+{
+	RMLUI_VK_ASSERTMSG(!m_p_device, "the pipeline cache path must be set before Initialize");
+	m_pipeline_cache_path = path;
+}
+
+RenderInterface_VK::ContextRecorder* RenderInterface_VK::CreateContextRecorder()
+{
+	RMLUI_VK_ASSERTMSG(m_p_device, "you must initialize the renderer before creating context recorders");
+	RMLUI_VK_ASSERTMSG(!m_p_current_command_buffer, "context recorders can't be created between BeginFrame and EndFrame");
+
+	m_context_recorders.push_back(Rml::UniquePtr<ContextRecorder>(new ContextRecorder(this)));
+	return m_context_recorders.back().get();
+}
+
+void RenderInterface_VK::DestroyContextRecorder(ContextRecorder* p_recorder)
+{
+	RMLUI_VK_ASSERTMSG(!m_p_current_command_buffer, "context recorders can't be destroyed between BeginFrame and EndFrame");
+
+	auto it = std::find_if(m_context_recorders.begin(), m_context_recorders.end(),
+		[p_recorder](const Rml::UniquePtr<ContextRecorder>& p_item) { return p_item.get() == p_recorder; });
+
+	if (it == m_context_recorders.end())
+		return;
+
+	// @ its command buffers may still be executing
+	auto status = vkDeviceWaitIdle(m_p_device);
+	RMLUI_VK_ASSERTMSG(status == VkResult::VK_SUCCESS, "failed to vkDeviceWaitIdle");
+
+	m_context_recorders.erase(it);
+}
+
+double RenderInterface_VK::GetPipelineCreationTime() const
+{
+	return m_pipeline_creation_time;
+}
+
+void RenderInterface_VK::SetViewport(int width, int height)
+{
+	auto status = vkDeviceWaitIdle(m_p_device);
+	RMLUI_VK_ASSERTMSG(status == VkResult::VK_SUCCESS, "failed to vkDeviceWaitIdle");
+
+	if (width > 0 && height > 0)
+	{
+		m_width = width;
+		m_height = height;
+	}
+
+	if (m_p_swapchain)
+	{
+		Destroy_Swapchain();
+		DestroyResourcesDependentOnSize();
+		m_p_swapchain = {};
+	}
 
 	VkExtent2D window_extent = GetValidSurfaceExtent();
 	if (window_extent.width == 0 || window_extent.height == 0)
@@ -834,6 +861,9 @@ void RenderInterface_VK::Shutdown()
 
 	RMLUI_VK_ASSERTMSG(status == VkResult::VK_SUCCESS, "you must have a valid status here");
 
+	m_ended_context_recorders.clear();
+	m_context_recorders.clear();
+
 	DestroyResourcesDependentOnSize();
 	Destroy_Resources();
 	Destroy_Allocator();
@@ -1174,15 +1204,17 @@ void RenderInterface_VK::Initialize_Resources(const VkPhysicalDeviceProperties&
 	m_command_buffer_ring.Initialize(m_p_device, m_queue_index_graphics);
 
 	const VkDeviceSize min_buffer_alignment = physical_device_properties.limits.minUniformBufferOffsetAlignment;
-	m_memory_pool.Initialize(kVideoMemoryForAllocation, min_buffer_alignment, m_p_allocator, m_p_device);
+	m_memory_pool.Initialize(kVideoMemoryForAllocation, kVideoMemoryForUniformsPerFrame, min_buffer_alignment, m_p_allocator, m_p_device);
 
-	m_upload_manager.Initialize(m_p_device, m_p_queue_graphics, m_queue_index_graphics);
+	m_upload_manager.Initialize(m_p_device, m_p_allocator, kStagingMemoryForUploadsPerFrame);
 	m_manager_descriptors.Initialize(m_p_device, 100, 100, 10, 10);
 
+	Initialize_PipelineCache(physical_device_properties);
+
+	CreateSamplers();
 	CreateShaders();
 	CreateDescriptorSetLayout();
 	CreatePipelineLayout();
-	CreateSamplers();
 	CreateDescriptorSets();
 }
 
@@ -1254,10 +1286,7 @@ void RenderInterface_VK::Destroy_Resources() noexcept
 	m_command_buffer_ring.Shutdown();
 	m_upload_manager.Shutdown();
 
-	if (m_p_descriptor_set)
-	{
-		m_manager_descriptors.Free_Descriptors(m_p_device, &m_p_descriptor_set);
-	}
+	Destroy_PipelineCache();
 
 	vkDestroyDescriptorSetLayout(m_p_device, m_p_descriptor_set_layout_vertex_transform, nullptr);
 	vkDestroyDescriptorSetLayout(m_p_device, m_p_descriptor_set_layout_texture, nullptr);
@@ -1269,8 +1298,8 @@ void RenderInterface_VK::Destroy_Resources() noexcept
 		vkDestroyShaderModule(m_p_device, p_module, nullptr);
 	}
 
-	DestroySamplers();
 	Destroy_Textures();
+	DestroySamplers();
 	Destroy_Geometries();
 
 	m_manager_descriptors.Shutdown(m_p_device);
@@ -1920,8 +1949,8 @@ void RenderInterface_VK::CreateDescriptorSets() noexcept
 	RMLUI_VK_ASSERTMSG(m_p_descriptor_set_layout_vertex_transform,
 		"[Vulkan] you have to initialize your VkDescriptorSetLayout before calling this method");
 
-	m_manager_descriptors.Alloc_Descriptor(m_p_device, &m_p_descriptor_set_layout_vertex_transform, &m_p_descriptor_set);
-	m_memory_pool.SetDescriptorSet(1, sizeof(shader_vertex_user_data_t), VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, m_p_descriptor_set);
+	m_memory_pool.Initialize_UniformDescriptors(&m_manager_descriptors, m_p_descriptor_set_layout_vertex_transform, 1,
+		sizeof(shader_vertex_user_data_t));
 }
 
 void RenderInterface_VK::CreateSamplers() noexcept
@@ -1944,6 +1973,8 @@ void RenderInterface_VK::Create_Pipelines() noexcept
 	RMLUI_VK_ASSERTMSG(m_p_pipeline_layout, "must be initialized");
 	RMLUI_VK_ASSERTMSG(m_p_render_pass, "must be initialized");
 
+	const auto time_start = std::chrono::steady_clock::now();
+
 	VkPipelineInputAssemblyStateCreateInfo info_assembly_state = {};
 	info_assembly_state.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
 	info_assembly_state.pNext = nullptr;
@@ -2085,7 +2116,7 @@ void RenderInterface_VK::Create_Pipelines() noexcept
 	info.renderPass = m_p_render_pass;
 	info.subpass = 0;
 
-	auto status = vkCreateGraphicsPipelines(m_p_device, nullptr, 1, &info, nullptr, &m_p_pipeline_with_textures);
+	auto status = vkCreateGraphicsPipelines(m_p_device, m_p_pipeline_cache, 1, &info, nullptr, &m_p_pipeline_with_textures);
 	RMLUI_VK_ASSERTMSG(status == VkResult::VK_SUCCESS, "failed to vkCreateGraphicsPipelines");
 
 	info_depth.back.passOp = VK_STENCIL_OP_KEEP;
@@ -2097,7 +2128,7 @@ void RenderInterface_VK::Create_Pipelines() noexcept
 	info_depth.back.reference = 1;
 	info_depth.front = info_depth.back;
 
-	status = vkCreateGraphicsPipelines(m_p_device, nullptr, 1, &info, nullptr,
+	status = vkCreateGraphicsPipelines(m_p_device, m_p_pipeline_cache, 1, &info, nullptr,
 		&m_p_pipeline_stencil_for_regular_geometry_that_applied_to_region_with_textures);
 	RMLUI_VK_ASSERTMSG(status == VkResult::VK_SUCCESS, "failed to vkCreateGraphicsPipelines");
 
@@ -2112,7 +2143,7 @@ void RenderInterface_VK::Create_Pipelines() noexcept
 	info_depth.back.reference = 1;
 	info_depth.front = info_depth.back;
 
-	status = vkCreateGraphicsPipelines(m_p_device, nullptr, 1, &info, nullptr, &m_p_pipeline_without_textures);
+	status = vkCreateGraphicsPipelines(m_p_device, m_p_pipeline_cache, 1, &info, nullptr, &m_p_pipeline_without_textures);
 	RMLUI_VK_ASSERTMSG(status == VkResult::VK_SUCCESS, "failed to vkCreateGraphicsPipelines");
 
 	info_depth.back.passOp = VK_STENCIL_OP_KEEP;
@@ -2124,7 +2155,7 @@ void RenderInterface_VK::Create_Pipelines() noexcept
 	info_depth.back.reference = 1;
 	info_depth.front = info_depth.back;
 
-	status = vkCreateGraphicsPipelines(m_p_device, nullptr, 1, &info, nullptr,
+	status = vkCreateGraphicsPipelines(m_p_device, m_p_pipeline_cache, 1, &info, nullptr,
 		&m_p_pipeline_stencil_for_regular_geometry_that_applied_to_region_without_textures);
 	RMLUI_VK_ASSERTMSG(status == VkResult::VK_SUCCESS, "failed to vkCreateGraphicsPipelines");
 
@@ -2138,7 +2169,7 @@ void RenderInterface_VK::Create_Pipelines() noexcept
 	info_depth.back.reference = 1;
 	info_depth.front = info_depth.back;
 
-	status = vkCreateGraphicsPipelines(m_p_device, nullptr, 1, &info, nullptr, &m_p_pipeline_stencil_for_region_where_geometry_will_be_drawn);
+	status = vkCreateGraphicsPipelines(m_p_device, m_p_pipeline_cache, 1, &info, nullptr, &m_p_pipeline_stencil_for_region_where_geometry_will_be_drawn);
 	RMLUI_VK_ASSERTMSG(status == VkResult::VK_SUCCESS, "failed to vkCreateGraphicsPipelines");
 
 #ifdef RMLUI_DEBUG
@@ -2171,6 +2202,22 @@ void RenderInterface_VK::Create_Pipelines() noexcept
 
 	vkSetDebugUtilsObjectNameEXT(m_p_device, &info_debug);
 #endif
+
+	m_pipeline_creation_time = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - time_start).count();
+
+	// @ the first creation is the one that matters for startup time, later ones (on swapchain recreation) always hit the in-memory cache
+	if (!m_is_pipeline_creation_reported)
+	{
+		Rml::Log::Message(Rml::Log::LT_INFO, "[Vulkan] Created pipelines in %.2f ms (%s pipeline cache)", m_pipeline_creation_time,
+			m_p_pipeline_cache ? (m_is_pipeline_cache_warm ? "warm" : "cold") : "no");
+		m_is_pipeline_creation_reported = true;
+	}
+#ifdef RMLUI_VK_DEBUG
+	else
+	{
+		Rml::Log::Message(Rml::Log::LT_DEBUG, "[Vulkan][Debug] Re-created pipelines in %.2f ms", m_pipeline_creation_time);
+	}
+#endif
 }
 
 void RenderInterface_VK::CreateSwapchainFrameBuffers(const VkExtent2D& real_render_image_size) noexcept
@@ -2342,12 +2389,10 @@ void RenderInterface_VK::CreateResourcesDependentOnSize(const VkExtent2D& real_r
 	m_viewport.x = 0.0f;
 	m_viewport.y = 0.0f;
 
-	m_scissor.extent.width = real_render_image_size.width;
-	m_scissor.extent.height = real_render_image_size.height;
-	m_scissor.offset.x = 0;
-	m_scissor.offset.y = 0;
-
-	m_scissor_original = m_scissor;
+	m_scissor_original.extent.width = real_render_image_size.width;
+	m_scissor_original.extent.height = real_render_image_size.height;
+	m_scissor_original.offset.x = 0;
+	m_scissor_original.offset.y = 0;
 
 	m_projection = Rml::Matrix4f::ProjectOrtho(0.0f, static_cast<float>(m_width), static_cast<float>(m_height), 0.0f, -10000, 10000);
 
@@ -2360,51 +2405,16 @@ void RenderInterface_VK::CreateResourcesDependentOnSize(const VkExtent2D& real_r
 
 	SetTransform(nullptr);
 
+	for (const auto& p_recorder : m_context_recorders)
+	{
+		Record_SetTransform(p_recorder->m_state, nullptr);
+	}
+
 	CreateRenderPass();
 	CreateSwapchainFrameBuffers(real_render_image_size);
 	Create_Pipelines();
 }
 
-RenderInterface_VK::buffer_data_t RenderInterface_VK::CreateResource_StagingBuffer(VkDeviceSize size, VkBufferUsageFlags flags) noexcept
-{
-	VkBufferCreateInfo info = {};
-	info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-	info.pNext = nullptr;
-	info.size = size;
-	info.usage = flags;
-
-	VmaAllocationCreateInfo info_allocation = {};
-	info_allocation.usage = VMA_MEMORY_USAGE_CPU_ONLY;
-
-	VkBuffer p_buffer = nullptr;
-	VmaAllocation p_allocation = nullptr;
-	VmaAllocationInfo info_stats = {};
-
-	VkResult status = vmaCreateBuffer(m_p_allocator, &info, &info_allocation, &p_buffer, &p_allocation, &info_stats);
-	RMLUI_VK_ASSERTMSG(status == VkResult::VK_SUCCESS, "failed to vmaCreateBuffer");
-
-#ifdef RMLUI_VK_DEBUG
-	Rml::Log::Message(Rml::Log::LT_DEBUG, "Allocated buffer [%s]", FormatByteSize(info_stats.size).c_str());
-#endif
-
-	buffer_data_t result = {};
-	result.m_p_vk_buffer = p_buffer;
-	result.m_p_vma_allocation = p_allocation;
-
-	return result;
-}
-
-void RenderInterface_VK::DestroyResource_StagingBuffer(const buffer_data_t& data) noexcept
-{
-	if (m_p_allocator)
-	{
-		if (data.m_p_vk_buffer && data.m_p_vma_allocation)
-		{
-			vmaDestroyBuffer(m_p_allocator, data.m_p_vk_buffer, data.m_p_vma_allocation);
-		}
-	}
-}
-
 void RenderInterface_VK::Destroy_Textures() noexcept
 {
 	for (auto& textures : m_pending_for_deletion_textures_by_frames)
@@ -2513,18 +2523,145 @@ void RenderInterface_VK::DestroySamplers() noexcept
 	vkDestroySampler(m_p_device, m_p_sampler_linear, nullptr);
 }
 
-void RenderInterface_VK::CreateRenderPass() noexcept
+void RenderInterface_VK::Initialize_PipelineCache(const VkPhysicalDeviceProperties& physical_device_properties) noexcept
 {
-	RMLUI_VK_ASSERTMSG(m_p_device, "you must have a valid VkDevice here");
+	RMLUI_VK_ASSERTMSG(m_p_device, "you must initialize VkDevice before calling this method");
 
-	Rml::Array<VkAttachmentDescription, 2> attachments = {};
+	// @ the blob is only valid for the exact device and driver that produced it, anything else is rejected before handing it to the driver
+	m_pipeline_cache_header = {};
+	m_pipeline_cache_header.m_magic = kPipelineCacheMagic;
+	m_pipeline_cache_header.m_header_version = kPipelineCacheHeaderVersion;
+	m_pipeline_cache_header.m_vendor_id = physical_device_properties.vendorID;
+	m_pipeline_cache_header.m_device_id = physical_device_properties.deviceID;
+	m_pipeline_cache_header.m_driver_version = physical_device_properties.driverVersion;
+	memcpy(m_pipeline_cache_header.m_pipeline_cache_uuid, physical_device_properties.pipelineCacheUUID, VK_UUID_SIZE);
 
-	attachments[0].format = m_swapchain_format.format;
-	attachments[0].samples = VK_SAMPLE_COUNT_1_BIT;
-	attachments[0].loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
-	attachments[0].storeOp = VK_ATTACHMENT_STORE_OP_STORE;
-	attachments[0].stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-	attachments[0].stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+	Rml::Vector<Rml::byte> initial_data;
+	m_is_pipeline_cache_warm = false;
+
+	if (!m_pipeline_cache_path.empty())
+	{
+		if (FILE* p_file = fopen(m_pipeline_cache_path.c_str(), "rb"))
+		{
+			// @ the stored size is only trusted when it matches the rest of the file, a truncated or corrupt file must not make us allocate
+			long file_length = -1;
+			if (fseek(p_file, 0, SEEK_END) == 0)
+				file_length = ftell(p_file);
+			const bool is_seek_back = (fseek(p_file, 0, SEEK_SET) == 0);
+
+			pipeline_cache_header_t header = {};
+			const bool is_header_read = is_seek_back && file_length >= static_cast<long>(sizeof(header)) &&
+				(fread(&header, sizeof(header), 1, p_file) == 1);
+			const uint64_t remaining_length = is_header_read ? static_cast<uint64_t>(file_length) - sizeof(header) : 0;
+
+			if (is_header_read && header.m_magic == m_pipeline_cache_header.m_magic &&
+				header.m_header_version == m_pipeline_cache_header.m_header_version &&
+				header.m_vendor_id == m_pipeline_cache_header.m_vendor_id && header.m_device_id == m_pipeline_cache_header.m_device_id &&
+				header.m_driver_version == m_pipeline_cache_header.m_driver_version &&
+				memcmp(header.m_pipeline_cache_uuid, m_pipeline_cache_header.m_pipeline_cache_uuid, VK_UUID_SIZE) == 0 && header.m_data_size > 0)
+			{
+				if (header.m_data_size == remaining_length)
+				{
+					initial_data.resize(static_cast<size_t>(header.m_data_size));
+					if (fread(initial_data.data(), 1, initial_data.size(), p_file) != initial_data.size())
+						initial_data.clear();
+				}
+				else
+				{
+					Rml::Log::Message(Rml::Log::LT_WARNING, "[Vulkan] Pipeline cache '%s' is truncated or corrupt, discarding it",
+						m_pipeline_cache_path.c_str());
+				}
+			}
+			else if (is_header_read)
+			{
+				Rml::Log::Message(Rml::Log::LT_INFO, "[Vulkan] Pipeline cache '%s' was created for another device or driver, ignoring it",
+					m_pipeline_cache_path.c_str());
+			}
+			else
+			{
+				Rml::Log::Message(Rml::Log::LT_WARNING, "[Vulkan] Pipeline cache '%s' is truncated or corrupt, discarding it",
+					m_pipeline_cache_path.c_str());
+			}
+
+			fclose(p_file);
+		}
+	}
+
+	VkPipelineCacheCreateInfo info = {};
+	info.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+	info.pNext = nullptr;
+	info.initialDataSize = initial_data.size();
+	info.pInitialData = initial_data.empty() ? nullptr : initial_data.data();
+
+	VkResult status = vkCreatePipelineCache(m_p_device, &info, nullptr, &m_p_pipeline_cache);
+
+	if (status != VkResult::VK_SUCCESS && !initial_data.empty())
+	{
+		// @ the driver refused the data, start over with an empty cache
+		info.initialDataSize = 0;
+		info.pInitialData = nullptr;
+		status = vkCreatePipelineCache(m_p_device, &info, nullptr, &m_p_pipeline_cache);
+		initial_data.clear();
+	}
+
+	if (status != VkResult::VK_SUCCESS)
+	{
+		Rml::Log::Message(Rml::Log::LT_WARNING, "[Vulkan] failed to vkCreatePipelineCache, pipelines will be created without a cache");
+		m_p_pipeline_cache = nullptr;
+	}
+
+	m_is_pipeline_cache_warm = !initial_data.empty();
+}
+
+void RenderInterface_VK::Destroy_PipelineCache() noexcept
+{
+	if (!m_p_pipeline_cache)
+		return;
+
+	if (!m_pipeline_cache_path.empty())
+	{
+		size_t data_size = 0;
+		VkResult status = vkGetPipelineCacheData(m_p_device, m_p_pipeline_cache, &data_size, nullptr);
+
+		Rml::Vector<Rml::byte> data;
+		if (status == VkResult::VK_SUCCESS && data_size > 0)
+		{
+			data.resize(data_size);
+			status = vkGetPipelineCacheData(m_p_device, m_p_pipeline_cache, &data_size, data.data());
+			data.resize(data_size);
+		}
+
+		if (status == VkResult::VK_SUCCESS && !data.empty())
+		{
+			FILE* p_file = fopen(m_pipeline_cache_path.c_str(), "wb");
+
+			pipeline_cache_header_t header = m_pipeline_cache_header;
+			header.m_data_size = static_cast<uint64_t>(data.size());
+
+			if (!p_file || fwrite(&header, sizeof(header), 1, p_file) != 1 || fwrite(data.data(), 1, data.size(), p_file) != data.size())
+				Rml::Log::Message(Rml::Log::LT_WARNING, "[Vulkan] failed to write pipeline cache '%s'", m_pipeline_cache_path.c_str());
+
+			if (p_file)
+				fclose(p_file);
+		}
+	}
+
+	vkDestroyPipelineCache(m_p_device, m_p_pipeline_cache, nullptr);
+	m_p_pipeline_cache = nullptr;
+}
+
+void RenderInterface_VK::CreateRenderPass() noexcept
+{
+	RMLUI_VK_ASSERTMSG(m_p_device, "you must have a valid VkDevice here");
+
+	Rml::Array<VkAttachmentDescription, 2> attachments = {};
+
+	attachments[0].format = m_swapchain_format.format;
+	attachments[0].samples = VK_SAMPLE_COUNT_1_BIT;
+	attachments[0].loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+	attachments[0].storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+	attachments[0].stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+	attachments[0].stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
 	attachments[0].initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
 	attachments[0].finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
 
@@ -2649,6 +2786,33 @@ void RenderInterface_VK::Submit() noexcept
 
 	VkFence p_fence = m_executed_fences[m_semaphore_index];
 
+	// Textures created since the last submit are uploaded by a separate command buffer which runs ahead of the frame's commands.
+	VkCommandBuffer p_command_buffers[2] = {};
+	uint32_t command_buffer_count = 0;
+
+	if (m_upload_manager.Has_PendingUploads())
+	{
+		VkCommandBuffer p_upload_command_buffer = m_command_buffer_ring.GetCommandBufferForActiveFrame(CommandBufferName::Upload);
+
+		VkCommandBufferBeginInfo info_command = {};
+		info_command.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+		info_command.pNext = nullptr;
+		info_command.pInheritanceInfo = nullptr;
+		info_command.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+		VkResult status = vkBeginCommandBuffer(p_upload_command_buffer, &info_command);
+		RMLUI_VK_ASSERTMSG(status == VkResult::VK_SUCCESS, "failed to vkBeginCommandBuffer");
+
+		m_upload_manager.Record_PendingUploads(p_upload_command_buffer);
+
+		status = vkEndCommandBuffer(p_upload_command_buffer);
+		RMLUI_VK_ASSERTMSG(status == VkResult::VK_SUCCESS, "failed to vkEndCommandBuffer");
+
+		p_command_buffers[command_buffer_count++] = p_upload_command_buffer;
+	}
+
+	p_command_buffers[command_buffer_count++] = m_p_current_command_buffer;
+
 	VkPipelineStageFlags submit_wait_stage = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
 
 	VkSubmitInfo info = {};
@@ -2660,8 +2824,8 @@ void RenderInterface_VK::Submit() noexcept
 	info.pWaitDstStageMask = &submit_wait_stage;
 	info.signalSemaphoreCount = 1;
 	info.pSignalSemaphores = p_semaphores_signal;
-	info.commandBufferCount = 1;
-	info.pCommandBuffers = &m_p_current_command_buffer;
+	info.commandBufferCount = command_buffer_count;
+	info.pCommandBuffers = p_command_buffers;
 
 	VkResult status = vkQueueSubmit(m_p_queue_graphics, 1, &info, p_fence);
 
@@ -2746,7 +2910,8 @@ void RenderInterface_VK::CommandBufferRing::Initialize(VkDevice p_device, uint32
 			info_buffer.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
 			info_buffer.pNext = nullptr;
 			info_buffer.commandPool = p_pool;
-			info_buffer.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+			info_buffer.level = command_buffer_index == static_cast<uint32_t>(CommandBufferName::Secondary) ? VK_COMMAND_BUFFER_LEVEL_SECONDARY
+																											: VK_COMMAND_BUFFER_LEVEL_PRIMARY;
 			info_buffer.commandBufferCount = 1;
 
 			VkCommandBuffer p_buffer = nullptr;
@@ -2802,17 +2967,363 @@ VkCommandBuffer RenderInterface_VK::CommandBufferRing::GetCommandBufferForActive
 	return result;
 }
 
+RenderInterface_VK::ContextRecorder::ContextRecorder(RenderInterface_VK* p_owner) :
+	m_p_owner{p_owner}, m_command_pools{}, m_command_buffers{}, m_state{}
+{
+	RMLUI_VK_ASSERTMSG(m_p_owner, "you must pass a valid renderer");
+
+	for (uint32_t frame_index = 0; frame_index < kSwapchainBackBufferCount; ++frame_index)
+	{
+		VkCommandPoolCreateInfo info_pool = {};
+		info_pool.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+		info_pool.pNext = nullptr;
+		info_pool.queueFamilyIndex = m_p_owner->m_queue_index_graphics;
+		info_pool.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+
+		auto status = vkCreateCommandPool(m_p_owner->m_p_device, &info_pool, nullptr, &m_command_pools[frame_index]);
+		RMLUI_VK_ASSERTMSG(status == VkResult::VK_SUCCESS, "can't create command pool");
+
+		VkCommandBufferAllocateInfo info_buffer = {};
+		info_buffer.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+		info_buffer.pNext = nullptr;
+		info_buffer.commandPool = m_command_pools[frame_index];
+		info_buffer.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+		info_buffer.commandBufferCount = 1;
+
+		status = vkAllocateCommandBuffers(m_p_owner->m_p_device, &info_buffer, &m_command_buffers[frame_index]);
+		RMLUI_VK_ASSERTMSG(status == VkResult::VK_SUCCESS, "failed to fill command buffers");
+	}
+
+	m_p_owner->Record_SetTransform(m_state, nullptr);
+}
+
+RenderInterface_VK::ContextRecorder::~ContextRecorder()
+{
+	for (uint32_t frame_index = 0; frame_index < kSwapchainBackBufferCount; ++frame_index)
+	{
+		vkFreeCommandBuffers(m_p_owner->m_p_device, m_command_pools[frame_index], 1, &m_command_buffers[frame_index]);
+		vkDestroyCommandPool(m_p_owner->m_p_device, m_command_pools[frame_index], nullptr);
+	}
+}
+
+void RenderInterface_VK::ContextRecorder::Begin()
+{
+	RMLUI_VK_ASSERTMSG(!m_state.m_p_command_buffer, "already recording, call End first");
+	RMLUI_VK_ASSERTMSG(m_p_owner->m_is_recording_secondary, "Begin must be called after BeginFrame of the renderer");
+
+	if (!m_p_owner->m_is_recording_secondary)
+		return;
+
+	// @ recording again in the same frame replaces the earlier recording, which then takes the place of the last End in the order
+	{
+		std::lock_guard<std::mutex> lock(m_p_owner->m_resource_mutex);
+		auto& ended_recorders = m_p_owner->m_ended_context_recorders;
+		ended_recorders.erase(std::remove(ended_recorders.begin(), ended_recorders.end(), this), ended_recorders.end());
+	}
+
+	// @ the pool was last used by the frame with the same index, which has completed by the time BeginFrame returns
+	const uint32_t frame_index = m_p_owner->m_semaphore_index;
+
+	auto status = vkResetCommandPool(m_p_owner->m_p_device, m_command_pools[frame_index], 0);
+	RMLUI_VK_ASSERTMSG(status == VkResult::VK_SUCCESS, "failed to vkResetCommandPool");
+
+	m_p_owner->Begin_SecondaryCommandBuffer(m_command_buffers[frame_index]);
+	m_p_owner->Reset_RecordingState(m_state, m_command_buffers[frame_index]);
+}
+
+void RenderInterface_VK::ContextRecorder::End()
+{
+	if (!m_state.m_p_command_buffer)
+		return;
+
+	auto status = vkEndCommandBuffer(m_state.m_p_command_buffer);
+	RMLUI_VK_ASSERTMSG(status == VkResult::VK_SUCCESS, "failed to vkEndCommandBuffer");
+
+	m_state.m_p_command_buffer = nullptr;
+
+	std::lock_guard<std::mutex> lock(m_p_owner->m_resource_mutex);
+	m_p_owner->m_ended_context_recorders.push_back(this);
+}
+
+Rml::CompiledGeometryHandle RenderInterface_VK::ContextRecorder::CompileGeometry(Rml::Span<const Rml::Vertex> vertices, Rml::Span<const int> indices)
+{
+	return m_p_owner->CompileGeometry(vertices, indices);
+}
+
+void RenderInterface_VK::ContextRecorder::RenderGeometry(Rml::CompiledGeometryHandle handle, Rml::Vector2f translation, Rml::TextureHandle texture)
+{
+	RMLUI_ZoneScopedN("Vulkan - RenderCompiledGeometry");
+
+	m_p_owner->Record_Geometry(m_state, handle, translation, texture);
+}
+
+void RenderInterface_VK::ContextRecorder::ReleaseGeometry(Rml::CompiledGeometryHandle geometry)
+{
+	m_p_owner->ReleaseGeometry(geometry);
+}
+
+Rml::TextureHandle RenderInterface_VK::ContextRecorder::LoadTexture(Rml::Vector2i& texture_dimensions, const Rml::String& source)
+{
+	return m_p_owner->LoadTexture(texture_dimensions, source);
+}
+
+Rml::TextureHandle RenderInterface_VK::ContextRecorder::GenerateTexture(Rml::Span<const Rml::byte> source_data, Rml::Vector2i source_dimensions)
+{
+	return m_p_owner->GenerateTexture(source_data, source_dimensions);
+}
+
+void RenderInterface_VK::ContextRecorder::ReleaseTexture(Rml::TextureHandle texture_handle)
+{
+	m_p_owner->ReleaseTexture(texture_handle);
+}
+
+void RenderInterface_VK::ContextRecorder::EnableScissorRegion(bool enable)
+{
+	m_p_owner->Record_EnableScissorRegion(m_state, enable);
+}
+
+void RenderInterface_VK::ContextRecorder::SetScissorRegion(Rml::Rectanglei region)
+{
+	m_p_owner->Record_SetScissorRegion(m_state, region);
+}
+
+void RenderInterface_VK::ContextRecorder::SetTransform(const Rml::Matrix4f* transform)
+{
+	m_p_owner->Record_SetTransform(m_state, transform);
+}
+
+RenderInterface_VK::UploadResourceManager::UploadResourceManager() :
+	m_p_device{}, m_p_allocator{}, m_staging_block_size{}, m_frame_index{}, m_upload_count{}, m_batch_count{}
+{}
+
+RenderInterface_VK::UploadResourceManager::~UploadResourceManager() {}
+
+void RenderInterface_VK::UploadResourceManager::Initialize(VkDevice p_device, VmaAllocator p_allocator, VkDeviceSize staging_block_size) noexcept
+{
+	RMLUI_VK_ASSERTMSG(p_device, "you have to pass a valid VkDevice for creation resources");
+	RMLUI_VK_ASSERTMSG(p_allocator, "you have to pass a valid VmaAllocator");
+	RMLUI_VK_ASSERTMSG(staging_block_size > 0, "size must be valid");
+
+	m_p_device = p_device;
+	m_p_allocator = p_allocator;
+	m_staging_block_size = staging_block_size;
+}
+
+void RenderInterface_VK::UploadResourceManager::Shutdown() noexcept
+{
+	for (auto& blocks : m_staging_blocks_by_frames)
+	{
+		for (staging_block_t& block : blocks)
+			Destroy_StagingBlock(block);
+		blocks.clear();
+	}
+
+	// @ the device is idle at this point and the images are destroyed together with the textures, just forget about them
+	m_pending_uploads.clear();
+}
+
+void RenderInterface_VK::UploadResourceManager::OnBeginFrame(uint32_t frame_index) noexcept
+{
+	RMLUI_VK_ASSERTMSG(frame_index < kSwapchainBackBufferCount, "frame index out of range");
+
+	m_frame_index = frame_index;
+
+	auto& blocks = m_staging_blocks_by_frames[frame_index];
+
+	// @ keep the regular blocks around for reuse, but don't hold on to oversized blocks made for a single large texture
+	for (staging_block_t& block : blocks)
+	{
+		if (block.m_size > m_staging_block_size)
+			Destroy_StagingBlock(block);
+
+		block.m_used = 0;
+	}
+
+	blocks.erase(std::remove_if(blocks.begin(), blocks.end(), [](const staging_block_t& block) { return block.m_p_data == nullptr; }),
+		blocks.end());
+}
+
+bool RenderInterface_VK::UploadResourceManager::Queue_TextureUpload(VkImage p_image, VkExtent3D extent, const void* p_data,
+	VkDeviceSize size) noexcept
+{
+	RMLUI_VK_ASSERTMSG(p_image, "you must pass a valid VkImage");
+	RMLUI_VK_ASSERTMSG(p_data && size > 0, "you must pass valid data for uploading");
+
+	// @ buffer offsets of copy commands must be a multiple of the texel size, keep them nicely aligned
+	constexpr VkDeviceSize kStagingAlignment = 16;
+
+	auto& blocks = m_staging_blocks_by_frames[m_frame_index];
+
+	staging_block_t* p_block = nullptr;
+	for (staging_block_t& block : blocks)
+	{
+		if (AlignUp<VkDeviceSize>(block.m_used, kStagingAlignment) + size <= block.m_size)
+		{
+			p_block = &block;
+			break;
+		}
+	}
+
+	if (!p_block)
+	{
+		staging_block_t block = {};
+		if (!Create_StagingBlock(Rml::Math::Max(m_staging_block_size, size), block))
+			return false;
+
+		blocks.push_back(block);
+		p_block = &blocks.back();
+	}
+
+	const VkDeviceSize offset = AlignUp<VkDeviceSize>(p_block->m_used, kStagingAlignment);
+	memcpy(p_block->m_p_data + offset, p_data, static_cast<size_t>(size));
+	p_block->m_used = offset + size;
+
+	pending_upload_t upload = {};
+	upload.m_p_image = p_image;
+	upload.m_extent = extent;
+	upload.m_p_staging_buffer = p_block->m_buffer.m_p_vk_buffer;
+	upload.m_staging_offset = offset;
+
+	m_pending_uploads.push_back(upload);
+
+	return true;
+}
+
+void RenderInterface_VK::UploadResourceManager::Record_PendingUploads(VkCommandBuffer p_command_buffer) noexcept
+{
+	RMLUI_VK_ASSERTMSG(p_command_buffer, "you must pass a valid VkCommandBuffer");
+
+	if (m_pending_uploads.empty())
+		return;
+
+	VkImageSubresourceRange range = {};
+	range.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+	range.baseMipLevel = 0;
+	range.baseArrayLayer = 0;
+	range.levelCount = 1;
+	range.layerCount = 1;
+
+	/*
+	 * The images start in VK_IMAGE_LAYOUT_UNDEFINED, so first move all of them into the transfer layout with a single barrier, then copy the
+	 * pixels from the staging ring, and finally move them into the layout for sampling in the pixel shader with a second barrier. Since this
+	 * command buffer is submitted together with (and ahead of) the frame's own command buffer, the barriers also order the copies before any
+	 * draw call of that frame that samples the images.
+	 */
+	Rml::Vector<VkImageMemoryBarrier> barriers(m_pending_uploads.size());
+
+	for (size_t i = 0; i < m_pending_uploads.size(); ++i)
+	{
+		VkImageMemoryBarrier& info_barrier = barriers[i];
+		info_barrier = {};
+		info_barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+		info_barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+		info_barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+		info_barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		info_barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		info_barrier.image = m_pending_uploads[i].m_p_image;
+		info_barrier.subresourceRange = range;
+		info_barrier.srcAccessMask = 0;
+		info_barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+	}
+
+	vkCmdPipelineBarrier(p_command_buffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr,
+		static_cast<uint32_t>(barriers.size()), barriers.data());
+
+	for (const pending_upload_t& upload : m_pending_uploads)
+	{
+		VkBufferImageCopy region = {};
+		region.bufferOffset = upload.m_staging_offset;
+		region.bufferRowLength = 0;
+		region.bufferImageHeight = 0;
+
+		region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+		region.imageSubresource.mipLevel = 0;
+		region.imageSubresource.baseArrayLayer = 0;
+		region.imageSubresource.layerCount = 1;
+		region.imageExtent = upload.m_extent;
+
+		vkCmdCopyBufferToImage(p_command_buffer, upload.m_p_staging_buffer, upload.m_p_image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+	}
+
+	for (VkImageMemoryBarrier& info_barrier : barriers)
+	{
+		info_barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+		info_barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+		info_barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+		info_barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+	}
+
+	vkCmdPipelineBarrier(p_command_buffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, nullptr, 0, nullptr,
+		static_cast<uint32_t>(barriers.size()), barriers.data());
+
+	m_upload_count += static_cast<uint32_t>(m_pending_uploads.size());
+	++m_batch_count;
+
+	m_pending_uploads.clear();
+}
+
+bool RenderInterface_VK::UploadResourceManager::Create_StagingBlock(VkDeviceSize size, staging_block_t& out) noexcept
+{
+	RMLUI_VK_ASSERTMSG(m_p_allocator, "you must have a valid VmaAllocator");
+
+	out = {};
+
+	VkBufferCreateInfo info = {};
+	info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+	info.pNext = nullptr;
+	info.size = size;
+	info.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+
+	VmaAllocationCreateInfo info_allocation = {};
+	info_allocation.usage = VMA_MEMORY_USAGE_CPU_ONLY;
+
+	VmaAllocationInfo info_stats = {};
+
+	VkResult status =
+		vmaCreateBuffer(m_p_allocator, &info, &info_allocation, &out.m_buffer.m_p_vk_buffer, &out.m_buffer.m_p_vma_allocation, &info_stats);
+	if (status != VkResult::VK_SUCCESS)
+	{
+		Rml::Log::Message(Rml::Log::LT_ERROR, "[Vulkan] failed to vmaCreateBuffer for a staging block of %zu bytes", size_t(size));
+		out = {};
+		return false;
+	}
+
+#ifdef RMLUI_VK_DEBUG
+	Rml::Log::Message(Rml::Log::LT_DEBUG, "[Vulkan][Debug] Allocated staging block [%s]", FormatByteSize(info_stats.size).c_str());
+#endif
+
+	status = vmaMapMemory(m_p_allocator, out.m_buffer.m_p_vma_allocation, (void**)&out.m_p_data);
+	RMLUI_VK_ASSERTMSG(status == VkResult::VK_SUCCESS, "failed to vmaMapMemory");
+
+	out.m_size = size;
+
+	return true;
+}
+
+void RenderInterface_VK::UploadResourceManager::Destroy_StagingBlock(staging_block_t& block) noexcept
+{
+	if (block.m_buffer.m_p_vk_buffer && block.m_buffer.m_p_vma_allocation)
+	{
+		vmaUnmapMemory(m_p_allocator, block.m_buffer.m_p_vma_allocation);
+		vmaDestroyBuffer(m_p_allocator, block.m_buffer.m_p_vk_buffer, block.m_buffer.m_p_vma_allocation);
+	}
+
+	block = {};
+}
+
 RenderInterface_VK::MemoryPool::MemoryPool() :
-	m_memory_total_size{}, m_device_min_uniform_alignment{}, m_p_data{}, m_p_buffer{}, m_p_buffer_alloc{}, m_p_device{}, m_p_vk_allocator{},
-	m_p_block{}
+	m_geometry_block_size{}, m_uniform_block_size{}, m_device_min_uniform_alignment{}, m_p_device{}, m_p_vk_allocator{}, m_p_descriptor_manager{},
+	m_p_uniform_layout{}, m_uniform_binding_index{}, m_uniform_range{}, m_geometry_bytes_used{}, m_geometry_bytes_used_high_water_mark{},
+	m_uniform_frame_index{}, m_uniform_block_index{}, m_uniform_bytes_used_last_frame{}, m_uniform_bytes_used_high_water_mark{}
 {}
 
 RenderInterface_VK::MemoryPool::~MemoryPool() {}
 
-void RenderInterface_VK::MemoryPool::Initialize(VkDeviceSize byte_size, VkDeviceSize device_min_uniform_alignment, VmaAllocator p_allocator,
-	VkDevice p_device) noexcept
+void RenderInterface_VK::MemoryPool::Initialize(VkDeviceSize geometry_block_size, VkDeviceSize uniform_block_size,
+	VkDeviceSize device_min_uniform_alignment, VmaAllocator p_allocator, VkDevice p_device) noexcept
 {
-	RMLUI_VK_ASSERTMSG(byte_size > 0, "size must be valid");
+	RMLUI_VK_ASSERTMSG(geometry_block_size > 0, "size must be valid");
+	RMLUI_VK_ASSERTMSG(uniform_block_size > 0, "size must be valid");
 	RMLUI_VK_ASSERTMSG(device_min_uniform_alignment > 0, "uniform alignment must be valid");
 	RMLUI_VK_ASSERTMSG(p_device, "you must pass a valid VkDevice");
 	RMLUI_VK_ASSERTMSG(p_allocator, "you must pass a valid VmaAllocator");
@@ -2825,63 +3336,101 @@ void RenderInterface_VK::MemoryPool::Initialize(VkDeviceSize byte_size, VkDevice
 	Rml::Log::Message(Rml::Log::LT_DEBUG, "[Vulkan][Debug] the alignment for uniform buffer is: %zu", m_device_min_uniform_alignment);
 #endif
 
-	m_memory_total_size = AlignUp<VkDeviceSize>(static_cast<VkDeviceSize>(byte_size), m_device_min_uniform_alignment);
-
-	VkBufferCreateInfo info = {};
-	info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-	info.usage = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT;
-	info.size = m_memory_total_size;
-
-	VmaAllocationCreateInfo info_alloc = {};
-
-	auto p_commentary = "our pool buffer that manages all memory in vulkan (dynamic)";
+	m_geometry_block_size = AlignUp<VkDeviceSize>(geometry_block_size, m_device_min_uniform_alignment);
+	m_uniform_block_size = AlignUp<VkDeviceSize>(uniform_block_size, m_device_min_uniform_alignment);
 
-	info_alloc.usage = VMA_MEMORY_USAGE_CPU_TO_GPU;
-	info_alloc.flags = VMA_ALLOCATION_CREATE_USER_DATA_COPY_STRING_BIT;
-	info_alloc.pUserData = const_cast<char*>(p_commentary);
+	// @ start with one block of each kind, the uniform blocks get their descriptor sets once the layout exists
+	m_geometry_blocks.emplace_back();
+	bool status = Create_Block(m_geometry_block_size, VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+		"memory pool block for vertex and index data", m_geometry_blocks.back());
+	RMLUI_VK_ASSERTMSG(status, "failed to create the first geometry block");
 
-	VmaAllocationInfo info_stats = {};
+	for (auto& blocks : m_uniform_blocks_by_frames)
+	{
+		blocks.emplace_back();
+		status = Create_Block(m_uniform_block_size, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, "memory pool block for per-frame uniform data", blocks.back());
+		RMLUI_VK_ASSERTMSG(status, "failed to create the first uniform block");
+	}
 
-	auto status = vmaCreateBuffer(m_p_vk_allocator, &info, &info_alloc, &m_p_buffer, &m_p_buffer_alloc, &info_stats);
+	(void)status;
+}
 
-	RMLUI_VK_ASSERTMSG(status == VkResult::VK_SUCCESS, "failed to vmaCreateBuffer");
+void RenderInterface_VK::MemoryPool::Initialize_UniformDescriptors(DescriptorPoolManager* p_manager, VkDescriptorSetLayout p_layout,
+	uint32_t binding_index, uint32_t range) noexcept
+{
+	RMLUI_VK_ASSERTMSG(p_manager, "you must pass a valid DescriptorPoolManager");
+	RMLUI_VK_ASSERTMSG(p_layout, "you must pass a valid VkDescriptorSetLayout");
 
-	VmaVirtualBlockCreateInfo info_virtual_block = {};
-	info_virtual_block.size = m_memory_total_size;
+	m_p_descriptor_manager = p_manager;
+	m_p_uniform_layout = p_layout;
+	m_uniform_binding_index = binding_index;
+	m_uniform_range = range;
 
-	status = vmaCreateVirtualBlock(&info_virtual_block, &m_p_block);
+	for (auto& blocks : m_uniform_blocks_by_frames)
+	{
+		for (block_t& block : blocks)
+		{
+			if (block.m_p_descriptor_set == nullptr)
+				Create_UniformDescriptorSet(block);
+		}
+	}
+}
 
-	RMLUI_VK_ASSERTMSG(status == VkResult::VK_SUCCESS, "failed to vmaCreateVirtualBlock");
+void RenderInterface_VK::MemoryPool::Shutdown() noexcept
+{
+	RMLUI_VK_ASSERTMSG(m_p_vk_allocator, "you must have a valid VmaAllocator");
 
 #ifdef RMLUI_VK_DEBUG
-	Rml::Log::Message(Rml::Log::LT_DEBUG, "[Vulkan][Debug] Allocated memory pool [%s]", FormatByteSize(info_stats.size).c_str());
+	MemoryStatistics stats = {};
+	Get_Statistics(stats);
+	Rml::Log::Message(Rml::Log::LT_DEBUG,
+		"[Vulkan][Debug] Destroyed memory pool, geometry: %u block(s) [%s] with high-water mark [%s], uniforms: %u block(s) [%s] with high-water "
+		"mark [%s] per frame",
+		stats.geometry_block_count, FormatByteSize(stats.geometry_bytes_reserved).c_str(),
+		FormatByteSize(stats.geometry_bytes_used_high_water_mark).c_str(), stats.uniform_block_count,
+		FormatByteSize(stats.uniform_bytes_reserved).c_str(), FormatByteSize(stats.uniform_bytes_used_high_water_mark).c_str());
 #endif
 
-	status = vmaMapMemory(m_p_vk_allocator, m_p_buffer_alloc, (void**)&m_p_data);
+	for (block_t& block : m_geometry_blocks)
+		Destroy_Block(block);
+	m_geometry_blocks.clear();
 
-	RMLUI_VK_ASSERTMSG(status == VkResult::VK_SUCCESS, "failed to vmaMapMemory");
+	for (auto& blocks : m_uniform_blocks_by_frames)
+	{
+		for (block_t& block : blocks)
+			Destroy_Block(block);
+		blocks.clear();
+	}
+
+	m_geometry_bytes_used = 0;
+	m_uniform_block_index = 0;
 }
 
-void RenderInterface_VK::MemoryPool::Shutdown() noexcept
+void RenderInterface_VK::MemoryPool::OnBeginFrame(uint32_t frame_index) noexcept
 {
-	RMLUI_VK_ASSERTMSG(m_p_vk_allocator, "you must have a valid VmaAllocator");
-	RMLUI_VK_ASSERTMSG(m_p_buffer, "you must allocate VkBuffer for deleting");
-	RMLUI_VK_ASSERTMSG(m_p_buffer_alloc, "you must allocate VmaAllocation for deleting");
+	RMLUI_VK_ASSERTMSG(frame_index < kSwapchainBackBufferCount, "frame index out of range");
 
-#ifdef RMLUI_VK_DEBUG
-	Rml::Log::Message(Rml::Log::LT_DEBUG, "[Vulkan][Debug] Destroyed memory pool [%s]", FormatByteSize(m_memory_total_size).c_str());
-#endif
+	// @ gather the usage of the frame we just finished recording before switching to the next ring
+	VkDeviceSize used = 0;
+	for (const block_t& block : m_uniform_blocks_by_frames[m_uniform_frame_index])
+		used += block.m_used;
 
-	vmaUnmapMemory(m_p_vk_allocator, m_p_buffer_alloc);
-	vmaDestroyVirtualBlock(m_p_block);
-	vmaDestroyBuffer(m_p_vk_allocator, m_p_buffer, m_p_buffer_alloc);
+	m_uniform_bytes_used_last_frame = used;
+	m_uniform_bytes_used_high_water_mark = Rml::Math::Max(m_uniform_bytes_used_high_water_mark, used);
+
+	// @ the fence of this frame has signaled, so nothing on the GPU is reading its uniform blocks anymore
+	m_uniform_frame_index = frame_index;
+	m_uniform_block_index = 0;
+
+	for (block_t& block : m_uniform_blocks_by_frames[frame_index])
+		block.m_used = 0;
 }
 
 bool RenderInterface_VK::MemoryPool::Alloc_GeneralBuffer(VkDeviceSize size, void** p_data, VkDescriptorBufferInfo* p_out,
-	VmaVirtualAllocation* p_alloc) noexcept
+	VmaVirtualAllocation* p_alloc, uint32_t* p_block_index) noexcept
 {
 	RMLUI_VK_ASSERTMSG(p_out, "you must pass a valid pointer");
-	RMLUI_VK_ASSERTMSG(m_p_buffer, "you must have a valid VkBuffer");
+	RMLUI_VK_ASSERTMSG(p_block_index, "you must pass a valid pointer");
 
 	RMLUI_VK_ASSERTMSG(*p_alloc == nullptr,
 		"you can't pass a VALID object, because it is for initialization. So it means you passed the already allocated "
@@ -2889,19 +3438,53 @@ bool RenderInterface_VK::MemoryPool::Alloc_GeneralBuffer(VkDeviceSize size, void
 
 	size = AlignUp<VkDeviceSize>(static_cast<VkDeviceSize>(size), m_device_min_uniform_alignment);
 
-	VkDeviceSize offset_memory{};
-
 	VmaVirtualAllocationCreateInfo info = {};
 	info.size = size;
 	info.alignment = m_device_min_uniform_alignment;
 
-	auto status = vmaVirtualAllocate(m_p_block, &info, p_alloc, &offset_memory);
+	VkDeviceSize offset_memory{};
+	uint32_t block_index = 0;
+	VkResult status = VK_ERROR_OUT_OF_DEVICE_MEMORY;
+
+	for (; block_index < static_cast<uint32_t>(m_geometry_blocks.size()); ++block_index)
+	{
+		block_t& block = m_geometry_blocks[block_index];
+		if (block.m_size - block.m_used < size)
+			continue;
+
+		status = vmaVirtualAllocate(block.m_p_virtual_block, &info, p_alloc, &offset_memory);
+		if (status == VkResult::VK_SUCCESS)
+			break;
+	}
+
+	if (status != VkResult::VK_SUCCESS)
+	{
+		// @ none of the blocks can fit the request, so grow the chain instead of failing
+		block_t block = {};
+		if (!Create_Block(Rml::Math::Max(m_geometry_block_size, size), VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+				"memory pool block for vertex and index data", block))
+			return false;
+
+		status = vmaVirtualAllocate(block.m_p_virtual_block, &info, p_alloc, &offset_memory);
+		RMLUI_VK_ASSERTMSG(status == VkResult::VK_SUCCESS, "failed to vmaVirtualAllocate in a fresh block");
+
+		block_index = static_cast<uint32_t>(m_geometry_blocks.size());
+		m_geometry_blocks.push_back(block);
 
-	RMLUI_VK_ASSERTMSG(status == VkResult::VK_SUCCESS, "failed to vmaVirtualAllocate");
+#ifdef RMLUI_VK_DEBUG
+		Rml::Log::Message(Rml::Log::LT_DEBUG, "[Vulkan][Debug] Memory pool grew to %u geometry block(s)", block_index + 1);
+#endif
+	}
 
-	*p_data = (void*)(m_p_data + offset_memory);
+	block_t& block = m_geometry_blocks[block_index];
+	block.m_used += size;
+	m_geometry_bytes_used += size;
+	m_geometry_bytes_used_high_water_mark = Rml::Math::Max(m_geometry_bytes_used_high_water_mark, m_geometry_bytes_used);
 
-	p_out->buffer = m_p_buffer;
+	*p_data = (void*)(block.m_p_data + offset_memory);
+	*p_block_index = block_index;
+
+	p_out->buffer = block.m_p_buffer;
 	p_out->offset = offset_memory;
 	p_out->range = size;
 
@@ -2909,27 +3492,78 @@ bool RenderInterface_VK::MemoryPool::Alloc_GeneralBuffer(VkDeviceSize size, void
 }
 
 bool RenderInterface_VK::MemoryPool::Alloc_VertexBuffer(uint32_t number_of_elements, uint32_t stride_in_bytes, void** p_data,
-	VkDescriptorBufferInfo* p_out, VmaVirtualAllocation* p_alloc) noexcept
+	VkDescriptorBufferInfo* p_out, VmaVirtualAllocation* p_alloc, uint32_t* p_block_index) noexcept
 {
-	return Alloc_GeneralBuffer(number_of_elements * stride_in_bytes, p_data, p_out, p_alloc);
+	return Alloc_GeneralBuffer(number_of_elements * stride_in_bytes, p_data, p_out, p_alloc, p_block_index);
 }
 
 bool RenderInterface_VK::MemoryPool::Alloc_IndexBuffer(uint32_t number_of_elements, uint32_t stride_in_bytes, void** p_data,
-	VkDescriptorBufferInfo* p_out, VmaVirtualAllocation* p_alloc) noexcept
+	VkDescriptorBufferInfo* p_out, VmaVirtualAllocation* p_alloc, uint32_t* p_block_index) noexcept
 {
-	return Alloc_GeneralBuffer(number_of_elements * stride_in_bytes, p_data, p_out, p_alloc);
+	return Alloc_GeneralBuffer(number_of_elements * stride_in_bytes, p_data, p_out, p_alloc, p_block_index);
 }
 
-void RenderInterface_VK::MemoryPool::SetDescriptorSet(uint32_t binding_index, uint32_t size, VkDescriptorType descriptor_type,
+bool RenderInterface_VK::MemoryPool::Alloc_UniformBuffer(VkDeviceSize size, void** p_data, uint32_t* p_dynamic_offset,
+	VkDescriptorSet* p_set) noexcept
+{
+	RMLUI_VK_ASSERTMSG(p_data, "you must pass a valid pointer");
+	RMLUI_VK_ASSERTMSG(p_dynamic_offset, "you must pass a valid pointer");
+	RMLUI_VK_ASSERTMSG(p_set, "you must pass a valid pointer");
+	RMLUI_VK_ASSERTMSG(m_p_descriptor_manager, "you must call Initialize_UniformDescriptors before allocating uniform data");
+
+	size = AlignUp<VkDeviceSize>(static_cast<VkDeviceSize>(size), m_device_min_uniform_alignment);
+
+	auto& blocks = m_uniform_blocks_by_frames[m_uniform_frame_index];
+
+	// @ linear allocation, move on to the next block in the ring of this frame when the current one is full
+	while (m_uniform_block_index < static_cast<uint32_t>(blocks.size()) &&
+		blocks[m_uniform_block_index].m_size - blocks[m_uniform_block_index].m_used < size)
+	{
+		++m_uniform_block_index;
+	}
+
+	if (m_uniform_block_index == static_cast<uint32_t>(blocks.size()))
+	{
+		block_t block = {};
+		if (!Create_Block(Rml::Math::Max(m_uniform_block_size, size), VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+				"memory pool block for per-frame uniform data", block))
+			return false;
+
+		if (!Create_UniformDescriptorSet(block))
+		{
+			Destroy_Block(block);
+			return false;
+		}
+
+		blocks.push_back(block);
+
+#ifdef RMLUI_VK_DEBUG
+		Rml::Log::Message(Rml::Log::LT_DEBUG, "[Vulkan][Debug] Memory pool grew to %u uniform block(s) for frame %u",
+			static_cast<uint32_t>(blocks.size()), m_uniform_frame_index);
+#endif
+	}
+
+	block_t& block = blocks[m_uniform_block_index];
+
+	*p_data = (void*)(block.m_p_data + block.m_used);
+	*p_dynamic_offset = static_cast<uint32_t>(block.m_used);
+	*p_set = block.m_p_descriptor_set;
+
+	block.m_used += size;
+
+	return true;
+}
+
+void RenderInterface_VK::MemoryPool::SetDescriptorSet(uint32_t binding_index, VkBuffer p_buffer, uint32_t size, VkDescriptorType descriptor_type,
 	VkDescriptorSet p_set) noexcept
 {
 	RMLUI_VK_ASSERTMSG(m_p_device, "you must have a valid VkDevice here");
 	RMLUI_VK_ASSERTMSG(p_set, "you must have a valid VkDescriptorSet here");
-	RMLUI_VK_ASSERTMSG(m_p_buffer, "you must have a valid VkBuffer here");
+	RMLUI_VK_ASSERTMSG(p_buffer, "you must have a valid VkBuffer here");
 
 	VkDescriptorBufferInfo info = {};
 
-	info.buffer = m_p_buffer;
+	info.buffer = p_buffer;
 	info.offset = 0;
 	info.range = size;
 
@@ -2952,7 +3586,6 @@ void RenderInterface_VK::MemoryPool::SetDescriptorSet(uint32_t binding_index, Vk
 {
 	RMLUI_VK_ASSERTMSG(m_p_device, "you must have a valid VkDevice here");
 	RMLUI_VK_ASSERTMSG(p_set, "you must have a valid VkDescriptorSet here");
-	RMLUI_VK_ASSERTMSG(m_p_buffer, "you must have a valid VkBuffer here");
 	RMLUI_VK_ASSERTMSG(p_info, "must be valid pointer");
 
 	VkWriteDescriptorSet info_write = {};
@@ -2974,7 +3607,6 @@ void RenderInterface_VK::MemoryPool::SetDescriptorSet(uint32_t binding_index, Vk
 {
 	RMLUI_VK_ASSERTMSG(m_p_device, "you must have a valid VkDevice here");
 	RMLUI_VK_ASSERTMSG(p_set, "you must have a valid VkDescriptorSet here");
-	RMLUI_VK_ASSERTMSG(m_p_buffer, "you must have a valid VkBuffer here");
 	RMLUI_VK_ASSERTMSG(p_view, "you must have a valid VkImageView");
 	RMLUI_VK_ASSERTMSG(p_sampler, "you must have a valid VkSampler here");
 
@@ -3002,40 +3634,129 @@ void RenderInterface_VK::MemoryPool::Free_GeometryHandle(geometry_handle_t* p_va
 {
 	RMLUI_VK_ASSERTMSG(p_valid_geometry_handle,
 		"you must pass a VALID pointer to geometry_handle_t, otherwise something is wrong and debug your code");
-	RMLUI_VK_ASSERTMSG(p_valid_geometry_handle->m_p_vertex_allocation, "you must have a VALID pointer of VmaAllocation for vertex buffer");
-	RMLUI_VK_ASSERTMSG(p_valid_geometry_handle->m_p_index_allocation, "you must have a VALID pointer of VmaAllocation for index buffer");
 
-	// TODO: The following assertion is disabled for now. The shader allocation pointer is only set once the geometry
-	// handle is rendered with. However, currently the Vulkan renderer does not handle all draw calls from RmlUi, so
-	// this pointer may never be set if the geometry was only used in a unsupported draw calls. This can then trigger
-	// the following assertion. The free call below gracefully handles zero pointers so this should be safe regardless.
-	// RMLUI_VK_ASSERTMSG(p_valid_geometry_handle->m_p_shader_allocation,
-	//		"you must have a VALID pointer of VmaAllocation for shader operations (like uniforms and etc)");
+	auto free_allocation = [this](VmaVirtualAllocation& p_alloc, uint32_t block_index) {
+		if (p_alloc == nullptr)
+			return;
+
+		RMLUI_VK_ASSERTMSG(block_index < m_geometry_blocks.size(), "the geometry handle refers to a block that doesn't exist");
+		block_t& block = m_geometry_blocks[block_index];
 
-	RMLUI_VK_ASSERTMSG(m_p_block, "you have to allocate the virtual block before do this operation...");
+		VmaVirtualAllocationInfo info = {};
+		vmaGetVirtualAllocationInfo(block.m_p_virtual_block, p_alloc, &info);
+		vmaVirtualFree(block.m_p_virtual_block, p_alloc);
 
-	vmaVirtualFree(m_p_block, p_valid_geometry_handle->m_p_vertex_allocation);
-	vmaVirtualFree(m_p_block, p_valid_geometry_handle->m_p_index_allocation);
-	vmaVirtualFree(m_p_block, p_valid_geometry_handle->m_p_shader_allocation);
+		block.m_used -= info.size;
+		m_geometry_bytes_used -= info.size;
+		p_alloc = nullptr;
+	};
+
+	free_allocation(p_valid_geometry_handle->m_p_vertex_allocation, p_valid_geometry_handle->m_vertex_block_index);
+	free_allocation(p_valid_geometry_handle->m_p_index_allocation, p_valid_geometry_handle->m_index_block_index);
 
-	p_valid_geometry_handle->m_p_vertex_allocation = nullptr;
-	p_valid_geometry_handle->m_p_shader_allocation = nullptr;
-	p_valid_geometry_handle->m_p_index_allocation = nullptr;
 	p_valid_geometry_handle->m_num_indices = 0;
 }
 
-void RenderInterface_VK::MemoryPool::Free_GeometryHandle_ShaderDataOnly(geometry_handle_t* p_valid_geometry_handle) noexcept
+void RenderInterface_VK::MemoryPool::Get_Statistics(MemoryStatistics& out) const noexcept
 {
-	RMLUI_VK_ASSERTMSG(p_valid_geometry_handle,
-		"you must pass a VALID pointer to geometry_handle_t, otherwise something is wrong and debug your code");
-	RMLUI_VK_ASSERTMSG(p_valid_geometry_handle->m_p_vertex_allocation, "you must have a VALID pointer of VmaAllocation for vertex buffer");
-	RMLUI_VK_ASSERTMSG(p_valid_geometry_handle->m_p_index_allocation, "you must have a VALID pointer of VmaAllocation for index buffer");
-	RMLUI_VK_ASSERTMSG(p_valid_geometry_handle->m_p_shader_allocation,
-		"you must have a VALID pointer of VmaAllocation for shader operations (like uniforms and etc)");
-	RMLUI_VK_ASSERTMSG(m_p_block, "you have to allocate the virtual block before do this operation...");
-
-	vmaVirtualFree(m_p_block, p_valid_geometry_handle->m_p_shader_allocation);
-	p_valid_geometry_handle->m_p_shader_allocation = nullptr;
+	out = {};
+
+	for (const block_t& block : m_geometry_blocks)
+		out.geometry_bytes_reserved += block.m_size;
+
+	out.geometry_bytes_used = m_geometry_bytes_used;
+	out.geometry_bytes_used_high_water_mark = m_geometry_bytes_used_high_water_mark;
+	out.geometry_block_count = static_cast<uint32_t>(m_geometry_blocks.size());
+
+	for (const auto& blocks : m_uniform_blocks_by_frames)
+	{
+		for (const block_t& block : blocks)
+			out.uniform_bytes_reserved += block.m_size;
+
+		out.uniform_block_count += static_cast<uint32_t>(blocks.size());
+	}
+
+	out.uniform_bytes_used_last_frame = m_uniform_bytes_used_last_frame;
+	out.uniform_bytes_used_high_water_mark = m_uniform_bytes_used_high_water_mark;
+}
+
+bool RenderInterface_VK::MemoryPool::Create_Block(VkDeviceSize size, VkBufferUsageFlags usage, const char* p_commentary, block_t& out) noexcept
+{
+	RMLUI_VK_ASSERTMSG(m_p_vk_allocator, "you must have a valid VmaAllocator");
+
+	out = {};
+	out.m_size = AlignUp<VkDeviceSize>(size, m_device_min_uniform_alignment);
+
+	VkBufferCreateInfo info = {};
+	info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+	info.usage = usage;
+	info.size = out.m_size;
+
+	VmaAllocationCreateInfo info_alloc = {};
+	info_alloc.usage = VMA_MEMORY_USAGE_CPU_TO_GPU;
+	info_alloc.flags = VMA_ALLOCATION_CREATE_USER_DATA_COPY_STRING_BIT;
+	info_alloc.pUserData = const_cast<char*>(p_commentary);
+
+	VmaAllocationInfo info_stats = {};
+
+	auto status = vmaCreateBuffer(m_p_vk_allocator, &info, &info_alloc, &out.m_p_buffer, &out.m_p_buffer_alloc, &info_stats);
+	if (status != VkResult::VK_SUCCESS)
+	{
+		Rml::Log::Message(Rml::Log::LT_ERROR, "[Vulkan] failed to vmaCreateBuffer for a memory pool block of %zu bytes", size_t(out.m_size));
+		out = {};
+		return false;
+	}
+
+	if (usage & (VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT))
+	{
+		VmaVirtualBlockCreateInfo info_virtual_block = {};
+		info_virtual_block.size = out.m_size;
+
+		status = vmaCreateVirtualBlock(&info_virtual_block, &out.m_p_virtual_block);
+		RMLUI_VK_ASSERTMSG(status == VkResult::VK_SUCCESS, "failed to vmaCreateVirtualBlock");
+	}
+
+#ifdef RMLUI_VK_DEBUG
+	Rml::Log::Message(Rml::Log::LT_DEBUG, "[Vulkan][Debug] Allocated memory pool block [%s]", FormatByteSize(info_stats.size).c_str());
+#endif
+
+	status = vmaMapMemory(m_p_vk_allocator, out.m_p_buffer_alloc, (void**)&out.m_p_data);
+	RMLUI_VK_ASSERTMSG(status == VkResult::VK_SUCCESS, "failed to vmaMapMemory");
+
+	return true;
+}
+
+void RenderInterface_VK::MemoryPool::Destroy_Block(block_t& block) noexcept
+{
+	if (block.m_p_descriptor_set && m_p_descriptor_manager)
+		m_p_descriptor_manager->Free_Descriptors(m_p_device, &block.m_p_descriptor_set);
+
+	if (block.m_p_virtual_block)
+	{
+		// @ geometry that was never released by RmlUi still holds allocations, they go away together with the block
+		vmaClearVirtualBlock(block.m_p_virtual_block);
+		vmaDestroyVirtualBlock(block.m_p_virtual_block);
+	}
+
+	if (block.m_p_buffer)
+	{
+		vmaUnmapMemory(m_p_vk_allocator, block.m_p_buffer_alloc);
+		vmaDestroyBuffer(m_p_vk_allocator, block.m_p_buffer, block.m_p_buffer_alloc);
+	}
+
+	block = {};
+}
+
+bool RenderInterface_VK::MemoryPool::Create_UniformDescriptorSet(block_t& block) noexcept
+{
+	RMLUI_VK_ASSERTMSG(m_p_descriptor_manager, "you must call Initialize_UniformDescriptors first");
+
+	if (!m_p_descriptor_manager->Alloc_Descriptor(m_p_device, &m_p_uniform_layout, &block.m_p_descriptor_set))
+		return false;
+
+	SetDescriptorSet(m_uniform_binding_index, block.m_p_buffer, m_uniform_range, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, block.m_p_descriptor_set);
+
+	return true;
 }
 
 #define GLAD_VULKAN_IMPLEMENTATION
@@ -37,6 +37,7 @@
 #endif
 
 #include "RmlUi_Include_Vulkan.h"
+#include <mutex>
 
 #ifdef RMLUI_DEBUG
 	#define RMLUI_VK_ASSERTMSG(statement, msg) RMLUI_ASSERTMSG(statement, msg)
@@ -72,7 +73,28 @@
 class RenderInterface_VK : public Rml::RenderInterface {
 public:
 	static constexpr uint32_t kSwapchainBackBufferCount = 3;
+	// Size of each block in the chain holding vertex and index data, a new block is added whenever the existing ones are full.
 	static constexpr VkDeviceSize kVideoMemoryForAllocation = 4 * 1024 * 1024; // [bytes]
+	// Size of each block in the per-frame ring holding uniform data, grows the same way as the geometry chain.
+	static constexpr VkDeviceSize kVideoMemoryForUniformsPerFrame = 256 * 1024; // [bytes]
+	// Size of the staging ring used for texture uploads of each frame, larger uploads get a temporary block of their own.
+	static constexpr VkDeviceSize kStagingMemoryForUploadsPerFrame = 4 * 1024 * 1024; // [bytes]
+
+	struct MemoryStatistics {
+		// Vertex and index data of compiled geometry.
+		VkDeviceSize geometry_bytes_reserved;
+		VkDeviceSize geometry_bytes_used;
+		VkDeviceSize geometry_bytes_used_high_water_mark;
+		uint32_t geometry_block_count;
+
+		// Per-draw uniform data, summed over all buffered frames.
+		VkDeviceSize uniform_bytes_reserved;
+		VkDeviceSize uniform_bytes_used_last_frame;
+		VkDeviceSize uniform_bytes_used_high_water_mark;
+		uint32_t uniform_block_count;
+	};
+
+	class ContextRecorder;
 
 	RenderInterface_VK();
 	~RenderInterface_VK();
@@ -89,6 +111,19 @@ public:
 	bool IsSwapchainValid();
 	void RecreateSwapchain();
 
+	// Returns the current usage and the high-water marks of the video memory pool, useful for sizing the blocks.
+	MemoryStatistics GetMemoryStatistics() const;
+
+	// Sets the file used to keep the pipeline cache between launches, must be called before Initialize. An empty path disables it.
+	void SetPipelineCachePath(const Rml::String& path);
+	// Returns the time spent on the last creation of the graphics pipelines, in milliseconds.
+	double GetPipelineCreationTime() const;
+
+	// Creates a recorder for an RmlUi context that can be rendered on its own thread, see ContextRecorder. The recorder is owned by the renderer
+	// and stays valid until it is destroyed or the renderer is shut down. Must not be called between BeginFrame and EndFrame.
+	ContextRecorder* CreateContextRecorder();
+	void DestroyContextRecorder(ContextRecorder* p_recorder);
+
 	// -- Inherited from Rml::RenderInterface --
 
 	/// Called by RmlUi when it wants to compile geometry it believes will be static for the forseeable future.
@@ -123,10 +158,28 @@ private:
 		Rml::Vector2f m_translate;
 	};
 
+	// @ everything that belongs to one command buffer being recorded, the renderer and each context recorder have their own
+	struct recording_state_t {
+		VkCommandBuffer m_p_command_buffer;
+
+		bool m_is_transform_enabled;
+		bool m_is_apply_to_regular_geometry_stencil;
+		bool m_is_use_scissor_specified;
+		bool m_is_use_stencil_pipeline;
+
+		VkRect2D m_scissor;
+		shader_vertex_user_data_t m_user_data_for_vertex_shader;
+
+		// @ what is bound in the command buffer, so that unchanged state isn't bound again for every draw
+		VkPipeline m_p_bound_pipeline;
+		VkDescriptorSet m_p_bound_texture_descriptor_set;
+	};
+
 	struct texture_data_t {
 		VkImage m_p_vk_image;
 		VkImageView m_p_vk_image_view;
 		VkSampler m_p_vk_sampler;
+		// @ written when the texture is created, so drawing never has to allocate it
 		VkDescriptorSet m_p_vk_descriptor_set;
 		VmaAllocation m_p_vma_allocation;
 	};
@@ -136,13 +189,15 @@ private:
 
 		VkDescriptorBufferInfo m_p_vertex;
 		VkDescriptorBufferInfo m_p_index;
-		VkDescriptorBufferInfo m_p_shader;
 
 		// @ this is for freeing our logical blocks for VMA
 		// see https://gpuopen-librariesandsdks.github.io/VulkanMemoryAllocator/html/virtual_allocator.html
 		VmaVirtualAllocation m_p_vertex_allocation;
 		VmaVirtualAllocation m_p_index_allocation;
-		VmaVirtualAllocation m_p_shader_allocation;
+
+		// @ index of the block in the memory pool chain that owns the allocation
+		uint32_t m_vertex_block_index;
+		uint32_t m_index_block_index;
 	};
 
 	struct buffer_data_t {
@@ -150,177 +205,144 @@ private:
 		VmaAllocation m_p_vma_allocation;
 	};
 
+	// @ batches texture uploads instead of waiting on the GPU for each one
+	// Pixel data is copied into a per-frame staging ring and the copies are queued. When the frame is submitted, all queued copies are recorded
+	// into one command buffer that is executed ahead of the frame's own commands in the same submission, so layout transitions are handled by
+	// barriers and no CPU wait is involved. The staging ring of a frame is rewound once the fence of that frame has signaled.
 	class UploadResourceManager {
 	public:
-		UploadResourceManager() : m_p_device{}, m_p_fence{}, m_p_command_buffer{}, m_p_command_pool{}, m_p_graphics_queue{} {}
-		~UploadResourceManager() {}
-
-		void Initialize(VkDevice p_device, VkQueue p_queue, uint32_t queue_family_index)
-		{
-			RMLUI_VK_ASSERTMSG(p_queue, "you have to pass a valid VkQueue");
-			RMLUI_VK_ASSERTMSG(p_device, "you have to pass a valid VkDevice for creation resources");
+		UploadResourceManager();
+		~UploadResourceManager();
 
-			m_p_device = p_device;
-			m_p_graphics_queue = p_queue;
-
-			Create_All(queue_family_index);
-		}
-
-		void Shutdown()
-		{
-			vkDestroyFence(m_p_device, m_p_fence, nullptr);
-			vkDestroyCommandPool(m_p_device, m_p_command_pool, nullptr);
-		}
-
-		template <typename Func>
-		void UploadToGPU(Func&& p_user_commands) noexcept
-		{
-			RMLUI_VK_ASSERTMSG(m_p_command_buffer, "you didn't initialize VkCommandBuffer");
-
-			VkCommandBufferBeginInfo info_command = {};
-
-			info_command.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-			info_command.pNext = nullptr;
-			info_command.pInheritanceInfo = nullptr;
-			info_command.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-
-			VkResult status = vkBeginCommandBuffer(m_p_command_buffer, &info_command);
-
-			RMLUI_VK_ASSERTMSG(status == VkResult::VK_SUCCESS, "failed to vkBeginCommandBuffer");
+		void Initialize(VkDevice p_device, VmaAllocator p_allocator, VkDeviceSize staging_block_size) noexcept;
+		void Shutdown() noexcept;
 
-			p_user_commands(m_p_command_buffer);
+		// @ must be called after the fence of the given frame has signaled
+		void OnBeginFrame(uint32_t frame_index) noexcept;
 
-			status = vkEndCommandBuffer(m_p_command_buffer);
+		// @ copies the data into staging memory, the image is ready for sampling in any frame submitted after this call
+		bool Queue_TextureUpload(VkImage p_image, VkExtent3D extent, const void* p_data, VkDeviceSize size) noexcept;
+		bool Has_PendingUploads() const noexcept { return !m_pending_uploads.empty(); }
+		// @ records the transitions and copies for all queued uploads and clears the queue
+		void Record_PendingUploads(VkCommandBuffer p_command_buffer) noexcept;
 
-			RMLUI_VK_ASSERTMSG(status == VkResult::VK_SUCCESS, "faield to vkEndCommandBuffer");
-
-			Submit();
-			Wait();
-		}
+		uint32_t Get_UploadCount() const noexcept { return m_upload_count; }
+		uint32_t Get_BatchCount() const noexcept { return m_batch_count; }
 
 	private:
-		void Create_Fence() noexcept
-		{
-			VkFenceCreateInfo info = {};
-			info.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
-			info.pNext = nullptr;
-			info.flags = 0;
-
-			VkResult status = vkCreateFence(m_p_device, &info, nullptr, &m_p_fence);
-
-			RMLUI_VK_ASSERTMSG(status == VkResult::VK_SUCCESS, "failed to vkCreateFence");
-		}
-
-		void Create_CommandBuffer() noexcept
-		{
-			RMLUI_VK_ASSERTMSG(m_p_command_pool, "you have to initialize VkCommandPool before calling this method!");
-
-			VkCommandBufferAllocateInfo info = {};
-			info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-			info.pNext = nullptr;
-			info.commandPool = m_p_command_pool;
-			info.commandBufferCount = 1;
-			info.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-
-			VkResult status = vkAllocateCommandBuffers(m_p_device, &info, &m_p_command_buffer);
-
-			RMLUI_VK_ASSERTMSG(status == VkResult::VK_SUCCESS, "failed to vkAllocateCommandBuffers");
-		}
-
-		void Create_CommandPool(uint32_t queue_family_index) noexcept
-		{
-			VkCommandPoolCreateInfo info = {};
-
-			info.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
-			info.pNext = nullptr;
-			info.queueFamilyIndex = queue_family_index;
-			info.flags = 0;
-
-			VkResult status = vkCreateCommandPool(m_p_device, &info, nullptr, &m_p_command_pool);
-
-			RMLUI_VK_ASSERTMSG(status == VkResult::VK_SUCCESS, "failed to vkCreateCommandPool");
-		}
-
-		void Create_All(uint32_t queue_family_index) noexcept
-		{
-			Create_Fence();
-			Create_CommandPool(queue_family_index);
-			Create_CommandBuffer();
-		}
-
-		void Wait() noexcept
-		{
-			RMLUI_VK_ASSERTMSG(m_p_fence, "you must initialize your VkFence");
-
-			vkWaitForFences(m_p_device, 1, &m_p_fence, VK_TRUE, UINT64_MAX);
-			vkResetFences(m_p_device, 1, &m_p_fence);
-			vkResetCommandPool(m_p_device, m_p_command_pool, 0);
-		}
+		struct staging_block_t {
+			buffer_data_t m_buffer;
+			char* m_p_data;
+			VkDeviceSize m_size;
+			VkDeviceSize m_used;
+		};
 
-		void Submit() noexcept
-		{
-			VkSubmitInfo info = {};
+		struct pending_upload_t {
+			VkImage m_p_image;
+			VkExtent3D m_extent;
+			VkBuffer m_p_staging_buffer;
+			VkDeviceSize m_staging_offset;
+		};
 
-			info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-			info.pNext = nullptr;
-			info.waitSemaphoreCount = 0;
-			info.signalSemaphoreCount = 0;
-			info.pSignalSemaphores = nullptr;
-			info.pWaitSemaphores = nullptr;
-			info.pWaitDstStageMask = nullptr;
-			info.pCommandBuffers = &m_p_command_buffer;
-			info.commandBufferCount = 1;
+		bool Create_StagingBlock(VkDeviceSize size, staging_block_t& out) noexcept;
+		void Destroy_StagingBlock(staging_block_t& block) noexcept;
 
-			auto status = vkQueueSubmit(m_p_graphics_queue, 1, &info, m_p_fence);
+		VkDevice m_p_device;
+		VmaAllocator m_p_allocator;
+		VkDeviceSize m_staging_block_size;
 
-			RMLUI_VK_ASSERTMSG(status == VkResult::VK_SUCCESS, "failed to vkQueueSubmit");
-		}
+		Rml::Array<Rml::Vector<staging_block_t>, kSwapchainBackBufferCount> m_staging_blocks_by_frames;
+		uint32_t m_frame_index;
+		Rml::Vector<pending_upload_t> m_pending_uploads;
 
-	private:
-		VkDevice m_p_device;
-		VkFence m_p_fence;
-		VkCommandBuffer m_p_command_buffer;
-		VkCommandPool m_p_command_pool;
-		VkQueue m_p_graphics_queue;
+		uint32_t m_upload_count;
+		uint32_t m_batch_count;
 	};
 
+	class DescriptorPoolManager;
+
 	// @ main manager for "allocating" vertex, index, uniform stuff
+	// Vertex and index data of compiled geometry live in a chain of blocks with virtual allocations (Vma), a new block is appended when none of
+	// the existing ones can fit the request. Per-draw uniform data is short-lived, so it is written linearly into a ring of blocks owned by the
+	// frame being recorded, which is rewound once the fence of that frame has signaled.
 	class MemoryPool {
 	public:
 		MemoryPool();
 		~MemoryPool();
 
-		void Initialize(VkDeviceSize byte_size, VkDeviceSize device_min_uniform_alignment, VmaAllocator p_allocator, VkDevice p_device) noexcept;
+		void Initialize(VkDeviceSize geometry_block_size, VkDeviceSize uniform_block_size, VkDeviceSize device_min_uniform_alignment,
+			VmaAllocator p_allocator, VkDevice p_device) noexcept;
+		// @ uniform blocks are bound through dynamic offsets, each block owns a descriptor set created with the given layout
+		void Initialize_UniformDescriptors(DescriptorPoolManager* p_manager, VkDescriptorSetLayout p_layout, uint32_t binding_index,
+			uint32_t range) noexcept;
 		void Shutdown() noexcept;
 
-		bool Alloc_GeneralBuffer(VkDeviceSize size, void** p_data, VkDescriptorBufferInfo* p_out, VmaVirtualAllocation* p_alloc) noexcept;
+		// @ must be called after the fence of the given frame has signaled, rewinds the uniform ring of that frame
+		void OnBeginFrame(uint32_t frame_index) noexcept;
+
+		bool Alloc_GeneralBuffer(VkDeviceSize size, void** p_data, VkDescriptorBufferInfo* p_out, VmaVirtualAllocation* p_alloc,
+			uint32_t* p_block_index) noexcept;
 		bool Alloc_VertexBuffer(uint32_t number_of_elements, uint32_t stride_in_bytes, void** p_data, VkDescriptorBufferInfo* p_out,
-			VmaVirtualAllocation* p_alloc) noexcept;
+			VmaVirtualAllocation* p_alloc, uint32_t* p_block_index) noexcept;
 		bool Alloc_IndexBuffer(uint32_t number_of_elements, uint32_t stride_in_bytes, void** p_data, VkDescriptorBufferInfo* p_out,
-			VmaVirtualAllocation* p_alloc) noexcept;
+			VmaVirtualAllocation* p_alloc, uint32_t* p_block_index) noexcept;
+		// @ the returned memory is only valid until the fence of the current frame signals
+		bool Alloc_UniformBuffer(VkDeviceSize size, void** p_data, uint32_t* p_dynamic_offset, VkDescriptorSet* p_set) noexcept;
 
-		void SetDescriptorSet(uint32_t binding_index, uint32_t size, VkDescriptorType descriptor_type, VkDescriptorSet p_set) noexcept;
+		void SetDescriptorSet(uint32_t binding_index, VkBuffer p_buffer, uint32_t size, VkDescriptorType descriptor_type,
+			VkDescriptorSet p_set) noexcept;
 		void SetDescriptorSet(uint32_t binding_index, VkDescriptorBufferInfo* p_info, VkDescriptorType descriptor_type,
 			VkDescriptorSet p_set) noexcept;
 		void SetDescriptorSet(uint32_t binding_index, VkSampler p_sampler, VkImageLayout layout, VkImageView p_view, VkDescriptorType descriptor_type,
 			VkDescriptorSet p_set) noexcept;
 
 		void Free_GeometryHandle(geometry_handle_t* p_valid_geometry_handle) noexcept;
-		void Free_GeometryHandle_ShaderDataOnly(geometry_handle_t* p_valid_geometry_handle) noexcept;
+
+		void Get_Statistics(MemoryStatistics& out) const noexcept;
 
 	private:
-		VkDeviceSize m_memory_total_size;
+		struct block_t {
+			VkBuffer m_p_buffer;
+			VmaAllocation m_p_buffer_alloc;
+			char* m_p_data;
+			VkDeviceSize m_size;
+			VkDeviceSize m_used;
+
+			// @ only for geometry blocks
+			VmaVirtualBlock m_p_virtual_block;
+			// @ only for uniform blocks
+			VkDescriptorSet m_p_descriptor_set;
+		};
+
+		bool Create_Block(VkDeviceSize size, VkBufferUsageFlags usage, const char* p_commentary, block_t& out) noexcept;
+		void Destroy_Block(block_t& block) noexcept;
+		bool Create_UniformDescriptorSet(block_t& block) noexcept;
+
+		VkDeviceSize m_geometry_block_size;
+		VkDeviceSize m_uniform_block_size;
 		VkDeviceSize m_device_min_uniform_alignment;
-		char* m_p_data;
-		VkBuffer m_p_buffer;
-		VmaAllocation m_p_buffer_alloc;
 		VkDevice m_p_device;
 		VmaAllocator m_p_vk_allocator;
-		VmaVirtualBlock m_p_block;
+
+		DescriptorPoolManager* m_p_descriptor_manager;
+		VkDescriptorSetLayout m_p_uniform_layout;
+		uint32_t m_uniform_binding_index;
+		uint32_t m_uniform_range;
+
+		Rml::Vector<block_t> m_geometry_blocks;
+		VkDeviceSize m_geometry_bytes_used;
+		VkDeviceSize m_geometry_bytes_used_high_water_mark;
+
+		Rml::Array<Rml::Vector<block_t>, kSwapchainBackBufferCount> m_uniform_blocks_by_frames;
+		uint32_t m_uniform_frame_index;
+		uint32_t m_uniform_block_index;
+		VkDeviceSize m_uniform_bytes_used_last_frame;
+		VkDeviceSize m_uniform_bytes_used_high_water_mark;
 	};
 
 	// If we need additional command buffers, we can add them to this list and retrieve them from the ring.
-	enum class CommandBufferName { Primary, Count };
+	// Secondary is allocated as a secondary command buffer, it holds the draws of the renderer itself when context recorders are in use.
+	enum class CommandBufferName { Primary, Upload, Secondary, Count };
 
 	// The command buffer ring stores a unique set of named command buffers for each bufferd frame.
 	// Explanation of how to use Vulkan efficiently: https://vkguide.dev/docs/chapter-4/double_buffering/
@@ -499,6 +521,17 @@ private:
 	void Create_Pipelines() noexcept;
 	void CreateRenderPass() noexcept;
 
+	void Reset_RecordingState(recording_state_t& state, VkCommandBuffer p_command_buffer) noexcept;
+	void Begin_SecondaryCommandBuffer(VkCommandBuffer p_command_buffer) noexcept;
+	void Record_Geometry(recording_state_t& state, Rml::CompiledGeometryHandle geometry, Rml::Vector2f translation,
+		Rml::TextureHandle texture) noexcept;
+	void Record_EnableScissorRegion(recording_state_t& state, bool enable) noexcept;
+	void Record_SetScissorRegion(recording_state_t& state, Rml::Rectanglei region) noexcept;
+	void Record_SetTransform(recording_state_t& state, const Rml::Matrix4f* transform) noexcept;
+
+	void Initialize_PipelineCache(const VkPhysicalDeviceProperties& physical_device_properties) noexcept;
+	void Destroy_PipelineCache() noexcept;
+
 	void CreateSwapchainFrameBuffers(const VkExtent2D& real_render_image_size) noexcept;
 
 	// This method is called in Views, so don't call it manually
@@ -510,8 +543,6 @@ private:
 
 	void CreateResourcesDependentOnSize(const VkExtent2D& real_render_image_size) noexcept;
 
-	buffer_data_t CreateResource_StagingBuffer(VkDeviceSize size, VkBufferUsageFlags flags) noexcept;
-	void DestroyResource_StagingBuffer(const buffer_data_t& data) noexcept;
 
 	void Destroy_Textures() noexcept;
 	void Destroy_Geometries() noexcept;
@@ -538,10 +569,8 @@ private:
 	VkFormat Get_SupportedDepthFormat();
 
 private:
-	bool m_is_transform_enabled;
-	bool m_is_apply_to_regular_geometry_stencil;
-	bool m_is_use_scissor_specified;
-	bool m_is_use_stencil_pipeline;
+	// @ true while the frame being recorded executes secondary command buffers, i.e. at least one context recorder exists
+	bool m_is_recording_secondary;
 
 	int m_width;
 	int m_height;
@@ -570,10 +599,29 @@ private:
 	VkPipeline m_p_pipeline_stencil_for_region_where_geometry_will_be_drawn;
 	VkPipeline m_p_pipeline_stencil_for_regular_geometry_that_applied_to_region_with_textures;
 	VkPipeline m_p_pipeline_stencil_for_regular_geometry_that_applied_to_region_without_textures;
-	VkDescriptorSet m_p_descriptor_set;
+
+	// @ written in front of the data returned by vkGetPipelineCacheData, so that a cache from another device or driver is never loaded
+	struct pipeline_cache_header_t {
+		uint32_t m_magic;
+		uint32_t m_header_version;
+		uint32_t m_vendor_id;
+		uint32_t m_device_id;
+		uint32_t m_driver_version;
+		uint8_t m_pipeline_cache_uuid[VK_UUID_SIZE];
+		uint64_t m_data_size;
+	};
+
+	static constexpr uint32_t kPipelineCacheMagic = 0x434b5652; // 'RVKC'
+	static constexpr uint32_t kPipelineCacheHeaderVersion = 1;
+
+	VkPipelineCache m_p_pipeline_cache;
+	pipeline_cache_header_t m_pipeline_cache_header;
+	Rml::String m_pipeline_cache_path;
+	bool m_is_pipeline_cache_warm;
+	bool m_is_pipeline_creation_reported;
+	double m_pipeline_creation_time;
 	VkRenderPass m_p_render_pass;
 	VkSampler m_p_sampler_linear;
-	VkRect2D m_scissor;
 
 	// @ means it captures the window size full width and full height, offset equals both x and y to 0
 	VkRect2D m_scissor_original;
@@ -588,8 +636,9 @@ private:
 #endif
 
 	VkSurfaceFormatKHR m_swapchain_format;
-	shader_vertex_user_data_t m_user_data_for_vertex_shader;
 	texture_data_t m_texture_depthstencil;
+	// @ state of the draws issued on the renderer itself
+	recording_state_t m_recording;
 
 	Rml::Matrix4f m_projection;
 	Rml::Vector<VkFence> m_executed_fences;
@@ -608,6 +657,55 @@ private:
 	MemoryPool m_memory_pool;
 	UploadResourceManager m_upload_manager;
 	DescriptorPoolManager m_manager_descriptors;
+
+	// @ guards what recorders share across threads: the memory pool, texture uploads, descriptors and the deletion queues
+	mutable std::mutex m_resource_mutex;
+	Rml::Vector<Rml::UniquePtr<ContextRecorder>> m_context_recorders;
+	// @ the recorders ended in the current frame in the order End was called, which is the order their command buffers are executed in
+	Rml::Vector<ContextRecorder*> m_ended_context_recorders;
+	Rml::Vector<VkCommandBuffer> m_secondary_command_buffers;
+};
+
+/**
+ * Records the draws of one RmlUi context into a secondary command buffer, so that several contexts can be recorded in parallel.
+ *
+ * Set it as the render interface of the context and call Begin and End around Context::Render, on any thread, after BeginFrame and before
+ * EndFrame of the renderer. Each recorder has its own command pools, so a recorder must only be used by one thread at a time. Geometry and
+ * texture handles are shared with the renderer and all other recorders. The primary command buffer executes the draws of the renderer itself
+ * first, followed by the recorders in the order End was called on them during the frame, so the first context ended is drawn at the back.
+ * When recording on several threads, call End from one thread once each context is rendered to keep that order stable from frame to frame.
+ */
+class RenderInterface_VK::ContextRecorder : public Rml::RenderInterface {
+public:
+	~ContextRecorder();
+
+	void Begin();
+	void End();
+
+	// -- Inherited from Rml::RenderInterface, forwarded to the renderer --
+
+	Rml::CompiledGeometryHandle CompileGeometry(Rml::Span<const Rml::Vertex> vertices, Rml::Span<const int> indices) override;
+	void RenderGeometry(Rml::CompiledGeometryHandle handle, Rml::Vector2f translation, Rml::TextureHandle texture) override;
+	void ReleaseGeometry(Rml::CompiledGeometryHandle geometry) override;
+
+	Rml::TextureHandle LoadTexture(Rml::Vector2i& texture_dimensions, const Rml::String& source) override;
+	Rml::TextureHandle GenerateTexture(Rml::Span<const Rml::byte> source_data, Rml::Vector2i source_dimensions) override;
+	void ReleaseTexture(Rml::TextureHandle texture_handle) override;
+
+	void EnableScissorRegion(bool enable) override;
+	void SetScissorRegion(Rml::Rectanglei region) override;
+
+	void SetTransform(const Rml::Matrix4f* transform) override;
+
+private:
+	friend class RenderInterface_VK;
+
+	explicit ContextRecorder(RenderInterface_VK* p_owner);
+
+	RenderInterface_VK* m_p_owner;
+	Rml::Array<VkCommandPool, kSwapchainBackBufferCount> m_command_pools;
+	Rml::Array<VkCommandBuffer, kSwapchainBackBufferCount> m_command_buffers;
+	recording_state_t m_state;
 };
 
 #endif
@@ -2,6 +2,7 @@
 
 #include <stdint.h>
 
+#define RMLUI_VK_HAS_SHADER_FRAG_COLOR
 alignas(uint32_t) static const unsigned char shader_frag_color[] = {
 	0x03,0x02,0x23,0x07,0x00,0x00,0x01,0x00,0x0A,0x00,0x0D,0x00,0x10,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
 	0x11,0x00,0x02,0x00,0x01,0x00,0x00,0x00,0x0B,0x00,0x06,0x00,0x01,0x00,0x00,0x00,0x47,0x4C,0x53,0x4C,
@@ -36,6 +37,7 @@ alignas(uint32_t) static const unsigned char shader_frag_color[] = {
 	0x09,0x00,0x00,0x00,0x0C,0x00,0x00,0x00,0xFD,0x00,0x01,0x00,0x38,0x00,0x01,0x00,
 };
 
+#define RMLUI_VK_HAS_SHADER_FRAG_TEXTURE
 alignas(uint32_t) static const unsigned char shader_frag_texture[] = {
 	0x03,0x02,0x23,0x07,0x00,0x00,0x01,0x00,0x0A,0x00,0x0D,0x00,0x1B,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
 	0x11,0x00,0x02,0x00,0x01,0x00,0x00,0x00,0x0B,0x00,0x06,0x00,0x01,0x00,0x00,0x00,0x47,0x4C,0x53,0x4C,
@@ -84,6 +86,7 @@ alignas(uint32_t) static const unsigned char shader_frag_texture[] = {
 	0x15,0x00,0x00,0x00,0x1A,0x00,0x00,0x00,0xFD,0x00,0x01,0x00,0x38,0x00,0x01,0x00,
 };
 
+#define RMLUI_VK_HAS_SHADER_VERT
 alignas(uint32_t) static const unsigned char shader_vert[] = {
 	0x03,0x02,0x23,0x07,0x00,0x00,0x01,0x00,0x0A,0x00,0x0D,0x00,0x36,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
 	0x11,0x00,0x02,0x00,0x01,0x00,0x00,0x00,0x0B,0x00,0x06,0x00,0x01,0x00,0x00,0x00,0x47,0x4C,0x53,0x4C,
@@ -26,8 +26,11 @@
 import sys
 import os
 import subprocess
+import shutil
 
 # Compiles all .frag and .vert files in this directory to SPIR-V binary C character arrays. Requires 'glslc' installed and available system-wide.
+# Each array is preceded by a 'RMLUI_VK_HAS_<VARIABLE>' define, so that the renderer can detect optional shaders which have not been compiled yet.
+# Validates every module with 'spirv-val' when it is available.
 
 out_file = "ShadersCompiledSPV.h"
 
@@ -39,7 +42,7 @@ out_path = os.path.join(current_dir, out_file)
 with open(out_path,'w') as result_file:
 	result_file.write('// RmlUi SPIR-V Vulkan shaders compiled using command: \'python compile_shaders.py\'. Do not edit manually.\n\n#include <stdint.h>\n')
 
-	for file in os.listdir(current_dir):
+	for file in sorted(os.listdir(current_dir)):
 		if file.endswith(".vert") or file.endswith(".frag"):
 			shader_path = os.path.join(current_dir, file)
 			variable_name = os.path.splitext(file)[0]
@@ -47,10 +50,14 @@ with open(out_path,'w') as result_file:
 			print("Compiling '{}' to SPIR-V using glslc.".format(file))
 			
 			subprocess.run(["glslc", shader_path, "-o", temp_spirv_path], check = True)
+
+			if shutil.which("spirv-val"):
+				subprocess.run(["spirv-val", temp_spirv_path], check = True)
 			
 			print("Success, writing output to variable '{}' in {}".format(variable_name, out_file))
 		
 			i = 0
+			result_file.write('\n#define RMLUI_VK_HAS_{}'.format(variable_name.upper()))
 			result_file.write('\nalignas(uint32_t) static const unsigned char {}[] = {{'.format(variable_name))
 			for b in open(temp_spirv_path, 'rb').read():
 				if i % 20 == 0:
@@ -1,37 +1,78 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
 #include <iostream>
+#include <memory>
+#include <new>
+#include <sstream>
 #include <string>
+#include <string.h>
+#include <thread>
+#include <vector>
+#if defined(_MSC_VER) && defined(_DEBUG)
+#include <crtdbg.h>
+#endif
 #include <RmlUi/Core.h>
 #include <RmlUi/Debugger.h>
 #include "ADDITONAL/RmlUi_Backend.h"
+#include "ADDITONAL/AssetWatcher.h"
+#include "ADDITONAL/AsyncLogSink.h"
+#include "ADDITONAL/BakedTexture.h"
+#include "ADDITONAL/FrameTiming.h"
+#include "ADDITONAL/InputReplay.h"
+#include "ADDITONAL/InstancedDecorators.h"
+#include "ADDITONAL/RmlUi_Platform_Null.h"
+#include "ADDITONAL/RmlUi_Renderer_GL3.h"
+#include "ADDITONAL/RmlUi_Renderer_Null.h"
+#include "ADDITONAL/RmlUi_Renderer_SW.h"
+#include "ADDITONAL/UICompositor.h"
+#include <RmlUi_Renderer_GL2.h>
 
-// Global/static variable to track reload requests
-static bool reload_requested = false;
+// Counts heap allocations while enabled, only during the benchmarks. The debug CRT reports every allocation made through it, which
+// includes rmlui.dll when it is linked against the same CRT. Otherwise only the allocations made by operator new in this executable are
+// seen, the ones inside rmlui.dll are not.
+static std::atomic<size_t> num_allocations{0};
 
-// KeyDownCallback for handling F5
-bool HandleKeyDown(Rml::Context* context, Rml::Input::KeyIdentifier key, int /*modifier*/, float /*native_dp_ratio*/, bool priority) {
-    if (key == Rml::Input::KI_F5 && priority) {
-        reload_requested = true;
-        return true; // Block further processing of F5
-    }
-    return false;
+#if defined(_MSC_VER) && defined(_DEBUG)
+static const char* allocation_counting_scope = "through the debug CRT, including rmlui.dll only if it shares the CRT";
+
+static int CountAllocationHook(int type, void*, size_t, int block_type, long, const unsigned char*, int)
+{
+    if ((type == _HOOK_ALLOC || type == _HOOK_REALLOC) && block_type != _CRT_BLOCK)
+        num_allocations.fetch_add(1, std::memory_order_relaxed);
+    return 1;
 }
 
-void ReloadDocument(Rml::Context* context, Rml::ElementDocument*& document, const std::string& path) {
-    if (document) {
-        document->Close(); // Close the current document
-    }
+static void EnableAllocationCounting(bool enable)
+{
+    _CrtSetAllocHook(enable ? CountAllocationHook : nullptr);
+}
+#else
+static const char* allocation_counting_scope = "by operator new in the executable, allocations inside rmlui.dll are not included";
+static std::atomic<bool> count_allocations{false};
 
-    // Clear cached stylesheets to force reload
-    Rml::Factory::ClearStyleSheetCache(); // <-- Add this line
+static void EnableAllocationCounting(bool enable)
+{
+    count_allocations.store(enable, std::memory_order_relaxed);
+}
 
-    document = context->LoadDocument(path); // Reload from disk
-    if (document) {
-        document->Show();
-    }
-    else {
-        Rml::Log::Message(Rml::Log::LT_ERROR, "Failed to reload document!");
-    }
+void* operator new(std::size_t size) {
+    if (count_allocations.load(std::memory_order_relaxed))
+        num_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size ? size : 1))
+        return ptr;
+    throw std::bad_alloc();
+}
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
 }
+#endif
 
 struct MyData
 {
@@ -56,7 +97,737 @@ bool SetupDataBinding(Rml::Context* context, Rml::DataModelHandle& my_model)
     return true;
 }
 
-int main() {
+// Command-line texture baker: RmlUi-Tutorial --bake <source.tga|png|jpg> <destination.rmlt> [--mips]
+int BakeTexture(int argc, char** argv)
+{
+    if (argc < 4) {
+        std::cout << "Usage: " << argv[0] << " --bake <source> <destination." << BakedTexture::FileExtension << "> [--mips]" << std::endl;
+        return 1;
+    }
+
+    const bool generate_mipmaps = (argc >= 5 && strcmp(argv[4], "--mips") == 0);
+
+    Rml::String message;
+    const bool result = BakedTexture::Bake(argv[2], argv[3], generate_mipmaps, &message);
+    std::cout << message << std::endl;
+    return result ? 0 : 1;
+}
+
+// The invader window template, shown next to the demo document in the benchmark
+static const char* benchmark_window_rml = R"(
+<rml>
+<head>
+    <link type="text/template" href="window.rml"/>
+    <title>Benchmark</title>
+</head>
+<body template="window">
+    <p>The quick brown fox jumps over the lazy dog.</p>
+    <p>Sphinx of black quartz, judge my vow.</p>
+</body>
+</rml>
+)";
+
+static void PrintTimings(const char* name, std::vector<double> samples_ms)
+{
+    std::sort(samples_ms.begin(), samples_ms.end());
+    double sum = 0.0;
+    for (double sample : samples_ms)
+        sum += sample;
+
+    std::cout << "  " << std::left << std::setw(8) << name << std::right << std::fixed << std::setprecision(4)
+              << " mean " << sum / samples_ms.size() << " ms, median " << samples_ms[samples_ms.size() / 2] << " ms, p99 "
+              << samples_ms[std::min(samples_ms.size() - 1, samples_ms.size() * 99 / 100)] << " ms, max " << samples_ms.back() << " ms" << std::endl;
+}
+
+// Loads the demo document and the invader window shown next to it, shared by the benchmarks
+static bool LoadBenchmarkDocuments(Rml::Context* context, Rml::DataModelHandle& model_handle)
+{
+    Rml::LoadFontFace("assets/LatoLatin-Regular.ttf");
+    Rml::LoadFontFace("assets/LatoLatin-Bold.ttf");
+    Rml::LoadFontFace("assets/LatoLatin-Italic.ttf");
+
+    if (!context || !SetupDataBinding(context, model_handle)) {
+        return false;
+    }
+
+    Rml::ElementDocument* document = context->LoadDocument("assets/demo.rml");
+    Rml::ElementDocument* window = context->LoadDocumentFromMemory(benchmark_window_rml, "assets/benchmark_window.rml");
+    if (!document || !window) {
+        std::cout << "Benchmark documents failed to load" << std::endl;
+        return false;
+    }
+    document->Show();
+    window->Show();
+    return true;
+}
+
+// A grid of small boxes that each carry their own rotation and translation, so that every draw is issued under a different transform
+static std::string BuildTransformBenchmarkRml(int columns, int rows)
+{
+    std::ostringstream rml;
+    rml << "<rml><head><title>Transforms</title><style>"
+           "body, div { display: block; } body { width: 100%; height: 100%; } "
+           "div { position: absolute; width: 14px; height: 14px; background-color: #c8643c; border: 1px #f0f0f0; }"
+           "</style></head><body>";
+    for (int row = 0; row < rows; row++) {
+        for (int column = 0; column < columns; column++) {
+            const int index = row * columns + column;
+            rml << "<div style=\"left: " << column * 20 << "px; top: " << row * 18 << "px; transform: rotate(" << (index * 7) % 360
+                << "deg) translate(" << index % 5 - 2 << "px, " << index % 3 - 1 << "px);\"/>";
+        }
+    }
+    rml << "</body></rml>";
+    return rml.str();
+}
+
+// Headless CPU benchmark of context update and render, without any GPU work: RmlUi-Tutorial --benchmark [frames]
+int RunBenchmark(int argc, char** argv)
+{
+    const int num_frames = (argc >= 3 ? std::max(std::atoi(argv[2]), 1) : 5000);
+
+    SystemInterface_Null system_interface;
+    RenderInterface_Null render_interface;
+    Rml::SetSystemInterface(&system_interface);
+    Rml::SetRenderInterface(&render_interface);
+
+    if (!Rml::Initialise()) {
+        return 1;
+    }
+
+    Rml::Context* context = Rml::CreateContext("benchmark", Rml::Vector2i(1280, 720));
+    Rml::DataModelHandle modelHandle;
+    if (!LoadBenchmarkDocuments(context, modelHandle)) {
+        Rml::Shutdown();
+        return 1;
+    }
+
+    // Count only what happens inside the frames
+    render_interface.EndFrame();
+
+    std::vector<double> update_ms, render_ms, frame_ms;
+    std::vector<size_t> allocations;
+    update_ms.reserve(num_frames);
+    render_ms.reserve(num_frames);
+    frame_ms.reserve(num_frames);
+    allocations.reserve(num_frames);
+
+    using Clock = std::chrono::steady_clock;
+    const Clock::time_point benchmark_start = Clock::now();
+    EnableAllocationCounting(true);
+
+    for (int i = 0; i < num_frames; i++) {
+        system_interface.AdvanceFrame();
+
+        const size_t allocations_before = num_allocations.load(std::memory_order_relaxed);
+        const Clock::time_point t0 = Clock::now();
+        context->Update();
+        const Clock::time_point t1 = Clock::now();
+        context->Render();
+        render_interface.EndFrame();
+        const Clock::time_point t2 = Clock::now();
+
+        update_ms.push_back(std::chrono::duration<double, std::milli>(t1 - t0).count());
+        render_ms.push_back(std::chrono::duration<double, std::milli>(t2 - t1).count());
+        frame_ms.push_back(std::chrono::duration<double, std::milli>(t2 - t0).count());
+        allocations.push_back(num_allocations.load(std::memory_order_relaxed) - allocations_before);
+    }
+
+    EnableAllocationCounting(false);
+    const double total_seconds = std::chrono::duration<double>(Clock::now() - benchmark_start).count();
+
+    size_t total_allocations = 0;
+    for (size_t count : allocations)
+        total_allocations += count;
+
+    const RenderInterface_Null::FrameStatistics& stats = render_interface.GetLastFrameStatistics();
+
+    std::cout << "Benchmark: " << num_frames << " frames in " << std::fixed << std::setprecision(3) << total_seconds << " s ("
+              << std::setprecision(1) << num_frames / total_seconds << " frames per second)" << std::endl;
+    PrintTimings("update", update_ms);
+    PrintTimings("render", render_ms);
+    PrintTimings("frame", frame_ms);
+    std::cout << "  allocations per frame: mean " << std::setprecision(1) << double(total_allocations) / num_frames << ", max "
+              << *std::max_element(allocations.begin(), allocations.end()) << " (counted " << allocation_counting_scope << ")"
+              << std::endl;
+    std::cout << "  last frame: " << stats.num_render_geometry_calls << " draw calls, " << stats.num_rendered_vertices << " vertices, "
+              << stats.num_rendered_indices << " indices, " << stats.num_compile_geometry_calls << " geometries compiled, "
+              << stats.num_layers_pushed << " layers, " << stats.num_filters_applied << " filters, " << stats.texture_bytes << " texture bytes"
+              << std::endl;
+
+    Rml::Shutdown();
+    return 0;
+}
+
+// Renders the context through the GL3 renderer and presents it, returning the CPU time of the frame in milliseconds
+static double RenderBenchmarkFrame(Rml::Context* context)
+{
+    context->Update();
+    const auto t0 = std::chrono::steady_clock::now();
+    Backend::BeginFrame();
+    context->Render();
+    Backend::PresentFrame();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+}
+
+// GPU benchmark of the GL3 renderer in a hidden window, without waiting for vertical sync: RmlUi-Tutorial --benchmark-gl [frames]
+int RunBenchmarkGL(int argc, char** argv)
+{
+    const int num_frames = (argc >= 3 ? std::max(std::atoi(argv[2]), 1) : 1000);
+
+    if (!Backend::Initialize("RmlUi Benchmark", 1280, 720, true, false)) {
+        std::cout << "Backend initialization failed" << std::endl;
+        return 1;
+    }
+    glfwSwapInterval(0);
+
+    Rml::SetSystemInterface(Backend::GetSystemInterface());
+    Rml::SetRenderInterface(Backend::GetRenderInterface());
+    if (!Rml::Initialise()) {
+        Backend::Shutdown();
+        return 1;
+    }
+
+    RenderInterface_GL3* render_interface = static_cast<RenderInterface_GL3*>(Backend::GetRenderInterface());
+    render_interface->SetViewport(1280, 720);
+
+    Rml::Context* context = Rml::CreateContext("benchmark", Rml::Vector2i(1280, 720));
+    Rml::DataModelHandle modelHandle;
+    if (!LoadBenchmarkDocuments(context, modelHandle)) {
+        Rml::Shutdown();
+        Backend::Shutdown();
+        return 1;
+    }
+    RenderBenchmarkFrame(context);
+
+    Rml::Context* transform_context = Rml::CreateContext("benchmark-transforms", Rml::Vector2i(1280, 720));
+    Rml::ElementDocument* transform_document =
+        transform_context ? transform_context->LoadDocumentFromMemory(BuildTransformBenchmarkRml(64, 40), "benchmark_transforms.rml") : nullptr;
+    if (!transform_document) {
+        std::cout << "Transform benchmark document failed to load" << std::endl;
+        Rml::Shutdown();
+        Backend::Shutdown();
+        return 1;
+    }
+    transform_document->Show();
+    RenderBenchmarkFrame(transform_context);
+
+    std::cout << "GL3 benchmark: " << num_frames << " frames per run" << std::endl;
+
+    // Uniform uploads: the shared uniform buffer uploaded only when changed, against once after every program switch. The demo
+    // documents are mostly untransformed, the transform document changes the transform before nearly every draw.
+    for (Rml::Context* benchmark_context : {context, transform_context}) {
+        std::cout << (benchmark_context == context ? "Demo documents:" : "Transformed elements (64x40):") << std::endl;
+
+        for (bool per_program : {false, true}) {
+            render_interface->SetSharedUniformsPerProgram(per_program);
+            const RenderInterface_GL3::UniformReport before = render_interface->GetUniformReport();
+
+            std::vector<double> frame_ms;
+            for (int i = 0; i < num_frames; i++) {
+                frame_ms.push_back(RenderBenchmarkFrame(benchmark_context));
+            }
+
+            const RenderInterface_GL3::UniformReport after = render_interface->GetUniformReport();
+            std::cout << (per_program ? "Uniforms uploaded per program: " : "Uniforms shared: ") << std::fixed << std::setprecision(1)
+                      << double(after.num_shared_uniform_uploads - before.num_shared_uniform_uploads) / num_frames << " uploads, "
+                      << double(after.num_program_switches - before.num_program_switches) / num_frames << " program switches, "
+                      << double(after.num_transform_submissions - before.num_transform_submissions) / num_frames << " draws per frame"
+                      << std::endl;
+            PrintTimings("frame", frame_ms);
+        }
+    }
+    render_interface->SetSharedUniformsPerProgram(false);
+    Rml::RemoveContext("benchmark-transforms");
+
+    // Resizing: a window edge dragged out and back in a few pixels per frame, as the backend applies it on framebuffer size changes
+    std::vector<Rml::Vector2i> sizes;
+    for (int step = 1; step <= 64; step++) {
+        sizes.push_back(Rml::Vector2i(1280 + 8 * std::min(step, 64 - step), 720 + 4 * std::min(step, 64 - step)));
+    }
+
+    const RenderInterface_GL3::RenderTargetReport targets_before = render_interface->GetRenderTargetReport();
+    const size_t allocations_before = num_allocations.load(std::memory_order_relaxed);
+    std::vector<double> resize_frame_ms;
+    EnableAllocationCounting(true);
+    for (const Rml::Vector2i& size : sizes) {
+        render_interface->SetViewport(size.x, size.y);
+        context->SetDimensions(size);
+        resize_frame_ms.push_back(RenderBenchmarkFrame(context));
+    }
+    EnableAllocationCounting(false);
+    const RenderInterface_GL3::RenderTargetReport targets_after = render_interface->GetRenderTargetReport();
+
+    const double num_resizes = double(sizes.size());
+    std::cout << "Resizing: " << sizes.size() << " resizes, " << std::fixed << std::setprecision(2)
+              << double(targets_after.num_reallocations - targets_before.num_reallocations) / num_resizes << " framebuffer reallocations, "
+              << double(targets_after.num_framebuffers_created - targets_before.num_framebuffers_created) / num_resizes
+              << " framebuffers created and " << double(num_allocations.load(std::memory_order_relaxed) - allocations_before) / num_resizes
+              << " allocations per resize (counted " << allocation_counting_scope << ")" << std::endl;
+    PrintTimings("frame", resize_frame_ms);
+
+    Rml::Shutdown();
+    Backend::Shutdown();
+    return 0;
+}
+
+// Compares the geometry modes of the GL2 renderer in a hidden window, without waiting for vertical sync:
+// RmlUi-Tutorial --benchmark-gl2 [frames]
+// Run against a software implementation of OpenGL for the comparison without a GPU, e.g. with Mesa's llvmpipe opengl32.dll placed next
+// to the executable on Windows, or LIBGL_ALWAYS_SOFTWARE=1 on Linux.
+int RunBenchmarkGL2(int argc, char** argv)
+{
+    const int num_frames = (argc >= 3 ? std::max(std::atoi(argv[2]), 1) : 1000);
+
+    if (!glfwInit()) {
+        std::cout << "GLFW initialization failed" << std::endl;
+        return 1;
+    }
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 2);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 0);
+    glfwWindowHint(GLFW_STENCIL_BITS, 8);
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    GLFWwindow* window = glfwCreateWindow(1280, 720, "RmlUi GL2 Benchmark", nullptr, nullptr);
+    if (!window) {
+        std::cout << "Window creation failed" << std::endl;
+        glfwTerminate();
+        return 1;
+    }
+    glfwMakeContextCurrent(window);
+    glfwSwapInterval(0);
+
+    SystemInterface_Null system_interface;
+    RenderInterface_GL2 render_interface;
+    render_interface.SetViewport(1280, 720);
+    Rml::SetSystemInterface(&system_interface);
+    Rml::SetRenderInterface(&render_interface);
+    if (!Rml::Initialise()) {
+        glfwDestroyWindow(window);
+        glfwTerminate();
+        return 1;
+    }
+
+    std::cout << "GL2 benchmark on " << (const char*)glGetString(GL_RENDERER) << ": " << num_frames << " frames per geometry mode" << std::endl;
+
+    using GeometryMode = RenderInterface_GL2::GeometryMode;
+    const std::pair<GeometryMode, const char*> modes[] = {
+        {GeometryMode::ClientArrays, "Client arrays"},
+        {GeometryMode::DisplayLists, "Display lists"},
+        {GeometryMode::VertexBuffers, "Vertex buffers"},
+    };
+
+    int result = 0;
+    for (const auto& mode : modes) {
+        // A fresh context per mode, so that all of its geometry is compiled with the mode
+        render_interface.SetMaxGeometryMode(mode.first);
+        Rml::Context* context = Rml::CreateContext("benchmark", Rml::Vector2i(1280, 720));
+        Rml::DataModelHandle modelHandle;
+        if (!LoadBenchmarkDocuments(context, modelHandle)) {
+            result = 1;
+            break;
+        }
+
+        std::vector<double> frame_ms;
+        frame_ms.reserve(num_frames);
+        for (int i = 0; i < num_frames; i++) {
+            system_interface.AdvanceFrame();
+            context->Update();
+            const auto t0 = std::chrono::steady_clock::now();
+            render_interface.Clear();
+            render_interface.BeginFrame();
+            context->Render();
+            render_interface.EndFrame();
+            glfwSwapBuffers(window);
+            frame_ms.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count());
+        }
+
+        const RenderInterface_GL2::GeometryStatistics stats = render_interface.GetGeometryStatistics();
+        std::cout << mode.second << ": " << stats.num_client_array_geometries << " client array, " << stats.num_display_list_geometries
+                  << " display list and " << stats.num_vertex_buffer_geometries << " vertex buffer geometries ("
+                  << stats.num_shared_quad_index_geometries << " sharing the quad indices), " << stats.buffer_bytes << " buffer bytes"
+                  << std::endl;
+        PrintTimings("frame", frame_ms);
+
+        Rml::RemoveContext("benchmark");
+    }
+
+    Rml::Shutdown();
+    glfwDestroyWindow(window);
+    glfwTerminate();
+    return result;
+}
+
+// Writes premultiplied RGBA rows from top to bottom as an uncompressed 32-bit TGA image, for inspecting the parity test
+static bool WriteTGA(const std::string& path, const std::vector<Rml::byte>& pixels, int width, int height)
+{
+    FILE* file = fopen(path.c_str(), "wb");
+    if (!file) {
+        return false;
+    }
+    const unsigned char header[18] = {0, 0, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0, (unsigned char)(width & 0xff), (unsigned char)(width >> 8),
+        (unsigned char)(height & 0xff), (unsigned char)(height >> 8), 32, 0x28};
+    fwrite(header, 1, sizeof(header), file);
+    std::vector<Rml::byte> bgra(pixels);
+    for (size_t i = 0; i + 3 < bgra.size(); i += 4) {
+        std::swap(bgra[i], bgra[i + 2]);
+    }
+    const bool result = (fwrite(bgra.data(), 1, bgra.size(), file) == bgra.size());
+    fclose(file);
+    return result;
+}
+
+// One feature per quarter of the window, each in a cell large enough to hold what its filters spill beyond the element
+static const char* parity_features_rml = R"(
+<rml>
+<head>
+    <title>Parity features</title>
+    <style>
+        body, div { display: block; }
+        body { width: 100%; height: 100%; font-family: LatoLatin; font-size: 28px; color: #fff; }
+        .cell { position: absolute; width: 640px; height: 360px; }
+        .card { position: absolute; left: 200px; top: 100px; width: 240px; height: 160px; line-height: 160px; text-align: center;
+            background-color: #3c78c8; border: 4px #f0f0f0; }
+        .stripe { height: 20px; background-color: #e0a030; }
+        .stripe.odd { background-color: #30a070; }
+    </style>
+</head>
+<body>
+    <div class="cell" style="left: 0px; top: 0px;"><div class="card" style="filter: blur(6px);">Blur</div></div>
+    <div class="cell" style="left: 640px; top: 0px;"><div class="card" style="filter: drop-shadow(#000c 12px 12px 8px);">Shadow</div></div>
+    <div class="cell" style="left: 0px; top: 360px;">
+        <div class="card" style="overflow: hidden; border-radius: 48px; line-height: normal;">
+            <div class="stripe"/><div class="stripe odd"/><div class="stripe"/><div class="stripe odd"/><div class="stripe"/>
+            <div class="stripe odd"/><div class="stripe"/><div class="stripe odd"/><div class="stripe"/><div class="stripe odd"/>
+        </div>
+    </div>
+    <div class="cell" style="left: 640px; top: 360px;"><div class="card" style="transform: rotate(20deg) scale(1.2);">Transform</div></div>
+</body>
+</rml>
+)";
+
+struct ParityFeature {
+    const char* name;
+    int x, y, width, height;
+};
+
+static const ParityFeature parity_features[] = {
+    {"blur", 0, 0, 640, 360},
+    {"drop-shadow", 640, 0, 640, 360},
+    {"border-radius clip", 0, 360, 640, 360},
+    {"transform", 640, 360, 640, 360},
+};
+
+struct ParityResult {
+    size_t num_pixels = 0;
+    size_t num_mismatched = 0;
+    int max_difference = 0;
+
+    double MismatchedPercent() const { return num_pixels ? 100.0 * double(num_mismatched) / double(num_pixels) : 0.0; }
+};
+
+// Renders the context of each renderer into an image of the given size, the GL3 image through a texture target
+static void RenderParityImages(RenderInterface_GL3* gl3_interface, Rml::Context* gl3_context, RenderInterface_SW& sw_interface,
+    Rml::Context* sw_context, int width, int height, std::vector<Rml::byte>& gl3_pixels, std::vector<Rml::byte>& sw_pixels)
+{
+    gl3_context->Update();
+    sw_context->Update();
+
+    const RenderInterface_GL3::TextureTargetHandle target = gl3_interface->CreateTextureTarget(width, height);
+    gl3_interface->RenderTextureTarget(target, gl3_context, 0.0);
+    gl3_interface->ReadTextureTarget(target, gl3_pixels);
+    gl3_interface->ReleaseTextureTarget(target);
+
+    sw_pixels.assign(size_t(width) * height * 4, 0);
+    sw_interface.SetRenderTarget(sw_pixels.data(), width, height, width * 4);
+    sw_interface.BeginFrame();
+    sw_context->Render();
+    sw_interface.EndFrame();
+}
+
+// Compares the pixels within the rectangle, a pixel mismatches when any of its channels differs by more than the tolerance
+static ParityResult CompareParityImages(const std::vector<Rml::byte>& a, const std::vector<Rml::byte>& b, int image_width, int x, int y,
+    int width, int height, int tolerance)
+{
+    ParityResult result;
+    for (int row = y; row < y + height; row++) {
+        for (int column = x; column < x + width; column++) {
+            const size_t i = (size_t(row) * image_width + column) * 4;
+            int pixel_difference = 0;
+            for (size_t c = i; c < i + 4; c++) {
+                pixel_difference = std::max(pixel_difference, std::abs(int(a[c]) - int(b[c])));
+            }
+            result.max_difference = std::max(result.max_difference, pixel_difference);
+            result.num_mismatched += (pixel_difference > tolerance ? 1 : 0);
+            result.num_pixels += 1;
+        }
+    }
+    return result;
+}
+
+// Renders the benchmark documents, and then a document with one feature in each quarter, through both the software renderer and the
+// GL3 renderer in a hidden window, and compares the pixels: RmlUi-Tutorial --sw-parity [tolerance] [max mismatched percent]
+// A pixel mismatches when any of its premultiplied channels differs by more than the tolerance. The benchmark documents and each feature
+// must stay within the mismatched percentage. Both images are written next to the executable when a comparison fails. Multisampling is
+// disabled in GL3, as the software renderer only antialiases through coverage.
+int RunSoftwareParity(int argc, char** argv)
+{
+    const int tolerance = (argc >= 3 ? std::max(std::atoi(argv[2]), 0) : 16);
+    const double max_mismatched_percent = (argc >= 4 ? std::max(std::atof(argv[3]), 0.0) : 0.5);
+    const int width = 1280, height = 720;
+
+    if (!Backend::Initialize("RmlUi Software Parity", width, height, false, false)) {
+        std::cout << "Backend initialization failed" << std::endl;
+        return 1;
+    }
+
+    // Both contexts are updated on the same frozen clock, so that animations are sampled at the same time
+    SystemInterface_Null system_interface;
+    RenderInterface_SW sw_interface;
+    Rml::SetSystemInterface(&system_interface);
+    Rml::SetRenderInterface(Backend::GetRenderInterface());
+    if (!Rml::Initialise()) {
+        Backend::Shutdown();
+        return 1;
+    }
+
+    RenderInterface_GL3* gl3_interface = static_cast<RenderInterface_GL3*>(Backend::GetRenderInterface());
+    gl3_interface->SetRenderQuality({0, 0, 1.f});
+
+    int result = 1;
+    Rml::Context* gl3_context = Rml::CreateContext("gl3", Rml::Vector2i(width, height));
+    Rml::Context* sw_context = Rml::CreateContext("software", Rml::Vector2i(width, height), &sw_interface);
+    Rml::Context* gl3_features_context = Rml::CreateContext("gl3-features", Rml::Vector2i(width, height));
+    Rml::Context* sw_features_context = Rml::CreateContext("software-features", Rml::Vector2i(width, height), &sw_interface);
+    Rml::DataModelHandle gl3_model, sw_model;
+
+    if (LoadBenchmarkDocuments(gl3_context, gl3_model) && LoadBenchmarkDocuments(sw_context, sw_model)) {
+        std::vector<Rml::byte> gl3_pixels, sw_pixels;
+        RenderParityImages(gl3_interface, gl3_context, sw_interface, sw_context, width, height, gl3_pixels, sw_pixels);
+
+        const ParityResult documents = CompareParityImages(sw_pixels, gl3_pixels, width, 0, 0, width, height, tolerance);
+        const bool documents_passed = (documents.MismatchedPercent() <= max_mismatched_percent);
+
+        std::cout << "Software parity: " << documents.num_mismatched << " pixels (" << std::fixed << std::setprecision(3)
+                  << documents.MismatchedPercent() << "%) differ by more than " << tolerance << ", max difference "
+                  << documents.max_difference << ", " << (documents_passed ? "passed" : "failed") << std::endl;
+        if (!documents_passed && WriteTGA("sw_parity_gl3.tga", gl3_pixels, width, height) &&
+            WriteTGA("sw_parity_software.tga", sw_pixels, width, height)) {
+            std::cout << "Images written to sw_parity_gl3.tga and sw_parity_software.tga" << std::endl;
+        }
+
+        bool features_passed = false;
+        Rml::ElementDocument* gl3_features =
+            gl3_features_context ? gl3_features_context->LoadDocumentFromMemory(parity_features_rml, "parity_features.rml") : nullptr;
+        Rml::ElementDocument* sw_features =
+            sw_features_context ? sw_features_context->LoadDocumentFromMemory(parity_features_rml, "parity_features.rml") : nullptr;
+        if (gl3_features && sw_features) {
+            gl3_features->Show();
+            sw_features->Show();
+            RenderParityImages(gl3_interface, gl3_features_context, sw_interface, sw_features_context, width, height, gl3_pixels, sw_pixels);
+
+            features_passed = true;
+            std::cout << "Feature parity:" << std::endl;
+            for (const ParityFeature& feature : parity_features) {
+                const ParityResult region =
+                    CompareParityImages(sw_pixels, gl3_pixels, width, feature.x, feature.y, feature.width, feature.height, tolerance);
+                const bool passed = (region.MismatchedPercent() <= max_mismatched_percent);
+                features_passed &= passed;
+
+                std::cout << "  " << std::left << std::setw(20) << feature.name << std::right << region.num_mismatched << " pixels ("
+                          << std::setprecision(3) << region.MismatchedPercent() << "%) differ, max difference " << region.max_difference
+                          << ", " << (passed ? "passed" : "failed") << std::endl;
+            }
+
+            if (!features_passed && WriteTGA("sw_parity_features_gl3.tga", gl3_pixels, width, height) &&
+                WriteTGA("sw_parity_features_software.tga", sw_pixels, width, height)) {
+                std::cout << "Images written to sw_parity_features_gl3.tga and sw_parity_features_software.tga" << std::endl;
+            }
+        }
+        else {
+            std::cout << "Parity feature document failed to load" << std::endl;
+        }
+
+        result = (documents_passed && features_passed ? 0 : 1);
+    }
+
+    // Shutting down releases the resources of the software contexts, so their render interface must outlive this
+    Rml::Shutdown();
+    Backend::Shutdown();
+    return result;
+}
+
+// Stress test of the asynchronous log sink, writing from many threads at once and checking that every message is accounted for:
+// RmlUi-Tutorial --log-stress [threads] [messages per thread]
+// Build with ThreadSanitizer where available (-fsanitize=thread with Clang or GCC) to also check the ring buffer for data races.
+int RunLogStress(int argc, char** argv)
+{
+    const int num_threads = (argc >= 3 ? std::max(std::atoi(argv[2]), 1) : 8);
+    const int num_messages = (argc >= 4 ? std::max(std::atoi(argv[3]), 1) : 20000);
+
+#ifdef _WIN32
+    FILE* output = fopen("NUL", "w");
+#else
+    FILE* output = fopen("/dev/null", "w");
+#endif
+    if (!output) {
+        return 1;
+    }
+
+    AsyncLogSink::Statistics stats = {};
+    {
+        AsyncLogSink sink(output);
+        // The rate limit would discard nearly everything, leaving the ring buffer idle
+        sink.SetRateLimit(0.0, 1);
+
+        std::vector<std::thread> threads;
+        for (int t = 0; t < num_threads; t++) {
+            threads.emplace_back([&sink, t, num_messages] {
+                for (int i = 0; i < num_messages; i++) {
+                    // Every eighth message is filtered, and each message is sent twice in a row to be collapsed when not interleaved
+                    const Rml::Log::Type type = (i % 8 == 0 ? Rml::Log::LT_DEBUG : Rml::Log::LT_WARNING);
+                    sink.Write(type, "thread " + std::to_string(t) + " message " + std::to_string(i / 2));
+                }
+            });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+
+        sink.Flush(5.0);
+        stats = sink.GetStatistics();
+    }
+    fclose(output);
+
+    const size_t num_sent = size_t(num_threads) * size_t(num_messages);
+    const size_t num_accounted = stats.num_written + stats.num_filtered + stats.num_rate_limited + stats.num_dropped_full + stats.num_repeated;
+
+    std::cout << "Log stress: " << num_sent << " messages from " << num_threads << " threads, " << stats.num_written << " written, "
+              << stats.num_repeated << " collapsed, " << stats.num_filtered << " filtered, " << stats.num_rate_limited << " rate limited, "
+              << stats.num_dropped_full << " dropped with the queue full" << std::endl;
+    if (num_accounted != num_sent) {
+        std::cout << "  " << num_sent - num_accounted << " messages unaccounted for" << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+// Headless replay of recorded input against the demo document, timing each input handler of the context:
+// RmlUi-Tutorial --replay <recording> [--real-time]
+int RunReplay(int argc, char** argv)
+{
+    if (argc < 3) {
+        std::cout << "Usage: " << argv[0] << " --replay <recording> [--real-time]" << std::endl;
+        return 1;
+    }
+    const bool real_time = (argc >= 4 && strcmp(argv[3], "--real-time") == 0);
+
+    Rml::Vector<InputReplay::Event> events;
+    if (!InputReplay::Load(argv[2], events)) {
+        return 1;
+    }
+
+    SystemInterface_Null system_interface;
+    RenderInterface_Null render_interface;
+    Rml::SetSystemInterface(&system_interface);
+    Rml::SetRenderInterface(&render_interface);
+
+    if (!Rml::Initialise()) {
+        return 1;
+    }
+
+    Rml::LoadFontFace("assets/LatoLatin-Regular.ttf");
+    Rml::LoadFontFace("assets/LatoLatin-Bold.ttf");
+    Rml::LoadFontFace("assets/LatoLatin-Italic.ttf");
+
+    Rml::Context* context = Rml::CreateContext("replay", Rml::Vector2i(1280, 720));
+    Rml::DataModelHandle modelHandle;
+    Rml::ElementDocument* document = (context && SetupDataBinding(context, modelHandle) ? context->LoadDocument("assets/demo.rml") : nullptr);
+    if (!document) {
+        std::cout << "Replay document failed to load" << std::endl;
+        Rml::Shutdown();
+        return 1;
+    }
+    document->Show();
+
+    InputReplay::Player player(context, std::move(events));
+
+    // Each iteration replays one recorded frame, and the elapsed time advances by the recorded length of that frame. In real time the
+    // frames are also held back until their recorded time, otherwise they run back to back.
+    std::vector<double> update_ms, render_ms;
+    using Clock = std::chrono::steady_clock;
+    const Clock::time_point replay_start = Clock::now();
+    double previous_frame_time = 0.0;
+    bool events_remaining = true;
+
+    while (events_remaining) {
+        events_remaining = player.Advance();
+
+        const double frame_time = player.GetFrameTime();
+        system_interface.SetTimeStep(frame_time - previous_frame_time);
+        system_interface.AdvanceFrame();
+        previous_frame_time = frame_time;
+
+        if (real_time) {
+            std::this_thread::sleep_until(replay_start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(frame_time)));
+        }
+
+        const Clock::time_point t0 = Clock::now();
+        context->Update();
+        const Clock::time_point t1 = Clock::now();
+        context->Render();
+        render_interface.EndFrame();
+        const Clock::time_point t2 = Clock::now();
+
+        update_ms.push_back(std::chrono::duration<double, std::milli>(t1 - t0).count());
+        render_ms.push_back(std::chrono::duration<double, std::milli>(t2 - t1).count());
+    }
+
+    const double total_seconds = std::chrono::duration<double>(Clock::now() - replay_start).count();
+
+    std::cout << "Replay: " << player.GetNumEvents() << " events in " << player.GetNumFrames() << " frames recorded over " << std::fixed
+              << std::setprecision(3) << player.GetDuration() << " s, replayed in " << update_ms.size() << " frames and " << total_seconds
+              << " s" << std::endl;
+    if (player.GetNumFrames() == 0) {
+        std::cout << "  the recording has no frame events, it was split into frames of " << InputReplay::Player::FallbackFrameTime * 1000.0
+                  << " ms" << std::endl;
+    }
+    for (int i = 0; i < (int)InputReplay::Handler::Count; i++) {
+        const InputReplay::Handler handler = InputReplay::Handler(i);
+        const Rml::Vector<double>& samples = player.GetHandlerSamples(handler);
+        if (!samples.empty()) {
+            const std::string name = std::string(InputReplay::GetHandlerName(handler)) + " x" + std::to_string(samples.size());
+            PrintTimings(name.c_str(), samples);
+        }
+    }
+    PrintTimings("update", update_ms);
+    PrintTimings("render", render_ms);
+
+    Rml::Shutdown();
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    if (argc >= 2 && strcmp(argv[1], "--bake") == 0) {
+        return BakeTexture(argc, argv);
+    }
+    if (argc >= 2 && strcmp(argv[1], "--benchmark") == 0) {
+        return RunBenchmark(argc, argv);
+    }
+    if (argc >= 2 && strcmp(argv[1], "--benchmark-gl") == 0) {
+        return RunBenchmarkGL(argc, argv);
+    }
+    if (argc >= 2 && strcmp(argv[1], "--benchmark-gl2") == 0) {
+        return RunBenchmarkGL2(argc, argv);
+    }
+    if (argc >= 2 && strcmp(argv[1], "--sw-parity") == 0) {
+        return RunSoftwareParity(argc, argv);
+    }
+    if (argc >= 2 && strcmp(argv[1], "--log-stress") == 0) {
+        return RunLogStress(argc, argv);
+    }
+    if (argc >= 2 && strcmp(argv[1], "--replay") == 0) {
+        return RunReplay(argc, argv);
+    }
+
     // Initialize backend first
     std::cout << "Initializing backend" << std::endl;
     if (!Backend::Initialize("RmlUi Demo", 1280, 720, true)) {
@@ -73,6 +844,18 @@ int main() {
         return 1;
     }
 
+    RenderInterface_GL3* render_interface = static_cast<RenderInterface_GL3*>(Backend::GetRenderInterface());
+
+    // Draw the tiled and ninepatch decorators through the instanced quad path of the GL3 renderer
+    InstancedDecorators::Initialize(render_interface);
+
+    // Optionally adapt the render quality to a frame time budget: RmlUi-Tutorial --frame-budget <milliseconds>
+    for (int i = 1; i + 1 < argc; i++) {
+        if (strcmp(argv[i], "--frame-budget") == 0) {
+            render_interface->SetFrameTimeBudget(std::atof(argv[i + 1]));
+        }
+    }
+
     // Load fonts
     // Load font faces
     if (!Rml::LoadFontFace("assets/LatoLatin-Regular.ttf")) {
@@ -93,8 +876,25 @@ int main() {
         return 1;
     }
 
-    // Initialize debugger AFTER context creation
-    Rml::Debugger::Initialise(context);
+    // Initialize debugger AFTER context creation, optionally in a window of its own: RmlUi-Tutorial --debugger-window
+    GLFWwindow* debugger_window = nullptr;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--debugger-window") == 0) {
+            debugger_window = Backend::OpenWindow("RmlUi Debugger", 640, 720, true);
+        }
+    }
+
+    Rml::Context* debugger_context = nullptr;
+    if (debugger_window) {
+        debugger_context = Rml::CreateContext("debugger", Rml::Vector2i(640, 720));
+        Backend::SetWindowContext(debugger_window, debugger_context);
+        Rml::Debugger::Initialise(debugger_context);
+        Rml::Debugger::SetContext(context);
+        Rml::Debugger::SetVisible(true);
+    }
+    else {
+        Rml::Debugger::Initialise(context);
+    }
     //Rml::Debugger::SetVisible(true);  // Start with debugger visible for testing
 
     //Setup Data Binding:
@@ -115,36 +915,102 @@ int main() {
     }
     document->Show();
     std::cout << "Document loaded successfully" << std::endl;
+
+    // Reload documents and style sheets as their files are saved, waking up the main loop from the watcher thread
+    // The watcher is stopped before shutting down, so its thread can't wake up a terminated GLFW or see the context released
+    std::unique_ptr<AssetWatcher> asset_watcher = std::make_unique<AssetWatcher>(context, [] { glfwPostEmptyEvent(); });
+
     // Main loop with proper error handling
 
-    bool f5_was_pressed = false;
+    // Sleep between events and only render when the document changed, unless started with: RmlUi-Tutorial --continuous
+    // Frame timing: --frame-limit <fps>, --frame-stats shows an overlay, --frame-timing-export <file.csv|file.json> on exit
+    // Input recording for headless replay with --replay: --record-input <file> writes the input on exit
+    // Host rendering at full rate with the user interface composited from a cached texture: --ui-rate <updates per second, 0 on change>
+    // Resource warming in the idle time of the loop: --warm <document.rml>, --warm-glyphs <size in px>, --warm-texture <file>
+    bool continuous = false;
+    std::unique_ptr<UICompositor> compositor;
+    const char* frame_timing_export = nullptr;
+    const char* input_recording_path = nullptr;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--continuous") == 0) {
+            continuous = true;
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "--record-input") == 0) {
+            input_recording_path = argv[i + 1];
+            Backend::StartInputRecording();
+        }
+        else if (strcmp(argv[i], "--frame-stats") == 0) {
+            FrameTiming::ShowOverlay(context);
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "--frame-limit") == 0) {
+            FrameTiming::SetFrameLimit(std::atof(argv[i + 1]));
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "--frame-timing-export") == 0) {
+            frame_timing_export = argv[i + 1];
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "--warm") == 0) {
+            Backend::SubmitIdleTask("preload document", IdleTasks::PreloadDocument(context, argv[i + 1]));
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "--warm-glyphs") == 0) {
+            Rml::String characters;
+            for (char c = ' '; c <= '~'; c++) {
+                characters += c;
+            }
+            Backend::SubmitIdleTask("rasterise glyphs", IdleTasks::RasteriseGlyphs(context, "LatoLatin", std::atoi(argv[i + 1]), characters),
+                IdleTaskScheduler::Budget::Honoured);
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "--warm-texture") == 0) {
+            Backend::SubmitIdleTask("upload texture", IdleTasks::UploadTexture(context, argv[i + 1]));
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "--ui-rate") == 0) {
+            compositor = std::make_unique<UICompositor>(*render_interface, context);
+            compositor->SetUpdateRate(std::atof(argv[i + 1]));
+            continuous = true;
+        }
+    }
 
     try {
-        while (Backend::ProcessEvents(context, nullptr, false)) {
-            context->Update();
-
-            // Detect F5 press without callbacks
-            GLFWwindow* window = Backend::GetWindow();
-            if (window) {
-                const bool f5_currently_pressed = (glfwGetKey(window, GLFW_KEY_F5) == GLFW_PRESS);
+        while (Backend::ProcessEvents(context, nullptr, !continuous)) {
+            if (FrameTiming::UpdateOverlay()) {
+                Backend::RequestRedraw();
+            }
+            if (asset_watcher->Update()) {
+                Backend::RequestRedraw();
+            }
 
-                if (f5_currently_pressed && !f5_was_pressed) {
-                    reload_requested = true;
+            {
+                FrameTiming::ScopedPhase phase(FrameTiming::Phase::Update);
+                if (!compositor) {
+                    context->Update();
+                }
+                if (debugger_context) {
+                    debugger_context->Update();
                 }
-                f5_was_pressed = f5_currently_pressed;
             }
 
-            // Check if F5 was pressed
-            if (reload_requested) {
-                ReloadDocument(context, document, "assets/demo.rml");
-                std::cout << 1 << std::endl;
-                reload_requested = false;
+            Backend::RenderWindows();
+
+            if (compositor) {
+                // The host scene is only cleared here, the context is updated and rendered by the compositor when it changed
+                Backend::BeginHostFrame();
+                {
+                    FrameTiming::ScopedPhase phase(FrameTiming::Phase::Render);
+                    compositor->Update(Backend::ShouldRender(context), glfwGetTime());
+                    compositor->Composite();
+                }
+                Backend::PresentHostFrame();
+                continue;
             }
 
-            std::cout << MyData.animal << std::endl;
+            if (!Backend::ShouldRender(context) && !continuous) {
+                continue;
+            }
 
             Backend::BeginFrame();
-            context->Render();
+            {
+                FrameTiming::ScopedPhase phase(FrameTiming::Phase::Render);
+                context->Render();
+            }
             Backend::PresentFrame();
         }
     }
@@ -152,8 +1018,72 @@ int main() {
         Rml::Log::Message(Rml::Log::LT_ERROR, "Runtime error: %s", e.what());
     }
 
+    if (frame_timing_export) {
+        const std::string path = frame_timing_export;
+        const bool json = (path.size() >= 5 && path.compare(path.size() - 5, 5, ".json") == 0);
+        if (json ? FrameTiming::ExportJSON(path) : FrameTiming::ExportCSV(path)) {
+            std::cout << "Frame timings written to " << path << std::endl;
+        }
+    }
+    FrameTiming::HideOverlay();
+
+    if (input_recording_path && Backend::StopInputRecording(input_recording_path)) {
+        std::cout << "Input recorded to " << input_recording_path << std::endl;
+    }
+
+    const Backend::LoopStatistics& loop_stats = Backend::GetLoopStatistics();
+    std::cout << "Rendered " << loop_stats.num_rendered_frames << " of " << loop_stats.num_iterations << " frames ("
+              << loop_stats.num_idle_frames << " idle), waiting " << loop_stats.time_waiting << " s, active " << loop_stats.time_active
+              << " s and running idle tasks " << loop_stats.time_idle_tasks << " s" << std::endl;
+
+    if (loop_stats.num_resize_events > 0) {
+        const RenderInterface_GL3::RenderTargetReport targets = render_interface->GetRenderTargetReport();
+        std::cout << "Resized " << loop_stats.num_resize_events << " times (" << loop_stats.num_resizes_applied << " applied), "
+                  << targets.num_reallocations << " framebuffer reallocations creating " << targets.num_framebuffers_created
+                  << " framebuffers" << std::endl;
+    }
+
+    if (compositor) {
+        const UICompositor::Statistics& ui_stats = compositor->GetStatistics();
+        const double ui_frame_ms = (ui_stats.num_ui_frames > 0 ? 1000.0 * ui_stats.ui_time / double(ui_stats.num_ui_frames) : 0.0);
+        const double mean_latency_ms = (ui_stats.num_changes > 0 ? 1000.0 * ui_stats.total_latency / double(ui_stats.num_changes) : 0.0);
+        std::cout << "Rendered the user interface in " << ui_stats.num_ui_frames << " of " << ui_stats.num_host_frames << " host frames ("
+                  << ui_stats.num_full_rate_frames << " at full rate), " << std::fixed << std::setprecision(3) << ui_frame_ms
+                  << " ms per update, saving about " << ui_frame_ms * double(ui_stats.num_host_frames - ui_stats.num_ui_frames)
+                  << " ms of UI time" << std::endl;
+        std::cout << "Change latency: mean " << mean_latency_ms << " ms, max " << 1000.0 * ui_stats.max_latency << " ms" << std::endl;
+        std::cout.unsetf(std::ios::fixed);
+        compositor.reset();
+    }
+
+    const IdleTaskScheduler::Statistics& idle_stats = Backend::GetIdleTaskStatistics();
+    if (idle_stats.num_submitted > 0) {
+        std::cout << "Idle tasks: " << idle_stats.num_completed << " of " << idle_stats.num_submitted << " completed in "
+                  << idle_stats.num_slices << " slices over " << idle_stats.num_idle_periods << " idle periods, using "
+                  << 1000.0 * idle_stats.time_used << " of " << 1000.0 * idle_stats.time_available << " ms available" << std::endl;
+        std::cout << "Idle task budget overruns: " << idle_stats.num_overruns << " (max " << 1000.0 * idle_stats.max_overrun << " ms), "
+                  << idle_stats.num_oversized_slices << " oversized slices" << std::endl;
+
+        const Rml::StringList pending_tasks = Backend::GetPendingIdleTasks();
+        if (!pending_tasks.empty()) {
+            std::cout << "Idle tasks still pending at exit:";
+            for (const Rml::String& name : pending_tasks) {
+                std::cout << " '" << name << "'";
+            }
+            std::cout << std::endl;
+        }
+    }
+
+    const AsyncLogSink::Statistics log_stats = Backend::GetLogStatistics();
+    if (log_stats.num_rate_limited + log_stats.num_dropped_full > 0) {
+        std::cout << "Log messages dropped: " << log_stats.num_rate_limited << " rate limited, " << log_stats.num_dropped_full
+                  << " with the queue full" << std::endl;
+    }
+
     // Cleanup
+    asset_watcher.reset();
     Rml::Shutdown();
+    InstancedDecorators::Shutdown();
     Backend::Shutdown();
 
     return 0;